@@ -0,0 +1,315 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/ExternalSorter.h"
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "common/algorithm/MemcomparableCodec.h"
+#include "common/datatypes/ValueOps.inl"
+
+DEFINE_int64(external_sort_memory_budget, 256 * 1024 * 1024,
+             "Bytes of rows buffered by an external sort before spilling to disk");
+DEFINE_string(external_sort_tmp_dir, "/tmp", "Directory of the runs spilled by external sorts");
+
+namespace nebula {
+namespace algorithm {
+
+using serializer = apache::thrift::CompactSerializer;
+
+namespace {
+
+constexpr size_t kReadBufferSize = 256 * 1024;
+
+// Rough bytes taken by the value, including sizeof(Value)
+size_t estimateSize(const Value& val);
+
+// Heap bytes of a props name, or of a key of a Map
+size_t keyBytes(const Symbol& key) {
+    return key.heapBytes();
+}
+
+size_t keyBytes(const std::string& key) {
+    return key.capacity();
+}
+
+template <class Props>
+size_t estimatePropsSize(const Props& props) {
+    size_t size = 0;
+    for (const auto& kv : props) {
+        // The entry of the flat map, the Value is counted by estimateSize()
+        size += sizeof(kv.first) + keyBytes(kv.first) + estimateSize(kv.second);
+    }
+    return size;
+}
+
+size_t estimateVertexSize(const Vertex& v) {
+    size_t size = estimateSize(v.vid);
+    for (const auto& tag : v.tags) {
+        size += sizeof(tag) + tag.name.heapBytes() + estimatePropsSize(tag.props);
+    }
+    return size;
+}
+
+size_t estimateSize(const Value& val) {
+    size_t size = sizeof(Value);
+    switch (val.type()) {
+        case Value::Type::STRING: {
+            return size + val.getStr().capacity();
+        }
+        case Value::Type::VERTEX: {
+            return size + sizeof(Vertex) + estimateVertexSize(val.getVertex());
+        }
+        case Value::Type::EDGE: {
+            const auto& e = val.getEdge();
+            return size + sizeof(Edge) + estimateSize(e.src) + estimateSize(e.dst) +
+                   e.name.heapBytes() + estimatePropsSize(e.props);
+        }
+        case Value::Type::PATH: {
+            const auto& p = val.getPath();
+            size += sizeof(Path) + estimateVertexSize(p.src);
+            for (const auto& step : p.steps) {
+                size += sizeof(step) + estimateVertexSize(step.dst) + step.name.heapBytes() +
+                        estimatePropsSize(step.props);
+            }
+            return size;
+        }
+        case Value::Type::LIST: {
+            size += sizeof(List);
+            for (const auto& v : val.getList().values) {
+                size += estimateSize(v);
+            }
+            return size;
+        }
+        case Value::Type::MAP: {
+            return size + sizeof(Map) + estimatePropsSize(val.getMap().kvs);
+        }
+        case Value::Type::SET: {
+            size += sizeof(Set);
+            for (const auto& v : val.getSet().values) {
+                size += 2 * sizeof(void*) + estimateSize(v);
+            }
+            return size;
+        }
+        case Value::Type::DATASET: {
+            const auto& ds = val.getDataSet();
+            size += sizeof(DataSet);
+            for (const auto& col : ds.colNames) {
+                size += sizeof(col) + col.capacity();
+            }
+            for (const auto& row : ds.rows) {
+                size += sizeof(row);
+                for (const auto& v : row.values) {
+                    size += estimateSize(v);
+                }
+            }
+            return size;
+        }
+        default: {
+            return size;
+        }
+    }
+}
+
+template <class T>
+void writePod(std::ofstream& out, T v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// Returns false on EOF
+bool readBytes(std::ifstream& in, std::string* buf) {
+    uint32_t size;
+    if (!in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        return false;
+    }
+    buf->resize(size);
+    return static_cast<bool>(in.read(&(*buf)[0], size));
+}
+
+}  // namespace
+
+ExternalSorter::ExternalSorter(std::vector<SortKey> keys, Options options)
+        : keys_(std::move(keys))
+        , options_(std::move(options)) {
+    if (options_.memoryBudget < 0) {
+        options_.memoryBudget = FLAGS_external_sort_memory_budget;
+    }
+    if (options_.tmpDir.empty()) {
+        options_.tmpDir = FLAGS_external_sort_tmp_dir;
+    }
+    CHECK_GT(options_.batchSize, 0);
+}
+
+
+ExternalSorter::~ExternalSorter() = default;
+
+
+Status ExternalSorter::add(Row row) {
+    DCHECK(!finished_);
+    Entry entry;
+    for (const auto& key : keys_) {
+        if (key.column >= row.size()) {
+            return Status::Error("Sort column %lu out of range, the row has %lu columns",
+                                 key.column, row.size());
+        }
+        MemcomparableCodec::encodeKey(row[key.column], &entry.key, key.descending);
+    }
+    bufferBytes_ += sizeof(Entry) + entry.key.capacity();
+    for (const auto& v : row.values) {
+        bufferBytes_ += estimateSize(v);
+    }
+    entry.row = std::move(row);
+    buffer_.emplace_back(std::move(entry));
+    ++numRows_;
+
+    if (bufferBytes_ > static_cast<size_t>(options_.memoryBudget)) {
+        return spill();
+    }
+    return Status::OK();
+}
+
+
+Status ExternalSorter::add(DataSet&& ds) {
+    for (auto& row : ds.rows) {
+        NG_RETURN_IF_ERROR(add(std::move(row)));
+    }
+    ds.rows.clear();
+    return Status::OK();
+}
+
+
+void ExternalSorter::sortBuffer() {
+    std::stable_sort(buffer_.begin(), buffer_.end(), [] (const Entry& a, const Entry& b) {
+        return a.key < b.key;
+    });
+}
+
+
+Status ExternalSorter::spill() {
+    if (buffer_.empty()) {
+        return Status::OK();
+    }
+    sortBuffer();
+
+    auto run = std::make_unique<Run>();
+    auto path = folly::stringPrintf("%s/nebula_sort.XXXXXX", options_.tmpDir.c_str());
+    try {
+        run->file = std::make_unique<fs::TempFile>(path.c_str());
+    } catch (const std::exception& e) {
+        return Status::Error("Failed to create the sort run in `%s': %s",
+                             options_.tmpDir.c_str(), e.what());
+    }
+
+    std::ofstream out(run->file->path(), std::ios::binary | std::ios::trunc);
+    std::string buf;
+    size_t bytes = 0;
+    for (const auto& entry : buffer_) {
+        writePod<uint32_t>(out, entry.key.size());
+        out.write(entry.key.data(), entry.key.size());
+        buf.clear();
+        serializer::serialize(entry.row, &buf);
+        writePod<uint32_t>(out, buf.size());
+        out.write(buf.data(), buf.size());
+        bytes += 2 * sizeof(uint32_t) + entry.key.size() + buf.size();
+    }
+    out.close();
+    if (!out) {
+        return Status::Error("Failed to write the sort run `%s'", run->file->path());
+    }
+    spilledBytes_ += bytes;
+    VLOG(2) << "Spilled " << buffer_.size() << " rows to " << run->file->path();
+
+    runs_.emplace_back(std::move(run));
+    buffer_.clear();
+    bufferBytes_ = 0;
+    return Status::OK();
+}
+
+
+Status ExternalSorter::finish() {
+    DCHECK(!finished_);
+    finished_ = true;
+
+    // The rows left in memory are not spilled, but merged as the last run
+    sortBuffer();
+    tail_ = std::make_unique<Run>();
+    tail_->entries = std::move(buffer_);
+    buffer_.clear();
+    bufferBytes_ = 0;
+
+    for (auto& run : runs_) {
+        run->readBuf = std::make_unique<char[]>(kReadBufferSize);
+        run->in.rdbuf()->pubsetbuf(run->readBuf.get(), kReadBufferSize);
+        run->in.open(run->file->path(), std::ios::binary);
+        if (!run->in) {
+            return Status::Error("Failed to open the sort run `%s'", run->file->path());
+        }
+        merging_.emplace_back(run.get());
+    }
+    merging_.emplace_back(tail_.get());
+
+    for (size_t i = 0; i < merging_.size(); ++i) {
+        auto ret = advance(merging_[i]);
+        NG_RETURN_IF_ERROR(ret);
+        if (ret.value()) {
+            heap_.emplace_back(i);
+        }
+    }
+    std::make_heap(heap_.begin(), heap_.end(), heapCmp());
+    return Status::OK();
+}
+
+
+StatusOr<bool> ExternalSorter::advance(Run* run) {
+    if (run->file == nullptr) {
+        if (run->pos >= run->entries.size()) {
+            run->entries.clear();
+            return false;
+        }
+        run->head = std::move(run->entries[run->pos++]);
+        return true;
+    }
+
+    if (!readBytes(run->in, &run->head.key)) {
+        if (run->in.eof()) {
+            run->in.close();
+            return false;
+        }
+        return Status::Error("Failed to read the sort run `%s'", run->file->path());
+    }
+    if (!readBytes(run->in, &run->rowBuf)) {
+        return Status::Error("Truncated sort run `%s'", run->file->path());
+    }
+    run->head.row.clear();
+    try {
+        serializer::deserialize(run->rowBuf, run->head.row);
+    } catch (const std::exception& e) {
+        return Status::Error("Corrupted sort run `%s': %s", run->file->path(), e.what());
+    }
+    return true;
+}
+
+
+StatusOr<std::vector<Row>> ExternalSorter::next() {
+    DCHECK(finished_);
+    std::vector<Row> rows;
+    auto cmp = heapCmp();
+    while (!heap_.empty() && rows.size() < options_.batchSize) {
+        std::pop_heap(heap_.begin(), heap_.end(), cmp);
+        auto* run = merging_[heap_.back()];
+        rows.emplace_back(std::move(run->head.row));
+
+        auto ret = advance(run);
+        NG_RETURN_IF_ERROR(ret);
+        if (ret.value()) {
+            std::push_heap(heap_.begin(), heap_.end(), cmp);
+        } else {
+            heap_.pop_back();
+        }
+    }
+    return rows;
+}
+
+}  // namespace algorithm
+}  // namespace nebula
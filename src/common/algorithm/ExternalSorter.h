@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_ALGORITHM_EXTERNALSORTER_H_
+#define COMMON_ALGORITHM_EXTERNALSORTER_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/DataSet.h"
+#include "common/fs/TempFile.h"
+
+DECLARE_int64(external_sort_memory_budget);
+DECLARE_string(external_sort_tmp_dir);
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Sorts rows which may not fit in memory, e.g. for ORDER BY.
+ *
+ * The sort keys of each row are encoded by MemcomparableCodec, so rows are
+ * compared by memcmp() in the order of operator<(Value, Value). Rows are
+ * buffered until their estimated size exceeds the memory budget, then sorted
+ * and spilled as a run to a temporary file. After finish(), the runs and the
+ * rows left in memory are merged, and returned batch by batch from next().
+ *
+ * Rows with equal keys are returned in the order they are added.
+ *
+ * Not thread-safe.
+ */
+class ExternalSorter final {
+public:
+    struct SortKey {
+        // Index of the column in the rows
+        size_t column;
+        bool descending{false};
+    };
+
+    struct Options {
+        // Defaults to FLAGS_external_sort_memory_budget
+        int64_t memoryBudget{-1};
+        // Defaults to FLAGS_external_sort_tmp_dir
+        std::string tmpDir;
+        // Max number of rows returned by next()
+        size_t batchSize{1024};
+    };
+
+    ExternalSorter(std::vector<SortKey> keys, Options options);
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    // The temporary files are removed
+    ~ExternalSorter();
+
+    Status add(Row row);
+
+    Status add(DataSet&& ds);
+
+    // No more rows will be added
+    Status finish();
+
+    // Returns the next batch of sorted rows, an empty batch after all the rows
+    // are returned.
+    StatusOr<std::vector<Row>> next();
+
+    size_t numRows() const {
+        return numRows_;
+    }
+
+    // Estimated bytes of the rows buffered in memory
+    size_t bufferedBytes() const {
+        return bufferBytes_;
+    }
+
+    // Number of runs spilled to disk
+    size_t numRuns() const {
+        return runs_.size();
+    }
+
+    size_t spilledBytes() const {
+        return spilledBytes_;
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        Row row;
+    };
+
+    // A sorted run, either in a temporary file or in memory
+    struct Run {
+        std::unique_ptr<fs::TempFile> file;
+        std::ifstream in;
+        std::unique_ptr<char[]> readBuf;
+        std::string rowBuf;
+        // Only for the in-memory run
+        std::vector<Entry> entries;
+        size_t pos{0};
+        // The smallest entry not returned yet
+        Entry head;
+    };
+
+    Status spill();
+
+    void sortBuffer();
+
+    // Moves the next entry of the run to its head, returns false if the run
+    // is exhausted.
+    StatusOr<bool> advance(Run* run);
+
+    // For a min heap of the runs
+    auto heapCmp() const {
+        return [this] (size_t a, size_t b) {
+            int cmp = merging_[a]->head.key.compare(merging_[b]->head.key);
+            return cmp > 0 || (cmp == 0 && a > b);
+        };
+    }
+
+private:
+    const std::vector<SortKey> keys_;
+    Options options_;
+
+    std::vector<Entry> buffer_;
+    size_t bufferBytes_{0};
+    size_t numRows_{0};
+
+    std::vector<std::unique_ptr<Run>> runs_;
+    // In-memory tail, which is the last run during merging
+    std::unique_ptr<Run> tail_;
+    size_t spilledBytes_{0};
+
+    bool finished_{false};
+    // Indexes of the runs with a head, ordered by the head key then the index,
+    // the run spilled earlier holds the rows added earlier.
+    std::vector<size_t> heap_;
+    std::vector<Run*> merging_;
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+#endif  // COMMON_ALGORITHM_EXTERNALSORTER_H_
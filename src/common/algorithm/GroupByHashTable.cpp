@@ -0,0 +1,235 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/GroupByHashTable.h"
+#include "common/algorithm/MemcomparableCodec.h"
+#include "common/base/MurmurHash2.h"
+
+namespace nebula {
+namespace algorithm {
+
+namespace {
+
+constexpr size_t kMinChunkSize = 64 * 1024;
+constexpr size_t kMaxChunkSize = 4 * 1024 * 1024;
+
+}   // namespace
+
+
+GroupByHashTable::GroupByHashTable(size_t numKeys, size_t expectedGroups)
+        : numKeys_(numKeys) {
+    size_t capacity = 16;
+    // Keep the load factor under 0.5
+    while (capacity < expectedGroups * 2) {
+        capacity <<= 1;
+    }
+    slots_.resize(capacity);
+    mask_ = capacity - 1;
+    groups_.reserve(expectedGroups);
+}
+
+
+size_t GroupByHashTable::insert(const Value* keys, bool* inserted) {
+    buf_.clear();
+    for (size_t i = 0; i < numKeys_; ++i) {
+        MemcomparableCodec::encodeUnordered(keys[i], &buf_);
+    }
+    auto hash = MurmurHash2()(buf_.data(), buf_.size());
+    return insert(buf_, hash, inserted);
+}
+
+
+size_t GroupByHashTable::find(const Value* keys) const {
+    buf_.clear();
+    for (size_t i = 0; i < numKeys_; ++i) {
+        MemcomparableCodec::encodeUnordered(keys[i], &buf_);
+    }
+    auto hash = MurmurHash2()(buf_.data(), buf_.size());
+    return probe(buf_, hash);
+}
+
+
+void GroupByHashTable::insert(const std::vector<const std::vector<Value>*>& columns,
+                              std::vector<size_t>* groups) {
+    std::vector<size_t> ends;
+    encodeBatch(columns, &buf_, &ends);
+    std::vector<uint64_t> hashes;
+    hashes.reserve(ends.size());
+    size_t begin = 0;
+    for (auto end : ends) {
+        hashes.emplace_back(MurmurHash2()(buf_.data() + begin, end - begin));
+        begin = end;
+    }
+
+    constexpr size_t kPrefetchDistance = 8;
+    groups->resize(ends.size());
+    begin = 0;
+    for (size_t i = 0; i < ends.size(); ++i) {
+        if (i + kPrefetchDistance < ends.size()) {
+            prefetch(hashes[i + kPrefetchDistance]);
+        }
+        folly::StringPiece key(buf_.data() + begin, ends[i] - begin);
+        (*groups)[i] = insert(key, hashes[i], nullptr);
+        begin = ends[i];
+    }
+}
+
+
+void GroupByHashTable::find(const std::vector<const std::vector<Value>*>& columns,
+                            std::vector<size_t>* groups) const {
+    std::vector<size_t> ends;
+    encodeBatch(columns, &buf_, &ends);
+    std::vector<uint64_t> hashes;
+    hashes.reserve(ends.size());
+    size_t begin = 0;
+    for (auto end : ends) {
+        hashes.emplace_back(MurmurHash2()(buf_.data() + begin, end - begin));
+        begin = end;
+    }
+
+    constexpr size_t kPrefetchDistance = 8;
+    groups->resize(ends.size());
+    begin = 0;
+    for (size_t i = 0; i < ends.size(); ++i) {
+        if (i + kPrefetchDistance < ends.size()) {
+            prefetch(hashes[i + kPrefetchDistance]);
+        }
+        folly::StringPiece key(buf_.data() + begin, ends[i] - begin);
+        (*groups)[i] = probe(key, hashes[i]);
+        begin = ends[i];
+    }
+}
+
+
+List GroupByHashTable::key(size_t group) const {
+    CHECK_LT(group, groups_.size());
+    const auto& g = groups_[group];
+    folly::StringPiece data(g.key, g.size);
+    List keys;
+    keys.reserve(numKeys_);
+    for (size_t i = 0; i < numKeys_; ++i) {
+        auto val = MemcomparableCodec::decodeUnordered(&data);
+        // Encoded by this table
+        CHECK(val.ok()) << val.status();
+        keys.emplace_back(std::move(val).value());
+    }
+    DCHECK(data.empty());
+    return keys;
+}
+
+
+size_t GroupByHashTable::memoryUsage() const {
+    return sizeof(*this)
+         + slots_.capacity() * sizeof(Slot)
+         + groups_.capacity() * sizeof(Group)
+         + arenaBytes_
+         + buf_.capacity();
+}
+
+
+size_t GroupByHashTable::probe(folly::StringPiece key, uint64_t hash) const {
+    auto hashTag = static_cast<uint32_t>(hash >> 32);
+    for (auto i = hash & mask_; ; i = (i + 1) & mask_) {
+        const auto& slot = slots_[i];
+        if (slot.group == 0) {
+            return kNotFound;
+        }
+        if (slot.hashTag == hashTag) {
+            const auto& g = groups_[slot.group - 1];
+            if (g.hash == hash && g.size == key.size() && memcmp(g.key, key.data(), g.size) == 0) {
+                return slot.group - 1;
+            }
+        }
+    }
+}
+
+
+size_t GroupByHashTable::insert(folly::StringPiece key, uint64_t hash, bool* inserted) {
+    auto hashTag = static_cast<uint32_t>(hash >> 32);
+    auto i = hash & mask_;
+    for (; ; i = (i + 1) & mask_) {
+        auto& slot = slots_[i];
+        if (slot.group == 0) {
+            break;
+        }
+        if (slot.hashTag == hashTag) {
+            const auto& g = groups_[slot.group - 1];
+            if (g.hash == hash && g.size == key.size() && memcmp(g.key, key.data(), g.size) == 0) {
+                if (inserted != nullptr) {
+                    *inserted = false;
+                }
+                return slot.group - 1;
+            }
+        }
+    }
+
+    CHECK_LT(groups_.size(), std::numeric_limits<uint32_t>::max());
+    auto group = groups_.size();
+    groups_.emplace_back(Group{store(key), static_cast<uint32_t>(key.size()), hash});
+    slots_[i].hashTag = hashTag;
+    slots_[i].group = group + 1;
+    if (groups_.size() * 2 > slots_.size()) {
+        grow();
+    }
+    if (inserted != nullptr) {
+        *inserted = true;
+    }
+    return group;
+}
+
+
+const char* GroupByHashTable::store(folly::StringPiece key) {
+    if (chunks_.empty() || chunkUsed_ + key.size() > chunkSize_) {
+        // Chunks grow with the table, up to kMaxChunkSize, except for huge keys
+        chunkSize_ = std::max(std::min(std::max(arenaBytes_, kMinChunkSize), kMaxChunkSize),
+                              key.size());
+        chunks_.emplace_back(new char[chunkSize_]);
+        chunkUsed_ = 0;
+        arenaBytes_ += chunkSize_;
+    }
+    auto* dst = chunks_.back().get() + chunkUsed_;
+    memcpy(dst, key.data(), key.size());
+    chunkUsed_ += key.size();
+    return dst;
+}
+
+
+void GroupByHashTable::grow() {
+    std::vector<Slot> slots(slots_.size() * 2);
+    auto mask = slots.size() - 1;
+    for (const auto& slot : slots_) {
+        if (slot.group == 0) {
+            continue;
+        }
+        auto i = groups_[slot.group - 1].hash & mask;
+        while (slots[i].group != 0) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+    slots_ = std::move(slots);
+    mask_ = mask;
+}
+
+
+void GroupByHashTable::encodeBatch(const std::vector<const std::vector<Value>*>& columns,
+                                   std::string* buf,
+                                   std::vector<size_t>* ends) const {
+    CHECK_EQ(columns.size(), numKeys_);
+    size_t numRows = columns.empty() ? 0 : columns.front()->size();
+    buf->clear();
+    ends->reserve(numRows);
+    for (size_t row = 0; row < numRows; ++row) {
+        for (const auto* column : columns) {
+            DCHECK_EQ(column->size(), numRows);
+            MemcomparableCodec::encodeUnordered((*column)[row], buf);
+        }
+        ends->emplace_back(buf->size());
+    }
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_ALGORITHM_GROUPBYHASHTABLE_H_
+#define COMMON_ALGORITHM_GROUPBYHASHTABLE_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "common/datatypes/List.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Hash table mapping group keys, i.e. tuples of Values, to dense group ids
+ * starting from 0, e.g. to index the states in an AggStateArena.
+ *
+ * Instead of keeping a List per group, each key tuple is serialized by the
+ * unordered mode of MemcomparableCodec into a canonical byte string, which
+ * lives in a chunked arena together with its hash.
+ * The slots are open addressed with linear probing, and keep part of the hash
+ * to skip most of the key comparisons.
+ *
+ * All the Value types are supported. Map and Set are serialized in sorted
+ * order, so equal ones are the same group. Unlike Value::operator==, the int 1
+ * and the float 1.0 are different groups, as are nulls of different kinds.
+ *
+ * Not thread-safe.
+ */
+class GroupByHashTable final {
+public:
+    static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+
+    explicit GroupByHashTable(size_t numKeys, size_t expectedGroups = 0);
+
+    GroupByHashTable(const GroupByHashTable&) = delete;
+    GroupByHashTable& operator=(const GroupByHashTable&) = delete;
+
+    size_t numKeys() const {
+        return numKeys_;
+    }
+
+    // Number of groups
+    size_t size() const {
+        return groups_.size();
+    }
+
+    // Returns the group of the `numKeys' values starting from `keys', a new
+    // group is added if not found.
+    size_t insert(const Value* keys, bool* inserted = nullptr);
+
+    size_t insert(const List& keys, bool* inserted = nullptr) {
+        DCHECK_EQ(keys.size(), numKeys_);
+        return insert(keys.values.data(), inserted);
+    }
+
+    // Returns kNotFound if the group does not exist
+    size_t find(const Value* keys) const;
+
+    size_t find(const List& keys) const {
+        DCHECK_EQ(keys.size(), numKeys_);
+        return find(keys.values.data());
+    }
+
+    // Batch versions over the key columns, which are of the same length. The
+    // keys are all serialized and hashed before probing, so the slots could be
+    // prefetched.
+    void insert(const std::vector<const std::vector<Value>*>& columns,
+                std::vector<size_t>* groups);
+
+    void find(const std::vector<const std::vector<Value>*>& columns,
+              std::vector<size_t>* groups) const;
+
+    // Deserialize the key tuple of the group
+    List key(size_t group) const;
+
+    // Bytes taken by the slots, the groups and the serialized keys
+    size_t memoryUsage() const;
+
+private:
+    struct Group {
+        const char* key;
+        uint32_t size;
+        uint64_t hash;
+    };
+
+    struct Slot {
+        // The high 32 bits of the hash
+        uint32_t hashTag{0};
+        // Group id + 1, 0 for an empty slot
+        uint32_t group{0};
+    };
+
+    size_t probe(folly::StringPiece key, uint64_t hash) const;
+
+    size_t insert(folly::StringPiece key, uint64_t hash, bool* inserted);
+
+    void prefetch(uint64_t hash) const {
+        __builtin_prefetch(&slots_[hash & mask_]);
+    }
+
+    const char* store(folly::StringPiece key);
+
+    void grow();
+
+    // Serialize a batch of rows, appending the offset after each key to `ends'
+    void encodeBatch(const std::vector<const std::vector<Value>*>& columns,
+                     std::string* buf,
+                     std::vector<size_t>* ends) const;
+
+private:
+    const size_t numKeys_;
+    std::vector<Slot> slots_;
+    size_t mask_{0};
+    std::vector<Group> groups_;
+
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    size_t chunkUsed_{0};
+    size_t chunkSize_{0};
+    size_t arenaBytes_{0};
+
+    // Reused to serialize the keys
+    mutable std::string buf_;
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+#endif  // COMMON_ALGORITHM_GROUPBYHASHTABLE_H_
@@ -0,0 +1,222 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/HyperLogLog.h"
+
+namespace nebula {
+namespace algorithm {
+
+namespace {
+
+// Marks the serialized sketch of sparse registers, along with the precision
+constexpr uint8_t kSparseFlag = 0x80;
+
+// The sparse registers, 4 bytes each, take at most a quarter of the dense ones
+size_t maxSparse(size_t numRegisters) {
+    return numRegisters / 16;
+}
+
+uint32_t sparseEntry(size_t index, uint8_t rank) {
+    return static_cast<uint32_t>(index << 8 | rank);
+}
+
+}  // namespace
+
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+        : precision_(std::min(std::max(precision, kMinPrecision), kMaxPrecision)) {
+    recount();
+}
+
+
+template <typename F>
+void HyperLogLog::forEachRegister(F&& f) const {
+    if (sparse()) {
+        for (auto entry : sparse_) {
+            f(entry >> 8, static_cast<uint8_t>(entry & 0xFF));
+        }
+        return;
+    }
+    for (size_t i = 0; i < registers_.size(); ++i) {
+        if (registers_[i] != 0) {
+            f(i, registers_[i]);
+        }
+    }
+}
+
+
+void HyperLogLog::add(uint64_t hash) {
+    auto index = hash >> (64 - precision_);
+    // The guard bit bounds the rank when all the remaining bits are zero
+    auto rest = (hash << precision_) | (1UL << (precision_ - 1));
+    auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    updateRegister(index, rank);
+}
+
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.precision_ < precision_) {
+        reduce(other.precision_);
+    }
+    if (other.precision_ == precision_) {
+        other.forEachRegister([this] (size_t index, uint8_t rank) {
+            updateRegister(index, rank);
+        });
+        return;
+    }
+    HyperLogLog reduced(other);
+    reduced.reduce(precision_);
+    merge(reduced);
+}
+
+
+uint64_t HyperLogLog::estimate() const {
+    double m = numRegisters();
+    double alpha;
+    switch (numRegisters()) {
+        case 16:
+            alpha = 0.673;
+            break;
+        case 32:
+            alpha = 0.697;
+            break;
+        case 64:
+            alpha = 0.709;
+            break;
+        default:
+            alpha = 0.7213 / (1 + 1.079 / m);
+            break;
+    }
+    auto estimate = alpha * m * m / harmonicSum_;
+    if (estimate <= 2.5 * m && numZeros_ > 0) {
+        // Linear counting for small cardinalities
+        estimate = m * std::log(m / numZeros_);
+    }
+    return std::llround(estimate);
+}
+
+
+std::string HyperLogLog::serialize() const {
+    std::string data;
+    if (sparse()) {
+        data.reserve(1 + sparse_.size() * sizeof(uint32_t));
+        data.append(1, static_cast<char>(precision_ | kSparseFlag));
+        data.append(reinterpret_cast<const char*>(sparse_.data()),
+                    sparse_.size() * sizeof(uint32_t));
+        return data;
+    }
+    data.reserve(1 + registers_.size());
+    data.append(1, static_cast<char>(precision_));
+    data.append(reinterpret_cast<const char*>(registers_.data()), registers_.size());
+    return data;
+}
+
+
+// static
+StatusOr<HyperLogLog> HyperLogLog::deserialize(folly::StringPiece data) {
+    if (data.empty()) {
+        return Status::Error("Empty HyperLogLog");
+    }
+    auto header = static_cast<uint8_t>(data[0]);
+    bool sparse = (header & kSparseFlag) != 0;
+    uint8_t precision = header & ~kSparseFlag;
+    auto body = data.subpiece(1);
+    if (precision < kMinPrecision || precision > kMaxPrecision) {
+        return Status::Error("Invalid HyperLogLog of precision %d", precision);
+    }
+    auto numRegisters = 1UL << precision;
+    if ((!sparse && body.size() != numRegisters) ||
+        (sparse && (body.size() % sizeof(uint32_t) != 0 ||
+                    body.size() / sizeof(uint32_t) > maxSparse(numRegisters)))) {
+        return Status::Error("Invalid HyperLogLog of precision %d, %lu bytes",
+                             precision, data.size());
+    }
+    HyperLogLog hll(precision);
+    if (!sparse) {
+        hll.registers_.assign(body.begin(), body.end());
+    } else {
+        hll.sparse_.resize(body.size() / sizeof(uint32_t));
+        memcpy(hll.sparse_.data(), body.data(), body.size());
+        for (size_t i = 0; i < hll.sparse_.size(); ++i) {
+            auto entry = hll.sparse_[i];
+            if ((entry >> 8) >= numRegisters || (entry & 0xFF) == 0 ||
+                (i > 0 && (hll.sparse_[i - 1] >> 8) >= (entry >> 8))) {
+                return Status::Error("Invalid sparse HyperLogLog, bad register %u", entry);
+            }
+        }
+    }
+    hll.recount();
+    return hll;
+}
+
+
+void HyperLogLog::reduce(uint8_t precision) {
+    DCHECK_LT(precision, precision_);
+    auto shift = precision_ - precision;
+    HyperLogLog reduced(precision);
+    forEachRegister([shift, &reduced] (size_t index, uint8_t rank) {
+        // The low bits of the old index become the leading bits of the rest
+        auto dropped = index & ((1UL << shift) - 1);
+        uint8_t newRank = dropped != 0
+                        ? __builtin_clzll(dropped) - (64 - shift) + 1
+                        : rank + shift;
+        reduced.updateRegister(index >> shift, newRank);
+    });
+    *this = std::move(reduced);
+}
+
+
+void HyperLogLog::updateRegister(size_t index, uint8_t rank) {
+    uint8_t old = 0;
+    if (!sparse()) {
+        old = registers_[index];
+        if (rank <= old) {
+            return;
+        }
+        registers_[index] = rank;
+    } else {
+        auto it = std::lower_bound(sparse_.begin(), sparse_.end(), sparseEntry(index, 0));
+        if (it != sparse_.end() && (*it >> 8) == index) {
+            old = *it & 0xFF;
+            if (rank <= old) {
+                return;
+            }
+            *it = sparseEntry(index, rank);
+        } else {
+            sparse_.insert(it, sparseEntry(index, rank));
+        }
+    }
+    if (old == 0) {
+        --numZeros_;
+    }
+    harmonicSum_ += std::ldexp(1.0, -rank) - std::ldexp(1.0, -old);
+    if (sparse() && sparse_.size() > maxSparse(numRegisters())) {
+        toDense();
+    }
+}
+
+
+void HyperLogLog::toDense() {
+    DCHECK(sparse());
+    registers_.assign(numRegisters(), 0);
+    for (auto entry : sparse_) {
+        registers_[entry >> 8] = entry & 0xFF;
+    }
+    std::vector<uint32_t>().swap(sparse_);
+}
+
+
+void HyperLogLog::recount() {
+    harmonicSum_ = numRegisters();
+    numZeros_ = numRegisters();
+    forEachRegister([this] (size_t, uint8_t rank) {
+        harmonicSum_ += std::ldexp(1.0, -rank) - 1.0;
+        --numZeros_;
+    });
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,1125 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/MemcomparableCodec.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+namespace algorithm {
+
+namespace {
+
+bool isNullType(uint8_t null) {
+    return null <= static_cast<uint8_t>(NullType::OUT_OF_RANGE);
+}
+
+namespace unordered {
+
+// The unordered mode is only kept in memory, so the native byte order is used
+enum class KeyTag : uint8_t {
+    EMPTY       = 0,
+    NULLVALUE   = 1,
+    BOOL        = 2,
+    INT         = 3,
+    FLOAT       = 4,
+    STRING      = 5,
+    DATE        = 6,
+    TIME        = 7,
+    DATETIME    = 8,
+    VERTEX      = 9,
+    EDGE        = 10,
+    PATH        = 11,
+    LIST        = 12,
+    MAP         = 13,
+    SET         = 14,
+    DATASET     = 15,
+};
+
+template <class T>
+void append(std::string* buf, T v) {
+    static_assert(std::is_trivially_copyable<T>::value, "");
+    buf->append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// The readers return false on truncated or corrupt data, rather than crash,
+// since the keys may be read back from spilled files
+template <class T>
+bool read(folly::StringPiece* data, T* v) {
+    static_assert(std::is_trivially_copyable<T>::value, "");
+    if (data->size() < sizeof(T)) {
+        return false;
+    }
+    memcpy(v, data->data(), sizeof(T));
+    data->advance(sizeof(T));
+    return true;
+}
+
+// Each element takes a byte at least, so a corrupt size is caught before
+// reserving for it
+bool readSize(folly::StringPiece* data, uint32_t* size) {
+    return read(data, size) && *size <= data->size();
+}
+
+void appendStr(std::string* buf, folly::StringPiece str) {
+    append<uint32_t>(buf, str.size());
+    buf->append(str.data(), str.size());
+}
+
+bool readStr(folly::StringPiece* data, std::string* str) {
+    uint32_t size;
+    if (!readSize(data, &size)) {
+        return false;
+    }
+    str->assign(data->data(), size);
+    data->advance(size);
+    return true;
+}
+
+void encodeValue(const Value& val, std::string* buf);
+
+bool decodeValue(folly::StringPiece* data, Value* val);
+
+// Keyed by property name, PropMap and MapKvs are sorted by name so it is
+// canonical
+template <class Props>
+void appendProps(std::string* buf, const Props& props) {
+    append<uint32_t>(buf, props.size());
+    for (const auto& kv : props) {
+        appendStr(buf, static_cast<const std::string&>(kv.first));
+        encodeValue(kv.second, buf);
+    }
+}
+
+template <class Props>
+bool readProps(folly::StringPiece* data, Props* props) {
+    uint32_t size;
+    if (!readSize(data, &size)) {
+        return false;
+    }
+    props->reserve(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        std::string name;
+        Value val;
+        if (!readStr(data, &name) || !decodeValue(data, &val)) {
+            return false;
+        }
+        // In order, so appended to the end
+        props->emplace(Props::decodedKey(std::move(name)), std::move(val));
+    }
+    return true;
+}
+
+void appendVertex(std::string* buf, const Vertex& v) {
+    encodeValue(v.vid, buf);
+    append<uint32_t>(buf, v.tags.size());
+    for (const auto& tag : v.tags) {
+        appendStr(buf, tag.name.str());
+        appendProps(buf, tag.props);
+    }
+}
+
+bool readVertex(folly::StringPiece* data, Vertex* v) {
+    uint32_t size;
+    if (!decodeValue(data, &v->vid) || !readSize(data, &size)) {
+        return false;
+    }
+    v->tags.reserve(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        std::string name;
+        PropMap props;
+        if (!readStr(data, &name) || !readProps(data, &props)) {
+            return false;
+        }
+        v->tags.emplace_back(Symbol::name(std::move(name)), std::move(props));
+    }
+    return true;
+}
+
+// Fields of an edge or a step after its endpoints
+template <class E>
+bool readEdgeFields(folly::StringPiece* data, E* e) {
+    std::string name;
+    if (!read(data, &e->type) || !readStr(data, &name) || !read(data, &e->ranking)) {
+        return false;
+    }
+    e->name = Symbol::name(std::move(name));
+    return readProps(data, &e->props);
+}
+
+void encodeValue(const Value& val, std::string* buf) {
+    switch (val.type()) {
+        case Value::Type::__EMPTY__: {
+            append(buf, KeyTag::EMPTY);
+            return;
+        }
+        case Value::Type::NULLVALUE: {
+            append(buf, KeyTag::NULLVALUE);
+            append<uint8_t>(buf, static_cast<uint8_t>(val.getNull()));
+            return;
+        }
+        case Value::Type::BOOL: {
+            append(buf, KeyTag::BOOL);
+            append<uint8_t>(buf, val.getBool());
+            return;
+        }
+        case Value::Type::INT: {
+            append(buf, KeyTag::INT);
+            append<int64_t>(buf, val.getInt());
+            return;
+        }
+        case Value::Type::FLOAT: {
+            append(buf, KeyTag::FLOAT);
+            // -0.0 == 0.0
+            auto f = val.getFloat();
+            append<double>(buf, f == 0.0 ? 0.0 : f);
+            return;
+        }
+        case Value::Type::STRING: {
+            append(buf, KeyTag::STRING);
+            appendStr(buf, val.getStr());
+            return;
+        }
+        case Value::Type::DATE: {
+            append(buf, KeyTag::DATE);
+            const auto& d = val.getDate();
+            append<int16_t>(buf, d.year);
+            append<int8_t>(buf, d.month);
+            append<int8_t>(buf, d.day);
+            return;
+        }
+        case Value::Type::TIME: {
+            append(buf, KeyTag::TIME);
+            const auto& t = val.getTime();
+            append<int8_t>(buf, t.hour);
+            append<int8_t>(buf, t.minute);
+            append<int8_t>(buf, t.sec);
+            append<int32_t>(buf, t.microsec);
+            return;
+        }
+        case Value::Type::DATETIME: {
+            append(buf, KeyTag::DATETIME);
+            append<uint64_t>(buf, val.getDateTime().qword);
+            return;
+        }
+        case Value::Type::VERTEX: {
+            append(buf, KeyTag::VERTEX);
+            appendVertex(buf, val.getVertex());
+            return;
+        }
+        case Value::Type::EDGE: {
+            append(buf, KeyTag::EDGE);
+            const auto& e = val.getEdge();
+            encodeValue(e.src, buf);
+            encodeValue(e.dst, buf);
+            append(buf, e.type);
+            appendStr(buf, e.name.str());
+            append(buf, e.ranking);
+            appendProps(buf, e.props);
+            return;
+        }
+        case Value::Type::PATH: {
+            append(buf, KeyTag::PATH);
+            const auto& p = val.getPath();
+            appendVertex(buf, p.src);
+            append<uint32_t>(buf, p.steps.size());
+            for (const auto& step : p.steps) {
+                appendVertex(buf, step.dst);
+                append(buf, step.type);
+                appendStr(buf, step.name.str());
+                append(buf, step.ranking);
+                appendProps(buf, step.props);
+            }
+            return;
+        }
+        case Value::Type::LIST: {
+            append(buf, KeyTag::LIST);
+            const auto& values = val.getList().values;
+            append<uint32_t>(buf, values.size());
+            for (const auto& v : values) {
+                encodeValue(v, buf);
+            }
+            return;
+        }
+        case Value::Type::MAP: {
+            append(buf, KeyTag::MAP);
+            appendProps(buf, val.getMap().kvs);
+            return;
+        }
+        case Value::Type::SET: {
+            append(buf, KeyTag::SET);
+            // The encoded values are self-delimiting, so the sorted concatenation
+            // is canonical
+            const auto& values = val.getSet().values;
+            std::vector<std::string> encoded;
+            encoded.reserve(values.size());
+            for (const auto& v : values) {
+                encoded.emplace_back();
+                encodeValue(v, &encoded.back());
+            }
+            std::sort(encoded.begin(), encoded.end());
+            append<uint32_t>(buf, encoded.size());
+            for (const auto& e : encoded) {
+                buf->append(e);
+            }
+            return;
+        }
+        case Value::Type::DATASET: {
+            append(buf, KeyTag::DATASET);
+            const auto& ds = val.getDataSet();
+            append<uint32_t>(buf, ds.colNames.size());
+            for (const auto& name : ds.colNames) {
+                appendStr(buf, name);
+            }
+            append<uint32_t>(buf, ds.rows.size());
+            for (const auto& row : ds.rows) {
+                append<uint32_t>(buf, row.values.size());
+                for (const auto& v : row.values) {
+                    encodeValue(v, buf);
+                }
+            }
+            return;
+        }
+    }
+    LOG(FATAL) << "Unknown value type " << static_cast<int>(val.type());
+}
+
+
+bool decodeValue(folly::StringPiece* data, Value* val) {
+    KeyTag tag;
+    if (!read(data, &tag)) {
+        return false;
+    }
+    switch (tag) {
+        case KeyTag::EMPTY: {
+            *val = Value();
+            return true;
+        }
+        case KeyTag::NULLVALUE: {
+            uint8_t null;
+            if (!read(data, &null) || !isNullType(null)) {
+                return false;
+            }
+            *val = static_cast<NullType>(null);
+            return true;
+        }
+        case KeyTag::BOOL: {
+            uint8_t b;
+            if (!read(data, &b)) {
+                return false;
+            }
+            *val = (b != 0);
+            return true;
+        }
+        case KeyTag::INT: {
+            int64_t i;
+            if (!read(data, &i)) {
+                return false;
+            }
+            *val = i;
+            return true;
+        }
+        case KeyTag::FLOAT: {
+            double f;
+            if (!read(data, &f)) {
+                return false;
+            }
+            *val = f;
+            return true;
+        }
+        case KeyTag::STRING: {
+            std::string str;
+            if (!readStr(data, &str)) {
+                return false;
+            }
+            *val = std::move(str);
+            return true;
+        }
+        case KeyTag::DATE: {
+            Date d;
+            if (!read(data, &d.year) || !read(data, &d.month) || !read(data, &d.day)) {
+                return false;
+            }
+            *val = d;
+            return true;
+        }
+        case KeyTag::TIME: {
+            Time t;
+            if (!read(data, &t.hour) ||
+                !read(data, &t.minute) ||
+                !read(data, &t.sec) ||
+                !read(data, &t.microsec)) {
+                return false;
+            }
+            *val = t;
+            return true;
+        }
+        case KeyTag::DATETIME: {
+            DateTime dt;
+            if (!read(data, &dt.qword)) {
+                return false;
+            }
+            *val = dt;
+            return true;
+        }
+        case KeyTag::VERTEX: {
+            Vertex v;
+            if (!readVertex(data, &v)) {
+                return false;
+            }
+            *val = std::move(v);
+            return true;
+        }
+        case KeyTag::EDGE: {
+            Edge e;
+            if (!decodeValue(data, &e.src) ||
+                !decodeValue(data, &e.dst) ||
+                !readEdgeFields(data, &e)) {
+                return false;
+            }
+            *val = std::move(e);
+            return true;
+        }
+        case KeyTag::PATH: {
+            Path p;
+            uint32_t size;
+            if (!readVertex(data, &p.src) || !readSize(data, &size)) {
+                return false;
+            }
+            p.steps.reserve(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                Step step;
+                if (!readVertex(data, &step.dst) || !readEdgeFields(data, &step)) {
+                    return false;
+                }
+                p.steps.emplace_back(std::move(step));
+            }
+            *val = std::move(p);
+            return true;
+        }
+        case KeyTag::LIST: {
+            uint32_t size;
+            if (!readSize(data, &size)) {
+                return false;
+            }
+            List list;
+            list.reserve(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                Value elem;
+                if (!decodeValue(data, &elem)) {
+                    return false;
+                }
+                list.emplace_back(std::move(elem));
+            }
+            *val = std::move(list);
+            return true;
+        }
+        case KeyTag::MAP: {
+            MapKvs kvs;
+            if (!readProps(data, &kvs)) {
+                return false;
+            }
+            *val = Map(std::move(kvs));
+            return true;
+        }
+        case KeyTag::SET: {
+            uint32_t size;
+            if (!readSize(data, &size)) {
+                return false;
+            }
+            Set set;
+            set.values.reserve(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                Value elem;
+                if (!decodeValue(data, &elem)) {
+                    return false;
+                }
+                set.values.emplace(std::move(elem));
+            }
+            *val = std::move(set);
+            return true;
+        }
+        case KeyTag::DATASET: {
+            DataSet ds;
+            uint32_t numCols;
+            if (!readSize(data, &numCols)) {
+                return false;
+            }
+            ds.colNames.reserve(numCols);
+            for (uint32_t i = 0; i < numCols; ++i) {
+                std::string name;
+                if (!readStr(data, &name)) {
+                    return false;
+                }
+                ds.colNames.emplace_back(std::move(name));
+            }
+            uint32_t numRows;
+            if (!readSize(data, &numRows)) {
+                return false;
+            }
+            ds.rows.reserve(numRows);
+            for (uint32_t i = 0; i < numRows; ++i) {
+                uint32_t size;
+                if (!readSize(data, &size)) {
+                    return false;
+                }
+                Row row;
+                row.reserve(size);
+                for (uint32_t j = 0; j < size; ++j) {
+                    Value elem;
+                    if (!decodeValue(data, &elem)) {
+                        return false;
+                    }
+                    row.emplace_back(std::move(elem));
+                }
+                ds.rows.emplace_back(std::move(row));
+            }
+            *val = std::move(ds);
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace unordered
+
+// In the order of Value::Type, int and float share one tag to be compared
+// numerically
+enum class OrderTag : uint8_t {
+    EMPTY       = 0x01,
+    BOOL        = 0x02,
+    NUMERIC     = 0x03,
+    STRING      = 0x04,
+    DATE        = 0x05,
+    TIME        = 0x06,
+    DATETIME    = 0x07,
+    VERTEX      = 0x08,
+    EDGE        = 0x09,
+    PATH        = 0x0A,
+    LIST        = 0x0B,
+    MAP         = 0x0C,
+    SET         = 0x0D,
+    DATASET     = 0x0E,
+    NULLVALUE   = 0xFE,
+};
+
+// Precede each element of a sequence, and end the sequence
+constexpr char kElement = 0x01;
+constexpr char kEnd = 0x00;
+
+void appendTag(std::string* buf, OrderTag tag) {
+    buf->push_back(static_cast<char>(tag));
+}
+
+// Big endian, so the bytes compare as the unsigned integer
+template <class T>
+void appendUnsigned(std::string* buf, T v) {
+    static_assert(std::is_unsigned<T>::value, "");
+    for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+        buf->push_back(static_cast<char>((v >> shift) & 0xFF));
+    }
+}
+
+// Flip the sign bit, so negative ones go before positive ones
+template <class T>
+void appendSigned(std::string* buf, T v) {
+    using U = std::make_unsigned_t<T>;
+    appendUnsigned<U>(buf, static_cast<U>(v) ^ (U(1) << (sizeof(T) * 8 - 1)));
+}
+
+void appendDouble(std::string* buf, double d) {
+    if (d == 0.0) {
+        // -0.0 == 0.0
+        d = 0.0;
+    } else if (std::isnan(d)) {
+        d = std::numeric_limits<double>::quiet_NaN();
+    }
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    // Negative numbers have all the bits flipped to reverse their order
+    bits = (bits & (1ULL << 63)) ? ~bits : bits | (1ULL << 63);
+    appendUnsigned<uint64_t>(buf, bits);
+}
+
+// An int is encoded as the nearest double, followed by the rounding error,
+// which is at most 2^9 for 64 bits ints. So ints are ordered exactly, and
+// compared with floats as doubles like operator< does.
+void appendInt(std::string* buf, int64_t i) {
+    auto d = static_cast<double>(i);
+    appendDouble(buf, d);
+    int64_t residual;
+    if (d >= 9223372036854775808.0) {
+        // Rounded up to 2^63, which is out of the int64 range
+        residual = static_cast<int64_t>(static_cast<uint64_t>(i) - (1ULL << 63));
+    } else {
+        residual = i - static_cast<int64_t>(d);
+    }
+    appendSigned<int16_t>(buf, static_cast<int16_t>(residual));
+}
+
+void appendFloat(std::string* buf, double f) {
+    appendDouble(buf, f);
+    appendSigned<int16_t>(buf, 0);
+}
+
+// 0x00 is escaped as 0x00 0xFF, and the string ends with 0x00 0x01, so a
+// prefix goes before the longer strings.
+void appendStr(std::string* buf, const std::string& str) {
+    size_t start = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '\0') {
+            buf->append(str, start, i + 1 - start);
+            buf->push_back('\xFF');
+            start = i + 1;
+        }
+    }
+    buf->append(str, start, std::string::npos);
+    buf->push_back('\x00');
+    buf->push_back('\x01');
+}
+
+void appendValue(std::string* buf, const Value& val);
+
+// Vertex and Step are only ordered by the vid and the number of tags
+void appendVertex(std::string* buf, const Vertex& v) {
+    appendValue(buf, v.vid);
+    appendUnsigned<uint32_t>(buf, v.tags.size());
+}
+
+void appendValue(std::string* buf, const Value& val) {
+    switch (val.type()) {
+        case Value::Type::__EMPTY__: {
+            appendTag(buf, OrderTag::EMPTY);
+            return;
+        }
+        case Value::Type::NULLVALUE: {
+            // All kinds of null are equal
+            appendTag(buf, OrderTag::NULLVALUE);
+            return;
+        }
+        case Value::Type::BOOL: {
+            appendTag(buf, OrderTag::BOOL);
+            buf->push_back(val.getBool() ? 1 : 0);
+            return;
+        }
+        case Value::Type::INT: {
+            appendTag(buf, OrderTag::NUMERIC);
+            appendInt(buf, val.getInt());
+            return;
+        }
+        case Value::Type::FLOAT: {
+            appendTag(buf, OrderTag::NUMERIC);
+            appendFloat(buf, val.getFloat());
+            return;
+        }
+        case Value::Type::STRING: {
+            appendTag(buf, OrderTag::STRING);
+            appendStr(buf, val.getStr());
+            return;
+        }
+        case Value::Type::DATE: {
+            const auto& d = val.getDate();
+            appendTag(buf, OrderTag::DATE);
+            appendSigned<int16_t>(buf, d.year);
+            appendSigned<int8_t>(buf, d.month);
+            appendSigned<int8_t>(buf, d.day);
+            return;
+        }
+        case Value::Type::TIME: {
+            const auto& t = val.getTime();
+            appendTag(buf, OrderTag::TIME);
+            appendSigned<int8_t>(buf, t.hour);
+            appendSigned<int8_t>(buf, t.minute);
+            appendSigned<int8_t>(buf, t.sec);
+            appendSigned<int32_t>(buf, t.microsec);
+            return;
+        }
+        case Value::Type::DATETIME: {
+            const auto& dt = val.getDateTime();
+            appendTag(buf, OrderTag::DATETIME);
+            appendSigned<int16_t>(buf, dt.year);
+            appendUnsigned<uint8_t>(buf, dt.month);
+            appendUnsigned<uint8_t>(buf, dt.day);
+            appendUnsigned<uint8_t>(buf, dt.hour);
+            appendUnsigned<uint8_t>(buf, dt.minute);
+            appendUnsigned<uint8_t>(buf, dt.sec);
+            appendUnsigned<uint32_t>(buf, dt.microsec);
+            return;
+        }
+        case Value::Type::VERTEX: {
+            appendTag(buf, OrderTag::VERTEX);
+            appendVertex(buf, val.getVertex());
+            return;
+        }
+        case Value::Type::EDGE: {
+            const auto& e = val.getEdge();
+            appendTag(buf, OrderTag::EDGE);
+            appendValue(buf, e.src);
+            appendValue(buf, e.dst);
+            appendSigned<int32_t>(buf, e.type);
+            appendSigned<int64_t>(buf, e.ranking);
+            appendUnsigned<uint32_t>(buf, e.props.size());
+            return;
+        }
+        case Value::Type::PATH: {
+            const auto& p = val.getPath();
+            appendTag(buf, OrderTag::PATH);
+            appendVertex(buf, p.src);
+            for (const auto& step : p.steps) {
+                buf->push_back(kElement);
+                appendVertex(buf, step.dst);
+                appendSigned<int32_t>(buf, step.type);
+                appendSigned<int64_t>(buf, step.ranking);
+                appendUnsigned<uint32_t>(buf, step.props.size());
+            }
+            buf->push_back(kEnd);
+            return;
+        }
+        case Value::Type::LIST: {
+            appendTag(buf, OrderTag::LIST);
+            for (const auto& v : val.getList().values) {
+                buf->push_back(kElement);
+                appendValue(buf, v);
+            }
+            buf->push_back(kEnd);
+            return;
+        }
+        // Never less than each other
+        case Value::Type::MAP: {
+            appendTag(buf, OrderTag::MAP);
+            return;
+        }
+        case Value::Type::SET: {
+            appendTag(buf, OrderTag::SET);
+            return;
+        }
+        case Value::Type::DATASET: {
+            appendTag(buf, OrderTag::DATASET);
+            return;
+        }
+    }
+    LOG(FATAL) << "Unknown type " << val.type();
+}
+
+// The part of encode() after the key, which is not inverted
+enum class NumericKind : uint8_t {
+    INT     = 0,
+    FLOAT   = 1,
+};
+
+void appendExtra(std::string* buf, const Value& val) {
+    switch (val.type()) {
+        case Value::Type::INT: {
+            buf->push_back(static_cast<char>(NumericKind::INT));
+            return;
+        }
+        case Value::Type::FLOAT: {
+            buf->push_back(static_cast<char>(NumericKind::FLOAT));
+            return;
+        }
+        case Value::Type::NULLVALUE: {
+            buf->push_back(static_cast<char>(val.getNull()));
+            return;
+        }
+        case Value::Type::VERTEX:
+        case Value::Type::EDGE:
+        case Value::Type::PATH:
+        case Value::Type::LIST:
+        case Value::Type::MAP:
+        case Value::Type::SET:
+        case Value::Type::DATASET: {
+            unordered::encodeValue(val, buf);
+            return;
+        }
+        default: {
+            // Decoded from the key
+            return;
+        }
+    }
+}
+
+void invert(std::string* buf, size_t start) {
+    for (auto i = start; i < buf->size(); ++i) {
+        (*buf)[i] = ~(*buf)[i];
+    }
+}
+
+class Reader final {
+public:
+    explicit Reader(folly::StringPiece data) : data_(data) {}
+
+    void setInvert(bool invert) {
+        mask_ = invert ? 0xFF : 0x00;
+    }
+
+    bool readByte(uint8_t* b) {
+        if (data_.empty()) {
+            return false;
+        }
+        *b = static_cast<uint8_t>(data_.front()) ^ mask_;
+        data_.advance(1);
+        return true;
+    }
+
+    template <class T>
+    bool readUnsigned(T* v) {
+        static_assert(std::is_unsigned<T>::value, "");
+        *v = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            uint8_t b;
+            if (!readByte(&b)) {
+                return false;
+            }
+            *v = static_cast<T>((*v << 8) | b);
+        }
+        return true;
+    }
+
+    template <class T>
+    bool readSigned(T* v) {
+        using U = std::make_unsigned_t<T>;
+        U u;
+        if (!readUnsigned<U>(&u)) {
+            return false;
+        }
+        *v = static_cast<T>(u ^ (U(1) << (sizeof(T) * 8 - 1)));
+        return true;
+    }
+
+    bool readDouble(double* d) {
+        uint64_t bits;
+        if (!readUnsigned<uint64_t>(&bits)) {
+            return false;
+        }
+        bits = (bits & (1ULL << 63)) ? bits & ~(1ULL << 63) : ~bits;
+        memcpy(d, &bits, sizeof(bits));
+        return true;
+    }
+
+    bool readStr(std::string* str) {
+        while (true) {
+            uint8_t b;
+            if (!readByte(&b)) {
+                return false;
+            }
+            if (b != 0x00) {
+                str->push_back(static_cast<char>(b));
+                continue;
+            }
+            if (!readByte(&b)) {
+                return false;
+            }
+            if (b == 0x01) {
+                return true;
+            }
+            if (b != 0xFF) {
+                return false;
+            }
+            str->push_back('\0');
+        }
+    }
+
+    folly::StringPiece& data() {
+        return data_;
+    }
+
+private:
+    folly::StringPiece data_;
+    uint8_t mask_{0};
+};
+
+// A value decoded from its key, to be completed by its extra part
+struct Decoded {
+    OrderTag tag;
+    Value val;
+    // Of ints
+    int16_t residual{0};
+};
+
+bool readKey(Reader* r, Decoded* out);
+
+bool skipVertex(Reader* r) {
+    Decoded vid;
+    uint32_t numTags;
+    return readKey(r, &vid) && r->readUnsigned<uint32_t>(&numTags);
+}
+
+bool skipEdgeFields(Reader* r) {
+    int32_t type;
+    int64_t ranking;
+    uint32_t numProps;
+    return r->readSigned<int32_t>(&type) &&
+           r->readSigned<int64_t>(&ranking) &&
+           r->readUnsigned<uint32_t>(&numProps);
+}
+
+// Calls `readElement' until the end of the sequence
+template <class F>
+bool readSequence(Reader* r, F&& readElement) {
+    while (true) {
+        uint8_t marker;
+        if (!r->readByte(&marker)) {
+            return false;
+        }
+        if (marker == static_cast<uint8_t>(kEnd)) {
+            return true;
+        }
+        if (marker != static_cast<uint8_t>(kElement) || !readElement()) {
+            return false;
+        }
+    }
+}
+
+// Scalars are decoded, the others are only skipped
+bool readKey(Reader* r, Decoded* out) {
+    uint8_t tag;
+    if (!r->readByte(&tag)) {
+        return false;
+    }
+    out->tag = static_cast<OrderTag>(tag);
+    switch (out->tag) {
+        case OrderTag::EMPTY: {
+            out->val = Value();
+            return true;
+        }
+        case OrderTag::BOOL: {
+            uint8_t b;
+            if (!r->readByte(&b)) {
+                return false;
+            }
+            out->val = (b != 0);
+            return true;
+        }
+        case OrderTag::NUMERIC: {
+            double d;
+            if (!r->readDouble(&d) || !r->readSigned<int16_t>(&out->residual)) {
+                return false;
+            }
+            out->val = d;
+            return true;
+        }
+        case OrderTag::STRING: {
+            std::string str;
+            if (!r->readStr(&str)) {
+                return false;
+            }
+            out->val = std::move(str);
+            return true;
+        }
+        case OrderTag::DATE: {
+            Date d;
+            if (!r->readSigned<int16_t>(&d.year) ||
+                !r->readSigned<int8_t>(&d.month) ||
+                !r->readSigned<int8_t>(&d.day)) {
+                return false;
+            }
+            out->val = d;
+            return true;
+        }
+        case OrderTag::TIME: {
+            Time t;
+            if (!r->readSigned<int8_t>(&t.hour) ||
+                !r->readSigned<int8_t>(&t.minute) ||
+                !r->readSigned<int8_t>(&t.sec) ||
+                !r->readSigned<int32_t>(&t.microsec)) {
+                return false;
+            }
+            out->val = t;
+            return true;
+        }
+        case OrderTag::DATETIME: {
+            int16_t year;
+            uint8_t month, day, hour, minute, sec;
+            uint32_t microsec;
+            if (!r->readSigned<int16_t>(&year) ||
+                !r->readUnsigned<uint8_t>(&month) ||
+                !r->readUnsigned<uint8_t>(&day) ||
+                !r->readUnsigned<uint8_t>(&hour) ||
+                !r->readUnsigned<uint8_t>(&minute) ||
+                !r->readUnsigned<uint8_t>(&sec) ||
+                !r->readUnsigned<uint32_t>(&microsec)) {
+                return false;
+            }
+            out->val = DateTime(year, month, day, hour, minute, sec, microsec);
+            return true;
+        }
+        case OrderTag::VERTEX: {
+            return skipVertex(r);
+        }
+        case OrderTag::EDGE: {
+            Decoded src, dst;
+            return readKey(r, &src) && readKey(r, &dst) && skipEdgeFields(r);
+        }
+        case OrderTag::PATH: {
+            return skipVertex(r) && readSequence(r, [r] {
+                return skipVertex(r) && skipEdgeFields(r);
+            });
+        }
+        case OrderTag::LIST: {
+            return readSequence(r, [r] {
+                Decoded elem;
+                return readKey(r, &elem);
+            });
+        }
+        case OrderTag::MAP:
+        case OrderTag::SET:
+        case OrderTag::DATASET:
+        case OrderTag::NULLVALUE: {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readExtra(folly::StringPiece* data, Decoded* decoded) {
+    switch (decoded->tag) {
+        case OrderTag::NUMERIC: {
+            if (data->empty()) {
+                return false;
+            }
+            auto kind = static_cast<NumericKind>(data->front());
+            data->advance(1);
+            if (kind == NumericKind::FLOAT) {
+                return true;
+            }
+            if (kind != NumericKind::INT) {
+                return false;
+            }
+            auto d = decoded->val.getFloat();
+            int64_t i;
+            if (d >= 9223372036854775808.0) {
+                i = static_cast<int64_t>((1ULL << 63) + static_cast<uint64_t>(decoded->residual));
+            } else {
+                i = static_cast<int64_t>(d) + decoded->residual;
+            }
+            decoded->val = i;
+            return true;
+        }
+        case OrderTag::NULLVALUE: {
+            if (data->empty() || !isNullType(static_cast<uint8_t>(data->front()))) {
+                return false;
+            }
+            decoded->val = static_cast<NullType>(data->front());
+            data->advance(1);
+            return true;
+        }
+        case OrderTag::VERTEX:
+        case OrderTag::EDGE:
+        case OrderTag::PATH:
+        case OrderTag::LIST:
+        case OrderTag::MAP:
+        case OrderTag::SET:
+        case OrderTag::DATASET: {
+            return unordered::decodeValue(data, &decoded->val);
+        }
+        default: {
+            return true;
+        }
+    }
+}
+
+}  // namespace
+
+// static
+void MemcomparableCodec::encodeKey(const Value& val, std::string* buf, bool descending) {
+    auto start = buf->size();
+    appendValue(buf, val);
+    if (descending) {
+        invert(buf, start);
+    }
+}
+
+
+// static
+void MemcomparableCodec::encode(const Value& val, std::string* buf, bool descending) {
+    encodeKey(val, buf, descending);
+    appendExtra(buf, val);
+}
+
+
+// static
+StatusOr<Value> MemcomparableCodec::decode(folly::StringPiece data, bool descending) {
+    Reader r(data);
+    r.setInvert(descending);
+    Decoded decoded;
+    if (!readKey(&r, &decoded) || !readExtra(&r.data(), &decoded) || !r.data().empty()) {
+        return Status::Error("Bad memcomparable encoding");
+    }
+    return std::move(decoded.val);
+}
+
+
+// static
+void MemcomparableCodec::encodeTuple(const List& tuple,
+                                     std::string* buf,
+                                     const std::vector<bool>& descending) {
+    DCHECK(descending.empty() || descending.size() == tuple.size());
+    for (size_t i = 0; i < tuple.size(); ++i) {
+        buf->push_back(kElement);
+        encodeKey(tuple[i], buf, !descending.empty() && descending[i]);
+    }
+    buf->push_back(kEnd);
+    for (const auto& val : tuple.values) {
+        appendExtra(buf, val);
+    }
+}
+
+
+// static
+StatusOr<List> MemcomparableCodec::decodeTuple(folly::StringPiece data,
+                                               const std::vector<bool>& descending) {
+    Reader r(data);
+    std::vector<Decoded> decoded;
+    auto ok = readSequence(&r, [&r, &decoded, &descending] {
+        auto i = decoded.size();
+        decoded.emplace_back();
+        r.setInvert(i < descending.size() && descending[i]);
+        auto read = readKey(&r, &decoded.back());
+        r.setInvert(false);
+        return read;
+    });
+    if (!ok) {
+        return Status::Error("Bad memcomparable encoding");
+    }
+
+    List tuple;
+    tuple.values.reserve(decoded.size());
+    for (auto& d : decoded) {
+        if (!readExtra(&r.data(), &d)) {
+            return Status::Error("Bad memcomparable encoding");
+        }
+        tuple.values.emplace_back(std::move(d.val));
+    }
+    if (!r.data().empty()) {
+        return Status::Error("Bad memcomparable encoding");
+    }
+    return tuple;
+}
+
+
+// static
+void MemcomparableCodec::encodeUnordered(const Value& val, std::string* buf) {
+    unordered::encodeValue(val, buf);
+}
+
+
+// static
+StatusOr<Value> MemcomparableCodec::decodeUnordered(folly::StringPiece* data) {
+    Value val;
+    if (!unordered::decodeValue(data, &val)) {
+        return Status::Error("Bad unordered encoding");
+    }
+    return val;
+}
+
+}  // namespace algorithm
+}  // namespace nebula
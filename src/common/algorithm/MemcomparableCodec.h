@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_ALGORITHM_MEMCOMPARABLECODEC_H_
+#define COMMON_ALGORITHM_MEMCOMPARABLECODEC_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/Value.h"
+#include "common/datatypes/List.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Order preserving encoding of Values, i.e. for any two Values a and b,
+ * memcmp() on their encoded bytes is negative if a < b.
+ *
+ * The order is the one of operator<(Value, Value): empty first, null last,
+ * different types by their type, int and float are compared numerically.
+ * Values which are neither less than the other, e.g. two Maps, may still be
+ * encoded differently, which is a total order refining operator<.
+ *
+ * Each encoding is self-delimiting, so the keys of several columns could be
+ * concatenated to sort by all of them.
+ *
+ * The keys from encodeKey() only keep what the order needs, e.g. the int 1 and
+ * the float 1.0 are the same key. encode() appends the rest after the key, so
+ * the Value could be decoded back, the order is not affected since the keys are
+ * compared first. The extra part of Vertex, Edge, Path, List, Map, Set and
+ * DataSet is their unordered encoding, which is in the native byte order, so
+ * the encoding is only meant to be decoded by the same kind of machines.
+ *
+ * The unordered mode only keeps equality, for hashing like in GroupByHashTable:
+ * two Values have the same bytes iff they are the same, where Map and Set are
+ * compared regardless of their order, but the int 1 and the float 1.0 differ,
+ * as do nulls of different kinds. It's cheaper to encode than the keys.
+ *
+ * Floats are decoded with -0.0 as 0.0 and all NaNs as the quiet NaN.
+ */
+class MemcomparableCodec final {
+public:
+    // Append the key of `val' to `buf', the bytes are inverted to sort in
+    // descending order.
+    static void encodeKey(const Value& val, std::string* buf, bool descending = false);
+
+    // Append the decodable encoding of `val' to `buf'
+    static void encode(const Value& val, std::string* buf, bool descending = false);
+
+    static StatusOr<Value> decode(folly::StringPiece data, bool descending = false);
+
+    // Encode a tuple, which is compared like a List, i.e. value by value, and
+    // a prefix goes first. Value i is in descending order if `descending[i]'.
+    static void encodeTuple(const List& tuple,
+                            std::string* buf,
+                            const std::vector<bool>& descending = {});
+
+    static StatusOr<List> decodeTuple(folly::StringPiece data,
+                                      const std::vector<bool>& descending = {});
+
+    // Append the unordered encoding of `val' to `buf'
+    static void encodeUnordered(const Value& val, std::string* buf);
+
+    // Decode a Value from the front of `data', which is advanced past it. The
+    // data is expected to come from encodeUnordered() in the same process, and
+    // an error is returned if it's truncated or corrupt.
+    static StatusOr<Value> decodeUnordered(folly::StringPiece* data);
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+#endif  // COMMON_ALGORITHM_MEMCOMPARABLECODEC_H_
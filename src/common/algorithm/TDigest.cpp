@@ -0,0 +1,204 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/TDigest.h"
+
+namespace nebula {
+namespace algorithm {
+
+namespace {
+
+// The inverse of the scale function k(q) = d/2 * (q < 0.5 ? sqrt(2q) : 2 - sqrt(2 - 2q)),
+// which keeps the centroids at both tails small
+double kToQ(double k, double d) {
+    double kDivD = k / d;
+    if (kDivD >= 0.5) {
+        double base = 1 - kDivD;
+        return 1 - 2 * base * base;
+    }
+    return 2 * kDivD * kDivD;
+}
+
+}  // namespace
+
+
+TDigest::TDigest(double compression)
+        : compression_(std::max(compression, 10.0)) {
+}
+
+
+void TDigest::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    buffer_.emplace_back(value);
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= static_cast<size_t>(compression_) * 5) {
+        compress();
+    }
+}
+
+
+void TDigest::merge(const TDigest& other) {
+    other.compress();
+    compress();
+    if (other.centroids_.empty()) {
+        return;
+    }
+    std::vector<Centroid> centroids;
+    centroids.reserve(centroids_.size() + other.centroids_.size());
+    std::merge(centroids_.begin(), centroids_.end(),
+               other.centroids_.begin(), other.centroids_.end(),
+               std::back_inserter(centroids),
+               [] (const auto& lhs, const auto& rhs) { return lhs.mean < rhs.mean; });
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    cluster(centroids);
+}
+
+
+double TDigest::quantile(double q) const {
+    compress();
+    if (centroids_.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (q <= 0) {
+        return min_;
+    }
+    if (q >= 1) {
+        return max_;
+    }
+
+    double rank = q * count_;
+    size_t pos = 0;
+    double t = 0;
+    for (; pos + 1 < centroids_.size() && rank >= t + centroids_[pos].weight; ++pos) {
+        t += centroids_[pos].weight;
+    }
+
+    // Interpolate between the neighbouring centroids
+    double delta = 0;
+    double lower = min_;
+    double upper = max_;
+    if (centroids_.size() > 1) {
+        if (pos == 0) {
+            delta = centroids_[1].mean - centroids_[0].mean;
+            upper = centroids_[1].mean;
+        } else if (pos == centroids_.size() - 1) {
+            delta = centroids_[pos].mean - centroids_[pos - 1].mean;
+            lower = centroids_[pos - 1].mean;
+        } else {
+            delta = (centroids_[pos + 1].mean - centroids_[pos - 1].mean) / 2;
+            lower = centroids_[pos - 1].mean;
+            upper = centroids_[pos + 1].mean;
+        }
+    }
+    auto value = centroids_[pos].mean + ((rank - t) / centroids_[pos].weight - 0.5) * delta;
+    return std::min(std::max(value, lower), upper);
+}
+
+
+std::string TDigest::serialize() const {
+    compress();
+    std::string data;
+    data.reserve(sizeof(double) * (3 + 2 * centroids_.size()));
+    auto append = [&data] (double v) {
+        data.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    };
+    append(compression_);
+    append(min_);
+    append(max_);
+    for (const auto& c : centroids_) {
+        append(c.mean);
+        append(c.weight);
+    }
+    return data;
+}
+
+
+// static
+StatusOr<TDigest> TDigest::deserialize(folly::StringPiece data) {
+    if (data.size() < sizeof(double) * 3 || (data.size() / sizeof(double)) % 2 == 0 ||
+        data.size() % sizeof(double) != 0) {
+        return Status::Error("Invalid t-digest of %lu bytes", data.size());
+    }
+    auto read = [&data] (size_t i) {
+        double v;
+        memcpy(&v, data.data() + i * sizeof(double), sizeof(v));
+        return v;
+    };
+    TDigest digest(read(0));
+    digest.min_ = read(1);
+    digest.max_ = read(2);
+    auto n = data.size() / sizeof(double);
+    digest.centroids_.reserve((n - 3) / 2);
+    for (size_t i = 3; i < n; i += 2) {
+        Centroid c{read(i), read(i + 1)};
+        if (!digest.centroids_.empty() && c.mean < digest.centroids_.back().mean) {
+            return Status::Error("Invalid t-digest, centroids out of order");
+        }
+        digest.count_ += c.weight;
+        digest.centroids_.emplace_back(c);
+    }
+    return digest;
+}
+
+
+void TDigest::compress() const {
+    if (buffer_.empty()) {
+        return;
+    }
+    ++numCompressions_;
+    std::sort(buffer_.begin(), buffer_.end());
+    std::vector<Centroid> merged;
+    merged.reserve(centroids_.size() + buffer_.size());
+    auto it = buffer_.begin();
+    for (const auto& c : centroids_) {
+        for (; it != buffer_.end() && *it < c.mean; ++it) {
+            merged.emplace_back(Centroid{*it, 1});
+        }
+        merged.emplace_back(c);
+    }
+    for (; it != buffer_.end(); ++it) {
+        merged.emplace_back(Centroid{*it, 1});
+    }
+    count_ += buffer_.size();
+    buffer_.clear();
+
+    cluster(merged);
+}
+
+
+void TDigest::cluster(const std::vector<Centroid>& sorted) const {
+    centroids_.clear();
+    if (sorted.empty()) {
+        return;
+    }
+    // Adjacent centroids are combined as long as the combined one stays within
+    // one unit of the scale function
+    double kLimit = 1;
+    double qLimitTimesCount = kToQ(kLimit++, compression_) * count_;
+    auto cur = sorted.front();
+    double weightSoFar = cur.weight;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        const auto& next = sorted[i];
+        weightSoFar += next.weight;
+        if (weightSoFar <= qLimitTimesCount) {
+            cur.mean += (next.mean - cur.mean) * next.weight / (cur.weight + next.weight);
+            cur.weight += next.weight;
+        } else {
+            centroids_.emplace_back(cur);
+            qLimitTimesCount = kToQ(kLimit++, compression_) * count_;
+            cur = next;
+        }
+    }
+    centroids_.emplace_back(cur);
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,80 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_ALGORITHM_TDIGEST_H_
+#define COMMON_ALGORITHM_TDIGEST_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Mergeable quantile sketch, see Dunning & Ertl, "Computing extremely accurate
+ * quantiles using t-digests".
+ *
+ * Values are buffered and merged into at most about `compression' centroids in
+ * batch, so memory is bounded by O(compression). A larger compression gives more
+ * accurate quantiles, especially the extreme ones.
+ */
+class TDigest final {
+public:
+    static constexpr double kDefaultCompression = 100;
+
+    explicit TDigest(double compression = kDefaultCompression);
+
+    void add(double value);
+
+    void merge(const TDigest& other);
+
+    // Estimate the value at quantile q in [0, 1], NaN if nothing added
+    double quantile(double q) const;
+
+    double count() const {
+        return count_ + buffer_.size();
+    }
+
+    // Times the buffered values have been merged into the centroids
+    size_t numCompressions() const {
+        return numCompressions_;
+    }
+
+    size_t memoryUsage() const {
+        return sizeof(*this) + centroids_.capacity() * sizeof(Centroid)
+                             + buffer_.capacity() * sizeof(double);
+    }
+
+    std::string serialize() const;
+
+    static StatusOr<TDigest> deserialize(folly::StringPiece data);
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Merge the buffered values into the centroids
+    void compress() const;
+
+    // Rebuild the centroids from the sorted ones, whose total weight is count_
+    void cluster(const std::vector<Centroid>& sorted) const;
+
+private:
+    double compression_;
+    // The digest is compressed lazily, even by the const readers
+    mutable std::vector<Centroid> centroids_;
+    mutable std::vector<double> buffer_;
+    mutable double count_{0};
+    mutable size_t numCompressions_{0};
+    double min_{std::numeric_limits<double>::infinity()};
+    double max_{-std::numeric_limits<double>::infinity()};
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+#endif  // COMMON_ALGORITHM_TDIGEST_H_
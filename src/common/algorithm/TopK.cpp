@@ -0,0 +1,170 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/TopK.h"
+
+namespace nebula {
+namespace algorithm {
+
+namespace {
+
+template <class T>
+int threeWay(const T& a, const T& b) {
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+// Equal within kEpsilon like Value::lessThan, NaN goes after all the numbers
+int compareFloat(double a, double b) {
+    if (UNLIKELY(std::isnan(a) || std::isnan(b))) {
+        return static_cast<int>(std::isnan(a)) - static_cast<int>(std::isnan(b));
+    }
+    if (std::abs(a - b) < kEpsilon) {
+        return 0;
+    }
+    return a < b ? -1 : 1;
+}
+
+int compareValue(const Value& a, const Value& b) {
+    auto aType = a.type();
+    auto bType = b.type();
+    if (aType == bType) {
+        switch (aType) {
+            case Value::Type::INT: {
+                return threeWay(a.getInt(), b.getInt());
+            }
+            case Value::Type::FLOAT: {
+                return compareFloat(a.getFloat(), b.getFloat());
+            }
+            case Value::Type::STRING: {
+                auto cmp = a.getStr().compare(b.getStr());
+                return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+            }
+            default: {
+                break;
+            }
+        }
+    } else if (((aType | bType) & Value::kNumericType) == Value::kNumericType) {
+        auto toDouble = [] (const Value& v) {
+            return v.isInt() ? static_cast<double>(v.getInt()) : v.getFloat();
+        };
+        return compareFloat(toDouble(a), toDouble(b));
+    }
+
+    auto lt = a.lessThan(b);
+    if (lt.isBool()) {
+        if (lt.getBool()) {
+            return -1;
+        }
+        auto gt = b.lessThan(a);
+        return gt.isBool() && gt.getBool() ? 1 : 0;
+    }
+    // Empty, null or different types
+    return threeWay(aType, bType);
+}
+
+}  // namespace
+
+TopK::TopK(std::vector<SortKey> keys, size_t k)
+        : keys_(std::move(keys))
+        , k_(k) {
+    heap_.reserve(k_);
+}
+
+
+int TopK::compare(const Row& a, const Row& b) const {
+    for (const auto& key : keys_) {
+        DCHECK_LT(key.column, a.size());
+        DCHECK_LT(key.column, b.size());
+        auto cmp = compareValue(a[key.column], b[key.column]);
+        if (cmp != 0) {
+            return key.descending ? -cmp : cmp;
+        }
+    }
+    return 0;
+}
+
+
+bool TopK::push(const Row& row) {
+    if (heap_.size() < k_) {
+        heap_.emplace_back(Entry{row, seq_++});
+        std::push_heap(heap_.begin(), heap_.end(), heapCmp());
+        return true;
+    }
+    ++seq_;
+    if (k_ == 0 || !accepts(row)) {
+        return false;
+    }
+    replaceTop(Row(row));
+    return true;
+}
+
+
+bool TopK::push(Row&& row) {
+    if (heap_.size() < k_) {
+        heap_.emplace_back(Entry{std::move(row), seq_++});
+        std::push_heap(heap_.begin(), heap_.end(), heapCmp());
+        return true;
+    }
+    ++seq_;
+    if (k_ == 0 || !accepts(row)) {
+        return false;
+    }
+    replaceTop(std::move(row));
+    return true;
+}
+
+
+size_t TopK::push(DataSet&& ds) {
+    size_t kept = 0;
+    for (auto& row : ds.rows) {
+        if (push(std::move(row))) {
+            ++kept;
+        }
+    }
+    ds.rows.clear();
+    return kept;
+}
+
+
+void TopK::replaceTop(Row&& row) {
+    auto cmp = heapCmp();
+    std::pop_heap(heap_.begin(), heap_.end(), cmp);
+    // Strictly less than the evicted row, as checked by accepts(), seq_ has
+    // been advanced for it already
+    heap_.back().row = std::move(row);
+    heap_.back().seq = seq_ - 1;
+    std::push_heap(heap_.begin(), heap_.end(), cmp);
+}
+
+
+void TopK::merge(TopK&& other) {
+    DCHECK_EQ(k_, other.k_);
+    DCHECK_EQ(keys_.size(), other.keys_.size());
+    // In the order of the other, so its earlier rows are kept among equal ones
+    std::sort_heap(other.heap_.begin(), other.heap_.end(), other.heapCmp());
+    for (auto& entry : other.heap_) {
+        if (!push(std::move(entry.row))) {
+            // The rest are not less than this one
+            break;
+        }
+    }
+    other.heap_.clear();
+}
+
+
+std::vector<Row> TopK::finish() && {
+    std::sort_heap(heap_.begin(), heap_.end(), heapCmp());
+    std::vector<Row> rows;
+    rows.reserve(heap_.size());
+    for (auto& entry : heap_) {
+        rows.emplace_back(std::move(entry.row));
+    }
+    heap_.clear();
+    return rows;
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_ALGORITHM_TOPK_H_
+#define COMMON_ALGORITHM_TOPK_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Keeps the first k rows in the order of the sort keys, e.g. for ORDER BY
+ * with a LIMIT, without sorting all the rows.
+ *
+ * The rows are kept in a bounded max heap, so the row to be evicted is on the
+ * top, and most rows of a large input are discarded after one comparison with
+ * it. Rows could be pushed one by one or batch by batch as they arrive.
+ *
+ * Values are compared with the semantics of Value::lessThan, e.g. floats
+ * within kEpsilon are equal. The values which lessThan can't order, i.e.
+ * empty, null and the ones of different types, are ordered by their types
+ * like operator<(Value, Value) does, so nulls go last in ascending order.
+ * Keys of int, float and string types are compared without calling lessThan.
+ * Among equal rows, the ones pushed earlier are kept.
+ *
+ * Not thread-safe. To select from parallel inputs, fill a TopK per thread,
+ * then merge them.
+ */
+class TopK final {
+public:
+    struct SortKey {
+        // Index of the column in the rows
+        size_t column;
+        bool descending{false};
+    };
+
+    TopK(std::vector<SortKey> keys, size_t k);
+
+    size_t k() const {
+        return k_;
+    }
+
+    size_t size() const {
+        return heap_.size();
+    }
+
+    // Returns false if the row is discarded, it's only copied if kept
+    bool push(const Row& row);
+
+    bool push(Row&& row);
+
+    // Returns the number of rows kept
+    size_t push(DataSet&& ds);
+
+    // Merge the rows of a TopK with the same keys and k
+    void merge(TopK&& other);
+
+    // Returns the kept rows in order
+    std::vector<Row> finish() &&;
+
+    // Negative if `a' goes before `b', 0 if they are equal
+    int compare(const Row& a, const Row& b) const;
+
+private:
+    struct Entry {
+        Row row;
+        // Order of pushing, to keep the earlier ones of equal rows
+        uint64_t seq;
+    };
+
+    bool before(const Entry& a, const Entry& b) const {
+        auto cmp = compare(a.row, b.row);
+        return cmp < 0 || (cmp == 0 && a.seq < b.seq);
+    }
+
+    auto heapCmp() const {
+        return [this] (const Entry& a, const Entry& b) {
+            return before(a, b);
+        };
+    }
+
+    // Whether the row would be kept, the heap has k rows
+    bool accepts(const Row& row) const {
+        return compare(row, heap_.front().row) < 0;
+    }
+
+    void replaceTop(Row&& row);
+
+private:
+    const std::vector<SortKey> keys_;
+    const size_t k_;
+    std::vector<Entry> heap_;
+    uint64_t seq_{0};
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+#endif  // COMMON_ALGORITHM_TOPK_H_
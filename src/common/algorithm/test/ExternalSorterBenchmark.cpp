@@ -0,0 +1,104 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/algorithm/ExternalSorter.h"
+
+namespace nebula {
+namespace algorithm {
+
+static constexpr size_t kRows = 1000000;
+
+// Rows of (int, string, int), built in main()
+static std::vector<Row> rows;
+// Estimated bytes of all the rows buffered in memory
+static size_t dataBytes = 0;
+
+static std::vector<Row> makeRows() {
+    std::mt19937 rng(0);
+    std::vector<Row> result;
+    result.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        Row row;
+        row.values.emplace_back(static_cast<int64_t>(rng()));
+        row.values.emplace_back(folly::stringPrintf("player_name_%u", rng() % 100000));
+        row.values.emplace_back(static_cast<int64_t>(i));
+        result.emplace_back(std::move(row));
+    }
+    return result;
+}
+
+size_t inMemorySort(size_t iters) {
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<Row> copy;
+        BENCHMARK_SUSPEND {
+            copy = rows;
+        }
+        std::stable_sort(copy.begin(), copy.end(), [] (const Row& a, const Row& b) {
+            if (a[1] != b[1]) {
+                return a[1] < b[1];
+            }
+            return a[0] < b[0];
+        });
+        folly::doNotOptimizeAway(copy.size());
+    }
+    return iters * kRows;
+}
+
+// The rows are `times' of the memory budget
+size_t externalSort(size_t iters, size_t times) {
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<Row> copy;
+        BENCHMARK_SUSPEND {
+            copy = rows;
+        }
+        ExternalSorter::Options options;
+        options.memoryBudget = dataBytes / times;
+        ExternalSorter sorter({{1, false}, {0, false}}, options);
+        for (auto& row : copy) {
+            CHECK(sorter.add(std::move(row)).ok());
+        }
+        CHECK(sorter.finish().ok());
+        size_t num = 0;
+        while (true) {
+            auto batch = sorter.next();
+            CHECK(batch.ok());
+            if (batch.value().empty()) {
+                break;
+            }
+            num += batch.value().size();
+        }
+        CHECK_EQ(kRows, num);
+    }
+    return iters * kRows;
+}
+
+BENCHMARK_MULTI(inMemorySort)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(externalSort, 1x_budget, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(externalSort, 10x_budget, 10)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(externalSort, 100x_budget, 100)
+
+}  // namespace algorithm
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    nebula::algorithm::rows = nebula::algorithm::makeRows();
+
+    nebula::algorithm::ExternalSorter::Options options;
+    options.memoryBudget = std::numeric_limits<int64_t>::max();
+    nebula::algorithm::ExternalSorter sorter({{1, false}, {0, false}}, options);
+    for (const auto& row : nebula::algorithm::rows) {
+        CHECK(sorter.add(row).ok());
+    }
+    nebula::algorithm::dataBytes = sorter.bufferedBytes();
+    LOG(INFO) << nebula::algorithm::kRows << " rows take about "
+              << nebula::algorithm::dataBytes / 1024 / 1024 << " MB in the sorter";
+
+    folly::runBenchmarks();
+    return 0;
+}
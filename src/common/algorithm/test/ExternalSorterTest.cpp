@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/ExternalSorter.h"
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace algorithm {
+
+static std::vector<Row> makeRows(size_t num) {
+    std::mt19937 rng(0);
+    std::vector<Row> rows;
+    rows.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        Row row;
+        if (rng() % 50 == 0) {
+            row.values.emplace_back(Value::kNullValue);
+        } else {
+            row.values.emplace_back(static_cast<int64_t>(rng() % 100));
+        }
+        row.values.emplace_back(folly::stringPrintf("name_%u", rng() % 1000));
+        // The input order
+        row.values.emplace_back(static_cast<int64_t>(i));
+        rows.emplace_back(std::move(row));
+    }
+    return rows;
+}
+
+static std::vector<Row> sortAll(ExternalSorter& sorter) {
+    std::vector<Row> result;
+    while (true) {
+        auto batch = sorter.next();
+        EXPECT_TRUE(batch.ok()) << batch.status();
+        if (!batch.ok() || batch.value().empty()) {
+            break;
+        }
+        EXPECT_LE(batch.value().size(), 100);
+        for (auto& row : batch.value()) {
+            result.emplace_back(std::move(row));
+        }
+    }
+    return result;
+}
+
+TEST(ExternalSorterTest, InMemory) {
+    auto rows = makeRows(1000);
+    ExternalSorter::Options options;
+    options.memoryBudget = 1024 * 1024 * 1024;
+    options.batchSize = 100;
+    ExternalSorter sorter({{0, false}}, options);
+    for (const auto& row : rows) {
+        ASSERT_TRUE(sorter.add(row).ok());
+    }
+    ASSERT_TRUE(sorter.finish().ok());
+    EXPECT_EQ(0, sorter.numRuns());
+    EXPECT_EQ(0, sorter.spilledBytes());
+
+    std::stable_sort(rows.begin(), rows.end(), [] (const Row& a, const Row& b) {
+        return a[0] < b[0];
+    });
+    EXPECT_EQ(rows, sortAll(sorter));
+}
+
+TEST(ExternalSorterTest, Spill) {
+    auto rows = makeRows(20000);
+    ExternalSorter::Options options;
+    options.memoryBudget = 64 * 1024;
+    options.batchSize = 100;
+    // By the first column descending, then the second one
+    ExternalSorter sorter({{0, true}, {1, false}}, options);
+    DataSet ds({"a", "b", "c"});
+    ds.rows = rows;
+    ASSERT_TRUE(sorter.add(std::move(ds)).ok());
+    ASSERT_TRUE(sorter.finish().ok());
+    EXPECT_EQ(rows.size(), sorter.numRows());
+    EXPECT_GT(sorter.numRuns(), 10);
+    EXPECT_GT(sorter.spilledBytes(), 0);
+
+    // Stable, so the rows of equal keys are in the input order
+    std::stable_sort(rows.begin(), rows.end(), [] (const Row& a, const Row& b) {
+        if (a[0] != b[0]) {
+            return b[0] < a[0];
+        }
+        return a[1] < b[1];
+    });
+    auto sorted = sortAll(sorter);
+    ASSERT_EQ(rows.size(), sorted.size());
+    EXPECT_EQ(rows, sorted);
+
+    auto batch = sorter.next();
+    ASSERT_TRUE(batch.ok());
+    EXPECT_TRUE(batch.value().empty());
+}
+
+TEST(ExternalSorterTest, BadColumn) {
+    ExternalSorter sorter({{3, false}}, ExternalSorter::Options());
+    EXPECT_FALSE(sorter.add(List({1, 2})).ok());
+}
+
+TEST(ExternalSorterTest, BadTmpDir) {
+    ExternalSorter::Options options;
+    options.memoryBudget = 0;
+    options.tmpDir = "/path/not/exist";
+    ExternalSorter sorter({{0, false}}, options);
+    EXPECT_FALSE(sorter.add(List({1})).ok());
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,115 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/algorithm/GroupByHashTable.h"
+
+namespace nebula {
+namespace algorithm {
+
+static constexpr size_t kRows = 1000000;
+
+// Key columns (int, string) of kRows rows, with `numGroups' distinct keys
+static std::vector<Value> makeIntColumn(size_t numGroups) {
+    std::vector<Value> col;
+    col.reserve(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        col.emplace_back(static_cast<int64_t>(i * 7919 % numGroups));
+    }
+    return col;
+}
+
+static std::vector<Value> makeStrColumn(const std::vector<Value>& ints) {
+    std::vector<Value> col;
+    col.reserve(ints.size());
+    for (const auto& v : ints) {
+        col.emplace_back(folly::stringPrintf("group_name_%ld", v.getInt() % 1000));
+    }
+    return col;
+}
+
+static std::unordered_map<size_t, std::pair<std::vector<Value>, std::vector<Value>>> columns;
+
+static const std::pair<std::vector<Value>, std::vector<Value>>& getColumns(size_t numGroups) {
+    auto& cols = columns[numGroups];
+    if (cols.first.empty()) {
+        cols.first = makeIntColumn(numGroups);
+        cols.second = makeStrColumn(cols.first);
+    }
+    return cols;
+}
+
+size_t unorderedMapGroupBy(size_t iters, size_t numGroups) {
+    // Built in main()
+    const auto& cols = getColumns(numGroups);
+    for (size_t i = 0; i < iters; ++i) {
+        std::unordered_map<List, size_t> groups;
+        for (size_t j = 0; j < kRows; ++j) {
+            List key({cols.first[j], cols.second[j]});
+            groups.emplace(std::move(key), groups.size());
+        }
+        folly::doNotOptimizeAway(groups.size());
+    }
+    return iters * kRows;
+}
+
+size_t hashTableGroupBy(size_t iters, size_t numGroups) {
+    // Built in main()
+    const auto& cols = getColumns(numGroups);
+    for (size_t i = 0; i < iters; ++i) {
+        GroupByHashTable table(2);
+        Value keys[2];
+        for (size_t j = 0; j < kRows; ++j) {
+            keys[0] = cols.first[j];
+            keys[1] = cols.second[j];
+            folly::doNotOptimizeAway(table.insert(keys));
+        }
+        folly::doNotOptimizeAway(table.size());
+    }
+    return iters * kRows;
+}
+
+size_t hashTableBatchGroupBy(size_t iters, size_t numGroups) {
+    // Built in main()
+    const auto& cols = getColumns(numGroups);
+    for (size_t i = 0; i < iters; ++i) {
+        GroupByHashTable table(2);
+        std::vector<size_t> groups;
+        table.insert({&cols.first, &cols.second}, &groups);
+        folly::doNotOptimizeAway(table.size());
+    }
+    return iters * kRows;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(unorderedMapGroupBy, 1K_groups, 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableGroupBy, 1K_groups, 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableBatchGroupBy, 1K_groups, 1000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(unorderedMapGroupBy, 100K_groups, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableGroupBy, 100K_groups, 100000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableBatchGroupBy, 100K_groups, 100000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(unorderedMapGroupBy, 1M_groups, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableGroupBy, 1M_groups, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(hashTableBatchGroupBy, 1M_groups, 1000000)
+
+}  // namespace algorithm
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    for (size_t numGroups : {1000UL, 100000UL, 1000000UL}) {
+        const auto& cols = nebula::algorithm::getColumns(numGroups);
+        nebula::algorithm::GroupByHashTable table(2);
+        std::vector<size_t> groups;
+        table.insert({&cols.first, &cols.second}, &groups);
+        LOG(INFO) << numGroups << " groups, GroupByHashTable takes "
+                  << table.memoryUsage() / table.size() << " bytes per group";
+    }
+    folly::runBenchmarks();
+    return 0;
+}
@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/GroupByHashTable.h"
+#include <gtest/gtest.h>
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+namespace algorithm {
+
+TEST(GroupByHashTableTest, Insert) {
+    GroupByHashTable table(2);
+    bool inserted = false;
+    EXPECT_EQ(0, table.insert(List({1, "a"}), &inserted));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(1, table.insert(List({1, "b"}), &inserted));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(0, table.insert(List({1, "a"}), &inserted));
+    EXPECT_FALSE(inserted);
+    // Different types are different groups
+    EXPECT_EQ(2, table.insert(List({1.0, "a"}), &inserted));
+    EXPECT_EQ(3, table.insert(List({Value::kNullValue, Value()}), &inserted));
+    EXPECT_EQ(4, table.size());
+
+    EXPECT_EQ(1, table.find(List({1, "b"})));
+    EXPECT_EQ(GroupByHashTable::kNotFound, table.find(List({2, "b"})));
+    EXPECT_EQ(List({1, "b"}), table.key(1));
+
+    // Grow the table many times
+    for (int64_t i = 0; i < 100000; ++i) {
+        table.insert(List({i, folly::to<std::string>(i)}));
+    }
+    EXPECT_EQ(100004, table.size());
+    for (int64_t i = 0; i < 100000; i += 1000) {
+        auto group = table.find(List({i, folly::to<std::string>(i)}));
+        ASSERT_NE(GroupByHashTable::kNotFound, group);
+        EXPECT_EQ(List({i, folly::to<std::string>(i)}), table.key(group));
+    }
+    EXPECT_GT(table.memoryUsage(), 100000 * 8);
+}
+
+TEST(GroupByHashTableTest, AllTypes) {
+    Vertex vertex("v", {Tag("tag", {{"p1", 1}, {"p2", "x"}})});
+    Edge edge("v", "w", 1, "like", 0, {{"p", 1.5}});
+    Path path;
+    path.src = vertex;
+    path.steps.emplace_back(Step(Vertex("w", {}), 1, "like", 0, {{"p", 1.5}}));
+    DataSet ds({"a", "b"});
+    ds.rows.emplace_back(List({1, "x"}));
+
+    std::vector<Value> values = {
+        Value(),
+        Value::kNullValue,
+        Value::kNullBadType,
+        true,
+        -1,
+        -0.5,
+        "str",
+        Date(2021, 1, 2),
+        Time(1, 2, 3, 4),
+        DateTime(2021, 1, 2, 3, 4, 5, 6),
+        vertex,
+        edge,
+        path,
+        List({1, List({2, 3})}),
+        Map({{"a", 1}, {"b", Map({{"c", 2}})}}),
+        Set({1, "a", 2.5}),
+        ds,
+    };
+    GroupByHashTable table(1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(i, table.insert(&values[i]));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(i, table.insert(&values[i]));
+        auto key = table.key(i);
+        ASSERT_EQ(1, key.size());
+        EXPECT_EQ(values[i].type(), key[0].type());
+        if (!values[i].isNull()) {
+            EXPECT_EQ(values[i], key[0]);
+        }
+    }
+    EXPECT_EQ(NullType::BAD_TYPE, table.key(2)[0].getNull());
+
+    // Maps and sets are the same group no matter the order of insertion
+    Map map;
+    for (int i = 0; i < 100; ++i) {
+        map.kvs.emplace(folly::to<std::string>(i), i);
+    }
+    Map reversed;
+    for (int i = 99; i >= 0; --i) {
+        reversed.kvs.emplace(folly::to<std::string>(i), i);
+    }
+    Value mapValue(map);
+    Value reversedValue(reversed);
+    EXPECT_EQ(table.insert(&mapValue), table.insert(&reversedValue));
+
+    Set set;
+    Set reversedSet;
+    for (int i = 0; i < 100; ++i) {
+        set.values.emplace(i);
+        reversedSet.values.emplace(99 - i);
+    }
+    Value setValue(set);
+    Value reversedSetValue(reversedSet);
+    EXPECT_EQ(table.insert(&setValue), table.insert(&reversedSetValue));
+    EXPECT_EQ(std::hash<Value>()(setValue), std::hash<Value>()(reversedSetValue));
+    EXPECT_EQ(std::hash<Value>()(mapValue), std::hash<Value>()(reversedValue));
+}
+
+TEST(GroupByHashTableTest, Batch) {
+    std::vector<Value> col1, col2;
+    for (int64_t i = 0; i < 10000; ++i) {
+        col1.emplace_back(i % 100);
+        col2.emplace_back(i % 7 == 0 ? Value::kNullValue : Value("s"));
+    }
+    GroupByHashTable table(2);
+    std::vector<size_t> groups;
+    table.insert({&col1, &col2}, &groups);
+    ASSERT_EQ(10000, groups.size());
+    // Each (i % 100, i % 7 == 0) is a group
+    EXPECT_EQ(200, table.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        EXPECT_EQ(table.find(List({col1[i], col2[i]})), groups[i]);
+    }
+
+    std::vector<Value> probe1 = {1, 1, 1000};
+    std::vector<Value> probe2 = {"s", Value::kNullValue, "s"};
+    std::vector<size_t> found;
+    table.find({&probe1, &probe2}, &found);
+    ASSERT_EQ(3, found.size());
+    EXPECT_EQ(groups[1], found[0]);
+    EXPECT_NE(GroupByHashTable::kNotFound, found[1]);
+    EXPECT_EQ(GroupByHashTable::kNotFound, found[2]);
+}
+
+}  // namespace algorithm
+}  // namespace nebula
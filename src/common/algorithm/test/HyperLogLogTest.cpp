@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/HyperLogLog.h"
+#include <gtest/gtest.h>
+#include <folly/hash/Hash.h>
+
+namespace nebula {
+namespace algorithm {
+
+static void addRange(HyperLogLog& hll, uint64_t begin, uint64_t end) {
+    for (auto i = begin; i < end; ++i) {
+        hll.add(folly::hash::twang_mix64(i));
+    }
+}
+
+TEST(HyperLogLogTest, Estimate) {
+    {
+        HyperLogLog hll;
+        EXPECT_EQ(0, hll.estimate());
+        // Duplicates are not counted
+        for (int i = 0; i < 3; ++i) {
+            addRange(hll, 0, 10);
+        }
+        EXPECT_EQ(10, hll.estimate());
+    }
+    for (uint64_t n : {1000UL, 100000UL, 1000000UL}) {
+        HyperLogLog hll;
+        addRange(hll, 0, n);
+        // Far beyond 3 times of the standard error
+        EXPECT_NEAR(n, hll.estimate(), n * 0.05);
+    }
+    {
+        HyperLogLog hll(HyperLogLog::kMinPrecision);
+        EXPECT_EQ(0, hll.memoryUsage() - sizeof(hll));
+        addRange(hll, 0, 100000);
+        EXPECT_EQ(16, hll.memoryUsage() - sizeof(hll));
+        EXPECT_NEAR(100000, hll.estimate(), 100000 * 0.5);
+    }
+}
+
+TEST(HyperLogLogTest, Sparse) {
+    HyperLogLog hll;
+    EXPECT_TRUE(hll.sparse());
+    addRange(hll, 0, 100);
+    EXPECT_TRUE(hll.sparse());
+    EXPECT_NEAR(100, hll.estimate(), 2);
+    // 4 bytes per register, instead of 16KB
+    EXPECT_GE(1024, hll.memoryUsage() - sizeof(hll));
+
+    // Turned dense beyond 1/16 of the registers, keeping the estimate
+    uint64_t n = 100;
+    while (hll.sparse()) {
+        auto before = hll.estimate();
+        addRange(hll, n, n + 1);
+        ++n;
+        if (!hll.sparse()) {
+            EXPECT_NEAR(before, hll.estimate(), 2);
+        }
+    }
+    EXPECT_LT(1000, n);
+    EXPECT_NEAR(n, hll.estimate(), n * 0.05);
+    EXPECT_EQ(16 * 1024, hll.memoryUsage() - sizeof(hll));
+    addRange(hll, n, 100000);
+    EXPECT_NEAR(100000, hll.estimate(), 5000);
+}
+
+TEST(HyperLogLogTest, Merge) {
+    {
+        HyperLogLog lhs, rhs;
+        addRange(lhs, 0, 60000);
+        addRange(rhs, 40000, 100000);
+        lhs.merge(rhs);
+        EXPECT_NEAR(100000, lhs.estimate(), 5000);
+    }
+    {
+        // Merge sketches of different precisions
+        HyperLogLog lhs(14), rhs(10), expected(10);
+        addRange(lhs, 0, 60000);
+        addRange(rhs, 40000, 100000);
+        addRange(expected, 0, 100000);
+        lhs.merge(rhs);
+        EXPECT_EQ(10, lhs.precision());
+        EXPECT_EQ(expected.estimate(), lhs.estimate());
+
+        HyperLogLog high(14);
+        addRange(high, 0, 60000);
+        rhs.merge(high);
+        EXPECT_EQ(10, rhs.precision());
+        EXPECT_EQ(expected.estimate(), rhs.estimate());
+    }
+}
+
+TEST(HyperLogLogTest, MergeSparse) {
+    HyperLogLog expected;
+    addRange(expected, 0, 50000);
+    for (auto n : {10UL, 500UL, 50000UL}) {
+        // Sparse or dense into sparse or dense
+        HyperLogLog lhs, rhs;
+        addRange(lhs, 0, n);
+        addRange(rhs, n, 50000);
+        EXPECT_EQ(n < 1000, lhs.sparse());
+        HyperLogLog merged(lhs);
+        merged.merge(rhs);
+        EXPECT_EQ(expected.estimate(), merged.estimate());
+        merged = rhs;
+        merged.merge(lhs);
+        EXPECT_EQ(expected.estimate(), merged.estimate());
+    }
+    {
+        HyperLogLog lhs, rhs, both;
+        addRange(lhs, 0, 100);
+        addRange(rhs, 50, 200);
+        addRange(both, 0, 200);
+        lhs.merge(rhs);
+        EXPECT_TRUE(lhs.sparse());
+        EXPECT_EQ(both.estimate(), lhs.estimate());
+    }
+    {
+        // And of a lower precision
+        HyperLogLog lhs(14), rhs(10), expectedLow(10);
+        addRange(lhs, 0, 30);
+        addRange(rhs, 20, 40);
+        addRange(expectedLow, 0, 40);
+        lhs.merge(rhs);
+        EXPECT_EQ(10, lhs.precision());
+        EXPECT_EQ(expectedLow.estimate(), lhs.estimate());
+    }
+}
+
+TEST(HyperLogLogTest, Serialize) {
+    HyperLogLog hll(12);
+    addRange(hll, 0, 12345);
+    auto data = hll.serialize();
+    auto result = HyperLogLog::deserialize(data);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(12, result.value().precision());
+    EXPECT_EQ(hll.estimate(), result.value().estimate());
+
+    EXPECT_FALSE(HyperLogLog::deserialize("").ok());
+    EXPECT_FALSE(HyperLogLog::deserialize(folly::StringPiece(data).subpiece(1)).ok());
+
+    HyperLogLog sparse(12);
+    addRange(sparse, 0, 100);
+    ASSERT_TRUE(sparse.sparse());
+    data = sparse.serialize();
+    // Some of the items may share a register
+    EXPECT_GE(1 + 100 * sizeof(uint32_t), data.size());
+    EXPECT_EQ(1, data.size() % sizeof(uint32_t));
+    result = HyperLogLog::deserialize(data);
+    ASSERT_TRUE(result.ok());
+    EXPECT_TRUE(result.value().sparse());
+    EXPECT_EQ(12, result.value().precision());
+    EXPECT_EQ(sparse.estimate(), result.value().estimate());
+
+    EXPECT_FALSE(HyperLogLog::deserialize(data.substr(0, data.size() - 1)).ok());
+    // The registers out of order
+    std::swap_ranges(data.begin() + 1, data.begin() + 5, data.begin() + 5);
+    EXPECT_FALSE(HyperLogLog::deserialize(data).ok());
+}
+
+}  // namespace algorithm
+}  // namespace nebula
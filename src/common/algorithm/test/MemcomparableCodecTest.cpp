@@ -0,0 +1,358 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/MemcomparableCodec.h"
+#include <gtest/gtest.h>
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Date.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+namespace algorithm {
+
+static std::string encodeKey(const Value& val, bool descending = false) {
+    std::string buf;
+    MemcomparableCodec::encodeKey(val, &buf, descending);
+    return buf;
+}
+
+TEST(MemcomparableCodecTest, Order) {
+    // In ascending order
+    std::vector<Value> values = {
+        Value(),
+        Value(false),
+        Value(true),
+        Value(std::numeric_limits<int64_t>::min()),
+        Value(-1e18),
+        Value(-2),
+        Value(-1.5),
+        Value(-1),
+        Value(0),
+        Value(0.5),
+        Value(1),
+        Value(9007199254740992L),
+        Value(9007199254740993L),
+        Value(1e300),
+        Value(std::numeric_limits<int64_t>::max()),
+        Value(""),
+        Value(std::string("\0", 1)),
+        Value(std::string("\0\0", 2)),
+        Value(std::string("\0a", 2)),
+        Value("a"),
+        Value(std::string("a\0", 2)),
+        Value("ab"),
+        Value("b"),
+        Value("\xFF"),
+        Value(Date(-1, 12, 31)),
+        Value(Date(2021, 1, 1)),
+        Value(Date(2021, 1, 2)),
+        Value(Time(1, 2, 3, 0)),
+        Value(Time(1, 2, 3, 4)),
+        Value(DateTime(2020, 12, 31, 23, 59, 59, 999999)),
+        Value(DateTime(2021, 1, 1, 0, 0, 0, 0)),
+        Value(Vertex("a", {})),
+        Value(Vertex("a", {Tag("t", {})})),
+        Value(Vertex("b", {})),
+        Value(Edge("a", "b", -1, "e", 0, {})),
+        Value(Edge("a", "b", 1, "e", -1, {})),
+        Value(Edge("a", "b", 1, "e", 0, {})),
+        Value(Edge("a", "c", 1, "e", 0, {})),
+        Value(Path(Vertex("a", {}), {})),
+        Value(Path(Vertex("a", {}), {Step(Vertex("b", {}), 1, "e", 0, {})})),
+        Value(Path(Vertex("a", {}), {Step(Vertex("b", {}), 2, "e", 0, {})})),
+        Value(List()),
+        Value(List({1})),
+        Value(List({1, 2})),
+        Value(List({1, "a"})),
+        Value(List({2})),
+        Value(Map()),
+        Value::kNullValue,
+    };
+    for (size_t i = 0; i < values.size(); ++i) {
+        for (size_t j = 0; j < values.size(); ++j) {
+            auto a = encodeKey(values[i]);
+            auto b = encodeKey(values[j]);
+            EXPECT_EQ(i < j, a < b) << values[i] << " vs " << values[j];
+            EXPECT_EQ(values[i] < values[j], a < b) << values[i] << " vs " << values[j];
+            a = encodeKey(values[i], true);
+            b = encodeKey(values[j], true);
+            EXPECT_EQ(i > j, a < b) << values[i] << " vs " << values[j];
+        }
+    }
+}
+
+TEST(MemcomparableCodecTest, Numeric) {
+    // Equal ints and floats are not less than each other
+    EXPECT_EQ(encodeKey(1), encodeKey(1.0));
+    EXPECT_EQ(encodeKey(0.0), encodeKey(-0.0));
+    // All kinds of nulls are equal
+    EXPECT_EQ(encodeKey(Value::kNullValue), encodeKey(Value::kNullBadType));
+
+    std::mt19937_64 rng(0);
+    std::vector<int64_t> ints;
+    for (int i = 0; i < 10000; ++i) {
+        ints.emplace_back(static_cast<int64_t>(rng()));
+        // Around 2^53 and 2^63, where adjacent ints are the same double
+        ints.emplace_back(static_cast<int64_t>(rng() % 4096) + (1L << 53) - 2048);
+        ints.emplace_back(std::numeric_limits<int64_t>::max() - static_cast<int64_t>(rng() % 4096));
+        ints.emplace_back(std::numeric_limits<int64_t>::min() + static_cast<int64_t>(rng() % 4096));
+    }
+    for (size_t i = 1; i < ints.size(); ++i) {
+        auto a = encodeKey(ints[i - 1]);
+        auto b = encodeKey(ints[i]);
+        EXPECT_EQ(ints[i - 1] < ints[i], a < b) << ints[i - 1] << " vs " << ints[i];
+        EXPECT_EQ(ints[i - 1] == ints[i], a == b) << ints[i - 1] << " vs " << ints[i];
+    }
+}
+
+TEST(MemcomparableCodecTest, Concatenated) {
+    // Keys of several columns compare column by column
+    auto encode = [] (const List& row) {
+        std::string buf;
+        MemcomparableCodec::encodeKey(row[0], &buf);
+        MemcomparableCodec::encodeKey(row[1], &buf, true);
+        return buf;
+    };
+    EXPECT_LT(encode(List({"a", 1})), encode(List({"ab", 2})));
+    EXPECT_LT(encode(List({"a", 2})), encode(List({"a", 1})));
+    EXPECT_LT(encode(List({"a", "b"})), encode(List({"a", "a"})));
+    EXPECT_LT(encode(List({"a", Value::kNullValue})), encode(List({"a", 1})));
+}
+
+TEST(MemcomparableCodecTest, Decode) {
+    std::vector<Value> values = {
+        Value(),
+        Value::kNullValue,
+        Value::kNullBadType,
+        Value::kNullOverflow,
+        Value(true),
+        Value(false),
+        Value(0),
+        Value(-1),
+        Value(std::numeric_limits<int64_t>::min()),
+        Value(std::numeric_limits<int64_t>::max()),
+        Value(9007199254740993L),
+        Value(1.0),
+        Value(-2.5),
+        Value(1e-300),
+        Value(std::numeric_limits<double>::infinity()),
+        Value(""),
+        Value(std::string("a\0b\0", 4)),
+        Value("\xFF\x01"),
+        Value(Date(-1, 12, 31)),
+        Value(Time(23, 59, 59, 999999)),
+        Value(DateTime(2021, 1, 2, 3, 4, 5, 6)),
+        Value(Vertex("v", {Tag("t", {{"p", 1}, {"q", "x"}})})),
+        Value(Edge("a", "b", -1, "e", 3, {{"p", 1.5}})),
+        Value(Path(Vertex("a", {}), {Step(Vertex("b", {}), 1, "e", 0, {{"p", 1}})})),
+        Value(List({1, 1.0, "a", Value::kNullBadData, List({Value()})})),
+        Value(Map({{"k", 1}, {"l", List({2})}})),
+        Value(Set({1, "a"})),
+        Value(DataSet({"a", "b"})),
+    };
+    for (const auto& val : values) {
+        for (bool descending : {false, true}) {
+            std::string buf;
+            MemcomparableCodec::encode(val, &buf, descending);
+            auto decoded = MemcomparableCodec::decode(buf, descending);
+            ASSERT_TRUE(decoded.ok()) << val;
+            EXPECT_EQ(val.type(), decoded.value().type()) << val;
+            EXPECT_EQ(val, decoded.value());
+            if (val.isNull()) {
+                EXPECT_EQ(val.getNull(), decoded.value().getNull());
+            }
+            // The key is a prefix
+            EXPECT_EQ(0, buf.compare(0, encodeKey(val, descending).size(),
+                                     encodeKey(val, descending)));
+        }
+    }
+
+    EXPECT_FALSE(MemcomparableCodec::decode("").ok());
+    EXPECT_FALSE(MemcomparableCodec::decode("\x04" "abc").ok());
+    std::string buf;
+    MemcomparableCodec::encode(1, &buf);
+    buf.pop_back();
+    EXPECT_FALSE(MemcomparableCodec::decode(buf).ok());
+}
+
+TEST(MemcomparableCodecTest, Tuple) {
+    std::mt19937 rng(0);
+    auto randomValue = [&rng] () -> Value {
+        switch (rng() % 6) {
+            case 0:
+                return Value::kNullValue;
+            case 1:
+                return static_cast<double>(rng() % 5);
+            case 2:
+                return std::string(rng() % 3, 'a' + rng() % 2);
+            default:
+                return static_cast<int64_t>(rng() % 5);
+        }
+    };
+    std::vector<List> tuples;
+    for (int i = 0; i < 500; ++i) {
+        List tuple;
+        auto size = rng() % 4;
+        for (size_t j = 0; j < size; ++j) {
+            tuple.values.emplace_back(randomValue());
+        }
+        tuples.emplace_back(std::move(tuple));
+    }
+
+    std::vector<std::string> encoded;
+    for (const auto& tuple : tuples) {
+        std::string buf;
+        MemcomparableCodec::encodeTuple(tuple, &buf);
+        auto decoded = MemcomparableCodec::decodeTuple(buf);
+        ASSERT_TRUE(decoded.ok()) << tuple;
+        EXPECT_EQ(tuple, decoded.value());
+        for (size_t j = 0; j < tuple.size(); ++j) {
+            EXPECT_EQ(tuple[j].type(), decoded.value()[j].type());
+        }
+        encoded.emplace_back(std::move(buf));
+    }
+    for (size_t i = 0; i < tuples.size(); ++i) {
+        for (size_t j = 0; j < tuples.size(); ++j) {
+            if (tuples[i] < tuples[j]) {
+                EXPECT_LT(encoded[i], encoded[j]) << tuples[i] << " vs " << tuples[j];
+            }
+        }
+    }
+
+    // Equal keys are compared before the decoding part
+    std::string a, b;
+    MemcomparableCodec::encodeTuple(List({1, "b"}), &a);
+    MemcomparableCodec::encodeTuple(List({1.0, "a"}), &b);
+    EXPECT_LT(b, a);
+
+    // Descending by the second value
+    std::vector<bool> descending = {false, true};
+    a.clear();
+    b.clear();
+    MemcomparableCodec::encodeTuple(List({1, "a"}), &a, descending);
+    MemcomparableCodec::encodeTuple(List({1, "b"}), &b, descending);
+    EXPECT_LT(b, a);
+    auto decoded = MemcomparableCodec::decodeTuple(a, descending);
+    ASSERT_TRUE(decoded.ok());
+    EXPECT_EQ(List({1, "a"}), decoded.value());
+}
+
+TEST(MemcomparableCodecTest, Unordered) {
+    auto encode = [] (const Value& val) {
+        std::string buf;
+        MemcomparableCodec::encodeUnordered(val, &buf);
+        return buf;
+    };
+    std::vector<Value> values = {
+        Value(),
+        Value::kNullValue,
+        Value::kNullBadType,
+        Value(true),
+        Value(-1),
+        Value(1),
+        Value(1.0),
+        Value(std::string("a\0b", 3)),
+        Value(Date(2021, 1, 2)),
+        Value(Time(1, 2, 3, 4)),
+        Value(DateTime(2021, 1, 2, 3, 4, 5, 6)),
+        Value(Vertex("v", {Tag("t", {{"p", 1}})})),
+        Value(Edge("a", "b", -1, "e", 3, {{"p", 1.5}})),
+        Value(Path(Vertex("a", {}), {Step(Vertex("b", {}), 1, "e", 0, {{"p", 1}})})),
+        Value(List({1, "a", List({Value()})})),
+        Value(Map({{"k", 1}, {"l", 2}})),
+        Value(Set({1, "a"})),
+        Value(DataSet({"a", "b"})),
+    };
+    // Concatenated and decoded back
+    std::string buf;
+    for (const auto& val : values) {
+        MemcomparableCodec::encodeUnordered(val, &buf);
+    }
+    folly::StringPiece data(buf);
+    for (const auto& val : values) {
+        auto decoded = MemcomparableCodec::decodeUnordered(&data);
+        ASSERT_TRUE(decoded.ok()) << val;
+        EXPECT_EQ(val.type(), decoded.value().type()) << val;
+        EXPECT_EQ(val, decoded.value());
+    }
+    EXPECT_TRUE(data.empty());
+
+    // Different ones are never the same bytes
+    for (size_t i = 0; i < values.size(); ++i) {
+        for (size_t j = i + 1; j < values.size(); ++j) {
+            EXPECT_NE(encode(values[i]), encode(values[j])) << values[i] << " vs " << values[j];
+        }
+    }
+    EXPECT_EQ(encode(0.0), encode(-0.0));
+    EXPECT_EQ(encode(Set({1, "a", 2.5})), encode(Set({2.5, "a", 1})));
+}
+
+TEST(MemcomparableCodecTest, Corrupt) {
+    // Of each tag with an extra part
+    std::vector<Value> values = {
+        Value(1),
+        Value::kNullBadData,
+        Value(Vertex("v", {Tag("t", {{"p", 1}, {"q", "x"}})})),
+        Value(Edge("a", "b", -1, "e", 3, {{"p", 1.5}})),
+        Value(Path(Vertex("a", {}), {Step(Vertex("b", {}), 1, "e", 0, {{"p", 1}})})),
+        Value(List({1, "a", List({Value()})})),
+        Value(Map({{"k", 1}, {"l", List({2})}})),
+        Value(Set({1, "a"})),
+        Value(DataSet({"a", "b"})),
+    };
+    for (const auto& val : values) {
+        std::string buf;
+        MemcomparableCodec::encode(val, &buf);
+        // Truncated anywhere, in the key or the extra part
+        for (size_t size = 0; size < buf.size(); ++size) {
+            EXPECT_FALSE(MemcomparableCodec::decode(buf.substr(0, size)).ok())
+                << val << " of " << size << " bytes";
+        }
+        // Or with bytes left over
+        EXPECT_FALSE(MemcomparableCodec::decode(buf + '\0').ok()) << val;
+
+        std::string tuple;
+        MemcomparableCodec::encodeTuple(List({val, val}), &tuple);
+        for (size_t size = 0; size < tuple.size(); ++size) {
+            EXPECT_FALSE(MemcomparableCodec::decodeTuple(tuple.substr(0, size)).ok())
+                << val << " of " << size << " bytes";
+        }
+        EXPECT_FALSE(MemcomparableCodec::decodeTuple(tuple + '\0').ok()) << val;
+
+        std::string unordered;
+        MemcomparableCodec::encodeUnordered(val, &unordered);
+        for (size_t size = 0; size < unordered.size(); ++size) {
+            folly::StringPiece data(unordered.data(), size);
+            EXPECT_FALSE(MemcomparableCodec::decodeUnordered(&data).ok())
+                << val << " of " << size << " bytes";
+        }
+    }
+
+    // Not of a NullType
+    std::string buf;
+    MemcomparableCodec::encode(Value::kNullValue, &buf);
+    buf.back() = 0x7F;
+    EXPECT_FALSE(MemcomparableCodec::decode(buf).ok());
+    buf.clear();
+    MemcomparableCodec::encodeUnordered(Value::kNullValue, &buf);
+    buf.back() = 0x7F;
+    folly::StringPiece data(buf);
+    EXPECT_FALSE(MemcomparableCodec::decodeUnordered(&data).ok());
+
+    // A size beyond the data
+    buf.clear();
+    MemcomparableCodec::encodeUnordered(Value(List({1, 2})), &buf);
+    buf[1] = '\xFF';
+    data = buf;
+    EXPECT_FALSE(MemcomparableCodec::decodeUnordered(&data).ok());
+}
+
+}  // namespace algorithm
+}  // namespace nebula
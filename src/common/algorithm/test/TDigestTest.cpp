@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/TDigest.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace nebula {
+namespace algorithm {
+
+TEST(TDigestTest, Quantile) {
+    {
+        TDigest digest;
+        EXPECT_TRUE(std::isnan(digest.quantile(0.5)));
+        digest.add(42);
+        EXPECT_EQ(42, digest.quantile(0));
+        EXPECT_EQ(42, digest.quantile(0.5));
+        EXPECT_EQ(42, digest.quantile(1));
+    }
+    {
+        TDigest digest;
+        std::vector<double> values;
+        for (int i = 0; i < 100000; ++i) {
+            values.emplace_back(i);
+        }
+        std::shuffle(values.begin(), values.end(), std::mt19937(42));
+        for (auto v : values) {
+            digest.add(v);
+        }
+        EXPECT_EQ(100000, digest.count());
+        EXPECT_EQ(0, digest.quantile(0));
+        EXPECT_EQ(99999, digest.quantile(1));
+        for (auto q : {0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+            EXPECT_NEAR(q * 100000, digest.quantile(q), 100000 * 0.01) << q;
+        }
+        // Memory is bounded by the compression
+        EXPECT_LT(digest.memoryUsage(), 16 * 1024);
+    }
+}
+
+TEST(TDigestTest, Merge) {
+    std::vector<TDigest> digests(8);
+    for (int i = 0; i < 80000; ++i) {
+        digests[i % digests.size()].add(i);
+    }
+    TDigest merged;
+    for (const auto& digest : digests) {
+        merged.merge(digest);
+    }
+    EXPECT_EQ(80000, merged.count());
+    for (auto q : {0.01, 0.5, 0.99}) {
+        EXPECT_NEAR(q * 80000, merged.quantile(q), 80000 * 0.01) << q;
+    }
+}
+
+TEST(TDigestTest, Serialize) {
+    TDigest digest(50);
+    for (int i = 0; i < 1000; ++i) {
+        digest.add(i % 100);
+    }
+    auto data = digest.serialize();
+    auto result = TDigest::deserialize(data);
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(digest.count(), result.value().count());
+    EXPECT_EQ(digest.quantile(0.5), result.value().quantile(0.5));
+
+    EXPECT_FALSE(TDigest::deserialize("").ok());
+    EXPECT_FALSE(TDigest::deserialize(folly::StringPiece(data).subpiece(8)).ok());
+}
+
+}  // namespace algorithm
+}  // namespace nebula
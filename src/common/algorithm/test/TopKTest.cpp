@@ -0,0 +1,135 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/algorithm/TopK.h"
+#include <gtest/gtest.h>
+#include "common/datatypes/Date.h"
+
+namespace nebula {
+namespace algorithm {
+
+static std::vector<Row> makeRows(size_t num, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<Row> rows;
+    for (size_t i = 0; i < num; ++i) {
+        Row row;
+        switch (rng() % 20) {
+            case 0:
+                row.values.emplace_back(Value::kNullValue);
+                break;
+            case 1:
+                row.values.emplace_back(static_cast<double>(rng() % 100) + 0.5);
+                break;
+            default:
+                row.values.emplace_back(static_cast<int64_t>(rng() % 100));
+                break;
+        }
+        row.values.emplace_back(folly::stringPrintf("name_%u", rng() % 50));
+        row.values.emplace_back(static_cast<int64_t>(i));
+        rows.emplace_back(std::move(row));
+    }
+    return rows;
+}
+
+// The first k rows by a full stable sort
+static std::vector<Row> sortAndLimit(std::vector<Row> rows,
+                                     const std::vector<TopK::SortKey>& keys,
+                                     size_t k) {
+    TopK cmp(keys, 0);
+    std::stable_sort(rows.begin(), rows.end(), [&cmp] (const Row& a, const Row& b) {
+        return cmp.compare(a, b) < 0;
+    });
+    rows.resize(std::min(k, rows.size()));
+    return rows;
+}
+
+TEST(TopKTest, Compare) {
+    TopK topK({{0, false}}, 10);
+    auto cmp = [&topK] (const Value& a, const Value& b) {
+        return topK.compare(List({a}), List({b}));
+    };
+    EXPECT_EQ(-1, cmp(1, 2));
+    EXPECT_EQ(1, cmp(2.5, 2));
+    EXPECT_EQ(0, cmp(1, 1.0));
+    EXPECT_EQ(0, cmp(1.0, 1.0 + 1e-10));
+    EXPECT_EQ(-1, cmp("a", "b"));
+    EXPECT_EQ(-1, cmp(Date(2021, 1, 1), Date(2021, 1, 2)));
+    EXPECT_EQ(-1, cmp(List({1, 2}), List({1, 3})));
+    // Ordered by type, nulls go last
+    EXPECT_EQ(-1, cmp(Value(), 1));
+    EXPECT_EQ(-1, cmp(true, 1));
+    EXPECT_EQ(-1, cmp(1, "a"));
+    EXPECT_EQ(-1, cmp("a", Value::kNullValue));
+    EXPECT_EQ(0, cmp(Value::kNullValue, Value::kNullBadType));
+
+    TopK desc({{0, true}, {1, false}}, 10);
+    EXPECT_EQ(-1, desc.compare(List({2, "b"}), List({1, "a"})));
+    EXPECT_EQ(-1, desc.compare(List({2, "a"}), List({2, "b"})));
+    EXPECT_EQ(-1, desc.compare(List({Value::kNullValue, "b"}), List({2, "a"})));
+}
+
+TEST(TopKTest, Push) {
+    auto rows = makeRows(10000, 0);
+    std::vector<std::vector<TopK::SortKey>> keysList = {
+        {{0, false}},
+        {{0, true}},
+        {{1, false}, {0, true}},
+    };
+    for (const auto& keys : keysList) {
+        for (size_t k : {0UL, 1UL, 10UL, 100UL, 20000UL}) {
+            TopK topK(keys, k);
+            size_t kept = 0;
+            for (size_t i = 0; i < rows.size(); ++i) {
+                // Both copying and moving
+                if (i % 2 == 0) {
+                    kept += topK.push(rows[i]);
+                } else {
+                    kept += topK.push(Row(rows[i]));
+                }
+            }
+            EXPECT_GE(kept, std::min(k, rows.size()));
+            EXPECT_EQ(std::min(k, rows.size()), topK.size());
+            EXPECT_EQ(sortAndLimit(rows, keys, k), std::move(topK).finish());
+        }
+    }
+}
+
+TEST(TopKTest, PushDataSet) {
+    std::vector<TopK::SortKey> keys = {{1, true}, {0, false}};
+    TopK topK(keys, 50);
+    std::vector<Row> all;
+    for (uint32_t i = 0; i < 10; ++i) {
+        DataSet ds({"a", "b", "c"});
+        ds.rows = makeRows(1000, i);
+        all.insert(all.end(), ds.rows.begin(), ds.rows.end());
+        topK.push(std::move(ds));
+    }
+    EXPECT_EQ(sortAndLimit(all, keys, 50), std::move(topK).finish());
+}
+
+TEST(TopKTest, Merge) {
+    std::vector<TopK::SortKey> keys = {{0, false}, {1, false}};
+    std::vector<Row> all;
+    std::vector<TopK> parts;
+    for (uint32_t i = 0; i < 4; ++i) {
+        auto rows = makeRows(5000, i);
+        parts.emplace_back(keys, 100);
+        for (auto& row : rows) {
+            all.emplace_back(row);
+            parts.back().push(std::move(row));
+        }
+    }
+
+    TopK merged(keys, 100);
+    for (auto& part : parts) {
+        merged.merge(std::move(part));
+        EXPECT_EQ(0, part.size());
+    }
+    EXPECT_EQ(sortAndLimit(all, keys, 100), std::move(merged).finish());
+}
+
+}  // namespace algorithm
+}  // namespace nebula
@@ -0,0 +1,149 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_COWPTR_H_
+#define COMMON_BASE_COWPTR_H_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace nebula {
+
+/**
+ * A copy-on-write pointer, i.e. copies of a CowPtr share the object through a
+ * reference count, and the object is only cloned when modified through a
+ * shared CowPtr.
+ *
+ * The object and the count are in a single allocation, and CowPtr itself is as
+ * small as a raw pointer. The count is atomic, so CowPtrs sharing an object
+ * could be used by different threads, as long as each CowPtr is used by one
+ * thread at a time.
+ *
+ * A reference from mutableRef() is only valid until the CowPtr is copied,
+ * the copy would see the later modifications otherwise.
+ *
+ * T could be incomplete where CowPtr is declared, like std::unique_ptr.
+ */
+template <class T>
+class CowPtr final {
+public:
+    CowPtr() = default;
+
+    template <class... Args>
+    static CowPtr make(Args&&... args) {
+        CowPtr ptr;
+        ptr.block_ = new Block(std::forward<Args>(args)...);
+        return ptr;
+    }
+
+    // Take over the object, which is moved into the shared block
+    explicit CowPtr(std::unique_ptr<T>&& obj) {
+        if (obj != nullptr) {
+            block_ = new Block(std::move(*obj));
+            obj.reset();
+        }
+    }
+
+    CowPtr(const CowPtr& rhs) noexcept : block_(rhs.block_) {
+        if (block_ != nullptr) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowPtr(CowPtr&& rhs) noexcept : block_(rhs.block_) {
+        rhs.block_ = nullptr;
+    }
+
+    CowPtr& operator=(const CowPtr& rhs) noexcept {
+        if (block_ != rhs.block_) {
+            CowPtr copy(rhs);
+            std::swap(block_, copy.block_);
+        }
+        return *this;
+    }
+
+    CowPtr& operator=(CowPtr&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            std::swap(block_, rhs.block_);
+        }
+        return *this;
+    }
+
+    ~CowPtr() {
+        reset();
+    }
+
+    void reset() {
+        if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block_;
+        }
+        block_ = nullptr;
+    }
+
+    const T* get() const {
+        return block_ == nullptr ? nullptr : &block_->obj;
+    }
+
+    const T& operator*() const {
+        return block_->obj;
+    }
+
+    const T* operator->() const {
+        return &block_->obj;
+    }
+
+    explicit operator bool() const {
+        return block_ != nullptr;
+    }
+
+    // Whether the object is not shared with other CowPtrs
+    bool unique() const {
+        return block_ != nullptr && block_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    size_t useCount() const {
+        return block_ == nullptr ? 0 : block_->refs.load(std::memory_order_acquire);
+    }
+
+    // Returns the object to modify, which is cloned first if shared
+    T& mutableRef() {
+        if (!unique()) {
+            auto* copy = new Block(block_->obj);
+            reset();
+            block_ = copy;
+        }
+        return block_->obj;
+    }
+
+    // Moves the object out if not shared, copies it otherwise. The CowPtr is
+    // reset after all.
+    T take() {
+        if (unique()) {
+            T obj = std::move(block_->obj);
+            reset();
+            return obj;
+        }
+        T obj = block_->obj;
+        reset();
+        return obj;
+    }
+
+private:
+    struct Block {
+        template <class... Args>
+        explicit Block(Args&&... args) : obj(std::forward<Args>(args)...) {}
+
+        std::atomic<uint32_t> refs{1};
+        T obj;
+    };
+
+    Block* block_{nullptr};
+};
+
+}  // namespace nebula
+#endif  // COMMON_BASE_COWPTR_H_
@@ -0,0 +1,128 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/StringInterner.h"
+#include "common/base/MurmurHash2.h"
+
+DEFINE_uint32(string_interner_capacity, 1 << 16,
+              "Slots of the process-wide string interner, half of which could be used");
+DEFINE_bool(intern_names, true,
+            "Whether to intern the schema names, i.e. of tags, edges and properties, "
+            "see Symbol");
+
+namespace nebula {
+
+namespace {
+
+struct Entry {
+    Entry(size_t h, folly::StringPiece s) : hash(h), str(s.data(), s.size()) {}
+
+    size_t hash;
+    std::string str;
+};
+
+
+class Table final {
+public:
+    explicit Table(size_t capacity) {
+        capacity_ = 2;
+        while (capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+        slots_ = std::make_unique<std::atomic<Entry*>[]>(capacity_);
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    // Linear probing, the slots are only filled, so the first empty one ends
+    // the lookup
+    const std::string* lookup(folly::StringPiece str, bool insert) {
+        auto hash = MurmurHash2()(str.data(), str.size());
+        auto mask = capacity_ - 1;
+        std::unique_ptr<Entry> created;
+        for (size_t i = hash & mask, probes = 0; probes < capacity_; i = (i + 1) & mask, ++probes) {
+            auto* entry = slots_[i].load(std::memory_order_acquire);
+            if (entry == nullptr) {
+                // Keep at least half of the slots empty for short probes
+                if (!insert || size_.load(std::memory_order_relaxed) >= capacity_ / 2) {
+                    return nullptr;
+                }
+                if (created == nullptr) {
+                    created = std::make_unique<Entry>(hash, str);
+                }
+                if (slots_[i].compare_exchange_strong(entry,
+                                                      created.get(),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire)) {
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    bytes_.fetch_add(sizeof(Entry) + str.size(), std::memory_order_relaxed);
+                    return &created.release()->str;
+                }
+                // Taken by another thread meanwhile, which is `entry' now
+            }
+            if (entry->hash == hash && folly::StringPiece(entry->str) == str) {
+                return &entry->str;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    size_t memoryUsage() const {
+        return capacity_ * sizeof(std::atomic<Entry*>) + bytes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    size_t capacity_;
+    std::unique_ptr<std::atomic<Entry*>[]> slots_;
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> bytes_{0};
+};
+
+
+Table& table() {
+    // Never destroyed, the interned strings are referred until exit
+    static auto* table = new Table(FLAGS_string_interner_capacity);
+    return *table;
+}
+
+}  // namespace
+
+
+// static
+const std::string* StringInterner::intern(folly::StringPiece str) {
+    if (str.size() > kMaxLength) {
+        return nullptr;
+    }
+    return table().lookup(str, true);
+}
+
+
+// static
+const std::string* StringInterner::find(folly::StringPiece str) {
+    if (str.size() > kMaxLength) {
+        return nullptr;
+    }
+    return table().lookup(str, false);
+}
+
+
+// static
+size_t StringInterner::size() {
+    return table().size();
+}
+
+
+// static
+size_t StringInterner::memoryUsage() {
+    return table().memoryUsage();
+}
+
+}  // namespace nebula
@@ -0,0 +1,50 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_STRINGINTERNER_H_
+#define COMMON_BASE_STRINGINTERNER_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+
+/**
+ * A process-wide set of strings, each is kept once, e.g. the names of tags,
+ * edges and properties, which are repeated a lot in the query results.
+ *
+ * An interned string is never freed nor moved, so its address is a stable
+ * handle, and two interned strings are equal iff their addresses are.
+ *
+ * The set is an open addressing hash table of a fixed capacity, see
+ * --string_interner_capacity, which is allocated on the first use. Both lookup
+ * and insertion are lock-free, a slot is claimed by compare-and-swap and never
+ * changes afterwards. Once the table is half full, or for the strings longer
+ * than kMaxLength, intern() returns nullptr, the callers keep their own copies
+ * then.
+ */
+class StringInterner final {
+public:
+    static constexpr size_t kMaxLength = 256;
+
+    // Returns the interned copy of `str', which is added if not yet, or nullptr
+    // if it could not be interned.
+    static const std::string* intern(folly::StringPiece str);
+
+    // Returns nullptr if `str' is not interned
+    static const std::string* find(folly::StringPiece str);
+
+    // The number of interned strings
+    static size_t size();
+
+    // Bytes taken by the table and the interned strings
+    static size_t memoryUsage();
+
+private:
+    StringInterner() = delete;
+};
+
+}  // namespace nebula
+#endif  // COMMON_BASE_STRINGINTERNER_H_
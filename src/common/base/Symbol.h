@@ -0,0 +1,276 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_SYMBOL_H_
+#define COMMON_BASE_SYMBOL_H_
+
+#include "common/base/Base.h"
+#include "common/base/StringInterner.h"
+
+DECLARE_bool(intern_names);
+
+namespace nebula {
+
+/**
+ * A name, e.g. of a tag, an edge or a property, which is a pointer to either
+ * a string interned by StringInterner, or a string owned by the Symbol.
+ *
+ * Only schema names, i.e. the names of tags, edges and properties defined in
+ * meta, are interned, by Symbol::name() when they are decoded. Their number is
+ * bounded by the schemas, so the same name repeated in a large result takes
+ * 8 bytes each instead of a std::string, and copying it is a pointer copy.
+ * Symbols built implicitly from strings are owned, so user data never fills
+ * the fixed interner table; the keys of a Map are plain std::strings anyway.
+ *
+ * Symbol::name() interns if --intern_names is on, the table is not full and the
+ * name is not too long. Symbol::intern() and Symbol::owned() choose regardless
+ * of the flag.
+ *
+ * It converts to `const std::string&', so mostly it could be used as one.
+ */
+class Symbol final {
+public:
+    Symbol() noexcept : bits_(reinterpret_cast<uintptr_t>(&emptyString())) {}
+
+    Symbol(const std::string& str) {          // NOLINT
+        init(str, false);
+    }
+
+    Symbol(std::string&& str) {               // NOLINT
+        init(std::move(str), false);
+    }
+
+    Symbol(const char* str) {                 // NOLINT
+        init(folly::StringPiece(str), false);
+    }
+
+    Symbol(folly::StringPiece str) {          // NOLINT
+        init(str, false);
+    }
+
+    Symbol(const Symbol& rhs) : bits_(rhs.bits_) {
+        if (!rhs.interned()) {
+            setOwned(rhs.str());
+        }
+    }
+
+    Symbol(Symbol&& rhs) noexcept : bits_(rhs.bits_) {
+        rhs.bits_ = reinterpret_cast<uintptr_t>(&emptyString());
+    }
+
+    Symbol& operator=(const Symbol& rhs) {
+        if (this != &rhs) {
+            Symbol copy(rhs);
+            std::swap(bits_, copy.bits_);
+        }
+        return *this;
+    }
+
+    Symbol& operator=(Symbol&& rhs) noexcept {
+        if (this != &rhs) {
+            std::swap(bits_, rhs.bits_);
+        }
+        return *this;
+    }
+
+    ~Symbol() {
+        if (!interned()) {
+            delete ptr();
+        }
+    }
+
+    // A schema name, interned if possible and --intern_names is on
+    static Symbol name(folly::StringPiece str) {
+        Symbol sym;
+        sym.init(str, FLAGS_intern_names);
+        return sym;
+    }
+
+    static Symbol name(std::string&& str) {
+        Symbol sym;
+        sym.init(std::move(str), FLAGS_intern_names);
+        return sym;
+    }
+
+    static Symbol name(const char* str) {
+        return name(folly::StringPiece(str));
+    }
+
+    // Interned if possible, regardless of --intern_names
+    static Symbol intern(folly::StringPiece str) {
+        Symbol sym;
+        sym.init(str, true);
+        return sym;
+    }
+
+    // Never interned
+    static Symbol owned(std::string str) {
+        Symbol sym;
+        if (!str.empty()) {
+            sym.setOwned(std::move(str));
+        }
+        return sym;
+    }
+
+    // The empty Symbol counts as interned
+    bool interned() const {
+        return (bits_ & kOwned) == 0;
+    }
+
+    const std::string& str() const {
+        return *ptr();
+    }
+
+    operator const std::string&() const {     // NOLINT
+        return str();
+    }
+
+    const char* data() const {
+        return str().data();
+    }
+
+    const char* c_str() const {
+        return str().c_str();
+    }
+
+    size_t size() const {
+        return str().size();
+    }
+
+    bool empty() const {
+        return str().empty();
+    }
+
+    void clear() {
+        *this = Symbol();
+    }
+
+    // Bytes allocated for this Symbol, nothing if interned
+    size_t heapBytes() const {
+        if (interned()) {
+            return 0;
+        }
+        auto* s = ptr();
+        auto* inlined = reinterpret_cast<const char*>(s);
+        bool local = s->data() >= inlined && s->data() < inlined + sizeof(std::string);
+        return sizeof(std::string) + (local ? 0 : s->capacity() + 1);
+    }
+
+    bool operator==(const Symbol& rhs) const {
+        if (bits_ == rhs.bits_) {
+            return true;
+        }
+        // Equal interned strings are the same one
+        if (interned() && rhs.interned()) {
+            return false;
+        }
+        return str() == rhs.str();
+    }
+
+    bool operator!=(const Symbol& rhs) const {
+        return !(*this == rhs);
+    }
+
+    bool operator<(const Symbol& rhs) const {
+        return str() < rhs.str();
+    }
+
+private:
+    static constexpr uintptr_t kOwned = 1;
+
+    // Not from the interner, so it needs no lookup, and the interned strings
+    // are never empty
+    static const std::string& emptyString() {
+        static const auto* empty = new std::string();
+        return *empty;
+    }
+
+    const std::string* ptr() const {
+        return reinterpret_cast<const std::string*>(bits_ & ~kOwned);
+    }
+
+    bool tryIntern(folly::StringPiece str) {
+        auto* interned = StringInterner::intern(str);
+        if (interned == nullptr) {
+            return false;
+        }
+        bits_ = reinterpret_cast<uintptr_t>(interned);
+        return true;
+    }
+
+    void init(folly::StringPiece str, bool intern) {
+        if (str.empty()) {
+            bits_ = reinterpret_cast<uintptr_t>(&emptyString());
+        } else if (!(intern && tryIntern(str))) {
+            setOwned(str.str());
+        }
+    }
+
+    void init(std::string&& str, bool intern) {
+        if (str.empty()) {
+            bits_ = reinterpret_cast<uintptr_t>(&emptyString());
+        } else if (!(intern && tryIntern(str))) {
+            setOwned(std::move(str));
+        }
+    }
+
+    void setOwned(std::string str) {
+        bits_ = reinterpret_cast<uintptr_t>(new std::string(std::move(str))) | kOwned;
+    }
+
+    uintptr_t bits_;
+};
+
+inline bool operator==(const Symbol& lhs, const std::string& rhs) {
+    return lhs.str() == rhs;
+}
+
+inline bool operator==(const std::string& lhs, const Symbol& rhs) {
+    return lhs == rhs.str();
+}
+
+inline bool operator==(const Symbol& lhs, const char* rhs) {
+    return lhs.str() == rhs;
+}
+
+inline bool operator==(const char* lhs, const Symbol& rhs) {
+    return lhs == rhs.str();
+}
+
+inline bool operator!=(const Symbol& lhs, const std::string& rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator!=(const std::string& lhs, const Symbol& rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator!=(const Symbol& lhs, const char* rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator!=(const char* lhs, const Symbol& rhs) {
+    return !(lhs == rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Symbol& sym) {
+    return os << sym.str();
+}
+
+}  // namespace nebula
+
+
+namespace std {
+
+template<>
+struct hash<nebula::Symbol> {
+    std::size_t operator()(const nebula::Symbol& sym) const noexcept {
+        return hash<std::string>()(sym.str());
+    }
+};
+
+}  // namespace std
+#endif  // COMMON_BASE_SYMBOL_H_
@@ -0,0 +1,85 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/CowPtr.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+
+TEST(CowPtrTest, Share) {
+    auto a = CowPtr<std::string>::make("hello");
+    EXPECT_TRUE(a.unique());
+    EXPECT_EQ("hello", *a);
+
+    auto b = a;
+    EXPECT_EQ(2, a.useCount());
+    EXPECT_EQ(a.get(), b.get());
+
+    // Cloned on modification
+    b.mutableRef().append(" world");
+    EXPECT_EQ("hello", *a);
+    EXPECT_EQ("hello world", *b);
+    EXPECT_TRUE(a.unique());
+    EXPECT_TRUE(b.unique());
+
+    // Not cloned if not shared
+    auto* ptr = b.get();
+    b.mutableRef().append("!");
+    EXPECT_EQ(ptr, b.get());
+
+    CowPtr<std::string> c;
+    EXPECT_FALSE(c);
+    c = a;
+    EXPECT_EQ(2, a.useCount());
+    c = std::move(b);
+    EXPECT_EQ(1, a.useCount());
+    EXPECT_EQ("hello world!", *c);
+    EXPECT_FALSE(b);
+}
+
+TEST(CowPtrTest, Take) {
+    auto a = CowPtr<std::vector<int>>::make(std::vector<int>{1, 2, 3});
+    auto b = a;
+    // Copied since shared
+    auto v = b.take();
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), v);
+    EXPECT_FALSE(b);
+    EXPECT_EQ(3, a->size());
+    // Moved
+    v = a.take();
+    EXPECT_EQ(3, v.size());
+    EXPECT_FALSE(a);
+
+    CowPtr<std::vector<int>> u(std::make_unique<std::vector<int>>(2, 5));
+    EXPECT_EQ(std::vector<int>({5, 5}), *u);
+}
+
+TEST(CowPtrTest, Threads) {
+    auto a = CowPtr<std::string>::make("shared");
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([a] () mutable {
+            for (int j = 0; j < 10000; ++j) {
+                auto copy = a;
+                if (j % 100 == 0) {
+                    copy.mutableRef().push_back('!');
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(a.unique());
+    EXPECT_EQ("shared", *a);
+}
+
+}  // namespace nebula
@@ -0,0 +1,120 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Symbol.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+
+TEST(StringInternerTest, Intern) {
+    auto* like = StringInterner::intern("like");
+    ASSERT_NE(nullptr, like);
+    EXPECT_EQ("like", *like);
+    EXPECT_EQ(like, StringInterner::intern(std::string("like")));
+    EXPECT_EQ(like, StringInterner::find("like"));
+    EXPECT_NE(like, StringInterner::intern("serve"));
+    EXPECT_EQ(nullptr, StringInterner::find("not_interned"));
+
+    std::string tooLong(StringInterner::kMaxLength + 1, 'a');
+    EXPECT_EQ(nullptr, StringInterner::intern(tooLong));
+}
+
+TEST(StringInternerTest, Concurrent) {
+    constexpr size_t kThreads = 8;
+    constexpr size_t kNames = 1000;
+    std::vector<std::vector<const std::string*>> interned(kThreads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t, &interned] () {
+            for (size_t i = 0; i < kNames; ++i) {
+                interned[t].emplace_back(
+                    StringInterner::intern(folly::stringPrintf("concurrent_%lu", i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < kNames; ++i) {
+        ASSERT_NE(nullptr, interned[0][i]);
+        EXPECT_EQ(folly::stringPrintf("concurrent_%lu", i), *interned[0][i]);
+        for (size_t t = 1; t < kThreads; ++t) {
+            EXPECT_EQ(interned[0][i], interned[t][i]);
+        }
+    }
+}
+
+TEST(SymbolTest, Basic) {
+    Symbol empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.interned());
+    EXPECT_EQ(empty, Symbol(""));
+
+    auto like = Symbol::name("like");
+    EXPECT_TRUE(like.interned());
+    EXPECT_EQ("like", like);
+    EXPECT_EQ(std::string("like"), like);
+    EXPECT_EQ(4, like.size());
+    EXPECT_EQ(0, like.heapBytes());
+    // The same interned string
+    EXPECT_EQ(like.data(), Symbol::name(std::string("like")).data());
+    EXPECT_EQ(like.data(), Symbol::name(folly::StringPiece("like")).data());
+
+    auto owned = Symbol::owned("like");
+    EXPECT_FALSE(owned.interned());
+    EXPECT_NE(like.data(), owned.data());
+    EXPECT_EQ(like, owned);
+    EXPECT_LT(0, owned.heapBytes());
+    EXPECT_NE(like, Symbol::owned("serve"));
+    EXPECT_TRUE(Symbol("a") < Symbol::owned("b"));
+
+    // Copies of an owned Symbol own their strings as well
+    auto copy = owned;
+    EXPECT_FALSE(copy.interned());
+    EXPECT_NE(owned.data(), copy.data());
+    EXPECT_EQ(owned, copy);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(owned, moved);
+    EXPECT_TRUE(copy.empty());    // NOLINT
+
+    const std::string& str = moved;
+    EXPECT_EQ("like", str);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(SymbolTest, Flag) {
+    FLAGS_intern_names = false;
+    auto owned = Symbol::name("like");
+    EXPECT_FALSE(owned.interned());
+    EXPECT_TRUE(Symbol::intern("like").interned());
+
+    FLAGS_intern_names = true;
+    EXPECT_TRUE(Symbol::name("like").interned());
+    EXPECT_EQ(owned, Symbol::name("like"));
+}
+
+TEST(SymbolTest, NotSchemaName) {
+    // Built implicitly, e.g. the keys of a Map, which are never interned
+    auto size = StringInterner::size();
+    for (const auto& sym : {Symbol("user_key"),
+                            Symbol(std::string("user_key")),
+                            Symbol(folly::StringPiece("user_key"))}) {
+        EXPECT_FALSE(sym.interned());
+        EXPECT_EQ("user_key", sym);
+    }
+    EXPECT_EQ(nullptr, StringInterner::find("user_key"));
+    EXPECT_EQ(size, StringInterner::size());
+    EXPECT_EQ(Symbol("like"), Symbol::name("like"));
+}
+
+}  // namespace nebula
@@ -603,6 +603,7 @@ void MetaClient::getResponse(Request req,
                    this] (folly::Try<RpcResponse>&& t) mutable {
             // exception occurred during RPC
             if (t.hasException()) {
+                clientsMan_->onFailure(host, t.exception());
                 if (toLeader) {
                     updateLeader();
                 } else {
@@ -3168,7 +3169,7 @@ void MetaClient::updateGflagsValue(const cpp2::ConfigItem& item) {
 }
 
 
-void MetaClient::updateNestedGflags(const std::unordered_map<std::string, Value> &nameValues) {
+void MetaClient::updateNestedGflags(const MapKvs &nameValues) {
     std::unordered_map<std::string, std::string> optionMap;
     for (const auto &value : nameValues) {
         optionMap.emplace(value.first, value.second.toString());
@@ -15,6 +15,7 @@
 #include "common/interface/gen-cpp2/meta_types.h"
 #include "common/base/Status.h"
 #include "common/base/StatusOr.h"
+#include "common/datatypes/PropMap.h"
 #include "common/meta/Common.h"
 #include "common/thread/GenericWorker.h"
 #include "common/thrift/ThriftClientManager.h"
@@ -24,6 +25,10 @@
 DECLARE_int32(meta_client_retry_times);
 
 namespace nebula {
+namespace storage {
+class StorageClientTest;
+}  // namespace storage
+
 namespace meta {
 
 using PartsAlloc = std::unordered_map<PartitionID, std::vector<HostAddr>>;
@@ -175,6 +180,8 @@ class MetaClient {
     FRIEND_TEST(MetaClientTest, RetryOnceTest);
     FRIEND_TEST(MetaClientTest, RetryUntilLimitTest);
     FRIEND_TEST(MetaClientTest, RocksdbOptionsTest);
+    // To mock the parts and leaders of a space
+    friend class storage::StorageClientTest;
 
 public:
     MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -648,7 +655,7 @@ protected:
 
     bool registerCfg();
     void updateGflagsValue(const cpp2::ConfigItem& item);
-    void updateNestedGflags(const std::unordered_map<std::string, Value> &nameValues);
+    void updateNestedGflags(const MapKvs &nameValues);
 
 
     bool loadSchemas(GraphSpaceID spaceId,
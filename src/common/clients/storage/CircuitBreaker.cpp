@@ -0,0 +1,154 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/clients/storage/CircuitBreaker.h"
+#include "common/time/WallClock.h"
+
+DEFINE_bool(storage_client_circuit_breaker, true,
+            "Whether to fail fast on storage hosts which keep failing");
+DEFINE_int32(storage_client_circuit_failure_threshold, 5,
+             "Number of consecutive rpc failures to open the circuit of a storage host");
+DEFINE_int32(storage_client_circuit_open_ms, 5000,
+             "Milliseconds to fail fast before probing an opened storage host again");
+
+namespace nebula {
+namespace storage {
+
+// static
+CircuitBreaker& CircuitBreaker::instance() {
+    static CircuitBreaker breaker;
+    return breaker;
+}
+
+
+CircuitBreaker::CircuitBreaker() {
+    openedCounter_ = stats::StatsManager::registerStats("storage_circuit_opened", "rate, sum");
+    fastFailCounter_ = stats::StatsManager::registerStats("storage_circuit_fast_fail",
+                                                          "rate, sum");
+    scoreHisto_ = stats::StatsManager::registerHisto("storage_host_health_score",
+                                                     1, 0, kMaxScore, "avg, p1, p5, p50");
+}
+
+
+bool CircuitBreaker::allowRequest(const HostAddr& host) {
+    if (!FLAGS_storage_client_circuit_breaker) {
+        return true;
+    }
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = hosts_.find(host);
+    if (it == hosts_.end()) {
+        return true;
+    }
+    auto& hs = it->second;
+    switch (hs.state) {
+        case State::CLOSED:
+            return true;
+        case State::OPEN:
+            if (nowInMs() - hs.openedAtMs < FLAGS_storage_client_circuit_open_ms) {
+                break;
+            }
+            VLOG(1) << "Probing storage host " << host;
+            hs.state = State::HALF_OPEN;
+            hs.probing = true;
+            return true;
+        case State::HALF_OPEN:
+            if (!hs.probing) {
+                hs.probing = true;
+                return true;
+            }
+            break;
+    }
+    stats::StatsManager::addValue(fastFailCounter_);
+    return false;
+}
+
+
+void CircuitBreaker::onSuccess(const HostAddr& host) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto& hs = hosts_[host];
+    if (hs.state != State::CLOSED) {
+        LOG(INFO) << "Storage host " << host << " recovered, close the circuit";
+    }
+    hs.state = State::CLOSED;
+    hs.consecutiveFailures = 0;
+    hs.probing = false;
+    updateScore(hs, true);
+}
+
+
+void CircuitBreaker::onFailure(const HostAddr& host) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto& hs = hosts_[host];
+    ++hs.consecutiveFailures;
+    hs.probing = false;
+    updateScore(hs, false);
+    if (hs.state == State::HALF_OPEN ||
+        (hs.state == State::CLOSED &&
+         hs.consecutiveFailures >= FLAGS_storage_client_circuit_failure_threshold)) {
+        LOG(WARNING) << "Storage host " << host << " failed " << hs.consecutiveFailures
+                     << " times in a row, open the circuit";
+        hs.state = State::OPEN;
+        hs.openedAtMs = nowInMs();
+        stats::StatsManager::addValue(openedCounter_);
+    }
+}
+
+
+CircuitBreaker::State CircuitBreaker::state(const HostAddr& host) const {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = hosts_.find(host);
+    return it == hosts_.end() ? State::CLOSED : it->second.state;
+}
+
+
+bool CircuitBreaker::isOpen(const HostAddr& host) const {
+    if (!FLAGS_storage_client_circuit_breaker) {
+        return false;
+    }
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = hosts_.find(host);
+    return it != hosts_.end() &&
+           it->second.state == State::OPEN &&
+           nowInMs() - it->second.openedAtMs < FLAGS_storage_client_circuit_open_ms;
+}
+
+
+int32_t CircuitBreaker::healthScore(const HostAddr& host) const {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = hosts_.find(host);
+    return it == hosts_.end() ? kMaxScore : it->second.score;
+}
+
+
+std::unordered_map<HostAddr, int32_t> CircuitBreaker::healthScores() const {
+    std::unordered_map<HostAddr, int32_t> scores;
+    std::lock_guard<std::mutex> g(lock_);
+    for (const auto& host : hosts_) {
+        scores.emplace(host.first, host.second.score);
+    }
+    return scores;
+}
+
+
+void CircuitBreaker::reset() {
+    std::lock_guard<std::mutex> g(lock_);
+    hosts_.clear();
+}
+
+
+void CircuitBreaker::updateScore(HostState& hs, bool succeeded) {
+    // Each outcome weighs 1/8, rounded towards the outcome
+    hs.score = succeeded ? (hs.score * 7 + kMaxScore + 7) / 8 : hs.score * 7 / 8;
+    stats::StatsManager::addValue(scoreHisto_, hs.score);
+}
+
+
+int64_t CircuitBreaker::nowInMs() const {
+    return fakeNowMs_ > 0 ? fakeNowMs_ : time::WallClock::fastNowInMilliSec();
+}
+
+}   // namespace storage
+}   // namespace nebula
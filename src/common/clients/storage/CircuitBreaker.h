@@ -0,0 +1,100 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CLIENTS_STORAGE_CIRCUITBREAKER_H_
+#define COMMON_CLIENTS_STORAGE_CIRCUITBREAKER_H_
+
+#include "common/base/Base.h"
+#include <gtest/gtest_prod.h>
+#include "common/datatypes/HostAddr.h"
+#include "common/stats/StatsManager.h"
+
+DECLARE_bool(storage_client_circuit_breaker);
+DECLARE_int32(storage_client_circuit_failure_threshold);
+DECLARE_int32(storage_client_circuit_open_ms);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Per storage host health, fed by the outcome of every rpc sent to the host.
+ *
+ *   CLOSED     -- Requests go through. After `failure_threshold' consecutive rpc
+ *                 failures, the circuit is opened.
+ *   OPEN       -- Requests fail fast without touching the network, until `open_ms'
+ *                 has elapsed.
+ *   HALF_OPEN  -- A single probe request is let through. It closes the circuit on
+ *                 success, or opens it again on failure.
+ *
+ * Besides the state, each host keeps a health score in [0, 100], which is an
+ * exponentially weighted moving average of rpc outcomes.
+ *
+ * The breaker is shared by all storage clients of the process.
+ */
+class CircuitBreaker final {
+    FRIEND_TEST(CircuitBreakerTest, StateTransition);
+
+public:
+    enum class State : int8_t {
+        CLOSED      = 0,
+        OPEN        = 1,
+        HALF_OPEN   = 2,
+    };
+
+    static constexpr int32_t kMaxScore = 100;
+
+    static CircuitBreaker& instance();
+
+    CircuitBreaker();
+
+    // Returns false if requests to the host should fail fast
+    bool allowRequest(const HostAddr& host);
+
+    void onSuccess(const HostAddr& host);
+
+    void onFailure(const HostAddr& host);
+
+    State state(const HostAddr& host) const;
+
+    // Whether the host is OPEN and still within the fail-fast period
+    bool isOpen(const HostAddr& host) const;
+
+    // Hosts never seen are considered healthy
+    int32_t healthScore(const HostAddr& host) const;
+
+    std::unordered_map<HostAddr, int32_t> healthScores() const;
+
+    void reset();
+
+private:
+    struct HostState {
+        State state{State::CLOSED};
+        int32_t consecutiveFailures{0};
+        int32_t score{kMaxScore};
+        int64_t openedAtMs{0};
+        // Whether the probe request of HALF_OPEN is in flight
+        bool probing{false};
+    };
+
+    void updateScore(HostState& hs, bool succeeded);
+
+    // Only used in test to fake the clock
+    int64_t nowInMs() const;
+
+private:
+    mutable std::mutex lock_;
+    std::unordered_map<HostAddr, HostState> hosts_;
+    int64_t fakeNowMs_{0};
+
+    stats::CounterId openedCounter_;
+    stats::CounterId fastFailCounter_;
+    stats::CounterId scoreHisto_;
+};
+
+}   // namespace storage
+}   // namespace nebula
+
+#endif  // COMMON_CLIENTS_STORAGE_CIRCUITBREAKER_H_
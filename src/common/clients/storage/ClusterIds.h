@@ -0,0 +1,80 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CLIENTS_STORAGE_CLUSTERIDS_H_
+#define COMMON_CLIENTS_STORAGE_CLUSTERIDS_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/HostAddr.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace storage {
+
+// host_addr => (partition -> [ids that belong to the shard])
+template<class T>
+using HostPartIds = std::unordered_map<
+    HostAddr,
+    std::unordered_map<
+        PartitionID,
+        std::vector<T>
+    >
+>;
+
+/**
+ * Cluster the given ids into the hosts they belong to, in two passes:
+ *   1. Compute the partition of every id, counting the ids of each partition
+ *   2. Resolve the host of each non-empty partition once, then move (or copy,
+ *      when `ids' is an lvalue) every id into its pre-reserved bucket
+ *
+ * `getPart' maps an id to a partition in [1, numParts], `getHost' maps a
+ * partition to a StatusOr<HostAddr>.
+ */
+template<class Container, class GetPartFunc, class GetHostFunc>
+StatusOr<HostPartIds<typename std::decay_t<Container>::value_type>>
+clusterIds(Container&& ids, int32_t numParts, GetPartFunc&& getPart, GetHostFunc&& getHost) {
+    using T = typename std::decay_t<Container>::value_type;
+    // Only steal the ids when the caller gives up the container
+    using Ref = std::conditional_t<std::is_lvalue_reference<Container>::value, const T&, T&&>;
+
+    std::vector<PartitionID> parts;
+    parts.reserve(ids.size());
+    // Index 0 is unused, partition id starts from 1
+    std::vector<size_t> partSizes(numParts + 1, 0);
+    for (const auto& id : ids) {
+        auto part = getPart(id);
+        DCHECK(part > 0 && part <= numParts);
+        parts.emplace_back(part);
+        ++partSizes[part];
+    }
+
+    HostPartIds<T> clusters;
+    std::vector<std::vector<T>*> buckets(numParts + 1, nullptr);
+    for (PartitionID part = 1; part <= numParts; ++part) {
+        if (partSizes[part] == 0) {
+            continue;
+        }
+        auto host = getHost(part);
+        if (!host.ok()) {
+            return host.status();
+        }
+        auto& bucket = clusters[std::move(host).value()][part];
+        bucket.reserve(partSizes[part]);
+        buckets[part] = &bucket;
+    }
+
+    size_t i = 0;
+    for (auto& id : ids) {
+        buckets[parts[i++]]->emplace_back(static_cast<Ref>(id));
+    }
+    return clusters;
+}
+
+}   // namespace storage
+}   // namespace nebula
+
+#endif  // COMMON_CLIENTS_STORAGE_CLUSTERIDS_H_
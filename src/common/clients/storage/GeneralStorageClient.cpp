@@ -15,11 +15,11 @@ GeneralStorageClient::get(GraphSpaceID space,
                           std::vector<std::string>&& keys,
                           bool returnPartly,
                           folly::EventBase* evb) {
-    auto status = clusterIdsToHosts(space,
-                                    std::move(keys),
-                                    [] (const std::string& v) -> const std::string& {
+    auto getKey = [] (const std::string& v) -> const std::string& {
         return v;
-    });
+    };
+    // A read, which could be served by a follower when the leader is unhealthy
+    auto status = clusterIdsToHosts(space, std::move(keys), getKey, true);
 
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::KVGetResponse>>(
@@ -112,5 +112,86 @@ GeneralStorageClient::remove(GraphSpaceID space,
         });
 }
 
+
+folly::SemiFuture<StorageRpcResponse<cpp2::KVGetResponse>>
+GeneralStorageClient::multiGet(GraphSpaceID space,
+                               std::vector<std::string>&& keys,
+                               size_t maxConcurrency,
+                               bool returnPartly,
+                               folly::EventBase* evb) {
+    auto getKey = [] (const std::string& v) -> const std::string& {
+        return v;
+    };
+    // A read, which could be served by a follower when the leader is unhealthy
+    auto status = clusterIdsToHosts(space, std::move(keys), getKey, true);
+
+    if (!status.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::KVGetResponse>>(
+            std::runtime_error(status.status().toString()));
+    }
+
+    std::vector<std::pair<HostAddr, cpp2::KVGetRequest>> requests;
+    for (auto& c : status.value()) {
+        for (auto& part : c.second) {
+            cpp2::KVGetRequest req;
+            req.set_space_id(space);
+            req.set_return_partly(returnPartly);
+            (*req.parts_ref())[part.first] = std::move(part.second);
+            requests.emplace_back(c.first, std::move(req));
+        }
+    }
+
+    std::vector<PartitionID> parts;
+    parts.reserve(requests.size());
+    for (const auto& req : requests) {
+        parts.emplace_back(req.second.get_parts().begin()->first);
+    }
+    auto futures = folly::window(
+        std::move(requests),
+        [this, evb] (std::pair<HostAddr, cpp2::KVGetRequest> req) {
+            return getResponse(
+                evb,
+                std::move(req),
+                [] (cpp2::GeneralStorageServiceAsyncClient* client,
+                    const cpp2::KVGetRequest& r) {
+                    return client->future_get(r);
+                });
+        },
+        std::max<size_t>(maxConcurrency, 1));
+
+    return folly::collectAll(std::move(futures))
+        .deferValue([parts = std::move(parts)] (auto&& tries) {
+            StorageRpcResponse<cpp2::KVGetResponse> rpcResp(tries.size());
+            for (size_t i = 0; i < tries.size(); i++) {
+                auto& t = tries[i];
+                if (t.hasException() || !t.value().ok()) {
+                    rpcResp.emplaceFailedPart(parts[i], nebula::cpp2::ErrorCode::E_RPC_FAILURE);
+                    rpcResp.markFailure();
+                    continue;
+                }
+                auto resp = std::move(t.value()).value();
+                auto& failedParts = resp.get_result().get_failed_parts();
+                if (!failedParts.empty()) {
+                    for (auto& code : failedParts) {
+                        rpcResp.emplaceFailedPart(code.get_part_id(), code.get_code());
+                    }
+                    rpcResp.markFailure();
+                }
+                rpcResp.addResponse(std::move(resp));
+            }
+            return rpcResp;
+        });
+}
+
+
+StatusOr<std::unique_ptr<KVBatchWriter>>
+GeneralStorageClient::batchWriter(GraphSpaceID space, KVBatchWriter::Options options) {
+    auto numParts = metaClient_->partsNum(space);
+    if (!numParts.ok()) {
+        return Status::Error("Space not found, spaceid: %d", space);
+    }
+    return std::make_unique<KVBatchWriter>(this, space, numParts.value(), std::move(options));
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -12,6 +12,7 @@
 #include "common/interface/gen-cpp2/GeneralStorageServiceAsyncClient.h"
 #include "common/datatypes/KeyValue.h"
 #include "common/clients/storage/StorageClientBase.h"
+#include "common/clients/storage/KVBatchWriter.h"
 #include "common/clients/meta/MetaClient.h"
 
 namespace nebula {
@@ -25,6 +26,7 @@ namespace storage {
 class GeneralStorageClient
         : public StorageClientBase<cpp2::GeneralStorageServiceAsyncClient> {
     using Parent = StorageClientBase<cpp2::GeneralStorageServiceAsyncClient>;
+    friend class KVBatchWriter;
 
 public:
     GeneralStorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
@@ -47,6 +49,20 @@ public:
         GraphSpaceID space,
         std::vector<std::string> keys,
         folly::EventBase* evb = nullptr);
+
+    // Same as get(), but sends one request per partition, with at most
+    // `maxConcurrency' requests in flight
+    folly::SemiFuture<StorageRpcResponse<cpp2::KVGetResponse>> multiGet(
+        GraphSpaceID space,
+        std::vector<std::string>&& keys,
+        size_t maxConcurrency,
+        bool returnPartly = false,
+        folly::EventBase* evb = nullptr);
+
+    // Creates a buffered writer for bulk puts and removes, see KVBatchWriter
+    StatusOr<std::unique_ptr<KVBatchWriter>> batchWriter(
+        GraphSpaceID space,
+        KVBatchWriter::Options options = KVBatchWriter::Options());
 };
 
 }  // namespace storage
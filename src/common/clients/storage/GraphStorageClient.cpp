@@ -32,7 +32,7 @@ GraphStorageClient::getNeighbors(GraphSpaceID space,
             std::runtime_error(cbStatus.status().toString()));
     }
 
-    auto status = clusterIdsToHosts(space, vertices, std::move(cbStatus).value());
+    auto status = clusterIdsToHosts(space, vertices, std::move(cbStatus).value(), true);
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
             std::runtime_error(status.status().toString()));
@@ -178,7 +178,7 @@ GraphStorageClient::getProps(GraphSpaceID space,
             std::runtime_error(cbStatus.status().toString()));
     }
 
-    auto status = clusterIdsToHosts(space, input.rows, std::move(cbStatus).value());
+    auto status = clusterIdsToHosts(space, input.rows, std::move(cbStatus).value(), true);
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::GetPropResponse>>(
             std::runtime_error(status.status().toString()));
@@ -475,7 +475,7 @@ GraphStorageClient::lookupIndex(GraphSpaceID space,
                                 int32_t tagOrEdge,
                                 const std::vector<std::string>& returnCols,
                                 folly::EventBase *evb) {
-    auto status = getHostParts(space);
+    auto status = getHostParts(space, true);
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::LookupIndexResp>>(
             std::runtime_error(status.status().toString()));
@@ -511,7 +511,7 @@ GraphStorageClient::lookupAndTraverse(GraphSpaceID space,
                                       cpp2::IndexSpec indexSpec,
                                       cpp2::TraverseSpec traverseSpec,
                                       folly::EventBase* evb) {
-    auto status = getHostParts(space);
+    auto status = getHostParts(space, true);
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
             std::runtime_error(status.status().toString()));
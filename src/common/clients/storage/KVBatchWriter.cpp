@@ -0,0 +1,320 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/io/async/EventBaseManager.h>
+#include "common/clients/storage/KVBatchWriter.h"
+#include "common/clients/storage/GeneralStorageClient.h"
+#include "common/time/WallClock.h"
+
+namespace nebula {
+namespace storage {
+
+KVBatchWriter::KVBatchWriter(GeneralStorageClient* client,
+                             GraphSpaceID space,
+                             int32_t numParts,
+                             Options options)
+        : client_(client)
+        , space_(space)
+        , numParts_(numParts)
+        , options_(std::move(options)) {
+    CHECK_NOTNULL(client_);
+    CHECK_GT(options_.maxOutstandingBatches, 0);
+    // Index 0 is unused, partition id starts from 1
+    leaders_.resize(numParts_ + 1);
+    if (options_.flushIntervalMs > 0) {
+        flusher_ = std::make_unique<thread::GenericWorker>();
+        CHECK(flusher_->start("kv-batch-flusher"));
+        flusher_->addRepeatTask(options_.flushIntervalMs, &KVBatchWriter::flushExpired, this);
+    }
+}
+
+
+KVBatchWriter::~KVBatchWriter() {
+    if (flusher_ != nullptr) {
+        flusher_->stop();
+        flusher_->wait();
+    }
+    DCHECK(folly::EventBaseManager::get()->getExistingEventBase() == nullptr)
+        << "Don't destroy KVBatchWriter in an IO thread";
+    std::unique_lock<std::mutex> lock(lock_);
+    flushLocked(lock);
+    // Not only the flush waiters are fulfilled, but also no callback is running
+    cond_.wait(lock, [this] { return flushed(); });
+}
+
+
+void KVBatchWriter::put(KeyValue kv) {
+    DCHECK(folly::EventBaseManager::get()->getExistingEventBase() == nullptr)
+        << "Don't call KVBatchWriter::put() in an IO thread";
+    std::unique_lock<std::mutex> lock(lock_);
+    PartitionID part;
+    auto* buffer = prepare(lock, kv.key, part);
+    if (buffer == nullptr) {
+        return;
+    }
+    buffer->numBytes += kv.key.size() + kv.value.size();
+    buffer->puts[part].emplace_back(std::move(kv));
+}
+
+
+void KVBatchWriter::remove(std::string key) {
+    DCHECK(folly::EventBaseManager::get()->getExistingEventBase() == nullptr)
+        << "Don't call KVBatchWriter::remove() in an IO thread";
+    std::unique_lock<std::mutex> lock(lock_);
+    PartitionID part;
+    auto* buffer = prepare(lock, key, part);
+    if (buffer == nullptr) {
+        return;
+    }
+    buffer->numBytes += key.size();
+    buffer->removes[part].emplace_back(std::move(key));
+}
+
+
+folly::SemiFuture<folly::Unit> KVBatchWriter::flush() {
+    std::unique_lock<std::mutex> lock(lock_);
+    flushLocked(lock);
+    if (flushed()) {
+        return folly::makeSemiFuture();
+    }
+    flushWaiters_.emplace_back();
+    return flushWaiters_.back().getSemiFuture();
+}
+
+
+void KVBatchWriter::flushLocked(std::unique_lock<std::mutex>& lock) {
+    std::vector<HostAddr> hosts;
+    for (const auto& buffer : buffers_) {
+        if (buffer.second.numKeys > 0) {
+            hosts.emplace_back(buffer.first);
+        }
+    }
+    for (const auto& host : hosts) {
+        if (buffers_[host].outstanding < options_.maxOutstandingBatches) {
+            sendLocked(lock, host);
+        } else {
+            // Sent in onBatchDone()
+            flushPending_.emplace(host);
+        }
+    }
+}
+
+
+size_t KVBatchWriter::numSucceeded() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return succeeded_;
+}
+
+
+size_t KVBatchWriter::numFailed() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return failed_;
+}
+
+
+size_t KVBatchWriter::numPending() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return pending_;
+}
+
+
+std::vector<KVBatchWriter::Failure> KVBatchWriter::takeFailures() {
+    std::lock_guard<std::mutex> g(lock_);
+    std::vector<Failure> failures;
+    failures.swap(failures_);
+    return failures;
+}
+
+
+StatusOr<HostAddr> KVBatchWriter::leaderOf(PartitionID part) {
+    auto& leader = leaders_[part];
+    if (leader.host.empty()) {
+        // Writes always go to the leader, a follower would reject them
+        auto ret = client_->getLeader(space_, part);
+        if (!ret.ok()) {
+            return ret.status();
+        }
+        leader = std::move(ret).value();
+    }
+    return leader;
+}
+
+
+KVBatchWriter::HostBuffer* KVBatchWriter::prepare(std::unique_lock<std::mutex>& lock,
+                                                  const std::string& key,
+                                                  PartitionID& part) {
+    part = client_->metaClient_->partId(numParts_, key);
+    auto leader = leaderOf(part);
+    if (!leader.ok()) {
+        VLOG(2) << "No leader for part " << part << ": " << leader.status();
+        ++failed_;
+        failures_.emplace_back(Failure{key, nebula::cpp2::ErrorCode::E_LEADER_CHANGED});
+        return nullptr;
+    }
+
+    const auto& host = leader.value();
+    auto* buffer = &buffers_[host];
+    if (buffer->numKeys >= options_.maxBatchKeys || buffer->numBytes >= options_.maxBatchBytes) {
+        // Pipeline the full buffer, as long as the host is not overwhelmed
+        cond_.wait(lock, [this, buffer] {
+            return buffer->outstanding < options_.maxOutstandingBatches;
+        });
+        // The buffer may have been sent by others during waiting
+        if (buffer->numKeys >= options_.maxBatchKeys ||
+            buffer->numBytes >= options_.maxBatchBytes) {
+            sendLocked(lock, host);
+        }
+    }
+    if (buffer->numKeys == 0) {
+        buffer->firstOpMs = time::WallClock::fastNowInMilliSec();
+    }
+    ++buffer->numKeys;
+    ++pending_;
+    return buffer;
+}
+
+
+void KVBatchWriter::sendLocked(std::unique_lock<std::mutex>& lock, const HostAddr& host) {
+    flushPending_.erase(host);
+    auto& buffer = buffers_[host];
+    if (buffer.numKeys == 0) {
+        return;
+    }
+    auto puts = std::move(buffer.puts);
+    auto removes = std::move(buffer.removes);
+    buffer.puts.clear();
+    buffer.removes.clear();
+    buffer.numKeys = 0;
+    buffer.numBytes = 0;
+    size_t batches = (puts.empty() ? 0 : 1) + (removes.empty() ? 0 : 1);
+    buffer.outstanding += batches;
+    inflight_ += batches;
+    lock.unlock();
+
+    if (!puts.empty()) {
+        std::unordered_map<PartitionID, std::vector<std::string>> keys;
+        for (const auto& part : puts) {
+            auto& partKeys = keys[part.first];
+            partKeys.reserve(part.second.size());
+            for (const auto& kv : part.second) {
+                partKeys.emplace_back(kv.key);
+            }
+        }
+        cpp2::KVPutRequest req;
+        req.set_space_id(space_);
+        req.set_parts(std::move(puts));
+        client_->getResponse(
+            nullptr,
+            std::make_pair(host, std::move(req)),
+            [] (cpp2::GeneralStorageServiceAsyncClient* client, const cpp2::KVPutRequest& r) {
+                return client->future_put(r);
+            })
+            .thenTry([this, host, keys = std::move(keys)] (auto&& t) mutable {
+                onBatchDone(host, keys, std::move(t));
+            });
+    }
+    if (!removes.empty()) {
+        auto keys = removes;
+        cpp2::KVRemoveRequest req;
+        req.set_space_id(space_);
+        req.set_parts(std::move(removes));
+        client_->getResponse(
+            nullptr,
+            std::make_pair(host, std::move(req)),
+            [] (cpp2::GeneralStorageServiceAsyncClient* client, const cpp2::KVRemoveRequest& r) {
+                return client->future_remove(r);
+            })
+            .thenTry([this, host, keys = std::move(keys)] (auto&& t) mutable {
+                onBatchDone(host, keys, std::move(t));
+            });
+    }
+    lock.lock();
+}
+
+
+void KVBatchWriter::onBatchDone(const HostAddr& host,
+                                std::unordered_map<PartitionID, std::vector<std::string>>& keys,
+                                folly::Try<StatusOr<cpp2::ExecResponse>>&& resp) {
+    std::vector<folly::Promise<folly::Unit>> waiters;
+    {
+        std::unique_lock<std::mutex> lock(lock_);
+        size_t numKeys = 0;
+        for (const auto& part : keys) {
+            numKeys += part.second.size();
+        }
+        pending_ -= numKeys;
+
+        if (resp.hasException() || !resp.value().ok()) {
+            LOG(ERROR) << "Batch to " << host << " failed: "
+                       << (resp.hasException() ? resp.exception().what().toStdString()
+                                               : resp.value().status().toString());
+            for (auto& part : keys) {
+                leaders_[part.first].clear();
+                failKeys(part.second, nebula::cpp2::ErrorCode::E_RPC_FAILURE);
+            }
+        } else {
+            for (const auto& code : resp.value().value().get_result().get_failed_parts()) {
+                auto it = keys.find(code.get_part_id());
+                if (it == keys.end()) {
+                    continue;
+                }
+                if (code.get_code() == nebula::cpp2::ErrorCode::E_LEADER_CHANGED) {
+                    // The leader cache of meta client has been updated by the base client
+                    leaders_[it->first].clear();
+                }
+                numKeys -= it->second.size();
+                failKeys(it->second, code.get_code());
+            }
+            succeeded_ += numKeys;
+        }
+
+        --buffers_[host].outstanding;
+        if (flushPending_.count(host) > 0) {
+            sendLocked(lock, host);
+        }
+        --inflight_;
+        if (flushed()) {
+            waiters.swap(flushWaiters_);
+        }
+        // Under the lock, since the writer may be destroyed once it's released,
+        // see ~KVBatchWriter(). Nothing of `this' is touched from then on.
+        cond_.notify_all();
+    }
+    for (auto& p : waiters) {
+        p.setValue();
+    }
+}
+
+
+void KVBatchWriter::failKeys(std::vector<std::string>& keys, nebula::cpp2::ErrorCode code) {
+    failed_ += keys.size();
+    for (auto& key : keys) {
+        failures_.emplace_back(Failure{std::move(key), code});
+    }
+    keys.clear();
+}
+
+
+void KVBatchWriter::flushExpired() {
+    auto now = time::WallClock::fastNowInMilliSec();
+    std::unique_lock<std::mutex> lock(lock_);
+    std::vector<HostAddr> hosts;
+    for (const auto& buffer : buffers_) {
+        const auto& b = buffer.second;
+        if (b.numKeys > 0 &&
+            now - b.firstOpMs >= options_.flushIntervalMs &&
+            b.outstanding < options_.maxOutstandingBatches) {
+            hosts.emplace_back(buffer.first);
+        }
+    }
+    for (const auto& host : hosts) {
+        sendLocked(lock, host);
+    }
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,155 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CLIENTS_STORAGE_KVBATCHWRITER_H_
+#define COMMON_CLIENTS_STORAGE_KVBATCHWRITER_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/datatypes/KeyValue.h"
+#include "common/datatypes/HostAddr.h"
+#include "common/interface/gen-cpp2/common_types.h"
+#include "common/interface/gen-cpp2/storage_types.h"
+#include "common/thread/GenericWorker.h"
+
+namespace nebula {
+namespace storage {
+
+class GeneralStorageClient;
+
+/**
+ * A buffered writer of KV puts and removes, created by
+ * GeneralStorageClient::batchWriter().
+ *
+ * Operations are accumulated per partition leader, and a host's buffer is sent
+ * as one request once it holds `maxBatchKeys' keys or `maxBatchBytes' bytes, or
+ * once its oldest operation has waited `flushIntervalMs'. Up to
+ * `maxOutstandingBatches' requests may be in flight per host; when the limit is
+ * reached, put() and remove() block until a batch of the host finishes. So they,
+ * and the destructor which waits for all batches, must NOT be called in the IO
+ * threads of the client, i.e. any thread running an EventBase, which is checked
+ * in debug mode. flush() never blocks and is fine to call anywhere.
+ *
+ * Operations on the same key are NOT ordered across batches, call flush() in
+ * between if needed.
+ *
+ * The writer is thread-safe.
+ */
+class KVBatchWriter final {
+public:
+    struct Options {
+        size_t maxBatchKeys{1024};
+        size_t maxBatchBytes{4 * 1024 * 1024};
+        int32_t flushIntervalMs{100};
+        size_t maxOutstandingBatches{4};
+    };
+
+    struct Failure {
+        std::string key;
+        nebula::cpp2::ErrorCode code;
+    };
+
+    KVBatchWriter(GeneralStorageClient* client,
+                  GraphSpaceID space,
+                  int32_t numParts,
+                  Options options);
+
+    // Flushes and waits for all pending operations, and for the callbacks of
+    // the batches to return
+    ~KVBatchWriter();
+
+    void put(KeyValue kv);
+
+    void remove(std::string key);
+
+    // Sends all the buffered operations, the future is fulfilled once nothing
+    // is in flight any more. A host with too many batches in flight is sent once
+    // one of them finishes, instead of waiting here.
+    folly::SemiFuture<folly::Unit> flush();
+
+    // Number of keys acknowledged by storage
+    size_t numSucceeded() const;
+
+    // Number of keys failed, see takeFailures() for the detail
+    size_t numFailed() const;
+
+    // Number of keys buffered or in flight
+    size_t numPending() const;
+
+    // Returns the failed keys since the last call
+    std::vector<Failure> takeFailures();
+
+private:
+    struct HostBuffer {
+        std::unordered_map<PartitionID, std::vector<KeyValue>> puts;
+        std::unordered_map<PartitionID, std::vector<std::string>> removes;
+        size_t numKeys{0};
+        size_t numBytes{0};
+        int64_t firstOpMs{0};
+        size_t outstanding{0};
+    };
+
+    StatusOr<HostAddr> leaderOf(PartitionID part);
+
+    // Returns the buffer of the leader of key's part, with a slot reserved for the
+    // key. A full buffer is sent first, waiting if the leader has too many batches
+    // in flight. Returns nullptr if the leader is unknown.
+    HostBuffer* prepare(std::unique_lock<std::mutex>& lock,
+                        const std::string& key,
+                        PartitionID& part);
+
+    // Sends out the buffer of the host, `lock' is released during sending
+    void sendLocked(std::unique_lock<std::mutex>& lock, const HostAddr& host);
+
+    // Sends out all the buffers, or marks them to be sent if the host has too many
+    // batches in flight
+    void flushLocked(std::unique_lock<std::mutex>& lock);
+
+    // Must be called with `lock_' held
+    bool flushed() const {
+        return inflight_ == 0 && flushPending_.empty();
+    }
+
+    // `keys' are the keys sent in the batch, grouped by part
+    void onBatchDone(const HostAddr& host,
+                     std::unordered_map<PartitionID, std::vector<std::string>>& keys,
+                     folly::Try<StatusOr<cpp2::ExecResponse>>&& resp);
+
+    // Must be called with `lock_' held
+    void failKeys(std::vector<std::string>& keys, nebula::cpp2::ErrorCode code);
+
+    void flushExpired();
+
+private:
+    GeneralStorageClient* client_{nullptr};
+    const GraphSpaceID space_;
+    const int32_t numParts_;
+    const Options options_;
+
+    mutable std::mutex lock_;
+    std::condition_variable cond_;
+    std::unordered_map<HostAddr, HostBuffer> buffers_;
+    // Index by partition id, empty host means unknown
+    std::vector<HostAddr> leaders_;
+    // Batches sent whose callbacks have not returned yet, it's decremented as the
+    // last step of the callback
+    size_t inflight_{0};
+    // Hosts to be sent by flush() once a batch of theirs finishes
+    std::unordered_set<HostAddr> flushPending_;
+    std::vector<folly::Promise<folly::Unit>> flushWaiters_;
+
+    size_t succeeded_{0};
+    size_t failed_{0};
+    size_t pending_{0};
+    std::vector<Failure> failures_;
+
+    std::unique_ptr<thread::GenericWorker> flusher_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // COMMON_CLIENTS_STORAGE_KVBATCHWRITER_H_
@@ -9,8 +9,28 @@
 DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
 DEFINE_uint32(storage_client_retry_interval_ms, 1000,
              "storage client sleep interval milliseconds between retry");
+DEFINE_string(storage_client_compression, "none",
+              "Transport compression of storage rpc, one of none, zlib and zstd");
+DEFINE_uint32(storage_client_compression_min_bytes, 64 * 1024,
+              "Storage rpc messages smaller than this are not compressed");
 
 namespace nebula {
 namespace storage {
+
+// static
+const StorageClientStats& StorageClientStats::get() {
+    static StorageClientStats clientStats;
+    return clientStats;
+}
+
+
+StorageClientStats::StorageClientStats() {
+    respBytes = stats::StatsManager::registerStats("storage_client_resp_bytes", "rate, sum");
+    respWireBytes = stats::StatsManager::registerStats("storage_client_resp_wire_bytes",
+                                                       "rate, sum");
+    e2eLatencyUs = stats::StatsManager::registerHisto(
+        "storage_client_e2e_latency_us", 1000, 0, 2000000, "avg, p75, p95, p99");
+}
+
 }   // namespace storage
 }   // namespace nebula
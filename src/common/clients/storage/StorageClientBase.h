@@ -12,12 +12,17 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "common/base/StatusOr.h"
 #include "common/meta/Common.h"
+#include "common/stats/StatsManager.h"
 #include "common/thrift/ThriftClientManager.h"
 #include "common/clients/meta/MetaClient.h"
+#include "common/clients/storage/CircuitBreaker.h"
+#include "common/clients/storage/ClusterIds.h"
 #include "common/interface/gen-cpp2/storage_types.h"
 
 DECLARE_int32(storage_client_timeout_ms);
 DECLARE_uint32(storage_client_retry_interval_ms);
+DECLARE_string(storage_client_compression);
+DECLARE_uint32(storage_client_compression_min_bytes);
 
 constexpr int32_t kInternalPortOffset = -2;
 
@@ -114,6 +119,20 @@ private:
 };
 
 
+// Counters shared by all storage clients
+struct StorageClientStats final {
+    static const StorageClientStats& get();
+
+    // The size of the responses before and after the transport compression
+    stats::CounterId respBytes;
+    stats::CounterId respWireBytes;
+    stats::CounterId e2eLatencyUs;
+
+private:
+    StorageClientStats();
+};
+
+
 /**
  * A base class for all storage clients
  */
@@ -122,6 +141,12 @@ class StorageClientBase {
 public:
     StatusOr<HostAddr> getLeader(GraphSpaceID spaceId, PartitionID partId) const;
 
+    // Overrides the compression given by the flags, for the connections
+    // created afterwards.
+    void setCompression(thrift::CompressionType type, uint32_t minCompressBytes) {
+        clientsMan_->setCompression(type, minCompressBytes);
+    }
+
 protected:
     StorageClientBase(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
                       meta::MetaClient* metaClient);
@@ -173,17 +198,15 @@ protected:
     // The method returns a map
     //  host_addr (A host, but in most case, the leader will be chosen)
     //      => (partition -> [ids that belong to the shard])
+    // The ids are moved into the result if `ids' is an rvalue. Only reads, i.e.
+    // `isRead', go to a healthy replica when the leader is unhealthy, see
+    // getHealthyHost(); writes always go to the leader.
     template<class Container, class GetIdFunc>
-    StatusOr<
-        std::unordered_map<
-            HostAddr,
-            std::unordered_map<
-                PartitionID,
-                std::vector<typename Container::value_type>
-            >
-        >
-    >
-    clusterIdsToHosts(GraphSpaceID spaceId, const Container& ids, GetIdFunc f) const;
+    StatusOr<HostPartIds<typename std::decay_t<Container>::value_type>>
+    clusterIdsToHosts(GraphSpaceID spaceId,
+                      Container&& ids,
+                      GetIdFunc f,
+                      bool isRead = false) const;
 
     virtual StatusOr<meta::PartHosts> getPartHosts(GraphSpaceID spaceId,
                                                    PartitionID partId) const {
@@ -191,8 +214,16 @@ protected:
         return metaClient_->getPartHostsFromCache(spaceId, partId);
     }
 
+    // The parts of the space by the host to send them to, like
+    // clusterIdsToHosts()
     virtual StatusOr<std::unordered_map<HostAddr, std::vector<PartitionID>>>
-    getHostParts(GraphSpaceID spaceId) const;
+    getHostParts(GraphSpaceID spaceId, bool isRead = false) const;
+
+    // Returns the leader of the part, unless its circuit is open. In that case, a
+    // healthy replica is chosen, which either serves the request after a new leader
+    // is elected, or replies E_LEADER_CHANGED with the new leader. Only for reads,
+    // a follower rejects writes, which would flip the cached leader for nothing.
+    StatusOr<HostAddr> getHealthyHost(GraphSpaceID spaceId, PartitionID partId) const;
 
     // from map
     template <typename K>
@@ -78,6 +78,15 @@ StorageClientBase<ClientType>::StorageClientBase(
         : metaClient_(metaClient)
         , ioThreadPool_(threadPool) {
     clientsMan_ = std::make_unique<thrift::ThriftClientManager<ClientType>>();
+    auto compression = thrift::toCompressionType(FLAGS_storage_client_compression);
+    if (compression.ok()) {
+        clientsMan_->setCompression(compression.value(),
+                                    FLAGS_storage_client_compression_min_bytes);
+    } else {
+        LOG(ERROR) << compression.status() << ", storage rpc will not be compressed";
+    }
+    const auto& clientStats = StorageClientStats::get();
+    clientsMan_->setResponseSizeStats(clientStats.respBytes, clientStats.respWireBytes);
 }
 
 
@@ -143,6 +152,18 @@ StorageClientBase<ClientType>::collectResponse(
                          host,
                          spaceId,
                          res] () mutable {
+            if (!CircuitBreaker::instance().allowRequest(host)) {
+                VLOG(2) << "Circuit of " << host << " is open, fail fast";
+                auto parts = getReqPartsId(*res.first);
+                context->resp.appendFailedParts(parts,
+                                                nebula::cpp2::ErrorCode::E_FAIL_TO_CONNECT);
+                invalidLeader(spaceId, parts);
+                context->resp.markFailure();
+                if (context->removeRequest(host)) {
+                    context->promise.setValue(std::move(context->resp));
+                }
+                return;
+            }
             auto client = clientsMan_->client(host,
                                               evb,
                                               false,
@@ -162,11 +183,14 @@ StorageClientBase<ClientType>::collectResponse(
                 if (val.hasException()) {
                     LOG(ERROR) << "Request to " << host
                                << " failed: " << val.exception().what();
+                    CircuitBreaker::instance().onFailure(host);
+                    clientsMan_->onFailure(host, val.exception());
                     auto parts = getReqPartsId(r);
                     context->resp.appendFailedParts(parts, nebula::cpp2::ErrorCode::E_RPC_FAILURE);
                     invalidLeader(spaceId, parts);
                     context->resp.markFailure();
                 } else {
+                    CircuitBreaker::instance().onSuccess(host);
                     auto resp = std::move(val.value());
                     auto& result = resp.get_result();
                     bool hasFailure{false};
@@ -195,9 +219,10 @@ StorageClientBase<ClientType>::collectResponse(
 
                     // Adjust the latency
                     auto latency = result.get_latency_in_us();
-                    context->resp.setLatency(host,
-                                             latency,
-                                             time::WallClock::fastNowInMicroSec() - start);
+                    auto e2eLatency = time::WallClock::fastNowInMicroSec() - start;
+                    context->resp.setLatency(host, latency, e2eLatency);
+                    stats::StatsManager::addValue(StorageClientStats::get().e2eLatencyUs,
+                                                  e2eLatency);
 
                     // Keep the response
                     context->resp.addResponse(std::move(resp));
@@ -248,12 +273,19 @@ void StorageClientBase<ClientType>::getResponseImpl(
     folly::via(evb, [evb, request = std::move(request), remoteFunc = std::move(remoteFunc),
                     pro = std::move(pro), this] () mutable {
         auto host = request.first;
-        auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
         auto spaceId = request.second.get_space_id();
         auto partsId = getReqPartsId(request.second);
-        LOG(INFO) << "Send request to storage " << host;
+        if (!CircuitBreaker::instance().allowRequest(host)) {
+            pro.setValue(Status::Error("Circuit of storage %s is open",
+                                       host.toString().c_str()));
+            invalidLeader(spaceId, partsId);
+            return;
+        }
+        auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
+        VLOG(2) << "Send request to storage " << host;
         remoteFunc(client.get(), request.second).via(evb)
              .then([spaceId,
+                    host,
                     partsId = std::move(partsId),
                     p = std::move(pro),
                     request = std::move(request),
@@ -261,6 +293,8 @@ void StorageClientBase<ClientType>::getResponseImpl(
                     this] (folly::Try<Response>&& t) mutable {
             // exception occurred during RPC
             if (t.hasException()) {
+                CircuitBreaker::instance().onFailure(host);
+                clientsMan_->onFailure(host, t.exception());
                 p.setValue(
                     Status::Error(
                         folly::stringPrintf("RPC failure in StorageClient: %s",
@@ -268,6 +302,7 @@ void StorageClientBase<ClientType>::getResponseImpl(
                 invalidLeader(spaceId, partsId);
                 return;
             }
+            CircuitBreaker::instance().onSuccess(host);
             auto&& resp = std::move(t.value());
             // leader changed
             auto& result = resp.get_result();
@@ -294,57 +329,32 @@ void StorageClientBase<ClientType>::getResponseImpl(
 
 template<typename ClientType>
 template<class Container, class GetIdFunc>
-StatusOr<
-    std::unordered_map<
-        HostAddr,
-        std::unordered_map<
-            PartitionID,
-            std::vector<typename Container::value_type>
-        >
-    >
->
+StatusOr<HostPartIds<typename std::decay_t<Container>::value_type>>
 StorageClientBase<ClientType>::clusterIdsToHosts(GraphSpaceID spaceId,
-                                                 const Container& ids,
-                                                 GetIdFunc f) const {
-    std::unordered_map<
-        HostAddr,
-        std::unordered_map<
-            PartitionID,
-            std::vector<typename Container::value_type>
-        >
-    > clusters;
-
+                                                 Container&& ids,
+                                                 GetIdFunc f,
+                                                 bool isRead) const {
+    CHECK(!!metaClient_);
     auto status = metaClient_->partsNum(spaceId);
     if (!status.ok()) {
         return Status::Error("Space not found, spaceid: %d", spaceId);
     }
     auto numParts = status.value();
-    std::unordered_map<PartitionID, HostAddr> leaders;
-    for (int32_t partId = 1; partId <= numParts; ++partId) {
-        auto leader = getLeader(spaceId, partId);
-        if (!leader.ok()) {
-            return leader.status();
-        }
-        leaders[partId] = std::move(leader).value();
-    }
-    for (auto& id : ids) {
-        CHECK(!!metaClient_);
-        status = metaClient_->partId(numParts, f(id));
-        if (!status.ok()) {
-            return status.status();
-        }
-
-        auto part = status.value();
-        const auto& leader = leaders[part];
-        clusters[leader][part].emplace_back(std::move(id));
-    }
-    return clusters;
+    return clusterIds(
+        std::forward<Container>(ids),
+        numParts,
+        [this, numParts, &f] (const auto& id) {
+            return metaClient_->partId(numParts, f(id));
+        },
+        [this, spaceId, isRead] (PartitionID partId) {
+            return isRead ? getHealthyHost(spaceId, partId) : getLeader(spaceId, partId);
+        });
 }
 
 
 template<typename ClientType>
 StatusOr<std::unordered_map<HostAddr, std::vector<PartitionID>>>
-StorageClientBase<ClientType>::getHostParts(GraphSpaceID spaceId) const {
+StorageClientBase<ClientType>::getHostParts(GraphSpaceID spaceId, bool isRead) const {
     std::unordered_map<HostAddr, std::vector<PartitionID>> hostParts;
     auto status = metaClient_->partsNum(spaceId);
     if (!status.ok()) {
@@ -353,14 +363,51 @@ StorageClientBase<ClientType>::getHostParts(GraphSpaceID spaceId) const {
 
     auto parts = status.value();
     for (auto partId = 1; partId <= parts; partId++) {
-        auto leader = getLeader(spaceId, partId);
-        if (!leader.ok()) {
-            return leader.status();
+        auto host = isRead ? getHealthyHost(spaceId, partId) : getLeader(spaceId, partId);
+        if (!host.ok()) {
+            return host.status();
         }
-        hostParts[leader.value()].emplace_back(partId);
+        hostParts[host.value()].emplace_back(partId);
     }
     return hostParts;
 }
 
+
+template<typename ClientType>
+StatusOr<HostAddr>
+StorageClientBase<ClientType>::getHealthyHost(GraphSpaceID spaceId, PartitionID partId) const {
+    auto leader = getLeader(spaceId, partId);
+    if (!leader.ok()) {
+        return leader;
+    }
+    auto& breaker = CircuitBreaker::instance();
+    if (!breaker.isOpen(leader.value())) {
+        return leader;
+    }
+    auto partHosts = getPartHosts(spaceId, partId);
+    if (!partHosts.ok()) {
+        return leader;
+    }
+    // Pick the healthiest replica other than the leader
+    const HostAddr* candidate = nullptr;
+    int32_t bestScore = -1;
+    for (const auto& host : partHosts.value().hosts_) {
+        if (host == leader.value() || breaker.isOpen(host)) {
+            continue;
+        }
+        auto score = breaker.healthScore(host);
+        if (score > bestScore) {
+            bestScore = score;
+            candidate = &host;
+        }
+    }
+    if (candidate == nullptr) {
+        return leader;
+    }
+    VLOG(2) << "Leader " << leader.value() << " of part " << partId
+            << " is unhealthy, reroute to " << *candidate;
+    return *candidate;
+}
+
 }   // namespace storage
 }   // namespace nebula
@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/clients/storage/CircuitBreaker.h"
+
+namespace nebula {
+namespace storage {
+
+TEST(CircuitBreakerTest, StateTransition) {
+    CircuitBreaker breaker;
+    breaker.fakeNowMs_ = 1000;
+    HostAddr host("127.0.0.1", 9779);
+
+    // Unknown hosts are healthy
+    EXPECT_TRUE(breaker.allowRequest(host));
+    EXPECT_EQ(CircuitBreaker::State::CLOSED, breaker.state(host));
+    EXPECT_EQ(CircuitBreaker::kMaxScore, breaker.healthScore(host));
+
+    for (int32_t i = 0; i < FLAGS_storage_client_circuit_failure_threshold - 1; i++) {
+        breaker.onFailure(host);
+        EXPECT_EQ(CircuitBreaker::State::CLOSED, breaker.state(host));
+        EXPECT_TRUE(breaker.allowRequest(host));
+    }
+    breaker.onFailure(host);
+    EXPECT_EQ(CircuitBreaker::State::OPEN, breaker.state(host));
+    EXPECT_TRUE(breaker.isOpen(host));
+    EXPECT_FALSE(breaker.allowRequest(host));
+    EXPECT_LT(breaker.healthScore(host), CircuitBreaker::kMaxScore);
+
+    // Only one probe is let through once the open period elapsed
+    breaker.fakeNowMs_ += FLAGS_storage_client_circuit_open_ms;
+    EXPECT_FALSE(breaker.isOpen(host));
+    EXPECT_TRUE(breaker.allowRequest(host));
+    EXPECT_EQ(CircuitBreaker::State::HALF_OPEN, breaker.state(host));
+    EXPECT_FALSE(breaker.allowRequest(host));
+
+    // Failed probe opens the circuit again
+    breaker.onFailure(host);
+    EXPECT_EQ(CircuitBreaker::State::OPEN, breaker.state(host));
+    EXPECT_FALSE(breaker.allowRequest(host));
+
+    // Succeeded probe closes the circuit
+    breaker.fakeNowMs_ += FLAGS_storage_client_circuit_open_ms;
+    EXPECT_TRUE(breaker.allowRequest(host));
+    auto score = breaker.healthScore(host);
+    breaker.onSuccess(host);
+    EXPECT_EQ(CircuitBreaker::State::CLOSED, breaker.state(host));
+    EXPECT_TRUE(breaker.allowRequest(host));
+    EXPECT_GT(breaker.healthScore(host), score);
+}
+
+
+TEST(CircuitBreakerTest, HealthScore) {
+    CircuitBreaker breaker;
+    HostAddr host("127.0.0.1", 9779);
+    for (int32_t i = 0; i < 100; i++) {
+        breaker.onFailure(host);
+    }
+    EXPECT_EQ(0, breaker.healthScore(host));
+    for (int32_t i = 0; i < 100; i++) {
+        breaker.onSuccess(host);
+    }
+    EXPECT_EQ(CircuitBreaker::kMaxScore, breaker.healthScore(host));
+
+    auto scores = breaker.healthScores();
+    ASSERT_EQ(1, scores.size());
+    EXPECT_EQ(CircuitBreaker::kMaxScore, scores[host]);
+}
+
+
+TEST(CircuitBreakerTest, Disabled) {
+    FLAGS_storage_client_circuit_breaker = false;
+    CircuitBreaker breaker;
+    HostAddr host("127.0.0.1", 9779);
+    for (int32_t i = 0; i < FLAGS_storage_client_circuit_failure_threshold; i++) {
+        breaker.onFailure(host);
+    }
+    EXPECT_TRUE(breaker.allowRequest(host));
+    EXPECT_FALSE(breaker.isOpen(host));
+    FLAGS_storage_client_circuit_breaker = true;
+}
+
+}   // namespace storage
+}   // namespace nebula
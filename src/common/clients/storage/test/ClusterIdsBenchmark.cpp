@@ -0,0 +1,117 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/base/MurmurHash2.h"
+#include "common/clients/storage/ClusterIds.h"
+#include "common/datatypes/DataSet.h"
+
+using nebula::HostAddr;
+using nebula::PartitionID;
+using nebula::Row;
+using nebula::StatusOr;
+using nebula::Value;
+
+static constexpr int32_t kNumParts = 100;
+static constexpr int32_t kNumHosts = 3;
+
+// Same as MetaClient::partId
+static PartitionID partId(const std::string& id) {
+    uint64_t vid = 0;
+    if (id.size() == 8) {
+        memcpy(static_cast<void*>(&vid), id.data(), 8);
+    } else {
+        nebula::MurmurHash2 hash;
+        vid = hash(id.data());
+    }
+    return vid % kNumParts + 1;
+}
+
+static StatusOr<HostAddr> leader(PartitionID part) {
+    return HostAddr(folly::stringPrintf("192.168.8.%d", part % kNumHosts), 9779);
+}
+
+static std::vector<Row> genRows(size_t n) {
+    std::vector<Row> rows;
+    rows.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        Row row;
+        row.values.emplace_back(folly::stringPrintf("vertex_%lu", i));
+        row.values.emplace_back(static_cast<int64_t>(i));
+        row.values.emplace_back("Tim Duncan");
+        row.values.emplace_back(42.0);
+        rows.emplace_back(std::move(row));
+    }
+    return rows;
+}
+
+// The one-pass clustering StorageClientBase::clusterIdsToHosts used to do
+static void legacyClusterIds(const std::vector<Row>& ids) {
+    nebula::storage::HostPartIds<Row> clusters;
+    std::unordered_map<PartitionID, HostAddr> leaders;
+    for (int32_t part = 1; part <= kNumParts; ++part) {
+        leaders[part] = leader(part).value();
+    }
+    for (auto& id : ids) {
+        auto part = partId(id.values[0].getStr());
+        const auto& host = leaders[part];
+        clusters[host][part].emplace_back(std::move(id));
+    }
+    folly::doNotOptimizeAway(clusters);
+}
+
+static void clusterRows(size_t iters, size_t n, bool move) {
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<Row> rows;
+        BENCHMARK_SUSPEND {
+            rows = genRows(n);
+        }
+        auto getPart = [] (const Row& row) {
+            return partId(row.values[0].getStr());
+        };
+        if (move) {
+            auto clusters = nebula::storage::clusterIds(
+                std::move(rows), kNumParts, getPart, leader);
+            folly::doNotOptimizeAway(clusters);
+        } else {
+            auto clusters = nebula::storage::clusterIds(rows, kNumParts, getPart, leader);
+            folly::doNotOptimizeAway(clusters);
+        }
+        BENCHMARK_SUSPEND {
+            rows.clear();
+        }
+    }
+}
+
+static void legacyClusterRows(size_t iters, size_t n) {
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<Row> rows;
+        BENCHMARK_SUSPEND {
+            rows = genRows(n);
+        }
+        legacyClusterIds(rows);
+        BENCHMARK_SUSPEND {
+            rows.clear();
+        }
+    }
+}
+
+BENCHMARK_NAMED_PARAM(legacyClusterRows, 10K, 10000)
+BENCHMARK_RELATIVE_NAMED_PARAM(clusterRows, 10K_copy, 10000, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(clusterRows, 10K_move, 10000, true)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(legacyClusterRows, 1M, 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM(clusterRows, 1M_copy, 1000000, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(clusterRows, 1M_move, 1000000, true)
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include "common/clients/storage/test/StorageClientTest.h"
+
+namespace nebula {
+namespace storage {
+
+class GeneralStorageClientTest : public StorageClientTest {
+protected:
+    // Puts a value of each key, and returns them
+    std::unordered_map<std::string, std::string> prepare(const std::vector<std::string>& keys) {
+        std::vector<KeyValue> kvs;
+        std::unordered_map<std::string, std::string> expected;
+        for (const auto& key : keys) {
+            kvs.emplace_back(std::make_pair(key, "value_of_" + key));
+            expected.emplace(key, "value_of_" + key);
+        }
+        auto resp = client_->put(kSpace, std::move(kvs)).get();
+        CHECK(resp.succeeded());
+        return expected;
+    }
+
+    static std::unordered_map<std::string, std::string> collect(
+            StorageRpcResponse<cpp2::KVGetResponse>& resp) {
+        std::unordered_map<std::string, std::string> kvs;
+        for (const auto& r : resp.responses()) {
+            kvs.insert(r.get_key_values().begin(), r.get_key_values().end());
+        }
+        return kvs;
+    }
+};
+
+
+TEST_F(GeneralStorageClientTest, MultiGet) {
+    auto keys = makeKeys(50);
+    auto expected = prepare(keys);
+    auto missing = makeKeys(60);
+    missing.erase(missing.begin(), missing.begin() + 50);
+
+    for (size_t maxConcurrency : {0, 1, 2, 16}) {
+        auto getKeys = keys;
+        getKeys.insert(getKeys.end(), missing.begin(), missing.end());
+        auto resp = client_->multiGet(kSpace, std::move(getKeys), maxConcurrency, true).get();
+        EXPECT_TRUE(resp.succeeded());
+        EXPECT_EQ(100, resp.completeness());
+        // One request per part
+        EXPECT_EQ(kParts, resp.responses().size());
+        EXPECT_EQ(expected, collect(resp));
+    }
+
+    // Same as get()
+    auto getKeys = keys;
+    auto resp = client_->get(kSpace, std::move(getKeys)).get();
+    EXPECT_TRUE(resp.succeeded());
+    EXPECT_EQ(expected, collect(resp));
+}
+
+
+TEST_F(GeneralStorageClientTest, MultiGetConcurrency) {
+    auto keys = makeKeys(100);
+    auto expected = prepare(keys);
+    for (auto& s : servers_) {
+        s.storage->setDelayMs(20);
+    }
+    // Both hosts serve 3 parts, at most 2 of them are requested at a time
+    auto resp = client_->multiGet(kSpace, std::move(keys), 2).get();
+    EXPECT_TRUE(resp.succeeded());
+    EXPECT_EQ(expected, collect(resp));
+    for (const auto& s : servers_) {
+        EXPECT_GE(2, s.storage->maxInflight());
+    }
+}
+
+
+TEST_F(GeneralStorageClientTest, MultiGetFailedParts) {
+    auto keys = makeKeys(50);
+    auto expected = prepare(keys);
+    storageOf(3).failPart(3, nebula::cpp2::ErrorCode::E_CONSENSUS_ERROR);
+    for (auto it = expected.begin(); it != expected.end();) {
+        if (partOf(it->first) == 3) {
+            it = expected.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto resp = client_->multiGet(kSpace, std::move(keys), 4).get();
+    EXPECT_FALSE(resp.succeeded());
+    ASSERT_EQ(1, resp.failedParts().size());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_CONSENSUS_ERROR, resp.failedParts().at(3));
+    // Only the request of the failed part is lost
+    EXPECT_EQ((kParts - 1) * 100 / kParts, resp.completeness());
+    EXPECT_EQ(expected, collect(resp));
+}
+
+
+TEST_F(GeneralStorageClientTest, MultiGetUnknownSpace) {
+    auto resp = client_->multiGet(kSpace + 1, makeKeys(10), 4);
+    EXPECT_THROW(std::move(resp).get(), std::runtime_error);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
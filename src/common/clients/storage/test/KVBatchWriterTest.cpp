@@ -0,0 +1,223 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include "common/clients/storage/test/StorageClientTest.h"
+
+namespace nebula {
+namespace storage {
+
+class KVBatchWriterTest : public StorageClientTest {
+protected:
+    std::unique_ptr<KVBatchWriter> makeWriter(KVBatchWriter::Options options) {
+        auto writer = client_->batchWriter(kSpace, std::move(options));
+        CHECK(writer.ok()) << writer.status();
+        return std::move(writer).value();
+    }
+
+    static KeyValue kvOf(const std::string& key) {
+        return KeyValue(std::make_pair(key, "value_of_" + key));
+    }
+};
+
+
+TEST_F(KVBatchWriterTest, SizeFlush) {
+    KVBatchWriter::Options options;
+    options.maxBatchKeys = 4;
+    options.flushIntervalMs = 0;
+    auto writer = makeWriter(options);
+    auto keys = makeKeys(5, 1);
+    for (size_t i = 0; i < 4; ++i) {
+        writer->put(kvOf(keys[i]));
+    }
+    // Sent once more comes
+    EXPECT_EQ(0, storageOf(1).numRequests());
+    writer->put(kvOf(keys[4]));
+    ASSERT_TRUE(waitFor([this] { return storedKvs().size() == 4; }));
+    EXPECT_EQ(1, storageOf(1).numRequests());
+    EXPECT_EQ(1, writer->numPending());
+
+    writer->flush().wait();
+    auto kvs = storedKvs();
+    ASSERT_EQ(5, kvs.size());
+    for (const auto& key : keys) {
+        EXPECT_EQ(kvOf(key).value, kvs[key]);
+    }
+    EXPECT_EQ(5, writer->numSucceeded());
+    EXPECT_EQ(0, writer->numFailed());
+    EXPECT_EQ(0, writer->numPending());
+
+    // Removed in a batch as well
+    for (const auto& key : keys) {
+        writer->remove(key);
+    }
+    writer->flush().wait();
+    EXPECT_TRUE(storedKvs().empty());
+    EXPECT_EQ(10, writer->numSucceeded());
+}
+
+
+TEST_F(KVBatchWriterTest, IntervalFlush) {
+    KVBatchWriter::Options options;
+    options.flushIntervalMs = 50;
+    auto writer = makeWriter(options);
+    auto keys = makeKeys(3);
+    for (const auto& key : keys) {
+        writer->put(kvOf(key));
+    }
+    // Sent by the flusher without flush()
+    EXPECT_TRUE(waitFor([this] { return storedKvs().size() == 3; }));
+    EXPECT_TRUE(waitFor([&writer] { return writer->numSucceeded() == 3; }));
+    EXPECT_EQ(0, writer->numPending());
+}
+
+
+TEST_F(KVBatchWriterTest, OutstandingLimit) {
+    for (size_t maxOutstanding : {1, 3}) {
+        storageOf(1).setDelayMs(20);
+        KVBatchWriter::Options options;
+        options.maxBatchKeys = 1;
+        options.flushIntervalMs = 0;
+        options.maxOutstandingBatches = maxOutstanding;
+        auto writer = makeWriter(options);
+        auto keys = makeKeys(10, 1);
+        for (const auto& key : keys) {
+            writer->put(kvOf(key));
+        }
+        writer->flush().wait();
+        EXPECT_EQ(10, writer->numSucceeded());
+        EXPECT_GE(maxOutstanding, storageOf(1).maxInflight());
+    }
+}
+
+
+TEST_F(KVBatchWriterTest, FlushNotBlocked) {
+    storageOf(1).setDelayMs(200);
+    KVBatchWriter::Options options;
+    options.maxBatchKeys = 2;
+    options.flushIntervalMs = 0;
+    options.maxOutstandingBatches = 1;
+    auto writer = makeWriter(options);
+    auto keys = makeKeys(3, 1);
+    for (const auto& key : keys) {
+        writer->put(kvOf(key));
+    }
+    // The first two are in flight, and the host is at the limit, so the last
+    // one is sent after them instead of blocking here
+    auto future = writer->flush();
+    EXPECT_FALSE(future.isReady());
+    EXPECT_EQ(3, writer->numPending());
+    std::move(future).get();
+    EXPECT_EQ(3, storedKvs().size());
+    EXPECT_EQ(3, writer->numSucceeded());
+    EXPECT_EQ(2, storageOf(1).numRequests());
+}
+
+
+TEST_F(KVBatchWriterTest, FailedParts) {
+    storageOf(2).failPart(2, nebula::cpp2::ErrorCode::E_CONSENSUS_ERROR);
+    KVBatchWriter::Options options;
+    options.flushIntervalMs = 0;
+    auto writer = makeWriter(options);
+    auto keys = makeKeys(100);
+    std::unordered_set<std::string> failedKeys;
+    for (const auto& key : keys) {
+        if (partOf(key) == 2) {
+            failedKeys.emplace(key);
+        }
+        writer->put(kvOf(key));
+    }
+    ASSERT_FALSE(failedKeys.empty());
+    writer->flush().wait();
+    EXPECT_EQ(keys.size() - failedKeys.size(), writer->numSucceeded());
+    EXPECT_EQ(failedKeys.size(), writer->numFailed());
+    EXPECT_EQ(keys.size() - failedKeys.size(), storedKvs().size());
+
+    auto failures = writer->takeFailures();
+    ASSERT_EQ(failedKeys.size(), failures.size());
+    for (const auto& failure : failures) {
+        EXPECT_EQ(1, failedKeys.count(failure.key)) << failure.key;
+        EXPECT_EQ(nebula::cpp2::ErrorCode::E_CONSENSUS_ERROR, failure.code);
+    }
+    EXPECT_TRUE(writer->takeFailures().empty());
+}
+
+
+TEST_F(KVBatchWriterTest, LeaderChanged) {
+    // Part 1 is moved from the first host to the second
+    ASSERT_EQ(0, hostOf(1));
+    storageOf(1).failPart(1, nebula::cpp2::ErrorCode::E_LEADER_CHANGED, hosts_[1]);
+    KVBatchWriter::Options options;
+    options.flushIntervalMs = 0;
+    auto writer = makeWriter(options);
+    auto keys = makeKeys(3, 1);
+    for (const auto& key : keys) {
+        writer->put(kvOf(key));
+    }
+    writer->flush().wait();
+    EXPECT_EQ(0, writer->numSucceeded());
+    auto failures = writer->takeFailures();
+    ASSERT_EQ(3, failures.size());
+    for (const auto& failure : failures) {
+        EXPECT_EQ(nebula::cpp2::ErrorCode::E_LEADER_CHANGED, failure.code);
+    }
+    auto leader = client_->getLeader(kSpace, 1);
+    ASSERT_TRUE(leader.ok());
+    EXPECT_EQ(hosts_[1], leader.value());
+
+    // Retried by the caller, to the new leader
+    for (const auto& failure : failures) {
+        writer->put(kvOf(failure.key));
+    }
+    writer->flush().wait();
+    EXPECT_EQ(3, writer->numSucceeded());
+    EXPECT_EQ(3, servers_[1].storage->kvs().size());
+    EXPECT_TRUE(servers_[0].storage->kvs().empty());
+}
+
+
+TEST_F(KVBatchWriterTest, DestroyInFlight) {
+    for (auto& s : servers_) {
+        s.storage->setDelayMs(50);
+    }
+    auto keys = makeKeys(40);
+    {
+        KVBatchWriter::Options options;
+        options.maxBatchKeys = 4;
+        options.flushIntervalMs = 10;
+        options.maxOutstandingBatches = 1;
+        auto writer = makeWriter(options);
+        for (const auto& key : keys) {
+            writer->put(kvOf(key));
+        }
+        EXPECT_LT(0, writer->numPending());
+        // Destroyed with batches in flight and buffered
+    }
+    // Nothing is left behind, and no callback runs on the destroyed writer
+    EXPECT_EQ(keys.size(), storedKvs().size());
+    size_t numRequests = 0;
+    for (const auto& s : servers_) {
+        numRequests += s.storage->numRequests();
+    }
+    usleep(100000);
+    size_t numRequestsAfter = 0;
+    for (const auto& s : servers_) {
+        numRequestsAfter += s.storage->numRequests();
+    }
+    EXPECT_EQ(numRequests, numRequestsAfter);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,298 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CLIENTS_STORAGE_TEST_STORAGECLIENTTEST_H_
+#define COMMON_CLIENTS_STORAGE_TEST_STORAGECLIENTTEST_H_
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <thrift/lib/cpp2/server/ThriftServer.h>
+#include "common/clients/meta/MetaClient.h"
+#include "common/clients/storage/GeneralStorageClient.h"
+#include "common/interface/gen-cpp2/GeneralStorageService.h"
+#include "common/thread/NamedThread.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * An in-memory GeneralStorageService, which fails the parts as told, and
+ * replies after `delayMs_' if it's set.
+ */
+class MockStorage final : public cpp2::GeneralStorageServiceSvIf {
+public:
+    MockStorage() : executor_(std::make_unique<folly::CPUThreadPoolExecutor>(8)) {}
+
+    ~MockStorage() override {
+        executor_->join();
+    }
+
+    folly::Future<cpp2::KVGetResponse> future_get(const cpp2::KVGetRequest& req) override {
+        cpp2::KVGetResponse resp;
+        std::unordered_map<std::string, std::string> kvs;
+        std::vector<cpp2::PartitionResult> failedParts;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            ++numRequests_;
+            for (const auto& part : req.get_parts()) {
+                if (failed(part.first, failedParts)) {
+                    continue;
+                }
+                for (const auto& key : part.second) {
+                    auto it = kvs_.find(key);
+                    if (it != kvs_.end()) {
+                        kvs.emplace(key, it->second);
+                    }
+                }
+            }
+        }
+        resp.set_result(makeResult(std::move(failedParts)));
+        resp.set_key_values(std::move(kvs));
+        return respond(std::move(resp));
+    }
+
+    folly::Future<cpp2::ExecResponse> future_put(const cpp2::KVPutRequest& req) override {
+        std::vector<cpp2::PartitionResult> failedParts;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            ++numRequests_;
+            for (const auto& part : req.get_parts()) {
+                if (failed(part.first, failedParts)) {
+                    continue;
+                }
+                for (const auto& kv : part.second) {
+                    kvs_[kv.key] = kv.value;
+                }
+            }
+        }
+        cpp2::ExecResponse resp;
+        resp.set_result(makeResult(std::move(failedParts)));
+        return respond(std::move(resp));
+    }
+
+    folly::Future<cpp2::ExecResponse> future_remove(const cpp2::KVRemoveRequest& req) override {
+        std::vector<cpp2::PartitionResult> failedParts;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            ++numRequests_;
+            for (const auto& part : req.get_parts()) {
+                if (failed(part.first, failedParts)) {
+                    continue;
+                }
+                for (const auto& key : part.second) {
+                    kvs_.erase(key);
+                }
+            }
+        }
+        cpp2::ExecResponse resp;
+        resp.set_result(makeResult(std::move(failedParts)));
+        return respond(std::move(resp));
+    }
+
+    // Fails the requests of `part' with `code', and `leader' is returned if
+    // the code is E_LEADER_CHANGED
+    void failPart(PartitionID part, nebula::cpp2::ErrorCode code, HostAddr leader = HostAddr()) {
+        std::lock_guard<std::mutex> g(lock_);
+        failedParts_[part] = std::make_pair(code, std::move(leader));
+    }
+
+    void setDelayMs(int32_t delayMs) {
+        delayMs_ = delayMs;
+    }
+
+    size_t numRequests() const {
+        std::lock_guard<std::mutex> g(lock_);
+        return numRequests_;
+    }
+
+    // The most requests being handled at the same time, only counted when
+    // the replies are delayed
+    size_t maxInflight() const {
+        std::lock_guard<std::mutex> g(lock_);
+        return maxInflight_;
+    }
+
+    std::unordered_map<std::string, std::string> kvs() const {
+        std::lock_guard<std::mutex> g(lock_);
+        return kvs_;
+    }
+
+private:
+    // Must be called with `lock_' held
+    bool failed(PartitionID part, std::vector<cpp2::PartitionResult>& failedParts) const {
+        auto it = failedParts_.find(part);
+        if (it == failedParts_.end()) {
+            return false;
+        }
+        cpp2::PartitionResult result;
+        result.set_code(it->second.first);
+        result.set_part_id(part);
+        if (it->second.first == nebula::cpp2::ErrorCode::E_LEADER_CHANGED) {
+            result.set_leader(it->second.second);
+        }
+        failedParts.emplace_back(std::move(result));
+        return true;
+    }
+
+    static cpp2::ResponseCommon makeResult(std::vector<cpp2::PartitionResult> failedParts) {
+        cpp2::ResponseCommon result;
+        result.set_failed_parts(std::move(failedParts));
+        result.set_latency_in_us(0);
+        return result;
+    }
+
+    template <typename Resp>
+    folly::Future<Resp> respond(Resp resp) {
+        int32_t delayMs = delayMs_;
+        if (delayMs <= 0) {
+            return folly::makeFuture(std::move(resp));
+        }
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            maxInflight_ = std::max(maxInflight_, ++inflight_);
+        }
+        return folly::via(executor_.get(), [this, delayMs, resp = std::move(resp)] () mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+            std::lock_guard<std::mutex> g(lock_);
+            --inflight_;
+            return std::move(resp);
+        });
+    }
+
+    mutable std::mutex lock_;
+    std::unordered_map<std::string, std::string> kvs_;
+    std::unordered_map<PartitionID, std::pair<nebula::cpp2::ErrorCode, HostAddr>> failedParts_;
+    std::atomic<int32_t> delayMs_{0};
+    size_t numRequests_{0};
+    size_t inflight_{0};
+    size_t maxInflight_{0};
+    std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+};
+
+
+/**
+ * Starts `kHosts' MockStorage servers, and a meta client of a space of `kParts'
+ * parts over them, with the parts and leaders mocked in its cache.
+ */
+class StorageClientTest : public ::testing::Test {
+protected:
+    static constexpr GraphSpaceID kSpace = 1;
+    static constexpr int32_t kParts = 6;
+    static constexpr size_t kHosts = 2;
+
+    struct Server {
+        std::shared_ptr<MockStorage> storage;
+        std::unique_ptr<apache::thrift::ThriftServer> server;
+        std::unique_ptr<thread::NamedThread> thread;
+    };
+
+    void SetUp() override {
+        ioThreadPool_ = std::make_shared<folly::IOThreadPoolExecutor>(4);
+        for (size_t i = 0; i < kHosts; ++i) {
+            Server s;
+            s.storage = std::make_shared<MockStorage>();
+            s.server = std::make_unique<apache::thrift::ThriftServer>();
+            s.server->setInterface(s.storage);
+            s.server->setPort(0);
+            auto* server = s.server.get();
+            s.thread = std::make_unique<thread::NamedThread>("mock-storage", [server] {
+                server->serve();
+            });
+            while (!server->getServeEventBase() || !server->getServeEventBase()->isRunning()) {
+                usleep(10000);
+            }
+            hosts_.emplace_back("127.0.0.1", server->getAddress().getPort());
+            servers_.emplace_back(std::move(s));
+        }
+
+        // Never connected, since only the cache is used
+        metaClient_ = std::make_unique<meta::MetaClient>(
+            ioThreadPool_, std::vector<HostAddr>{HostAddr("127.0.0.1", 1)});
+        auto space = std::make_shared<meta::SpaceInfoCache>();
+        for (PartitionID part = 1; part <= kParts; ++part) {
+            const auto& host = hosts_[hostOf(part)];
+            space->partsAlloc_[part] = {host};
+            space->partsOnHost_[host].emplace_back(part);
+            metaClient_->leadersInfo_.leaderMap_[{kSpace, part}] = host;
+        }
+        metaClient_->localCache_[kSpace] = std::move(space);
+        metaClient_->ready_ = true;
+
+        client_ = std::make_unique<GeneralStorageClient>(ioThreadPool_, metaClient_.get());
+    }
+
+    void TearDown() override {
+        client_.reset();
+        for (auto& s : servers_) {
+            s.server->stop();
+            s.thread->join();
+        }
+        servers_.clear();
+        metaClient_.reset();
+        ioThreadPool_->join();
+    }
+
+    // Index of the host serving `part', parts are spread round robin
+    static size_t hostOf(PartitionID part) {
+        return (part - 1) % kHosts;
+    }
+
+    MockStorage& storageOf(PartitionID part) {
+        return *servers_[hostOf(part)].storage;
+    }
+
+    PartitionID partOf(const std::string& key) const {
+        return metaClient_->partId(kParts, key);
+    }
+
+    // Returns `num' keys of `part', or of any part if it's 0
+    std::vector<std::string> makeKeys(size_t num, PartitionID part = 0) const {
+        std::vector<std::string> keys;
+        for (int32_t i = 0; keys.size() < num; ++i) {
+            // Not of 8 bytes, which are hashed as an integer vid
+            auto key = folly::stringPrintf("key_%05d", i);
+            if (part == 0 || partOf(key) == part) {
+                keys.emplace_back(std::move(key));
+            }
+        }
+        return keys;
+    }
+
+    // All the keys stored by the mock servers
+    std::unordered_map<std::string, std::string> storedKvs() const {
+        std::unordered_map<std::string, std::string> kvs;
+        for (const auto& s : servers_) {
+            auto hostKvs = s.storage->kvs();
+            kvs.insert(hostKvs.begin(), hostKvs.end());
+        }
+        return kvs;
+    }
+
+    // Waits at most `timeoutMs' for `cond' to be true
+    template <typename Cond>
+    static bool waitFor(Cond&& cond, int32_t timeoutMs = 5000) {
+        for (int32_t waited = 0; waited < timeoutMs; waited += 10) {
+            if (cond()) {
+                return true;
+            }
+            usleep(10000);
+        }
+        return cond();
+    }
+
+    std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
+    std::vector<Server> servers_;
+    std::vector<HostAddr> hosts_;
+    std::unique_ptr<meta::MetaClient> metaClient_;
+    std::unique_ptr<GeneralStorageClient> client_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // COMMON_CLIENTS_STORAGE_TEST_STORAGECLIENTTEST_H_
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CODEC_ROWFORMAT_H_
+#define COMMON_CODEC_ROWFORMAT_H_
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace codec {
+
+/**
+ * The v2 layout of an encoded row:
+ *
+ *   header | schema version | null flags | fixed-width fields | strings
+ *
+ * - The header is one byte, 0x08 | N, followed by the N (0 to 7) bytes of the
+ *   schema version in little endian.
+ * - The null flags take one bit per nullable field, at nullFlagPos() of the
+ *   field, the highest bit of a byte first. A bit set means null.
+ * - Each field takes size() bytes at offset() of the field:
+ *   BOOL as one byte, the integers, FLOAT, DOUBLE and TIMESTAMP in little
+ *   endian, STRING as the int32 offset in the row and the int32 length of its
+ *   content, FIXED_STRING padded by '\0', DATE as int16 year, int8 month and
+ *   int8 day, TIME as int8 hour, minute and sec and int32 microsec, and
+ *   DATETIME as the DATE followed by the TIME.
+ * - The contents of the STRING fields are appended after the fixed-width
+ *   fields.
+ */
+struct RowFormat final {
+    static_assert(folly::kIsLittleEndian, "The rows are encoded in little endian");
+
+    static constexpr uint8_t kHeaderV2 = 0x08;
+    static constexpr uint8_t kHeaderTypeMask = 0x18;
+    static constexpr uint8_t kVerBytesMask = 0x07;
+    static constexpr uint8_t kNullBits[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+
+    static size_t numNullBytes(size_t numNullableFields) {
+        return (numNullableFields + 7) >> 3;
+    }
+
+    // The number of bytes the schema version takes
+    static size_t verBytes(uint64_t ver) {
+        size_t n = 0;
+        while (ver != 0) {
+            ++n;
+            ver >>= 8;
+        }
+        return n;
+    }
+
+    template <typename T>
+    static T read(const char* pos) {
+        T val;
+        memcpy(&val, pos, sizeof(T));
+        return val;
+    }
+
+    template <typename T>
+    static void write(char* pos, T val) {
+        memcpy(pos, &val, sizeof(T));
+    }
+};
+
+}  // namespace codec
+}  // namespace nebula
+#endif  // COMMON_CODEC_ROWFORMAT_H_
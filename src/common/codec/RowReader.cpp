@@ -0,0 +1,260 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/codec/RowReader.h"
+
+namespace nebula {
+namespace codec {
+
+// static
+StatusOr<SchemaVer> RowReader::getSchemaVer(folly::StringPiece row) {
+    if (row.empty()) {
+        return Status::Error("Empty row");
+    }
+    auto header = static_cast<uint8_t>(row[0]);
+    if ((header & RowFormat::kHeaderTypeMask) != RowFormat::kHeaderV2) {
+        return Status::Error("Unsupported row header 0x%02x", header);
+    }
+    size_t verBytes = header & RowFormat::kVerBytesMask;
+    if (row.size() < 1 + verBytes) {
+        return Status::Error("Truncated row of %lu bytes", row.size());
+    }
+    uint64_t ver = 0;
+    for (size_t i = 0; i < verBytes; ++i) {
+        ver |= static_cast<uint64_t>(static_cast<uint8_t>(row[1 + i])) << (8 * i);
+    }
+    return static_cast<SchemaVer>(ver);
+}
+
+
+// static
+StatusOr<size_t> RowReader::checkRow(const meta::NebulaSchemaProvider* schema,
+                                     folly::StringPiece row) {
+    auto ver = getSchemaVer(row);
+    NG_RETURN_IF_ERROR(ver);
+    if (ver.value() != schema->getVersion()) {
+        return Status::Error("The row is encoded with schema version %ld, not %ld",
+                             ver.value(),
+                             schema->getVersion());
+    }
+    size_t headerLen = 1 + (static_cast<uint8_t>(row[0]) & RowFormat::kVerBytesMask);
+    auto minSize = headerLen
+                 + RowFormat::numNullBytes(schema->getNumNullableFields())
+                 + schema->size();
+    if (row.size() < minSize) {
+        return Status::Error("Truncated row of %lu bytes, %lu expected", row.size(), minSize);
+    }
+    return headerLen;
+}
+
+
+// static
+StatusOr<RowReader> RowReader::make(const meta::NebulaSchemaProvider* schema,
+                                    folly::StringPiece row) {
+    auto headerLen = checkRow(DCHECK_NOTNULL(schema), row);
+    NG_RETURN_IF_ERROR(headerLen);
+    return RowReader(schema, row, headerLen.value());
+}
+
+
+int64_t RowReader::getInt(size_t index) const {
+    auto* pos = row_.data() + dataPos(index);
+    switch (fieldOf(index).type()) {
+        case cpp2::PropertyType::INT8:
+            return RowFormat::read<int8_t>(pos);
+        case cpp2::PropertyType::INT16:
+            return RowFormat::read<int16_t>(pos);
+        case cpp2::PropertyType::INT32:
+            return RowFormat::read<int32_t>(pos);
+        case cpp2::PropertyType::INT64:
+        case cpp2::PropertyType::VID:
+        case cpp2::PropertyType::TIMESTAMP:
+            return RowFormat::read<int64_t>(pos);
+        default:
+            DLOG(FATAL) << "Field " << index << " is not an integer";
+            return 0;
+    }
+}
+
+
+folly::StringPiece RowReader::getString(size_t index) const {
+    auto& field = fieldOf(index);
+    auto* pos = row_.data() + dataPos(index);
+    if (field.type() == cpp2::PropertyType::FIXED_STRING) {
+        folly::StringPiece str(pos, field.size());
+        auto end = str.find('\0');
+        return end == folly::StringPiece::npos ? str : str.subpiece(0, end);
+    }
+    DCHECK(field.type() == cpp2::PropertyType::STRING);
+    auto offset = RowFormat::read<int32_t>(pos);
+    auto len = RowFormat::read<int32_t>(pos + sizeof(int32_t));
+    if (UNLIKELY(offset < 0 || len < 0 ||
+                 static_cast<size_t>(offset) + static_cast<size_t>(len) > row_.size())) {
+        LOG(ERROR) << "String field " << index << " is out of the row";
+        return folly::StringPiece();
+    }
+    return row_.subpiece(offset, len);
+}
+
+
+Date RowReader::getDate(size_t index) const {
+    auto* pos = row_.data() + dataPos(index);
+    return Date(RowFormat::read<int16_t>(pos),
+                RowFormat::read<int8_t>(pos + sizeof(int16_t)),
+                RowFormat::read<int8_t>(pos + sizeof(int16_t) + sizeof(int8_t)));
+}
+
+
+Time RowReader::getTime(size_t index) const {
+    auto* pos = row_.data() + dataPos(index);
+    return Time(RowFormat::read<int8_t>(pos),
+                RowFormat::read<int8_t>(pos + 1),
+                RowFormat::read<int8_t>(pos + 2),
+                RowFormat::read<int32_t>(pos + 3));
+}
+
+
+DateTime RowReader::getDateTime(size_t index) const {
+    auto* pos = row_.data() + dataPos(index);
+    return DateTime(RowFormat::read<int16_t>(pos),
+                    RowFormat::read<int8_t>(pos + 2),
+                    RowFormat::read<int8_t>(pos + 3),
+                    RowFormat::read<int8_t>(pos + 4),
+                    RowFormat::read<int8_t>(pos + 5),
+                    RowFormat::read<int8_t>(pos + 6),
+                    RowFormat::read<int32_t>(pos + 7));
+}
+
+
+Value RowReader::getValue(size_t index) const {
+    if (index >= numFields()) {
+        return Value::kNullOutOfRange;
+    }
+    if (isNull(index)) {
+        return Value::kNullValue;
+    }
+    switch (fieldOf(index).type()) {
+        case cpp2::PropertyType::BOOL:
+            return getBool(index);
+        case cpp2::PropertyType::INT8:
+        case cpp2::PropertyType::INT16:
+        case cpp2::PropertyType::INT32:
+        case cpp2::PropertyType::INT64:
+        case cpp2::PropertyType::VID:
+        case cpp2::PropertyType::TIMESTAMP:
+            return getInt(index);
+        case cpp2::PropertyType::FLOAT:
+        case cpp2::PropertyType::DOUBLE:
+            return getFloat(index);
+        case cpp2::PropertyType::STRING:
+        case cpp2::PropertyType::FIXED_STRING:
+            return getString(index).str();
+        case cpp2::PropertyType::DATE:
+            return getDate(index);
+        case cpp2::PropertyType::TIME:
+            return getTime(index);
+        case cpp2::PropertyType::DATETIME:
+            return getDateTime(index);
+        case cpp2::PropertyType::UNKNOWN:
+            break;
+    }
+    return Value::kNullBadType;
+}
+
+
+Value RowReader::getValue(folly::StringPiece name) const {
+    auto index = schema_->getFieldIndex(name);
+    if (index < 0) {
+        return Value::kNullUnknownProp;
+    }
+    return getValue(index);
+}
+
+
+void RowReader::appendTo(size_t index, ColumnVector& column) const {
+    bool null = isNull(index);
+    column.nulls.emplace_back(null);
+    switch (column.type) {
+        case cpp2::PropertyType::BOOL:
+            column.ints.emplace_back(null ? 0 : getBool(index));
+            break;
+        case cpp2::PropertyType::INT8:
+        case cpp2::PropertyType::INT16:
+        case cpp2::PropertyType::INT32:
+        case cpp2::PropertyType::INT64:
+        case cpp2::PropertyType::VID:
+        case cpp2::PropertyType::TIMESTAMP:
+            column.ints.emplace_back(null ? 0 : getInt(index));
+            break;
+        case cpp2::PropertyType::FLOAT:
+        case cpp2::PropertyType::DOUBLE:
+            column.floats.emplace_back(null ? 0.0 : getFloat(index));
+            break;
+        case cpp2::PropertyType::STRING:
+        case cpp2::PropertyType::FIXED_STRING:
+            column.strs.emplace_back(null ? folly::StringPiece() : getString(index));
+            break;
+        case cpp2::PropertyType::DATE:
+        case cpp2::PropertyType::TIME:
+        case cpp2::PropertyType::DATETIME:
+            column.values.emplace_back(null ? Value::kNullValue : getValue(index));
+            break;
+        case cpp2::PropertyType::UNKNOWN:
+            column.values.emplace_back(Value::kNullBadType);
+            break;
+    }
+}
+
+
+// static
+Status RowReader::decodeColumns(const meta::NebulaSchemaProvider* schema,
+                                const std::vector<folly::StringPiece>& rows,
+                                const std::vector<size_t>& columns,
+                                std::vector<ColumnVector>& out) {
+    for (auto index : columns) {
+        if (index >= schema->getNumFields()) {
+            return Status::Error("Field index %lu is out of range", index);
+        }
+    }
+    out.resize(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto& column = out[i];
+        column.type = schema->fields()[columns[i]].type();
+        column.nulls.reserve(column.nulls.size() + rows.size());
+        switch (column.type) {
+            case cpp2::PropertyType::FLOAT:
+            case cpp2::PropertyType::DOUBLE:
+                column.floats.reserve(column.floats.size() + rows.size());
+                break;
+            case cpp2::PropertyType::STRING:
+            case cpp2::PropertyType::FIXED_STRING:
+                column.strs.reserve(column.strs.size() + rows.size());
+                break;
+            case cpp2::PropertyType::DATE:
+            case cpp2::PropertyType::TIME:
+            case cpp2::PropertyType::DATETIME:
+            case cpp2::PropertyType::UNKNOWN:
+                column.values.reserve(column.values.size() + rows.size());
+                break;
+            default:
+                column.ints.reserve(column.ints.size() + rows.size());
+                break;
+        }
+    }
+
+    for (auto row : rows) {
+        auto headerLen = checkRow(schema, row);
+        NG_RETURN_IF_ERROR(headerLen);
+        RowReader reader(schema, row, headerLen.value());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            reader.appendTo(columns[i], out[i]);
+        }
+    }
+    return Status::OK();
+}
+
+}  // namespace codec
+}  // namespace nebula
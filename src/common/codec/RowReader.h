@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CODEC_ROWREADER_H_
+#define COMMON_CODEC_ROWREADER_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/codec/RowFormat.h"
+#include "common/datatypes/Value.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+namespace codec {
+
+/**
+ * The values of a field decoded from a batch of rows, one per row. Only the
+ * vector of the type of the field is filled:
+ *   ints    BOOL, INT8, INT16, INT32, INT64, VID and TIMESTAMP
+ *   floats  FLOAT and DOUBLE
+ *   strs    STRING and FIXED_STRING, which refer to the rows
+ *   values  DATE, TIME and DATETIME
+ * The value of a null is 0, 0.0, an empty piece or a null value respectively.
+ */
+struct ColumnVector {
+    cpp2::PropertyType type{cpp2::PropertyType::UNKNOWN};
+    // 1 for null
+    std::vector<uint8_t> nulls;
+    std::vector<int64_t> ints;
+    std::vector<double> floats;
+    std::vector<folly::StringPiece> strs;
+    std::vector<Value> values;
+
+    size_t size() const {
+        return nulls.size();
+    }
+
+    void clear() {
+        nulls.clear();
+        ints.clear();
+        floats.clear();
+        strs.clear();
+        values.clear();
+    }
+};
+
+/**
+ * Reads the fields of a row encoded in RowFormat straight from the buffer,
+ * with no Value materialized unless getValue() is called. The typed getters
+ * expect the field of the type, and a non-null value.
+ *
+ * The reader refers to the buffer and the schema, both should outlive it.
+ */
+class RowReader final {
+public:
+    static StatusOr<RowReader> make(const meta::NebulaSchemaProvider* schema,
+                                    folly::StringPiece row);
+
+    // The schema version the row is encoded with, to find its schema
+    static StatusOr<SchemaVer> getSchemaVer(folly::StringPiece row);
+
+    /**
+     * Decodes the `columns' of the `rows' into `out', one ColumnVector per
+     * column, appending to the vectors. All the rows should be encoded with
+     * the schema, otherwise an error is returned with `out' partially filled.
+     */
+    static Status decodeColumns(const meta::NebulaSchemaProvider* schema,
+                                const std::vector<folly::StringPiece>& rows,
+                                const std::vector<size_t>& columns,
+                                std::vector<ColumnVector>& out);
+
+    const meta::NebulaSchemaProvider* schema() const {
+        return schema_;
+    }
+
+    size_t numFields() const {
+        return schema_->getNumFields();
+    }
+
+    bool isNull(size_t index) const {
+        auto& field = fieldOf(index);
+        if (!field.nullable()) {
+            return false;
+        }
+        auto pos = field.nullFlagPos();
+        auto flags = static_cast<uint8_t>(row_[headerLen_ + (pos >> 3)]);
+        return (flags & RowFormat::kNullBits[pos & 7]) != 0;
+    }
+
+    bool getBool(size_t index) const {
+        DCHECK(fieldOf(index).type() == cpp2::PropertyType::BOOL);
+        return row_[dataPos(index)] != 0;
+    }
+
+    // Any of the integer fields, and TIMESTAMP
+    int64_t getInt(size_t index) const;
+
+    // FLOAT or DOUBLE
+    double getFloat(size_t index) const {
+        if (fieldOf(index).type() == cpp2::PropertyType::FLOAT) {
+            return RowFormat::read<float>(row_.data() + dataPos(index));
+        }
+        DCHECK(fieldOf(index).type() == cpp2::PropertyType::DOUBLE);
+        return RowFormat::read<double>(row_.data() + dataPos(index));
+    }
+
+    // STRING or FIXED_STRING, referring to the row. The padding of the fixed
+    // string is trimmed.
+    folly::StringPiece getString(size_t index) const;
+
+    Date getDate(size_t index) const;
+    Time getTime(size_t index) const;
+    DateTime getDateTime(size_t index) const;
+
+    // Materializes the field, null if it's null
+    Value getValue(size_t index) const;
+    Value getValue(folly::StringPiece name) const;
+
+private:
+    RowReader(const meta::NebulaSchemaProvider* schema,
+              folly::StringPiece row,
+              size_t headerLen)
+        : schema_(schema)
+        , row_(row)
+        , headerLen_(headerLen)
+        , dataOffset_(headerLen + RowFormat::numNullBytes(schema->getNumNullableFields())) {}
+
+    // Checks the header and the size of the row, returns the header length
+    static StatusOr<size_t> checkRow(const meta::NebulaSchemaProvider* schema,
+                                     folly::StringPiece row);
+
+    const meta::NebulaSchemaProvider::SchemaField& fieldOf(size_t index) const {
+        DCHECK_LT(index, schema_->fields().size());
+        return schema_->fields()[index];
+    }
+
+    size_t dataPos(size_t index) const {
+        return dataOffset_ + fieldOf(index).offset();
+    }
+
+    void appendTo(size_t index, ColumnVector& column) const;
+
+    const meta::NebulaSchemaProvider* schema_;
+    folly::StringPiece row_;
+    size_t headerLen_;
+    // Where the fixed-width fields start
+    size_t dataOffset_;
+};
+
+}  // namespace codec
+}  // namespace nebula
+#endif  // COMMON_CODEC_ROWREADER_H_
@@ -0,0 +1,215 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/codec/RowWriter.h"
+
+namespace nebula {
+namespace codec {
+
+RowWriter::RowWriter(const meta::NebulaSchemaProvider* schema)
+        : schema_(DCHECK_NOTNULL(schema))
+        , isSet_(schema->getNumFields(), false) {
+    auto ver = schema->getVersion();
+    DCHECK_GE(ver, 0);
+    auto verBytes = RowFormat::verBytes(ver);
+    DCHECK_LE(verBytes, RowFormat::kVerBytesMask);
+    headerLen_ = 1 + verBytes;
+    dataOffset_ = headerLen_ + RowFormat::numNullBytes(schema->getNumNullableFields());
+
+    buf_.reserve(dataOffset_ + schema->size());
+    buf_.append(1, static_cast<char>(RowFormat::kHeaderV2 | verBytes));
+    for (size_t i = 0; i < verBytes; ++i) {
+        buf_.append(1, static_cast<char>((ver >> (8 * i)) & 0xFF));
+    }
+    buf_.resize(dataOffset_ + schema->size(), '\0');
+}
+
+
+Status RowWriter::set(size_t index, const Value& val) {
+    DCHECK(!finished_);
+    auto& fields = schema_->fields();
+    if (index >= fields.size()) {
+        return Status::Error("Field index %lu is out of range", index);
+    }
+    auto& field = fields[index];
+    if (val.isNull()) {
+        if (!field.nullable()) {
+            return Status::Error("Field `%s' is not nullable", field.name());
+        }
+        setNullBit(field.nullFlagPos(), true);
+    } else {
+        NG_RETURN_IF_ERROR(write(field, val));
+        if (field.nullable()) {
+            setNullBit(field.nullFlagPos(), false);
+        }
+    }
+    isSet_[index] = true;
+    return Status::OK();
+}
+
+
+Status RowWriter::set(folly::StringPiece name, const Value& val) {
+    auto index = schema_->getFieldIndex(name);
+    if (index < 0) {
+        return Status::Error("Unknown field `%s'", name.str().c_str());
+    }
+    return set(index, val);
+}
+
+
+Status RowWriter::finish() {
+    if (finished_) {
+        return Status::OK();
+    }
+    auto& fields = schema_->fields();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (isSet_[i]) {
+            continue;
+        }
+        auto& field = fields[i];
+        if (field.hasDefault()) {
+            auto* cached = field.constDefaultValue();
+            NG_RETURN_IF_ERROR(cached != nullptr ? set(i, *cached) : set(i, field.evalDefault()));
+        } else if (field.nullable()) {
+            setNullBit(field.nullFlagPos(), true);
+        } else {
+            return Status::Error("Field `%s' is not set, and has no default", field.name());
+        }
+    }
+    finished_ = true;
+    return Status::OK();
+}
+
+
+template <typename T>
+Status RowWriter::writeInt(const SchemaField& field, const Value& val) {
+    if (!val.isInt()) {
+        return Status::Error("Field `%s' expects an int, not %s",
+                             field.name(),
+                             val.typeName().c_str());
+    }
+    auto i = val.getInt();
+    if (i < std::numeric_limits<T>::min() || i > std::numeric_limits<T>::max()) {
+        return Status::Error("%ld is out of the range of field `%s'", i, field.name());
+    }
+    RowFormat::write<T>(dataOf(field), static_cast<T>(i));
+    return Status::OK();
+}
+
+
+Status RowWriter::writeString(const SchemaField& field, const Value& val) {
+    if (!val.isStr()) {
+        return Status::Error("Field `%s' expects a string, not %s",
+                             field.name(),
+                             val.typeName().c_str());
+    }
+    auto& str = val.getStr();
+    if (field.type() == cpp2::PropertyType::FIXED_STRING) {
+        auto* pos = dataOf(field);
+        auto len = std::min(str.size(), field.size());
+        memcpy(pos, str.data(), len);
+        memset(pos + len, 0, field.size() - len);
+        return Status::OK();
+    }
+    if (buf_.size() + str.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        return Status::Error("Row is too large to append field `%s'", field.name());
+    }
+    auto offset = static_cast<int32_t>(buf_.size());
+    // The buffer might be reallocated, so the field is written after
+    buf_.append(str);
+    auto* pos = dataOf(field);
+    RowFormat::write<int32_t>(pos, offset);
+    RowFormat::write<int32_t>(pos + sizeof(int32_t), static_cast<int32_t>(str.size()));
+    return Status::OK();
+}
+
+
+Status RowWriter::write(const SchemaField& field, const Value& val) {
+    switch (field.type()) {
+        case cpp2::PropertyType::BOOL: {
+            if (!val.isBool()) {
+                break;
+            }
+            *dataOf(field) = val.getBool() ? 1 : 0;
+            return Status::OK();
+        }
+        case cpp2::PropertyType::INT8:
+            return writeInt<int8_t>(field, val);
+        case cpp2::PropertyType::INT16:
+            return writeInt<int16_t>(field, val);
+        case cpp2::PropertyType::INT32:
+            return writeInt<int32_t>(field, val);
+        case cpp2::PropertyType::INT64:
+        case cpp2::PropertyType::VID:
+        case cpp2::PropertyType::TIMESTAMP:
+            return writeInt<int64_t>(field, val);
+        case cpp2::PropertyType::FLOAT: {
+            if (!val.isNumeric()) {
+                break;
+            }
+            auto f = val.isInt() ? static_cast<double>(val.getInt()) : val.getFloat();
+            RowFormat::write<float>(dataOf(field), static_cast<float>(f));
+            return Status::OK();
+        }
+        case cpp2::PropertyType::DOUBLE: {
+            if (!val.isNumeric()) {
+                break;
+            }
+            auto f = val.isInt() ? static_cast<double>(val.getInt()) : val.getFloat();
+            RowFormat::write<double>(dataOf(field), f);
+            return Status::OK();
+        }
+        case cpp2::PropertyType::STRING:
+        case cpp2::PropertyType::FIXED_STRING:
+            return writeString(field, val);
+        case cpp2::PropertyType::DATE: {
+            if (!val.isDate()) {
+                break;
+            }
+            auto& date = val.getDate();
+            auto* pos = dataOf(field);
+            RowFormat::write<int16_t>(pos, date.year);
+            RowFormat::write<int8_t>(pos + 2, date.month);
+            RowFormat::write<int8_t>(pos + 3, date.day);
+            return Status::OK();
+        }
+        case cpp2::PropertyType::TIME: {
+            if (!val.isTime()) {
+                break;
+            }
+            auto& time = val.getTime();
+            auto* pos = dataOf(field);
+            RowFormat::write<int8_t>(pos, time.hour);
+            RowFormat::write<int8_t>(pos + 1, time.minute);
+            RowFormat::write<int8_t>(pos + 2, time.sec);
+            RowFormat::write<int32_t>(pos + 3, time.microsec);
+            return Status::OK();
+        }
+        case cpp2::PropertyType::DATETIME: {
+            if (!val.isDateTime()) {
+                break;
+            }
+            auto& dt = val.getDateTime();
+            auto* pos = dataOf(field);
+            RowFormat::write<int16_t>(pos, dt.year);
+            RowFormat::write<int8_t>(pos + 2, dt.month);
+            RowFormat::write<int8_t>(pos + 3, dt.day);
+            RowFormat::write<int8_t>(pos + 4, dt.hour);
+            RowFormat::write<int8_t>(pos + 5, dt.minute);
+            RowFormat::write<int8_t>(pos + 6, dt.sec);
+            RowFormat::write<int32_t>(pos + 7, dt.microsec);
+            return Status::OK();
+        }
+        case cpp2::PropertyType::UNKNOWN:
+            break;
+    }
+    return Status::Error("Field `%s' could not be set to %s",
+                         field.name(),
+                         val.typeName().c_str());
+}
+
+}  // namespace codec
+}  // namespace nebula
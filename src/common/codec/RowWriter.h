@@ -0,0 +1,88 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CODEC_ROWWRITER_H_
+#define COMMON_CODEC_ROWWRITER_H_
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/codec/RowFormat.h"
+#include "common/datatypes/Value.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+namespace codec {
+
+/**
+ * Encodes a row of the schema in RowFormat. The fixed-width fields are
+ * written in place, and the strings are appended to the row as they are set.
+ *
+ *   RowWriter writer(schema);
+ *   writer.set(0, 1);
+ *   writer.set("name", "Tim");
+ *   NG_RETURN_IF_ERROR(writer.finish());
+ *   auto row = writer.moveEncodedStr();
+ *
+ * The values are converted to the types of the fields, e.g. an int to a
+ * DOUBLE field, and an error is returned if they could not be, or the
+ * integers are out of the range of the fields.
+ */
+class RowWriter final {
+public:
+    explicit RowWriter(const meta::NebulaSchemaProvider* schema);
+
+    Status set(size_t index, const Value& val);
+    Status set(folly::StringPiece name, const Value& val);
+
+    // Fills the fields not set with their defaults, or null. It fails if any
+    // of them has neither.
+    Status finish();
+
+    const std::string& getEncodedStr() const {
+        DCHECK(finished_);
+        return buf_;
+    }
+
+    std::string moveEncodedStr() {
+        DCHECK(finished_);
+        return std::move(buf_);
+    }
+
+private:
+    using SchemaField = meta::NebulaSchemaProvider::SchemaField;
+
+    Status write(const SchemaField& field, const Value& val);
+
+    template <typename T>
+    Status writeInt(const SchemaField& field, const Value& val);
+
+    Status writeString(const SchemaField& field, const Value& val);
+
+    char* dataOf(const SchemaField& field) {
+        return &buf_[dataOffset_ + field.offset()];
+    }
+
+    void setNullBit(size_t pos, bool null) {
+        auto& flags = buf_[headerLen_ + (pos >> 3)];
+        if (null) {
+            flags |= RowFormat::kNullBits[pos & 7];
+        } else {
+            flags &= ~RowFormat::kNullBits[pos & 7];
+        }
+    }
+
+    const meta::NebulaSchemaProvider* schema_;
+    std::string buf_;
+    size_t headerLen_;
+    // Where the fixed-width fields start
+    size_t dataOffset_;
+    std::vector<bool> isSet_;
+    bool finished_{false};
+};
+
+}  // namespace codec
+}  // namespace nebula
+#endif  // COMMON_CODEC_ROWWRITER_H_
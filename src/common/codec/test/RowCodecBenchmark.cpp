@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/codec/RowReader.h"
+#include "common/codec/RowWriter.h"
+
+namespace nebula {
+namespace codec {
+
+// 24 fields, a third each of INT64, DOUBLE and STRING
+static constexpr size_t kNumFields = 24;
+static constexpr size_t kNumRows = 1000;
+
+struct Rows {
+    std::unique_ptr<meta::NebulaSchemaProvider> schema;
+    std::vector<std::string> encoded;
+    std::vector<folly::StringPiece> rows;
+    std::vector<size_t> all;
+    // An INT64 and a STRING field
+    std::vector<size_t> projected{3, 5};
+};
+
+static const Rows& rows() {
+    static const auto data = [] () {
+        Rows r;
+        r.schema = std::make_unique<meta::NebulaSchemaProvider>(1);
+        for (size_t i = 0; i < kNumFields; ++i) {
+            auto type = i % 3 == 0 ? cpp2::PropertyType::INT64
+                      : i % 3 == 1 ? cpp2::PropertyType::DOUBLE
+                      : cpp2::PropertyType::STRING;
+            r.schema->addField(folly::stringPrintf("col_%lu", i), type);
+            r.all.emplace_back(i);
+        }
+        for (size_t row = 0; row < kNumRows; ++row) {
+            RowWriter writer(r.schema.get());
+            for (size_t i = 0; i < kNumFields; ++i) {
+                Value val;
+                switch (i % 3) {
+                    case 0:
+                        val = static_cast<int64_t>(row * i);
+                        break;
+                    case 1:
+                        val = row * 0.5;
+                        break;
+                    default:
+                        val = folly::stringPrintf("a string value of row %lu", row);
+                        break;
+                }
+                CHECK(writer.set(i, val).ok());
+            }
+            CHECK(writer.finish().ok());
+            r.encoded.emplace_back(writer.moveEncodedStr());
+        }
+        r.rows.assign(r.encoded.begin(), r.encoded.end());
+        return r;
+    }();
+    return data;
+}
+
+// Each field decoded into a Value, as the consumers did property by property
+size_t materialize(size_t iters, bool projected) {
+    auto& r = rows();
+    auto& columns = projected ? r.projected : r.all;
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto row : r.rows) {
+            auto reader = RowReader::make(r.schema.get(), row);
+            for (auto column : columns) {
+                Value val = reader.value().getValue(column);
+                folly::doNotOptimizeAway(val);
+            }
+        }
+    }
+    return iters * kNumRows;
+}
+
+// Each field read in place by its type
+size_t readInPlace(size_t iters, bool projected) {
+    auto& r = rows();
+    auto& columns = projected ? r.projected : r.all;
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto row : r.rows) {
+            auto reader = RowReader::make(r.schema.get(), row);
+            auto& rd = reader.value();
+            for (auto column : columns) {
+                switch (column % 3) {
+                    case 0:
+                        folly::doNotOptimizeAway(rd.getInt(column));
+                        break;
+                    case 1:
+                        folly::doNotOptimizeAway(rd.getFloat(column));
+                        break;
+                    default:
+                        folly::doNotOptimizeAway(rd.getString(column));
+                        break;
+                }
+            }
+        }
+    }
+    return iters * kNumRows;
+}
+
+size_t decodeColumns(size_t iters, bool projected) {
+    auto& r = rows();
+    auto& columns = projected ? r.projected : r.all;
+    std::vector<ColumnVector> out;
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto& column : out) {
+            column.clear();
+        }
+        CHECK(RowReader::decodeColumns(r.schema.get(), r.rows, columns, out).ok());
+        folly::doNotOptimizeAway(out);
+    }
+    return iters * kNumRows;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(materialize, full_row, false)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(readInPlace, full_row, false)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(decodeColumns, full_row, false)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(materialize, projected, true)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(readInPlace, projected, true)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(decodeColumns, projected, true)
+
+}  // namespace codec
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
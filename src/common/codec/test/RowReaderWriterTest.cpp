@@ -0,0 +1,212 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/codec/RowReader.h"
+#include "common/codec/RowWriter.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+
+namespace nebula {
+namespace codec {
+
+class RowReaderWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        schema_ = std::make_unique<meta::NebulaSchemaProvider>(3);
+        schema_->addField("bool", cpp2::PropertyType::BOOL);
+        schema_->addField("int8", cpp2::PropertyType::INT8);
+        schema_->addField("int16", cpp2::PropertyType::INT16);
+        schema_->addField("int32", cpp2::PropertyType::INT32);
+        schema_->addField("int64", cpp2::PropertyType::INT64);
+        schema_->addField("float", cpp2::PropertyType::FLOAT);
+        schema_->addField("double", cpp2::PropertyType::DOUBLE);
+        schema_->addField("string", cpp2::PropertyType::STRING);
+        schema_->addField("fixed", cpp2::PropertyType::FIXED_STRING, 8);
+        schema_->addField("timestamp", cpp2::PropertyType::TIMESTAMP);
+        schema_->addField("date", cpp2::PropertyType::DATE);
+        schema_->addField("time", cpp2::PropertyType::TIME);
+        schema_->addField("datetime", cpp2::PropertyType::DATETIME);
+        schema_->addField("nullable", cpp2::PropertyType::STRING, 0, true);
+        schema_->addField("default",
+                          cpp2::PropertyType::INT64,
+                          0,
+                          false,
+                          ConstantExpression::make(&pool_, 7));
+        schema_->addField("now",
+                          cpp2::PropertyType::TIMESTAMP,
+                          0,
+                          false,
+                          FunctionCallExpression::make(&pool_, "now", ArgumentList::make(&pool_)));
+    }
+
+    // Sets all the fields without defaults
+    void setAll(RowWriter& writer, int64_t i) {
+        ASSERT_TRUE(writer.set("bool", i % 2 == 0).ok());
+        ASSERT_TRUE(writer.set("int8", i % 100).ok());
+        ASSERT_TRUE(writer.set("int16", i * 3).ok());
+        ASSERT_TRUE(writer.set("int32", i * 1000).ok());
+        ASSERT_TRUE(writer.set("int64", i * 1000000000L).ok());
+        ASSERT_TRUE(writer.set("float", 1.5).ok());
+        // An int to a double field
+        ASSERT_TRUE(writer.set("double", i).ok());
+        ASSERT_TRUE(writer.set("string", folly::stringPrintf("string_%ld", i)).ok());
+        ASSERT_TRUE(writer.set("fixed", "fix").ok());
+        ASSERT_TRUE(writer.set("timestamp", 1600000000L + i).ok());
+        ASSERT_TRUE(writer.set("date", Date(2021, 3, 4)).ok());
+        ASSERT_TRUE(writer.set("time", Time(5, 6, 7, 8)).ok());
+        ASSERT_TRUE(writer.set("datetime", DateTime(2021, 3, 4, 5, 6, 7, 8)).ok());
+    }
+
+    ObjectPool pool_;
+    std::unique_ptr<meta::NebulaSchemaProvider> schema_;
+};
+
+
+TEST_F(RowReaderWriterTest, AllTypes) {
+    RowWriter writer(schema_.get());
+    setAll(writer, 42);
+    ASSERT_TRUE(writer.set("nullable", "not null").ok());
+    ASSERT_TRUE(writer.finish().ok());
+    auto row = writer.moveEncodedStr();
+
+    auto ver = RowReader::getSchemaVer(row);
+    ASSERT_TRUE(ver.ok());
+    EXPECT_EQ(3, ver.value());
+
+    auto result = RowReader::make(schema_.get(), row);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto& reader = result.value();
+    EXPECT_TRUE(reader.getBool(0));
+    EXPECT_EQ(42, reader.getInt(1));
+    EXPECT_EQ(126, reader.getInt(2));
+    EXPECT_EQ(42000, reader.getInt(3));
+    EXPECT_EQ(42000000000L, reader.getInt(4));
+    EXPECT_EQ(1.5, reader.getFloat(5));
+    EXPECT_EQ(42.0, reader.getFloat(6));
+    EXPECT_EQ("string_42", reader.getString(7));
+    // The string refers to the row
+    EXPECT_GE(reader.getString(7).data(), row.data());
+    EXPECT_LT(reader.getString(7).data(), row.data() + row.size());
+    EXPECT_EQ("fix", reader.getString(8));
+    EXPECT_EQ(1600000042L, reader.getInt(9));
+    EXPECT_EQ(Date(2021, 3, 4), reader.getDate(10));
+    EXPECT_EQ(Time(5, 6, 7, 8), reader.getTime(11));
+    EXPECT_EQ(DateTime(2021, 3, 4, 5, 6, 7, 8), reader.getDateTime(12));
+    EXPECT_FALSE(reader.isNull(13));
+    EXPECT_EQ("not null", reader.getString(13));
+
+    EXPECT_EQ(Value(true), reader.getValue("bool"));
+    EXPECT_EQ(Value(42), reader.getValue("int8"));
+    EXPECT_EQ(Value(42.0), reader.getValue("double"));
+    EXPECT_EQ(Value("string_42"), reader.getValue("string"));
+    EXPECT_EQ(Value(Date(2021, 3, 4)), reader.getValue("date"));
+    EXPECT_EQ(Value::kNullUnknownProp, reader.getValue("unknown"));
+    EXPECT_EQ(Value::kNullOutOfRange, reader.getValue(100));
+}
+
+
+TEST_F(RowReaderWriterTest, NullAndDefault) {
+    RowWriter writer(schema_.get());
+    setAll(writer, 1);
+    ASSERT_TRUE(writer.finish().ok());
+    auto row = writer.moveEncodedStr();
+
+    auto result = RowReader::make(schema_.get(), row);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto& reader = result.value();
+    EXPECT_TRUE(reader.isNull(13));
+    EXPECT_EQ(Value::kNullValue, reader.getValue("nullable"));
+    EXPECT_EQ(7, reader.getInt(14));
+    EXPECT_LT(0, reader.getInt(15));
+
+    // Set to null explicitly
+    RowWriter nullWriter(schema_.get());
+    setAll(nullWriter, 1);
+    ASSERT_TRUE(nullWriter.set("nullable", "a").ok());
+    ASSERT_TRUE(nullWriter.set("nullable", Value::kNullValue).ok());
+    ASSERT_TRUE(nullWriter.finish().ok());
+    auto nullRow = nullWriter.moveEncodedStr();
+    auto nullReader = RowReader::make(schema_.get(), nullRow);
+    ASSERT_TRUE(nullReader.ok());
+    EXPECT_TRUE(nullReader.value().isNull(13));
+}
+
+
+TEST_F(RowReaderWriterTest, Errors) {
+    RowWriter writer(schema_.get());
+    EXPECT_FALSE(writer.set("int8", 128).ok());
+    EXPECT_FALSE(writer.set("int16", "1").ok());
+    EXPECT_FALSE(writer.set("bool", Value::kNullValue).ok());
+    EXPECT_FALSE(writer.set("unknown", 1).ok());
+    EXPECT_FALSE(writer.set(100, 1).ok());
+    // Not all the fields without defaults are set
+    EXPECT_FALSE(writer.finish().ok());
+
+    RowWriter full(schema_.get());
+    setAll(full, 1);
+    ASSERT_TRUE(full.finish().ok());
+    auto row = full.moveEncodedStr();
+
+    EXPECT_FALSE(RowReader::make(schema_.get(), "").ok());
+    EXPECT_FALSE(RowReader::make(schema_.get(), folly::StringPiece(row).subpiece(0, 10)).ok());
+    meta::NebulaSchemaProvider other(4);
+    other.addField("int64", cpp2::PropertyType::INT64);
+    EXPECT_FALSE(RowReader::make(&other, row).ok());
+}
+
+
+TEST_F(RowReaderWriterTest, DecodeColumns) {
+    constexpr int64_t kRows = 100;
+    std::vector<std::string> encoded;
+    for (int64_t i = 0; i < kRows; ++i) {
+        RowWriter writer(schema_.get());
+        setAll(writer, i);
+        if (i % 3 == 0) {
+            ASSERT_TRUE(writer.set("nullable", folly::stringPrintf("n%ld", i)).ok());
+        }
+        ASSERT_TRUE(writer.finish().ok());
+        encoded.emplace_back(writer.moveEncodedStr());
+    }
+    std::vector<folly::StringPiece> rows(encoded.begin(), encoded.end());
+
+    std::vector<ColumnVector> columns;
+    // int64, double, string, date, nullable
+    auto status = RowReader::decodeColumns(schema_.get(), rows, {4, 6, 7, 10, 13}, columns);
+    ASSERT_TRUE(status.ok()) << status;
+    ASSERT_EQ(5, columns.size());
+    for (auto& column : columns) {
+        EXPECT_EQ(kRows, column.size());
+    }
+    EXPECT_EQ(cpp2::PropertyType::INT64, columns[0].type);
+    EXPECT_EQ(cpp2::PropertyType::STRING, columns[2].type);
+    for (int64_t i = 0; i < kRows; ++i) {
+        EXPECT_EQ(i * 1000000000L, columns[0].ints[i]);
+        EXPECT_EQ(static_cast<double>(i), columns[1].floats[i]);
+        EXPECT_EQ(folly::stringPrintf("string_%ld", i), columns[2].strs[i]);
+        EXPECT_EQ(Value(Date(2021, 3, 4)), columns[3].values[i]);
+        if (i % 3 == 0) {
+            EXPECT_FALSE(columns[4].nulls[i]);
+            EXPECT_EQ(folly::stringPrintf("n%ld", i), columns[4].strs[i]);
+        } else {
+            EXPECT_TRUE(columns[4].nulls[i]);
+        }
+    }
+
+    EXPECT_FALSE(RowReader::decodeColumns(schema_.get(), rows, {100}, columns).ok());
+}
+
+}  // namespace codec
+}  // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -11,6 +11,7 @@
 #include <folly/RWSpinLock.h>
 #include "common/datatypes/Value.h"
 #include "common/datatypes/DataSet.h"
+#include "common/context/ExpressionFrame.h"
 
 namespace nebula {
 
@@ -75,8 +76,21 @@ public:
 
     virtual void setVar(const std::string& var, Value val) = 0;
 
+    // The frame which the bound expressions write their results to, so the same
+    // trees could be evaluated by the threads with their own contexts at once.
+    // The unbound expressions, or all of them if no frame is set, keep their
+    // results in themselves.
+    ExpressionFrame* frame() const {
+        return frame_;
+    }
+
+    void setFrame(ExpressionFrame* frame) {
+        frame_ = frame;
+    }
+
 private:
     std::unordered_map<std::string, std::regex> regex_;
+    ExpressionFrame*                             frame_{nullptr};
 };
 
 }  // namespace nebula
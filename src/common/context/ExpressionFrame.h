@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_CONTEXT_EXPRESSIONFRAME_H_
+#define COMMON_CONTEXT_EXPRESSIONFRAME_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "common/function/FunctionMemo.h"
+
+namespace nebula {
+
+/***************************************************************************
+ *
+ * The results of the nodes of bound expression trees, one slot per node,
+ * and the loop variables of list comprehension, reduce and predicate
+ * expressions, one local per variable, see ExprSlotBinder.
+ *
+ * A local refers to the element being iterated, so setting it copies nothing.
+ *
+ * The memos of the memoized function calls are kept here as well, by the
+ * slots of the calls, since they are written by each call.
+ *
+ * Each thread evaluating the same trees keeps its own frame, which is set
+ * to its ExpressionContext, so the trees themselves are not written.
+ *
+ * The frame is NOT thread-safe
+ *
+ **************************************************************************/
+class ExpressionFrame final {
+public:
+    explicit ExpressionFrame(size_t numSlots = 0, size_t numLocals = 0)
+        : slots_(numSlots), locals_(numLocals, &Value::kNullValue) {}
+
+    size_t size() const {
+        return slots_.size();
+    }
+
+    size_t numLocals() const {
+        return locals_.size();
+    }
+
+    // Grows only, so a frame could be reused for trees with fewer slots
+    void resize(size_t numSlots, size_t numLocals = 0) {
+        if (numSlots > slots_.size()) {
+            slots_.resize(numSlots);
+        }
+        if (numLocals > locals_.size()) {
+            locals_.resize(numLocals, &Value::kNullValue);
+        }
+    }
+
+    Value& slot(size_t index) {
+        DCHECK_LT(index, slots_.size());
+        return slots_[index];
+    }
+
+    // The value should outlive the reads of the local
+    void setLocal(size_t index, const Value* val) {
+        DCHECK_LT(index, locals_.size());
+        locals_[index] = val;
+    }
+
+    const Value& local(size_t index) const {
+        DCHECK_LT(index, locals_.size());
+        return *locals_[index];
+    }
+
+    // The memo of the function call bound to slot `index', which is created
+    // by the call on its first evaluation with this frame
+    std::unique_ptr<FunctionMemo>& memo(size_t index) {
+        DCHECK_LT(index, slots_.size());
+        return memos_[index];
+    }
+
+    // nullptr if the call has not been evaluated with this frame
+    const FunctionMemo* findMemo(size_t index) const {
+        auto found = memos_.find(index);
+        return found == memos_.end() ? nullptr : found->second.get();
+    }
+
+    // Release the values held, keeping the slots, and the memos for the rest
+    // of the query
+    void reset() {
+        for (auto& val : slots_) {
+            val.clear();
+        }
+        std::fill(locals_.begin(), locals_.end(), &Value::kNullValue);
+    }
+
+private:
+    std::vector<Value> slots_;
+    std::vector<const Value*> locals_;
+    // Few calls are memoized, so they are not of a slot each
+    std::unordered_map<size_t, std::unique_ptr<FunctionMemo>> memos_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_CONTEXT_EXPRESSIONFRAME_H_
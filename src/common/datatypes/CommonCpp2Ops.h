@@ -24,6 +24,9 @@ struct Map;
 struct Set;
 struct List;
 struct DataSet;
+class Symbol;
+template <class Key> class BasicPropMap;
+using PropMap = BasicPropMap<Symbol>;
 }   // namespace nebula
 
 namespace apache::thrift {
@@ -43,6 +46,7 @@ SPECIALIZE_CPP2OPS(nebula::Map);
 SPECIALIZE_CPP2OPS(nebula::Set);
 SPECIALIZE_CPP2OPS(nebula::List);
 SPECIALIZE_CPP2OPS(nebula::DataSet);
+SPECIALIZE_CPP2OPS(nebula::PropMap);
 
 }   // namespace apache::thrift
 
@@ -7,10 +7,10 @@
 #ifndef COMMON_DATATYPES_EDGE_H_
 #define COMMON_DATATYPES_EDGE_H_
 
-#include <unordered_map>
-
+#include "common/base/Symbol.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/datatypes/Value.h"
+#include "common/datatypes/PropMap.h"
 
 namespace nebula {
 
@@ -18,9 +18,9 @@ struct Edge {
     Value src;
     Value dst;
     EdgeType type;
-    std::string name;
+    Symbol name;
     EdgeRanking ranking;
-    std::unordered_map<std::string, Value> props;
+    PropMap props;
 
     Edge() {}
     Edge(Edge&& v) noexcept
@@ -40,9 +40,9 @@ struct Edge {
     Edge(Value s,
          Value d,
          EdgeType t,
-         std::string n,
+         Symbol n,
          EdgeRanking r,
-         std::unordered_map<std::string, Value>&& p)
+         PropMap&& p)
         : src(std::move(s))
         , dst(std::move(d))
         , type(std::move(t))
@@ -7,19 +7,19 @@
 #ifndef COMMON_DATATYPES_MAP_H_
 #define COMMON_DATATYPES_MAP_H_
 
-#include <unordered_map>
-
 #include "common/datatypes/Value.h"
+#include "common/datatypes/PropMap.h"
 
 namespace nebula {
 
 struct Map {
-    std::unordered_map<std::string, Value> kvs;
+    // Keyed by std::strings, which are user data rather than schema names
+    MapKvs kvs;
 
     Map() = default;
     Map(const Map&) = default;
     Map(Map&&) noexcept = default;
-    explicit Map(std::unordered_map<std::string, Value> values) {
+    explicit Map(MapKvs values) {
         kvs = std::move(values);
     }
 
@@ -56,7 +56,7 @@ struct Map {
         return kvs.count(value.getStr()) != 0;
     }
 
-    const Value& at(const std::string &key) const {
+    const Value& at(folly::StringPiece key) const {
         auto iter = kvs.find(key);
         if (iter == kvs.end()) {
             return Value::kNullUnknownProp;
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Map.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropMapOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -48,10 +49,7 @@ uint32_t Cpp2Ops<nebula::Map>::write(Protocol* proto, nebula::Map const* obj) {
     xfer += proto->writeStructBegin("NMap");
 
     xfer += proto->writeFieldBegin("kvs", apache::thrift::protocol::T_MAP, 1);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->kvs);
+    xfer += detail::writePropMap(proto, &obj->kvs);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -74,11 +72,7 @@ void Cpp2Ops<nebula::Map>::read(Protocol* proto, nebula::Map* obj) {
 
 _readField_kvs:
     {
-        obj->kvs = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->kvs);
+        detail::readPropMap(proto, &obj->kvs);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 1, 0, protocol::T_STOP))) {
@@ -128,10 +122,7 @@ uint32_t Cpp2Ops<nebula::Map>::serializedSize(Protocol const* proto,
     xfer += proto->serializedStructSize("NMap");
 
     xfer += proto->serializedFieldSize("kvs", apache::thrift::protocol::T_MAP, 1);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->kvs);
+    xfer += detail::serializedSizePropMap(proto, &obj->kvs);
     xfer += proto->serializedSizeStop();
     return xfer;
 }
@@ -144,10 +135,7 @@ uint32_t Cpp2Ops<nebula::Map>::serializedSizeZC(Protocol const* proto,
     xfer += proto->serializedStructSize("NMap");
 
     xfer += proto->serializedFieldSize("kvs", apache::thrift::protocol::T_MAP, 1);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->kvs);
+    xfer += detail::serializedSizeZCPropMap(proto, &obj->kvs);
     xfer += proto->serializedSizeStop();
     return xfer;
 }
@@ -7,6 +7,7 @@
 #ifndef COMMON_DATATYPES_PATH_H_
 #define COMMON_DATATYPES_PATH_H_
 
+#include "common/base/Symbol.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/Vertex.h"
@@ -16,9 +17,9 @@ namespace nebula {
 struct Step {
     Vertex dst;
     EdgeType type;
-    std::string name;
+    Symbol name;
     EdgeRanking ranking;
-    std::unordered_map<std::string, Value> props;
+    PropMap props;
 
     Step() = default;
     Step(const Step& s) : dst(s.dst)
@@ -34,9 +35,9 @@ struct Step {
         , props(std::move(s.props)) {}
     Step(Vertex d,
          EdgeType t,
-         std::string n,
+         Symbol n,
          EdgeRanking r,
-         std::unordered_map<std::string, Value> p) noexcept
+         PropMap p) noexcept
         : dst(std::move(d)), type(t), name(std::move(n)), ranking(r), props(std::move(p)) {}
 
     void clear() {
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Path.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropMapOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -79,7 +80,7 @@ uint32_t Cpp2Ops<nebula::Step>::write(Protocol* proto, nebula::Step const* obj)
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("name", apache::thrift::protocol::T_STRING, 3);
-    xfer += proto->writeBinary(obj->name);
+    xfer += proto->writeBinary(obj->name.str());
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("ranking", apache::thrift::protocol::T_I64, 4);
@@ -88,10 +89,7 @@ uint32_t Cpp2Ops<nebula::Step>::write(Protocol* proto, nebula::Step const* obj)
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::write(proto, &obj->props);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -133,7 +131,9 @@ _readField_type:
 
 _readField_name:
     {
-        proto->readBinary(obj->name);
+        std::string name;
+        proto->readBinary(name);
+        obj->name = nebula::Symbol::name(std::move(name));
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 3, 4, protocol::T_I64))) {
@@ -152,11 +152,7 @@ _readField_ranking:
 
 _readField_props:
     {
-        obj->props = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->props);
+        detail::readPropMap(proto, &obj->props);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 5, 0, protocol::T_STOP))) {
@@ -246,17 +242,14 @@ uint32_t Cpp2Ops<nebula::Step>::serializedSize(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->type);
 
     xfer += proto->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 3);
-    xfer += proto->serializedSizeBinary(obj->name);
+    xfer += proto->serializedSizeBinary(obj->name.str());
 
     xfer += proto->serializedFieldSize("ranking", apache::thrift::protocol::T_I64, 4);
     xfer += detail::pm::protocol_methods<type_class::integral, nebula::EdgeRanking>
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -277,17 +270,14 @@ uint32_t Cpp2Ops<nebula::Step>::serializedSizeZC(Protocol const* proto,
         ::serializedSize<false>(*proto, obj->type);
 
     xfer += proto->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 3);
-    xfer += proto->serializedSizeZCBinary(obj->name);
+    xfer += proto->serializedSizeZCBinary(obj->name.str());
 
     xfer += proto->serializedFieldSize("ranking", apache::thrift::protocol::T_I64, 4);
     xfer += detail::pm::protocol_methods<type_class::integral, nebula::EdgeRanking>
         ::serializedSize<false>(*proto, obj->ranking);
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 5);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::serializedSizeZC(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
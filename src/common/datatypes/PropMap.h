@@ -0,0 +1,371 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PROPMAP_H_
+#define COMMON_DATATYPES_PROPMAP_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <folly/Range.h>
+
+#include "common/base/Symbol.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * The map from names to Values of Tag::props, Edge::props, Step::props, i.e.
+ * PropMap, and of Map::kvs, i.e. MapKvs.
+ *
+ * The entries are kept in a vector sorted by name, which is one allocation for
+ * the whole map instead of one per node, and is scanned fast for the few
+ * properties a tag or an edge usually has. Insertion is O(n), so large maps
+ * should not be built one by one, but in bulk, by a Builder, the constructors
+ * or the range insert(), which sort the entries once.
+ *
+ * The interface is the subset of std::unordered_map used on these fields, with
+ * the lookups by folly::StringPiece, which saves building a std::string from
+ * the name. Iterators are invalidated by insertion and erasure, like those of
+ * a vector.
+ *
+ * The props of tags, edges and steps are keyed by Symbols of the schema names,
+ * which are interned when decoded. The keys of a Map are user data, which are
+ * never interned, so they are kept as std::strings, whose short ones take no
+ * allocation of their own.
+ *
+ * It is serialized as a thrift map<binary, Value>, see PropMapOps.inl.
+ */
+template <class Key>
+class BasicPropMap final {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using container_type = std::vector<value_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using size_type = typename container_type::size_type;
+
+    /**
+     * Appends the entries unsorted, and sorts them once in build(), i.e.
+     * O(n log n) for n entries instead of O(n^2) by emplace(). The first one
+     * of the duplicated names is kept.
+     */
+    class Builder final {
+    public:
+        Builder() = default;
+
+        explicit Builder(size_type expected) {
+            kvs_.reserve(expected);
+        }
+
+        template <class K, class... Args>
+        Builder& emplace(K&& key, Args&&... args) {
+            kvs_.emplace_back(std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+            return *this;
+        }
+
+        size_type size() const {
+            return kvs_.size();
+        }
+
+        BasicPropMap build() && {
+            return BasicPropMap(std::move(kvs_));
+        }
+
+    private:
+        container_type kvs_;
+    };
+
+    BasicPropMap() = default;
+    BasicPropMap(const BasicPropMap&) = default;
+    BasicPropMap(BasicPropMap&&) noexcept = default;
+    BasicPropMap& operator=(const BasicPropMap&) = default;
+    BasicPropMap& operator=(BasicPropMap&&) noexcept = default;
+
+    // The first one of the duplicated names is kept, like std::unordered_map
+    BasicPropMap(std::initializer_list<value_type> kvs)
+        : kvs_(kvs) {
+        sortAndUnique();
+    }
+
+    explicit BasicPropMap(container_type kvs)
+        : kvs_(std::move(kvs)) {
+        sortAndUnique();
+    }
+
+    // Not explicit, so the code building the props in a std::unordered_map
+    // still works
+    BasicPropMap(const std::unordered_map<std::string, Value>& kvs)   // NOLINT
+        : kvs_(kvs.begin(), kvs.end()) {
+        sortAndUnique();
+    }
+
+    BasicPropMap(std::unordered_map<std::string, Value>&& kvs) {      // NOLINT
+        kvs_.reserve(kvs.size());
+        for (auto& kv : kvs) {
+            kvs_.emplace_back(kv.first, std::move(kv.second));
+        }
+        kvs.clear();
+        sortAndUnique();
+    }
+
+    template <class InputIt>
+    BasicPropMap(InputIt first, InputIt last)
+        : kvs_(first, last) {
+        sortAndUnique();
+    }
+
+    iterator begin() {
+        return kvs_.begin();
+    }
+
+    iterator end() {
+        return kvs_.end();
+    }
+
+    const_iterator begin() const {
+        return kvs_.begin();
+    }
+
+    const_iterator end() const {
+        return kvs_.end();
+    }
+
+    const_iterator cbegin() const {
+        return kvs_.cbegin();
+    }
+
+    const_iterator cend() const {
+        return kvs_.cend();
+    }
+
+    size_type size() const {
+        return kvs_.size();
+    }
+
+    bool empty() const {
+        return kvs_.empty();
+    }
+
+    void clear() {
+        kvs_.clear();
+    }
+
+    void reserve(size_type n) {
+        kvs_.reserve(n);
+    }
+
+    iterator find(folly::StringPiece key) {
+        auto iter = lowerBound(key);
+        return iter != kvs_.end() && key == pieceOf(iter->first) ? iter : kvs_.end();
+    }
+
+    const_iterator find(folly::StringPiece key) const {
+        return const_cast<BasicPropMap*>(this)->find(key);
+    }
+
+    size_type count(folly::StringPiece key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    bool contains(folly::StringPiece key) const {
+        return find(key) != end();
+    }
+
+    // Throws std::out_of_range if not found, like std::unordered_map
+    Value& at(folly::StringPiece key) {
+        auto iter = find(key);
+        if (iter == kvs_.end()) {
+            throw std::out_of_range("PropMap::at: no such key");
+        }
+        return iter->second;
+    }
+
+    const Value& at(folly::StringPiece key) const {
+        return const_cast<BasicPropMap*>(this)->at(key);
+    }
+
+    Value& operator[](const Key& key) {
+        return emplace(key).first->second;
+    }
+
+    Value& operator[](Key&& key) {
+        return emplace(std::move(key)).first->second;
+    }
+
+    // Does nothing if the key exists already, the value is not constructed
+    // then, i.e. it is the try_emplace() of std::unordered_map
+    template <class K, class... Args>
+    std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+        auto name = pieceOf(key);
+        auto iter = lowerBound(name);
+        if (iter != kvs_.end() && name == pieceOf(iter->first)) {
+            return {iter, false};
+        }
+        iter = kvs_.emplace(iter,
+                            std::piecewise_construct,
+                            std::forward_as_tuple(std::forward<K>(key)),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iter, true};
+    }
+
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& kv) {
+        return emplace(kv.first, kv.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& kv) {
+        return emplace(std::move(kv.first), std::move(kv.second));
+    }
+
+    // Appended and sorted in bulk, the existing entries are kept over the
+    // inserted ones of the same names
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        auto oldSize = kvs_.size();
+        for (; first != last; ++first) {
+            kvs_.emplace_back(first->first, first->second);
+        }
+        mergeTail(oldSize);
+    }
+
+    template <class V>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, V&& val) {
+        auto res = emplace(key, std::forward<V>(val));
+        if (!res.second) {
+            res.first->second = std::forward<V>(val);
+        }
+        return res;
+    }
+
+    size_type erase(folly::StringPiece key) {
+        auto iter = find(key);
+        if (iter == kvs_.end()) {
+            return 0;
+        }
+        kvs_.erase(iter);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) {
+        return kvs_.erase(pos);
+    }
+
+    // The key of a name decoded, e.g. from thrift: a schema name is interned
+    // by Symbol::name(), a key of a Map is kept as is
+    static Key decodedKey(std::string&& name);
+
+    // Both are sorted, so equal maps have their entries in the same order
+    bool operator==(const BasicPropMap& rhs) const {
+        return kvs_ == rhs.kvs_;
+    }
+
+    bool operator!=(const BasicPropMap& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    static folly::StringPiece pieceOf(const Symbol& key) {
+        return key.str();
+    }
+
+    static folly::StringPiece pieceOf(const std::string& key) {
+        return key;
+    }
+
+    static folly::StringPiece pieceOf(const char* key) {
+        return key;
+    }
+
+    static folly::StringPiece pieceOf(folly::StringPiece key) {
+        return key;
+    }
+
+    iterator lowerBound(folly::StringPiece key) {
+        // The names are usually appended in order, e.g. when decoded
+        if (kvs_.empty() || pieceOf(kvs_.back().first) < key) {
+            return kvs_.end();
+        }
+        return std::lower_bound(kvs_.begin(), kvs_.end(), key,
+                                [] (const value_type& kv, folly::StringPiece k) {
+                                    return pieceOf(kv.first) < k;
+                                });
+    }
+
+    static bool less(const value_type& lhs, const value_type& rhs) {
+        return pieceOf(lhs.first) < pieceOf(rhs.first);
+    }
+
+    // Sort the entries from `oldSize' on, and merge them into the sorted ones
+    // before, which go first among the equal names
+    void mergeTail(size_type oldSize) {
+        if (oldSize == kvs_.size()) {
+            return;
+        }
+        auto mid = kvs_.begin() + oldSize;
+        if (!std::is_sorted(mid, kvs_.end(), less)) {
+            std::stable_sort(mid, kvs_.end(), less);
+        }
+        if (oldSize > 0 && !less(*(mid - 1), *mid)) {
+            std::inplace_merge(kvs_.begin(), mid, kvs_.end(), less);
+        }
+        auto last = std::unique(kvs_.begin(), kvs_.end(),
+                                [] (const value_type& lhs, const value_type& rhs) {
+                                    return lhs.first == rhs.first;
+                                });
+        kvs_.erase(last, kvs_.end());
+    }
+
+    void sortAndUnique() {
+        if (std::is_sorted(kvs_.begin(), kvs_.end(), less)) {
+            // Names in order could still be duplicated
+            if (std::adjacent_find(kvs_.begin(), kvs_.end(),
+                                   [] (const value_type& lhs, const value_type& rhs) {
+                                       return lhs.first == rhs.first;
+                                   }) == kvs_.end()) {
+                return;
+            }
+        } else {
+            std::stable_sort(kvs_.begin(), kvs_.end(), less);
+        }
+        auto last = std::unique(kvs_.begin(), kvs_.end(),
+                                [] (const value_type& lhs, const value_type& rhs) {
+                                    return lhs.first == rhs.first;
+                                });
+        kvs_.erase(last, kvs_.end());
+    }
+
+    container_type kvs_;
+};
+
+using PropMap = BasicPropMap<Symbol>;
+using MapKvs = BasicPropMap<std::string>;
+
+template <>
+inline Symbol PropMap::decodedKey(std::string&& name) {
+    return Symbol::name(std::move(name));
+}
+
+template <>
+inline std::string MapKvs::decodedKey(std::string&& name) {
+    return std::move(name);
+}
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_PROPMAP_H_
@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_DATATYPES_PROPMAPOPS_H_
+#define COMMON_DATATYPES_PROPMAPOPS_H_
+
+#include "common/base/Base.h"
+
+#include <thrift/lib/cpp2/GeneratedCodeHelper.h>
+
+#include "common/datatypes/PropMap.h"
+#include "common/datatypes/CommonCpp2Ops.h"
+
+namespace apache {
+namespace thrift {
+
+/**************************************
+ *
+ * Ops for class PropMap, which is on the wire the same as the
+ * map<binary, Value> of the fields it is used for. The kvs of a Map, i.e.
+ * MapKvs, are read and written by the same helpers.
+ *
+ *************************************/
+namespace detail {
+
+template<class Protocol, class Props>
+uint32_t writePropMap(Protocol* proto, Props const* obj) {
+    uint32_t xfer = 0;
+    xfer += proto->writeMapBegin(apache::thrift::protocol::T_STRING,
+                                 apache::thrift::protocol::T_STRUCT,
+                                 obj->size());
+    for (const auto& kv : *obj) {
+        xfer += proto->writeBinary(static_cast<const std::string&>(kv.first));
+        xfer += Cpp2Ops<nebula::Value>::write(proto, &kv.second);
+    }
+    xfer += proto->writeMapEnd();
+    return xfer;
+}
+
+
+// Reads a map<binary, Value>, whose keys are schema names interned if it's a
+// PropMap, or kept as they are if it's the MapKvs of a Map
+template<class Protocol, class Props>
+void readPropMap(Protocol* proto, Props* obj) {
+    typename Props::container_type kvs;
+    auto readEntry = [proto, &kvs] () {
+        std::string key;
+        proto->readBinary(key);
+        nebula::Value val;
+        Cpp2Ops<nebula::Value>::read(proto, &val);
+        kvs.emplace_back(Props::decodedKey(std::move(key)), std::move(val));
+    };
+
+    apache::thrift::protocol::TType keyType;
+    apache::thrift::protocol::TType valType;
+    uint32_t size = 0;
+    proto->readMapBegin(keyType, valType, size);
+    if (proto->kOmitsContainerSizes()) {
+        while (proto->peekMap()) {
+            readEntry();
+        }
+    } else if (size > 0) {
+        if (keyType == apache::thrift::protocol::T_STRING &&
+                valType == apache::thrift::protocol::T_STRUCT) {
+            kvs.reserve(size);
+            for (uint32_t i = 0; i < size; ++i) {
+                readEntry();
+            }
+        } else {
+            for (uint32_t i = 0; i < size; ++i) {
+                proto->skip(keyType);
+                proto->skip(valType);
+            }
+        }
+    }
+    proto->readMapEnd();
+
+    // The entries are written in order, so they are usually not sorted again
+    *obj = Props(std::move(kvs));
+}
+
+
+template<class Protocol, class Props>
+uint32_t serializedSizePropMap(Protocol const* proto, Props const* obj) {
+    uint32_t xfer = 0;
+    xfer += proto->serializedSizeMapBegin(apache::thrift::protocol::T_STRING,
+                                          apache::thrift::protocol::T_STRUCT,
+                                          obj->size());
+    for (const auto& kv : *obj) {
+        xfer += proto->serializedSizeBinary(static_cast<const std::string&>(kv.first));
+        xfer += Cpp2Ops<nebula::Value>::serializedSize(proto, &kv.second);
+    }
+    xfer += proto->serializedSizeMapEnd();
+    return xfer;
+}
+
+
+template<class Protocol, class Props>
+uint32_t serializedSizeZCPropMap(Protocol const* proto, Props const* obj) {
+    uint32_t xfer = 0;
+    xfer += proto->serializedSizeMapBegin(apache::thrift::protocol::T_STRING,
+                                          apache::thrift::protocol::T_STRUCT,
+                                          obj->size());
+    for (const auto& kv : *obj) {
+        xfer += proto->serializedSizeZCBinary(static_cast<const std::string&>(kv.first));
+        xfer += Cpp2Ops<nebula::Value>::serializedSizeZC(proto, &kv.second);
+    }
+    xfer += proto->serializedSizeMapEnd();
+    return xfer;
+}
+
+}  // namespace detail
+
+
+inline constexpr protocol::TType Cpp2Ops<nebula::PropMap>::thriftType() {
+    return apache::thrift::protocol::T_MAP;
+}
+
+
+template<class Protocol>
+uint32_t Cpp2Ops<nebula::PropMap>::write(Protocol* proto, nebula::PropMap const* obj) {
+    return detail::writePropMap(proto, obj);
+}
+
+
+template<class Protocol>
+void Cpp2Ops<nebula::PropMap>::read(Protocol* proto, nebula::PropMap* obj) {
+    detail::readPropMap(proto, obj);
+}
+
+
+template<class Protocol>
+uint32_t Cpp2Ops<nebula::PropMap>::serializedSize(Protocol const* proto,
+                                                  nebula::PropMap const* obj) {
+    return detail::serializedSizePropMap(proto, obj);
+}
+
+
+template<class Protocol>
+uint32_t Cpp2Ops<nebula::PropMap>::serializedSizeZC(Protocol const* proto,
+                                                    nebula::PropMap const* obj) {
+    return detail::serializedSizeZCPropMap(proto, obj);
+}
+
+}  // namespace thrift
+}  // namespace apache
+#endif  // COMMON_DATATYPES_PROPMAPOPS_H_
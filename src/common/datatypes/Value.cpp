@@ -64,13 +64,31 @@ std::size_t hash<nebula::Value>::operator()(const nebula::Value& v) const noexce
             return hash<nebula::List>()(v.getList());
         }
         case nebula::Value::Type::MAP: {
-            LOG(FATAL) << "Hash for MAP has not been implemented";
+            // Combine the entries commutatively, regardless of their order
+            size_t seed = 0;
+            for (auto& kv : v.getMap().kvs) {
+                auto h = hash<string>()(kv.first);
+                h ^= hash<nebula::Value>()(kv.second) + 0x9e3779b9 + (h << 6) + (h >> 2);
+                seed += h;
+            }
+            return seed;
         }
         case nebula::Value::Type::SET: {
-            LOG(FATAL) << "Hash for SET has not been implemented";
+            size_t seed = 0;
+            for (auto& value : v.getSet().values) {
+                seed += hash<nebula::Value>()(value);
+            }
+            return seed;
         }
         case nebula::Value::Type::DATASET: {
-            LOG(FATAL) << "Hash for DATASET has not been implemented";
+            size_t seed = 0;
+            for (auto& name : v.getDataSet().colNames) {
+                seed ^= hash<string>()(name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            for (auto& row : v.getDataSet().rows) {
+                seed ^= hash<nebula::List>()(row) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
         }
         default: {
             LOG(FATAL) << "Unknown type";
@@ -844,27 +862,27 @@ DateTime& Value::mutableDateTime() {
 
 Vertex& Value::mutableVertex() {
     CHECK_EQ(type_, Type::VERTEX);
-    return *(value_.vVal);
+    return value_.vVal.mutableRef();
 }
 
 Edge& Value::mutableEdge() {
     CHECK_EQ(type_, Type::EDGE);
-    return *(value_.eVal);
+    return value_.eVal.mutableRef();
 }
 
 Path& Value::mutablePath() {
     CHECK_EQ(type_, Type::PATH);
-    return *(value_.pVal);
+    return value_.pVal.mutableRef();
 }
 
 List& Value::mutableList() {
     CHECK_EQ(type_, Type::LIST);
-    return *(value_.lVal);
+    return value_.lVal.mutableRef();
 }
 
 Map& Value::mutableMap() {
     CHECK_EQ(type_, Type::MAP);
-    return *(value_.mVal);
+    return value_.mVal.mutableRef();
 }
 
 Set& Value::mutableSet() {
@@ -936,35 +954,35 @@ DateTime Value::moveDateTime() {
 
 Vertex Value::moveVertex() {
     CHECK_EQ(type_, Type::VERTEX);
-    Vertex v = std::move(*(value_.vVal));
+    Vertex v = value_.vVal.take();
     clear();
     return v;
 }
 
 Edge Value::moveEdge() {
     CHECK_EQ(type_, Type::EDGE);
-    Edge v = std::move(*(value_.eVal));
+    Edge v = value_.eVal.take();
     clear();
     return v;
 }
 
 Path Value::movePath() {
     CHECK_EQ(type_, Type::PATH);
-    Path v = std::move(*(value_.pVal));
+    Path v = value_.pVal.take();
     clear();
     return v;
 }
 
 List Value::moveList() {
     CHECK_EQ(type_, Type::LIST);
-    List list = std::move(*(value_.lVal));
+    List list = value_.lVal.take();
     clear();
     return list;
 }
 
 Map Value::moveMap() {
     CHECK_EQ(type_, Type::MAP);
-    Map map = std::move(*(value_.mVal));
+    Map map = value_.mVal.take();
     clear();
     return map;
 }
@@ -1341,104 +1359,129 @@ void Value::setDT(DateTime&& v) {
     new (std::addressof(value_.dtVal)) DateTime(std::move(v));
 }
 
-void Value::setV(const std::unique_ptr<Vertex>& v) {
+void Value::setV(const CowPtr<Vertex>& v) {
+    type_ = Type::VERTEX;
+    new (std::addressof(value_.vVal)) CowPtr<Vertex>(v);
+}
+
+void Value::setV(CowPtr<Vertex>&& v) {
     type_ = Type::VERTEX;
-    new (std::addressof(value_.vVal)) std::unique_ptr<Vertex>(new Vertex(*v));
+    new (std::addressof(value_.vVal)) CowPtr<Vertex>(std::move(v));
 }
 
 void Value::setV(std::unique_ptr<Vertex>&& v) {
     type_ = Type::VERTEX;
-    new (std::addressof(value_.vVal)) std::unique_ptr<Vertex>(std::move(v));
+    new (std::addressof(value_.vVal)) CowPtr<Vertex>(std::move(v));
 }
 
 void Value::setV(const Vertex& v) {
     type_ = Type::VERTEX;
-    new (std::addressof(value_.vVal)) std::unique_ptr<Vertex>(new Vertex(v));
+    new (std::addressof(value_.vVal)) CowPtr<Vertex>(CowPtr<Vertex>::make(v));
 }
 
 void Value::setV(Vertex&& v) {
     type_ = Type::VERTEX;
-    new (std::addressof(value_.vVal)) std::unique_ptr<Vertex>(new Vertex(std::move(v)));
+    new (std::addressof(value_.vVal)) CowPtr<Vertex>(CowPtr<Vertex>::make(std::move(v)));
 }
 
-void Value::setE(const std::unique_ptr<Edge>& v) {
+void Value::setE(const CowPtr<Edge>& v) {
     type_ = Type::EDGE;
-    new (std::addressof(value_.eVal)) std::unique_ptr<Edge>(new Edge(*v));
+    new (std::addressof(value_.eVal)) CowPtr<Edge>(v);
+}
+
+void Value::setE(CowPtr<Edge>&& v) {
+    type_ = Type::EDGE;
+    new (std::addressof(value_.eVal)) CowPtr<Edge>(std::move(v));
 }
 
 void Value::setE(std::unique_ptr<Edge>&& v) {
     type_ = Type::EDGE;
-    new (std::addressof(value_.eVal)) std::unique_ptr<Edge>(std::move(v));
+    new (std::addressof(value_.eVal)) CowPtr<Edge>(std::move(v));
 }
 
 void Value::setE(const Edge& v) {
     type_ = Type::EDGE;
-    new (std::addressof(value_.eVal)) std::unique_ptr<Edge>(new Edge(v));
+    new (std::addressof(value_.eVal)) CowPtr<Edge>(CowPtr<Edge>::make(v));
 }
 
 void Value::setE(Edge&& v) {
     type_ = Type::EDGE;
-    new (std::addressof(value_.eVal)) std::unique_ptr<Edge>(new Edge(std::move(v)));
+    new (std::addressof(value_.eVal)) CowPtr<Edge>(CowPtr<Edge>::make(std::move(v)));
+}
+
+void Value::setP(const CowPtr<Path>& v) {
+    type_ = Type::PATH;
+    new (std::addressof(value_.pVal)) CowPtr<Path>(v);
 }
 
-void Value::setP(const std::unique_ptr<Path>& v) {
+void Value::setP(CowPtr<Path>&& v) {
     type_ = Type::PATH;
-    new (std::addressof(value_.pVal)) std::unique_ptr<Path>(new Path(*v));
+    new (std::addressof(value_.pVal)) CowPtr<Path>(std::move(v));
 }
 
 void Value::setP(std::unique_ptr<Path>&& v) {
     type_ = Type::PATH;
-    new (std::addressof(value_.pVal)) std::unique_ptr<Path>(std::move(v));
+    new (std::addressof(value_.pVal)) CowPtr<Path>(std::move(v));
 }
 
 void Value::setP(const Path& v) {
     type_ = Type::PATH;
-    new (std::addressof(value_.pVal)) std::unique_ptr<Path>(new Path(v));
+    new (std::addressof(value_.pVal)) CowPtr<Path>(CowPtr<Path>::make(v));
 }
 
 void Value::setP(Path&& v) {
     type_ = Type::PATH;
-    new (std::addressof(value_.pVal)) std::unique_ptr<Path>(new Path(std::move(v)));
+    new (std::addressof(value_.pVal)) CowPtr<Path>(CowPtr<Path>::make(std::move(v)));
 }
 
-void Value::setL(const std::unique_ptr<List>& v) {
+void Value::setL(const CowPtr<List>& v) {
     type_ = Type::LIST;
-    new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(*v));
+    new (std::addressof(value_.lVal)) CowPtr<List>(v);
+}
+
+void Value::setL(CowPtr<List>&& v) {
+    type_ = Type::LIST;
+    new (std::addressof(value_.lVal)) CowPtr<List>(std::move(v));
 }
 
 void Value::setL(std::unique_ptr<List>&& v) {
     type_ = Type::LIST;
-    new (std::addressof(value_.lVal)) std::unique_ptr<List>(std::move(v));
+    new (std::addressof(value_.lVal)) CowPtr<List>(std::move(v));
 }
 
 void Value::setL(const List& v) {
     type_ = Type::LIST;
-    new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(v));
+    new (std::addressof(value_.lVal)) CowPtr<List>(CowPtr<List>::make(v));
 }
 
 void Value::setL(List&& v) {
     type_ = Type::LIST;
-    new (std::addressof(value_.lVal)) std::unique_ptr<List>(new List(std::move(v)));
+    new (std::addressof(value_.lVal)) CowPtr<List>(CowPtr<List>::make(std::move(v)));
+}
+
+void Value::setM(const CowPtr<Map>& v) {
+    type_ = Type::MAP;
+    new (std::addressof(value_.mVal)) CowPtr<Map>(v);
 }
 
-void Value::setM(const std::unique_ptr<Map>& v) {
+void Value::setM(CowPtr<Map>&& v) {
     type_ = Type::MAP;
-    new (std::addressof(value_.mVal)) std::unique_ptr<Map>(new Map(*v));
+    new (std::addressof(value_.mVal)) CowPtr<Map>(std::move(v));
 }
 
 void Value::setM(std::unique_ptr<Map>&& v) {
     type_ = Type::MAP;
-    new (std::addressof(value_.mVal)) std::unique_ptr<Map>(std::move(v));
+    new (std::addressof(value_.mVal)) CowPtr<Map>(std::move(v));
 }
 
 void Value::setM(const Map& v) {
     type_ = Type::MAP;
-    new (std::addressof(value_.mVal)) std::unique_ptr<Map>(new Map(v));
+    new (std::addressof(value_.mVal)) CowPtr<Map>(CowPtr<Map>::make(v));
 }
 
 void Value::setM(Map&& v) {
     type_ = Type::MAP;
-    new (std::addressof(value_.mVal)) std::unique_ptr<Map>(new Map(std::move(v)));
+    new (std::addressof(value_.mVal)) CowPtr<Map>(CowPtr<Map>::make(std::move(v)));
 }
 
 void Value::setU(const std::unique_ptr<Set>& v) {
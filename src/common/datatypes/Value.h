@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "common/base/CowPtr.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/datatypes/Date.h"
 
@@ -293,6 +294,8 @@ struct Value {
     Set moveSet();
     DataSet moveDataSet();
 
+    // Vertex, Edge, Path, List and Map are shared by the copies of a Value, so
+    // they are cloned here if shared. Don't keep the reference across copying.
     NullType& mutableNull();
     bool& mutableBool();
     int64_t& mutableInt();
@@ -335,11 +338,12 @@ private:
         Date                        dVal;
         Time                        tVal;
         DateTime                    dtVal;
-        std::unique_ptr<Vertex>     vVal;
-        std::unique_ptr<Edge>       eVal;
-        std::unique_ptr<Path>       pVal;
-        std::unique_ptr<List>       lVal;
-        std::unique_ptr<Map>        mVal;
+        // Shared by the copies until modified
+        CowPtr<Vertex>              vVal;
+        CowPtr<Edge>                eVal;
+        CowPtr<Path>                pVal;
+        CowPtr<List>                lVal;
+        CowPtr<Map>                 mVal;
         std::unique_ptr<Set>        uVal;
         std::unique_ptr<DataSet>    gVal;
 
@@ -379,27 +383,32 @@ private:
     void setDT(const DateTime& v);
     void setDT(DateTime&& v);
     // Vertex value
-    void setV(const std::unique_ptr<Vertex>& v);
+    void setV(const CowPtr<Vertex>& v);
+    void setV(CowPtr<Vertex>&& v);
     void setV(std::unique_ptr<Vertex>&& v);
     void setV(const Vertex& v);
     void setV(Vertex&& v);
     // Edge value
-    void setE(const std::unique_ptr<Edge>& v);
+    void setE(const CowPtr<Edge>& v);
+    void setE(CowPtr<Edge>&& v);
     void setE(std::unique_ptr<Edge>&& v);
     void setE(const Edge& v);
     void setE(Edge&& v);
     // Path value
-    void setP(const std::unique_ptr<Path>& v);
+    void setP(const CowPtr<Path>& v);
+    void setP(CowPtr<Path>&& v);
     void setP(std::unique_ptr<Path>&& v);
     void setP(const Path& v);
     void setP(Path&& v);
     // List value
-    void setL(const std::unique_ptr<List>& v);
+    void setL(const CowPtr<List>& v);
+    void setL(CowPtr<List>&& v);
     void setL(std::unique_ptr<List>&& v);
     void setL(const List& v);
     void setL(List&& v);
     // Map value
-    void setM(const std::unique_ptr<Map>& v);
+    void setM(const CowPtr<Map>& v);
+    void setM(CowPtr<Map>&& v);
     void setM(std::unique_ptr<Map>&& v);
     void setM(const Map& v);
     void setM(Map&& v);
@@ -93,7 +93,7 @@ namespace std {
 
 // Inject a customized hash function
 std::size_t hash<nebula::Tag>::operator()(const nebula::Tag& h) const noexcept {
-    return folly::hash::fnv64(h.name);
+    return folly::hash::fnv64(h.name.str());
 }
 
 std::size_t hash<nebula::Vertex>::operator()(const nebula::Vertex& h) const noexcept {
@@ -7,18 +7,19 @@
 #ifndef COMMON_DATATYPES_VERTEX_H_
 #define COMMON_DATATYPES_VERTEX_H_
 
-#include <unordered_map>
 #include <vector>
 #include <sstream>
 
+#include "common/base/Symbol.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/datatypes/Value.h"
+#include "common/datatypes/PropMap.h"
 
 namespace nebula {
 
 struct Tag {
-    std::string name;
-    std::unordered_map<std::string, Value> props;
+    Symbol name;
+    PropMap props;
 
     Tag() = default;
     Tag(Tag&& tag) noexcept
@@ -27,7 +28,7 @@ struct Tag {
     Tag(const Tag& tag)
         : name(tag.name)
         , props(tag.props) {}
-    Tag(std::string tagName, std::unordered_map<std::string, Value> tagProps)
+    Tag(Symbol tagName, PropMap tagProps)
         : name(std::move(tagName))
         , props(std::move(tagProps)) {}
 
@@ -15,6 +15,7 @@
 
 #include "common/datatypes/Vertex.h"
 #include "common/datatypes/CommonCpp2Ops.h"
+#include "common/datatypes/PropMapOps.inl"
 
 namespace apache {
 namespace thrift {
@@ -56,14 +57,11 @@ uint32_t Cpp2Ops<nebula::Tag>::write(Protocol* proto, nebula::Tag const* obj) {
     xfer += proto->writeStructBegin("Tag");
 
     xfer += proto->writeFieldBegin("name", apache::thrift::protocol::T_STRING, 1);
-    xfer += proto->writeBinary(obj->name);
+    xfer += proto->writeBinary(obj->name.str());
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldBegin("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::write(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::write(proto, &obj->props);
     xfer += proto->writeFieldEnd();
 
     xfer += proto->writeFieldStop();
@@ -86,7 +84,9 @@ void Cpp2Ops<nebula::Tag>::read(Protocol* proto, nebula::Tag* obj) {
 
 _readField_name:
     {
-        proto->readBinary(obj->name);
+        std::string name;
+        proto->readBinary(name);
+        obj->name = nebula::Symbol::name(std::move(name));
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 1, 2, protocol::T_MAP))) {
@@ -95,11 +95,7 @@ _readField_name:
 
 _readField_props:
     {
-        obj->props = std::unordered_map<std::string, nebula::Value>();
-        detail::pm::protocol_methods<
-                type_class::map<type_class::binary, type_class::structure>,
-                std::unordered_map<std::string, nebula::Value>
-            >::read(*proto, obj->props);
+        detail::readPropMap(proto, &obj->props);
     }
 
     if (UNLIKELY(!readState.advanceToNextField(proto, 2, 0, protocol::T_STOP))) {
@@ -158,13 +154,10 @@ uint32_t Cpp2Ops<nebula::Tag>::serializedSize(Protocol const* proto,
     xfer += proto->serializedStructSize("Tag");
 
     xfer += proto->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 1);
-    xfer += proto->serializedSizeBinary(obj->name);
+    xfer += proto->serializedSizeBinary(obj->name.str());
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::serializedSize(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -178,13 +171,10 @@ uint32_t Cpp2Ops<nebula::Tag>::serializedSizeZC(Protocol const* proto,
     xfer += proto->serializedStructSize("Tag");
 
     xfer += proto->serializedFieldSize("name", apache::thrift::protocol::T_STRING, 1);
-    xfer += proto->serializedSizeZCBinary(obj->name);
+    xfer += proto->serializedSizeZCBinary(obj->name.str());
 
     xfer += proto->serializedFieldSize("props", apache::thrift::protocol::T_MAP, 2);
-    xfer += detail::pm::protocol_methods<
-            type_class::map<type_class::binary, type_class::structure>,
-            std::unordered_map<std::string, nebula::Value>
-        >::serializedSize<false>(*proto, obj->props);
+    xfer += Cpp2Ops<nebula::PropMap>::serializedSizeZC(proto, &obj->props);
 
     xfer += proto->serializedSizeStop();
     return xfer;
@@ -4,17 +4,30 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
+#include <iostream>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include <folly/Benchmark.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include "common/base/Base.h"
+#include "common/base/StringInterner.h"
+#include "common/base/Symbol.h"
 #include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/PropMap.h"
 #include "common/datatypes/Value.h"
+#include "common/datatypes/ValueOps.inl"
 
 using nebula::Edge;
+using nebula::Map;
+using nebula::MapKvs;
+using nebula::PropMap;
+using nebula::StringInterner;
+using nebula::Symbol;
 using nebula::Value;
 using nebula::EdgeType;
 using nebula::EdgeRanking;
@@ -171,7 +184,280 @@ BENCHMARK_RELATIVE(HashTupleEdge, n) {
     }
 }
 
+BENCHMARK_DRAW_LINE();
+
+// The props of an edge, of the unordered_map used before and of PropMap
+using UnorderedProps = std::unordered_map<std::string, Value>;
+using UnorderedPropsMethods = apache::thrift::detail::pm::protocol_methods<
+    apache::thrift::type_class::map<apache::thrift::type_class::binary,
+                                    apache::thrift::type_class::structure>,
+    UnorderedProps>;
+
+static constexpr size_t kNumProps = 8;
+
+static const std::vector<std::string>& propNames() {
+    static const std::vector<std::string> names = [] () {
+        std::vector<std::string> v;
+        for (size_t i = 0; i < kNumProps; ++i) {
+            v.emplace_back(folly::stringPrintf("prop_%lu", i));
+        }
+        return v;
+    }();
+    return names;
+}
+
+// Ints and short strings
+static const std::vector<Value>& propValues() {
+    static const std::vector<Value> values = [] () {
+        std::vector<Value> v;
+        for (size_t i = 0; i < kNumProps; ++i) {
+            if (i % 2 == 0) {
+                v.emplace_back(static_cast<int64_t>(i));
+            } else {
+                v.emplace_back(randomString(16));
+            }
+        }
+        return v;
+    }();
+    return values;
+}
+
+template <class Props>
+static Props makeProps() {
+    Props props;
+    props.reserve(kNumProps);
+    for (size_t i = 0; i < kNumProps; ++i) {
+        props.emplace(propNames()[i], propValues()[i]);
+    }
+    return props;
+}
+
+BENCHMARK(BuildUnorderedProps, n) {
+    for (size_t i = 0; i < n; ++i) {
+        auto props = makeProps<UnorderedProps>();
+        folly::doNotOptimizeAway(props);
+    }
+}
+
+BENCHMARK_RELATIVE(BuildPropMap, n) {
+    for (size_t i = 0; i < n; ++i) {
+        auto props = makeProps<PropMap>();
+        folly::doNotOptimizeAway(props);
+    }
+}
+
+BENCHMARK(LookupUnorderedProps, n) {
+    UnorderedProps props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<UnorderedProps>();
+    }
+    const auto& names = propNames();
+    for (size_t i = 0; i < n; ++i) {
+        auto iter = props.find(names[i % kNumProps]);
+        folly::doNotOptimizeAway(iter->second);
+    }
+}
+
+BENCHMARK_RELATIVE(LookupPropMap, n) {
+    PropMap props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<PropMap>();
+    }
+    const auto& names = propNames();
+    for (size_t i = 0; i < n; ++i) {
+        auto iter = props.find(names[i % kNumProps]);
+        folly::doNotOptimizeAway(iter->second);
+    }
+}
+
+// Property names usually come from the query as string pieces, which have to be
+// copied into a std::string to find in the unordered_map
+BENCHMARK(LookupUnorderedPropsByPiece, n) {
+    UnorderedProps props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<UnorderedProps>();
+    }
+    const auto& names = propNames();
+    for (size_t i = 0; i < n; ++i) {
+        folly::StringPiece name(names[i % kNumProps]);
+        auto iter = props.find(name.str());
+        folly::doNotOptimizeAway(iter->second);
+    }
+}
+
+BENCHMARK_RELATIVE(LookupPropMapByPiece, n) {
+    PropMap props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<PropMap>();
+    }
+    const auto& names = propNames();
+    for (size_t i = 0; i < n; ++i) {
+        folly::StringPiece name(names[i % kNumProps]);
+        auto iter = props.find(name);
+        folly::doNotOptimizeAway(iter->second);
+    }
+}
+
+BENCHMARK(SerializeUnorderedProps, n) {
+    UnorderedProps props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<UnorderedProps>();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        folly::IOBufQueue queue;
+        apache::thrift::CompactProtocolWriter writer;
+        writer.setOutput(&queue);
+        UnorderedPropsMethods::write(writer, props);
+        folly::doNotOptimizeAway(queue);
+    }
+}
+
+BENCHMARK_RELATIVE(SerializePropMap, n) {
+    PropMap props;
+    BENCHMARK_SUSPEND {
+        props = makeProps<PropMap>();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        folly::IOBufQueue queue;
+        apache::thrift::CompactProtocolWriter writer;
+        writer.setOutput(&queue);
+        apache::thrift::Cpp2Ops<PropMap>::write(&writer, &props);
+        folly::doNotOptimizeAway(queue);
+    }
+}
+
+// Both are the same on the wire
+static std::unique_ptr<folly::IOBuf> serializedProps() {
+    auto props = makeProps<PropMap>();
+    folly::IOBufQueue queue;
+    apache::thrift::CompactProtocolWriter writer;
+    writer.setOutput(&queue);
+    apache::thrift::Cpp2Ops<PropMap>::write(&writer, &props);
+    return queue.move();
+}
+
+BENCHMARK(DeserializeUnorderedProps, n) {
+    std::unique_ptr<folly::IOBuf> buf;
+    BENCHMARK_SUSPEND {
+        buf = serializedProps();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        apache::thrift::CompactProtocolReader reader;
+        reader.setInput(buf.get());
+        UnorderedProps props;
+        UnorderedPropsMethods::read(reader, props);
+        folly::doNotOptimizeAway(props);
+    }
+}
+
+BENCHMARK_RELATIVE(DeserializePropMap, n) {
+    std::unique_ptr<folly::IOBuf> buf;
+    BENCHMARK_SUSPEND {
+        buf = serializedProps();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        apache::thrift::CompactProtocolReader reader;
+        reader.setInput(buf.get());
+        PropMap props;
+        apache::thrift::Cpp2Ops<PropMap>::read(&reader, &props);
+        folly::doNotOptimizeAway(props);
+    }
+}
+
+// The kvs of a Map are keyed by std::strings, so the short keys here are
+// decoded into the one vector of the map without an allocation of their own
+BENCHMARK_RELATIVE(DeserializeMap, n) {
+    std::string buf;
+    BENCHMARK_SUSPEND {
+        Map map(makeProps<MapKvs>());
+        apache::thrift::CompactSerializer::serialize(map, &buf);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        Map map;
+        apache::thrift::CompactSerializer::deserialize(buf, map);
+        folly::doNotOptimizeAway(map);
+    }
+}
+
+BENCHMARK_DRAW_LINE();
+
+// A result of edges, whose names and property names are either owned by each
+// edge or interned
+static constexpr size_t kNumEdges = 1000000;
+
+static std::vector<Edge> makeEdges(size_t num, bool intern) {
+    auto name = [intern] (const std::string& str) {
+        return intern ? Symbol::intern(str) : Symbol::owned(str);
+    };
+    std::vector<Edge> edges;
+    edges.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        PropMap props;
+        props.reserve(kNumProps);
+        for (size_t j = 0; j < kNumProps; ++j) {
+            props.emplace(name(propNames()[j]), propValues()[j]);
+        }
+        edges.emplace_back(Edge(static_cast<int64_t>(i),
+                                static_cast<int64_t>(i + 1),
+                                1,
+                                name("like"),
+                                0,
+                                std::move(props)));
+    }
+    return edges;
+}
+
+// Bytes of the edges, but the heap of the property values, which are the same
+// either way
+static size_t edgesFootprint(const std::vector<Edge>& edges) {
+    size_t size = edges.capacity() * sizeof(Edge);
+    for (const auto& edge : edges) {
+        size += edge.name.heapBytes() + edge.props.size() * sizeof(PropMap::value_type);
+        for (const auto& kv : edge.props) {
+            size += kv.first.heapBytes();
+        }
+    }
+    return size;
+}
+
+static void reportNameFootprint() {
+    auto interner = StringInterner::memoryUsage();
+    auto owned = edgesFootprint(makeEdges(kNumEdges, false));
+    auto interned = edgesFootprint(makeEdges(kNumEdges, true));
+    interner = StringInterner::memoryUsage() - interner;
+    std::cout << kNumEdges << " edges of " << kNumProps << " props each, names owned: "
+              << (owned >> 20) << "MB, names interned: " << (interned >> 20) << "MB"
+              << ", plus " << (interner >> 10) << "KB of the interner" << std::endl;
+}
+
+BENCHMARK(CopyEdgesOwnedNames, n) {
+    std::vector<Edge> edges;
+    BENCHMARK_SUSPEND {
+        edges = makeEdges(n, false);
+    }
+    auto copy = edges;
+    folly::doNotOptimizeAway(copy);
+    BENCHMARK_SUSPEND {
+        copy.clear();
+        edges.clear();
+    }
+}
+
+BENCHMARK_RELATIVE(CopyEdgesInternedNames, n) {
+    std::vector<Edge> edges;
+    BENCHMARK_SUSPEND {
+        edges = makeEdges(n, true);
+    }
+    auto copy = edges;
+    folly::doNotOptimizeAway(copy);
+    BENCHMARK_SUSPEND {
+        copy.clear();
+        edges.clear();
+    }
+}
+
 int main() {
+    reportNameFootprint();
     folly::runBenchmarks();
     return 0;
 }
@@ -0,0 +1,150 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/PropMap.h"
+#include "common/datatypes/ValueOps.inl"
+
+namespace nebula {
+
+using serializer = apache::thrift::CompactSerializer;
+
+TEST(PropMap, Basic) {
+    PropMap props({{"c", 3}, {"a", 1}, {"b", 2}, {"a", 10}});
+    // Sorted, the first one of the duplicated keys is kept
+    ASSERT_EQ(3, props.size());
+    std::vector<std::string> names;
+    for (const auto& kv : props) {
+        names.emplace_back(kv.first);
+    }
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), names);
+    EXPECT_EQ(Value(1), props.at("a"));
+
+    folly::StringPiece name("b");
+    ASSERT_NE(props.end(), props.find(name));
+    EXPECT_EQ(Value(2), props.find(name)->second);
+    EXPECT_EQ(props.end(), props.find("d"));
+    EXPECT_EQ(1, props.count("c"));
+    EXPECT_EQ(0, props.count(""));
+    EXPECT_THROW(props.at("d"), std::out_of_range);
+
+    EXPECT_FALSE(props.emplace("b", 20).second);
+    EXPECT_EQ(Value(2), props.at("b"));
+    EXPECT_TRUE(props.emplace("bb", 22).second);
+    props["0"] = 0;
+    props["c"] = 30;
+    EXPECT_EQ(PropMap({{"0", 0}, {"a", 1}, {"b", 2}, {"bb", 22}, {"c", 30}}), props);
+
+    EXPECT_EQ(1, props.erase("bb"));
+    EXPECT_EQ(0, props.erase("bb"));
+    props.erase(props.begin());
+    EXPECT_EQ(PropMap({{"a", 1}, {"b", 2}, {"c", 30}}), props);
+
+    // The same as the unordered_map of the same entries
+    std::unordered_map<std::string, Value> unordered = {{"c", 30}, {"b", 2}, {"a", 1}};
+    EXPECT_EQ(props, PropMap(unordered));
+    EXPECT_EQ(props, PropMap(std::move(unordered)));
+    EXPECT_NE(props, PropMap({{"a", 1}, {"b", 2}, {"c", 3}}));
+}
+
+TEST(PropMap, Bulk) {
+    PropMap::Builder builder(4);
+    builder.emplace("c", 3).emplace("a", 1).emplace(std::string("b"), 2).emplace("a", 10);
+    EXPECT_EQ(4, builder.size());
+    auto props = std::move(builder).build();
+    EXPECT_EQ(PropMap({{"a", 1}, {"b", 2}, {"c", 3}}), props);
+
+    // The existing ones are kept
+    std::vector<std::pair<std::string, Value>> kvs = {{"d", 4}, {"b", 20}, {"0", 0}, {"d", 40}};
+    props.insert(kvs.begin(), kvs.end());
+    EXPECT_EQ(PropMap({{"0", 0}, {"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}}), props);
+    props.insert(kvs.end(), kvs.end());
+    EXPECT_EQ(5, props.size());
+
+    // Appended in order
+    PropMap other({{"e", 5}, {"f", 6}});
+    props.insert(other.begin(), other.end());
+    EXPECT_EQ(PropMap({{"0", 0}, {"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}, {"e", 5}, {"f", 6}}),
+              props);
+
+    PropMap empty;
+    empty.insert(kvs.begin(), kvs.end());
+    EXPECT_EQ(PropMap({{"0", 0}, {"b", 20}, {"d", 4}}), empty);
+}
+
+TEST(PropMap, Serialize) {
+    std::unordered_map<std::string, Value> unordered;
+    for (int64_t i = 0; i < 100; ++i) {
+        unordered.emplace(folly::to<std::string>(i), i);
+    }
+    PropMap props(unordered);
+
+    // The same map<binary, Value> on the wire as the unordered_map
+    using Methods = apache::thrift::detail::pm::protocol_methods<
+        apache::thrift::type_class::map<apache::thrift::type_class::binary,
+                                        apache::thrift::type_class::structure>,
+        std::unordered_map<std::string, Value>>;
+    {
+        folly::IOBufQueue queue;
+        apache::thrift::CompactProtocolWriter writer;
+        writer.setOutput(&queue);
+        auto size = apache::thrift::Cpp2Ops<PropMap>::write(&writer, &props);
+        EXPECT_LE(size, apache::thrift::Cpp2Ops<PropMap>::serializedSize(&writer, &props));
+        auto buf = queue.move();
+
+        apache::thrift::CompactProtocolReader reader;
+        reader.setInput(buf.get());
+        std::unordered_map<std::string, Value> decoded;
+        Methods::read(reader, decoded);
+        EXPECT_EQ(unordered, decoded);
+    }
+    {
+        folly::IOBufQueue queue;
+        apache::thrift::CompactProtocolWriter writer;
+        writer.setOutput(&queue);
+        Methods::write(writer, unordered);
+        auto buf = queue.move();
+
+        apache::thrift::CompactProtocolReader reader;
+        reader.setInput(buf.get());
+        PropMap decoded;
+        apache::thrift::Cpp2Ops<PropMap>::read(&reader, &decoded);
+        EXPECT_EQ(props, decoded);
+    }
+
+    // As the fields
+    Edge edge("src", "dst", 1, "like", 0, PropMap(props));
+    std::string buf;
+    serializer::serialize(edge, &buf);
+    Edge edgeCopy;
+    serializer::deserialize(buf, edgeCopy);
+    EXPECT_EQ(edge, edgeCopy);
+    // Schema names are interned when decoded
+    EXPECT_TRUE(edgeCopy.name.interned());
+    for (const auto& kv : edgeCopy.props) {
+        EXPECT_TRUE(kv.first.interned());
+    }
+
+    // A Map is keyed by std::strings, the same on the wire
+    Map map(MapKvs(props.begin(), props.end()));
+    buf.clear();
+    serializer::serialize(map, &buf);
+    Map mapCopy;
+    serializer::deserialize(buf, mapCopy);
+    EXPECT_EQ(map, mapCopy);
+    EXPECT_EQ(props.size(), mapCopy.kvs.size());
+    for (const auto& kv : mapCopy.kvs) {
+        EXPECT_EQ(props.at(kv.first), kv.second);
+    }
+}
+
+}  // namespace nebula
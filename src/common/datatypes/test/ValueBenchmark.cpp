@@ -11,11 +11,19 @@
 #include <folly/Benchmark.h>
 
 #include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
+#include "common/datatypes/Path.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/Vertex.h"
 
+using nebula::DataSet;
 using nebula::Edge;
+using nebula::List;
+using nebula::Path;
+using nebula::PropMap;
+using nebula::Step;
+using nebula::Tag;
 using nebula::Value;
 using nebula::Vertex;
 
@@ -112,6 +120,73 @@ BENCHMARK(HashIntValue, n) {
     }
 }
 
+BENCHMARK_DRAW_LINE();
+
+static Vertex randomVertex() {
+    PropMap props;
+    for (int i = 0; i < 5; i++) {
+        props.emplace(folly::stringPrintf("prop_%d", i), randomString(16));
+    }
+    return Vertex(randomString(16), {Tag("player", std::move(props))});
+}
+
+// 1000 rows of (vertex, path of 3 steps)
+static DataSet makeRows() {
+    DataSet ds({"v", "p"});
+    for (size_t i = 0; i < 1000; i++) {
+        std::vector<Step> steps;
+        for (int j = 0; j < 3; j++) {
+            steps.emplace_back(randomVertex(), 1, "like", 0,
+                               PropMap{{"likeness", 90}});
+        }
+        ds.rows.emplace_back(List({randomVertex(), Path(randomVertex(), std::move(steps))}));
+    }
+    return ds;
+}
+
+// As a copy of Value did before the payloads are shared
+static Value deepCopy(const Value& v) {
+    if (v.isVertex()) {
+        return Value(v.getVertex());
+    }
+    if (v.isPath()) {
+        return Value(v.getPath());
+    }
+    return v;
+}
+
+BENCHMARK(CopyRowsDeep, n) {
+    DataSet ds;
+    BENCHMARK_SUSPEND {
+        ds = makeRows();
+    }
+    for (size_t i = 0; i < n; i++) {
+        DataSet copy;
+        copy.colNames = ds.colNames;
+        copy.rows.reserve(ds.rows.size());
+        for (const auto &row : ds.rows) {
+            List r;
+            r.values.reserve(row.size());
+            for (const auto &v : row.values) {
+                r.values.emplace_back(deepCopy(v));
+            }
+            copy.rows.emplace_back(std::move(r));
+        }
+        folly::doNotOptimizeAway(copy);
+    }
+}
+
+BENCHMARK_RELATIVE(CopyRows, n) {
+    DataSet ds;
+    BENCHMARK_SUSPEND {
+        ds = makeRows();
+    }
+    for (size_t i = 0; i < n; i++) {
+        DataSet copy = ds;
+        folly::doNotOptimizeAway(copy);
+    }
+}
+
 int main() {
     folly::runBenchmarks();
     return 0;
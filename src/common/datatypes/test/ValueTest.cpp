@@ -1106,6 +1106,44 @@ TEST(Value, Ctor) {
     // Value v2(&tmp);
 }
 
+TEST(Value, CopyOnWrite) {
+    Value list(List({1, 2, 3}));
+    Value copy = list;
+    // Shared by the copy
+    EXPECT_EQ(list.getListPtr(), copy.getListPtr());
+    copy.mutableList().values.emplace_back(4);
+    EXPECT_NE(list.getListPtr(), copy.getListPtr());
+    EXPECT_EQ(List({1, 2, 3}), list.getList());
+    EXPECT_EQ(List({1, 2, 3, 4}), copy.getList());
+
+    Value vertex(Vertex("v", {Tag("t", {{"p", 1}})}));
+    std::vector<Value> row = {vertex, vertex};
+    EXPECT_EQ(vertex.getVertexPtr(), row[1].getVertexPtr());
+    // Moving out of a shared one copies
+    auto v = row[0].moveVertex();
+    EXPECT_TRUE(row[0].empty());
+    EXPECT_EQ(vertex, row[1]);
+    EXPECT_EQ(vertex.getVertex(), v);
+
+    Value path(Path(Vertex("a", {}), {Step(Vertex("b", {}), 1, "e", 0, {})}));
+    Value pathCopy;
+    pathCopy = path;
+    EXPECT_EQ(path.getPathPtr(), pathCopy.getPathPtr());
+    pathCopy.mutablePath().reverse();
+    EXPECT_EQ(Vertex("a", {}), path.getPath().src);
+    EXPECT_EQ(Vertex("b", {}), pathCopy.getPath().src);
+
+    Value map(Map({{"k", 1}}));
+    Value mapCopy(map);
+    mapCopy.setMap(Map({{"k", 2}}));
+    EXPECT_EQ(Value(1), map.getMap().kvs.at("k"));
+
+    Value edge(Edge("a", "b", 1, "e", 0, {}));
+    Value edgeCopy = edge;
+    edgeCopy.mutableEdge().ranking = 1;
+    EXPECT_EQ(0, edge.getEdge().ranking);
+}
+
 }  // namespace nebula
 
 
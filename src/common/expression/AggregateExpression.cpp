@@ -38,18 +38,23 @@ void AggregateExpression::resetFrom(Decoder& decoder) {
 
 const Value& AggregateExpression::eval(ExpressionContext& ctx) {
     DCHECK(!!aggData_);
-    auto val = arg_->eval(ctx);
-    auto uniques = aggData_->uniques();
+    auto& val = arg_->eval(ctx);
     if (distinct_) {
+        auto uniques = aggData_->uniques();
         if (uniques->contains(val)) {
-            return aggData_->result();
+            return aggData_->partialResult();
         }
         uniques->values.emplace(val);
     }
 
     DCHECK(aggFunc_);
     aggFunc_(aggData_, val);
+    return aggData_->partialResult();
+}
 
+const Value& AggregateExpression::finalize() {
+    DCHECK(!!aggData_);
+    aggData_->finalize();
     return aggData_->result();
 }
 
@@ -57,6 +62,29 @@ void AggregateExpression::apply(AggData* aggData, const Value& val) {
     AggFunctionManager::get(name_).value()(aggData, val);
 }
 
+Status AggregateExpression::merge(AggData* dst, const AggData& src) {
+    DCHECK(!!dst);
+    if (distinct_) {
+        // The partial results could not be merged, since they may share values
+        auto uniques = dst->uniques();
+        if (src.uniques() == nullptr) {
+            return Status::OK();
+        }
+        DCHECK(aggFunc_);
+        for (const auto& val : src.uniques()->values) {
+            if (uniques->values.emplace(val).second) {
+                aggFunc_(dst, val);
+            }
+        }
+        return Status::OK();
+    }
+
+    auto mergeFunc = AggFunctionManager::getMerge(name_);
+    NG_RETURN_IF_ERROR(mergeFunc);
+    mergeFunc.value()(dst, src);
+    return Status::OK();
+}
+
 std::string AggregateExpression::toString() const {
     // TODO fix it
     std::string arg;
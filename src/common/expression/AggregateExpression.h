@@ -28,10 +28,21 @@ public:
         return pool->add(new AggregateExpression(pool, name, arg, distinct));
     }
 
+    // Applies the argument of the current row to the AggData, and returns the
+    // result so far, which is not final for the functions deferring it, e.g.
+    // approximate percentiles
     const Value& eval(ExpressionContext& ctx) override;
 
+    // Works out the result of the AggData once all the rows of the group have
+    // been applied
+    const Value& finalize();
+
     void apply(AggData* aggData, const Value& val);
 
+    // Merge the partial aggregation `src' into `dst'. For DISTINCT aggregation,
+    // only the values not seen by `dst' are applied.
+    Status merge(AggData* dst, const AggData& src);
+
     bool operator==(const Expression& rhs) const override;
 
     std::string toString() const override;
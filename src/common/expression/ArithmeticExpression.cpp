@@ -11,29 +11,30 @@
 namespace nebula {
 
 const Value& ArithmeticExpression::eval(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
     auto& lhs = lhs_->eval(ctx);
     auto& rhs = rhs_->eval(ctx);
 
     switch (kind_) {
         case Kind::kAdd:
-            result_ = lhs + rhs;
+            result = lhs + rhs;
             break;
         case Kind::kMinus:
-            result_ = lhs - rhs;
+            result = lhs - rhs;
             break;
         case Kind::kMultiply:
-            result_ = lhs * rhs;
+            result = lhs * rhs;
             break;
         case Kind::kDivision:
-            result_ = lhs / rhs;
+            result = lhs / rhs;
             break;
         case Kind::kMod:
-            result_ = lhs % rhs;
+            result = lhs % rhs;
             break;
         default:
             LOG(FATAL) << "Unknown type: " << kind_;
     }
-    return result_;
+    return result;
 }
 
 std::string ArithmeticExpression::toString() const {
@@ -18,14 +18,16 @@ const Value& AttributeExpression::eval(ExpressionContext &ctx) {
     auto &rvalue = right()->eval(ctx);
     DCHECK(rvalue.isStr());
 
+    // Borrowed from `lvalue' if possible, which lives until the left operand is
+    // evaluated again
+    auto& result = resultOf(ctx, result_);
     // TODO(dutor) Take care of the builtin properties, _src, _vid, _type, etc.
     switch (lvalue.type()) {
         case Value::Type::MAP:
             return lvalue.getMap().at(rvalue.getStr());
         case Value::Type::VERTEX: {
             if (rvalue.getStr() == kVid) {
-                result_ = lvalue.getVertex().vid;
-                return result_;
+                return lvalue.getVertex().vid;
             }
             for (auto &tag : lvalue.getVertex().tags) {
                 auto iter = tag.props.find(rvalue.getStr());
@@ -39,15 +41,15 @@ const Value& AttributeExpression::eval(ExpressionContext &ctx) {
             DCHECK(!rvalue.getStr().empty());
             if (rvalue.getStr()[0] == '_') {
                 if (rvalue.getStr() == kSrc) {
-                    result_ = lvalue.getEdge().src;
+                    return lvalue.getEdge().src;
                 } else if (rvalue.getStr() == kDst) {
-                    result_ = lvalue.getEdge().dst;
+                    return lvalue.getEdge().dst;
                 } else if (rvalue.getStr() == kRank) {
-                    result_ = lvalue.getEdge().ranking;
+                    result = lvalue.getEdge().ranking;
                 } else if (rvalue.getStr() == kType) {
-                    result_ = lvalue.getEdge().name;
+                    result = lvalue.getEdge().name.str();
                 }
-                return result_;
+                return result;
             }
             auto iter = lvalue.getEdge().props.find(rvalue.getStr());
             if (iter == lvalue.getEdge().props.end()) {
@@ -56,14 +58,14 @@ const Value& AttributeExpression::eval(ExpressionContext &ctx) {
             return iter->second;
         }
         case Value::Type::DATE:
-            result_ = time::TimeUtils::getDateAttr(lvalue.getDate(), rvalue.getStr());
-            return result_;
+            result = time::TimeUtils::getDateAttr(lvalue.getDate(), rvalue.getStr());
+            return result;
         case Value::Type::TIME:
-            result_ = time::TimeUtils::getTimeAttr(lvalue.getTime(), rvalue.getStr());
-            return result_;
+            result = time::TimeUtils::getTimeAttr(lvalue.getTime(), rvalue.getStr());
+            return result;
         case Value::Type::DATETIME:
-            result_ = time::TimeUtils::getDateTimeAttr(lvalue.getDateTime(), rvalue.getStr());
-            return result_;
+            result = time::TimeUtils::getDateTimeAttr(lvalue.getDateTime(), rvalue.getStr());
+            return result;
         default:
             return Value::kNullBadType;
     }
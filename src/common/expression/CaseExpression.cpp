@@ -54,31 +54,28 @@ bool CaseExpression::operator==(const Expression& rhs) const {
 }
 
 const Value& CaseExpression::eval(ExpressionContext& ctx) {
-    auto cond = condition_ != nullptr ? condition_->eval(ctx) : Value();
+    // The results of the operands are borrowed, which live until they are
+    // evaluated again
+    const auto& cond = condition_ != nullptr ? condition_->eval(ctx) : Value::kEmpty;
     for (const auto& whenThen : cases_) {
-        auto when = whenThen.when->eval(ctx);
+        const auto& when = whenThen.when->eval(ctx);
         if (condition_ != nullptr) {
             if (cond == when) {
-                result_ = whenThen.then->eval(ctx);
-                return result_;
+                return whenThen.then->eval(ctx);
             }
         } else {
             if (!when.isBool()) {
                 return Value::kNullBadType;
             }
             if (when.getBool()) {
-                result_ = whenThen.then->eval(ctx);
-                return result_;
+                return whenThen.then->eval(ctx);
             }
         }
     }
     if (default_ != nullptr) {
-        result_ = default_->eval(ctx);
-    } else {
-        result_ = Value::kNullValue;
+        return default_->eval(ctx);
     }
-
-    return result_;
+    return Value::kNullValue;
 }
 
 std::string CaseExpression::toString() const {
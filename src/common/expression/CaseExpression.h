@@ -148,7 +148,6 @@ private:
     std::vector<CaseList::Item> cases_;
     Expression* condition_{nullptr};
     Expression* default_{nullptr};
-    Value result_;
 };
 
 }   // namespace nebula
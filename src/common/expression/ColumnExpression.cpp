@@ -11,8 +11,9 @@
 namespace nebula {
 
 const Value& ColumnExpression::eval(ExpressionContext &ctx) {
-    result_ = ctx.getColumn(index_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getColumn(index_);
+    return result;
 }
 
 bool ColumnExpression::operator==(const Expression &expr) const {
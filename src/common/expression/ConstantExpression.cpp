@@ -21,6 +21,12 @@ bool ConstantExpression::operator==(const Expression& rhs) const {
 
 
 
+ValueColumn ConstantExpression::evalBatch(ExpressionContext&,
+                                          size_t numRows,
+                                          folly::FunctionRef<void(size_t)>) {
+    return ValueColumn::constant(val_, numRows);
+}
+
 void ConstantExpression::writeTo(Encoder& encoder) const {
     // kind_
     encoder << kind_;
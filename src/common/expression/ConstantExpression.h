@@ -31,6 +31,10 @@ public:
         return val_;
     }
 
+    ValueColumn evalBatch(ExpressionContext& ctx,
+                          size_t numRows,
+                          folly::FunctionRef<void(size_t)> setRow) override;
+
     const Value& value() const {
         return val_;
     }
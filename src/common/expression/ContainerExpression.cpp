@@ -50,16 +50,17 @@ bool ListExpression::operator==(const Expression &rhs) const {
 
 
 const Value& ListExpression::eval(ExpressionContext &ctx) {
-    // TODO(dutor) Reuse `result_' iff all elements are constant
+    auto& result = resultOf(ctx, result_);
+    // TODO(dutor) Reuse `result' iff all elements are constant
     std::vector<Value> items;
     items.reserve(size());
 
     for (auto &expr : items_) {
         items.emplace_back(expr->eval(ctx));
     }
-    result_.setList(List(std::move(items)));
+    result.setList(List(std::move(items)));
 
-    return result_;
+    return result;
 }
 
 
@@ -122,16 +123,17 @@ bool SetExpression::operator==(const Expression &rhs) const {
 
 
 const Value& SetExpression::eval(ExpressionContext &ctx) {
-    // TODO(dutor) Reuse `result_' iff all elements are constant
+    auto& result = resultOf(ctx, result_);
+    // TODO(dutor) Reuse `result' iff all elements are constant
     std::unordered_set<Value> set;
     set.reserve(size());
 
     for (auto &expr : items_) {
         set.emplace(expr->eval(ctx));
     }
-    result_.setSet(Set(std::move(set)));
+    result.setSet(Set(std::move(set)));
 
-    return result_;
+    return result;
 }
 
 
@@ -199,16 +201,18 @@ bool MapExpression::operator==(const Expression &rhs) const {
 
 
 const Value& MapExpression::eval(ExpressionContext &ctx) {
-    // TODO(dutor) Reuse `result_' iff all elements are constant
-    std::unordered_map<std::string, Value> map;
-    map.reserve(size());
+    auto& result = resultOf(ctx, result_);
+    // TODO(dutor) Reuse `result' iff all elements are constant
+    MapKvs::container_type kvs;
+    kvs.reserve(size());
 
     for (auto &kv : items_) {
-        map.emplace(kv.first, kv.second->eval(ctx));
+        kvs.emplace_back(kv.first, kv.second->eval(ctx));
     }
-    result_.setMap(Map(std::move(map)));
+    // Sorted once, the first one of the duplicated keys is kept
+    result.setMap(Map(MapKvs(std::move(kvs))));
 
-    return result_;
+    return result;
 }
 
 
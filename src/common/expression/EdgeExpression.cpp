@@ -11,8 +11,9 @@
 namespace nebula {
 
 const Value& EdgeExpression::eval(ExpressionContext &ctx) {
-    result_ = ctx.getEdge();
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdge();
+    return result;
 }
 
 void EdgeExpression::accept(ExprVisitor *visitor) {
@@ -0,0 +1,203 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/ExprConstantChecker.h"
+#include "common/function/FunctionManager.h"
+
+namespace nebula {
+
+void ExprConstantChecker::visit(ConstantExpression *) {
+}
+
+void ExprConstantChecker::visit(UnaryExpression *expr) {
+    // ++ and -- write the variable
+    if (expr->kind() == Expression::Kind::kUnaryIncr ||
+        expr->kind() == Expression::Kind::kUnaryDecr) {
+        constant_ = false;
+        return;
+    }
+    check(expr->operand());
+}
+
+void ExprConstantChecker::visit(TypeCastingExpression *expr) {
+    check(expr->operand());
+}
+
+void ExprConstantChecker::visit(LabelExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(LabelAttributeExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(ArithmeticExpression *expr) {
+    checkBinary(expr);
+}
+
+void ExprConstantChecker::visit(RelationalExpression *expr) {
+    checkBinary(expr);
+}
+
+void ExprConstantChecker::visit(SubscriptExpression *expr) {
+    checkBinary(expr);
+}
+
+void ExprConstantChecker::visit(AttributeExpression *expr) {
+    checkBinary(expr);
+}
+
+void ExprConstantChecker::visit(LogicalExpression *expr) {
+    for (auto* operand : expr->operands()) {
+        check(operand);
+    }
+}
+
+void ExprConstantChecker::visit(FunctionCallExpression *expr) {
+    auto isPure = FunctionManager::getIsPure(expr->name(), expr->args()->numArgs());
+    if (!isPure.ok() || !isPure.value()) {
+        constant_ = false;
+        return;
+    }
+    for (auto* arg : expr->args()->args()) {
+        check(arg);
+    }
+}
+
+void ExprConstantChecker::visit(AggregateExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(UUIDExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(VariableExpression *expr) {
+    if (!inScope(expr->var())) {
+        constant_ = false;
+    }
+}
+
+void ExprConstantChecker::visit(VersionedVariableExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(ListExpression *expr) {
+    for (auto* item : expr->items()) {
+        check(item);
+    }
+}
+
+void ExprConstantChecker::visit(SetExpression *expr) {
+    for (auto* item : expr->items()) {
+        check(item);
+    }
+}
+
+void ExprConstantChecker::visit(MapExpression *expr) {
+    for (auto& item : expr->items()) {
+        check(item.second);
+    }
+}
+
+void ExprConstantChecker::visit(TagPropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgePropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(InputPropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(VariablePropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(DestPropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(SourcePropertyExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgeSrcIdExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgeTypeExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgeRankExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgeDstIdExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(VertexExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(EdgeExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(CaseExpression *expr) {
+    check(expr->condition());
+    for (auto& whenThen : expr->cases()) {
+        check(whenThen.when);
+        check(whenThen.then);
+    }
+    check(expr->defaultResult());
+}
+
+void ExprConstantChecker::visit(PathBuildExpression *expr) {
+    for (auto* item : expr->items()) {
+        check(item);
+    }
+}
+
+void ExprConstantChecker::visit(ColumnExpression *) {
+    constant_ = false;
+}
+
+void ExprConstantChecker::visit(PredicateExpression *expr) {
+    check(expr->collection());
+    scopes_.emplace_back(expr->innerVar());
+    check(expr->filter());
+    scopes_.pop_back();
+}
+
+void ExprConstantChecker::visit(ListComprehensionExpression *expr) {
+    check(expr->collection());
+    scopes_.emplace_back(expr->innerVar());
+    check(expr->filter());
+    check(expr->mapping());
+    scopes_.pop_back();
+}
+
+void ExprConstantChecker::visit(ReduceExpression *expr) {
+    check(expr->initial());
+    check(expr->collection());
+    scopes_.emplace_back(expr->accumulator());
+    scopes_.emplace_back(expr->innerVar());
+    check(expr->mapping());
+    scopes_.resize(scopes_.size() - 2);
+}
+
+void ExprConstantChecker::visit(SubscriptRangeExpression *expr) {
+    check(expr->list());
+    check(expr->lo());
+    check(expr->hi());
+}
+
+}  // namespace nebula
@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_EXPRESSION_EXPRCONSTANTCHECKER_H_
+#define COMMON_EXPRESSION_EXPRCONSTANTCHECKER_H_
+
+#include "common/expression/ExprVisitor.h"
+
+namespace nebula {
+
+/**
+ * Checks whether an expression always evaluates to the same value, i.e. it
+ * reads nothing from the context but the loop variables of its own list
+ * comprehension, reduce and predicate expressions, and calls only the pure
+ * functions. The value of such an expression could be evaluated once and
+ * cached, e.g. the default value of a schema field, while the others, such as
+ * now() or uuid(), should be evaluated each time.
+ */
+class ExprConstantChecker final : public ExprVisitor {
+public:
+    static bool isConstant(Expression* expr) {
+        ExprConstantChecker checker;
+        checker.check(expr);
+        return checker.constant_;
+    }
+
+    void visit(ConstantExpression *expr) override;
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+    void visit(LabelExpression *expr) override;
+    void visit(LabelAttributeExpression *expr) override;
+    void visit(ArithmeticExpression *expr) override;
+    void visit(RelationalExpression *expr) override;
+    void visit(SubscriptExpression *expr) override;
+    void visit(AttributeExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+    void visit(FunctionCallExpression *expr) override;
+    void visit(AggregateExpression *expr) override;
+    void visit(UUIDExpression *expr) override;
+    void visit(VariableExpression *expr) override;
+    void visit(VersionedVariableExpression *expr) override;
+    void visit(ListExpression *expr) override;
+    void visit(SetExpression *expr) override;
+    void visit(MapExpression *expr) override;
+    void visit(TagPropertyExpression *expr) override;
+    void visit(EdgePropertyExpression *expr) override;
+    void visit(InputPropertyExpression *expr) override;
+    void visit(VariablePropertyExpression *expr) override;
+    void visit(DestPropertyExpression *expr) override;
+    void visit(SourcePropertyExpression *expr) override;
+    void visit(EdgeSrcIdExpression *expr) override;
+    void visit(EdgeTypeExpression *expr) override;
+    void visit(EdgeRankExpression *expr) override;
+    void visit(EdgeDstIdExpression *expr) override;
+    void visit(VertexExpression *expr) override;
+    void visit(EdgeExpression *expr) override;
+    void visit(CaseExpression *expr) override;
+    void visit(PathBuildExpression *expr) override;
+    void visit(ColumnExpression *expr) override;
+    void visit(PredicateExpression *expr) override;
+    void visit(ListComprehensionExpression *expr) override;
+    void visit(ReduceExpression *expr) override;
+    void visit(SubscriptRangeExpression *expr) override;
+
+private:
+    ExprConstantChecker() = default;
+
+    void check(Expression* expr) {
+        if (constant_ && expr != nullptr) {
+            expr->accept(this);
+        }
+    }
+
+    void checkBinary(BinaryExpression* expr) {
+        check(expr->left());
+        check(expr->right());
+    }
+
+    bool inScope(const std::string& var) const {
+        return std::find(scopes_.begin(), scopes_.end(), var) != scopes_.end();
+    }
+
+    bool constant_{true};
+    // The loop variables in scope
+    std::vector<std::string> scopes_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_EXPRESSION_EXPRCONSTANTCHECKER_H_
@@ -0,0 +1,216 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/ExprSlotBinder.h"
+
+namespace nebula {
+
+void ExprSlotBinder::visit(ConstantExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(UnaryExpression *expr) {
+    bindNode(expr);
+    bind(expr->operand());
+}
+
+void ExprSlotBinder::visit(TypeCastingExpression *expr) {
+    bindNode(expr);
+    bind(expr->operand());
+}
+
+void ExprSlotBinder::visit(LabelExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(LabelAttributeExpression *expr) {
+    bindNode(expr);
+    bind(expr->left());
+    bind(expr->right());
+}
+
+void ExprSlotBinder::visit(ArithmeticExpression *expr) {
+    bindBinary(expr);
+}
+
+void ExprSlotBinder::visit(RelationalExpression *expr) {
+    bindBinary(expr);
+}
+
+void ExprSlotBinder::visit(SubscriptExpression *expr) {
+    bindBinary(expr);
+}
+
+void ExprSlotBinder::visit(AttributeExpression *expr) {
+    bindBinary(expr);
+}
+
+void ExprSlotBinder::visit(LogicalExpression *expr) {
+    bindNode(expr);
+    for (auto* operand : expr->operands()) {
+        bind(operand);
+    }
+}
+
+void ExprSlotBinder::visit(FunctionCallExpression *expr) {
+    bindNode(expr);
+    for (auto* arg : expr->args()->args()) {
+        bind(arg);
+    }
+}
+
+void ExprSlotBinder::visit(AggregateExpression *expr) {
+    bindNode(expr);
+    bind(expr->arg());
+}
+
+void ExprSlotBinder::visit(UUIDExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(VariableExpression *expr) {
+    bindNode(expr);
+    // The other variables are still read from the context
+    expr->setLocal(findLocal(expr->var()));
+}
+
+void ExprSlotBinder::visit(VersionedVariableExpression *expr) {
+    bindNode(expr);
+    bind(expr->version());
+}
+
+void ExprSlotBinder::visit(ListExpression *expr) {
+    bindNode(expr);
+    for (auto* item : expr->items()) {
+        bind(item);
+    }
+}
+
+void ExprSlotBinder::visit(SetExpression *expr) {
+    bindNode(expr);
+    for (auto* item : expr->items()) {
+        bind(item);
+    }
+}
+
+void ExprSlotBinder::visit(MapExpression *expr) {
+    bindNode(expr);
+    for (auto& item : expr->items()) {
+        bind(item.second);
+    }
+}
+
+void ExprSlotBinder::visit(TagPropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgePropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(InputPropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(VariablePropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(DestPropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(SourcePropertyExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgeSrcIdExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgeTypeExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgeRankExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgeDstIdExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(VertexExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(EdgeExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(CaseExpression *expr) {
+    bindNode(expr);
+    bind(expr->condition());
+    for (auto& whenThen : expr->cases()) {
+        bind(whenThen.when);
+        bind(whenThen.then);
+    }
+    bind(expr->defaultResult());
+}
+
+void ExprSlotBinder::visit(PathBuildExpression *expr) {
+    bindNode(expr);
+    for (auto* item : expr->items()) {
+        bind(item);
+    }
+}
+
+void ExprSlotBinder::visit(ColumnExpression *expr) {
+    bindNode(expr);
+}
+
+void ExprSlotBinder::visit(PredicateExpression *expr) {
+    bindNode(expr);
+    bind(expr->collection());
+    // exists() has no loop variable
+    if (!expr->hasInnerVar()) {
+        bind(expr->filter());
+        return;
+    }
+    expr->setInnerVarLocal(pushLocal(expr->innerVar()));
+    bind(expr->filter());
+    popLocals(1);
+}
+
+void ExprSlotBinder::visit(ListComprehensionExpression *expr) {
+    bindNode(expr);
+    bind(expr->collection());
+    expr->setInnerVarLocal(pushLocal(expr->innerVar()));
+    bind(expr->filter());
+    bind(expr->mapping());
+    popLocals(1);
+}
+
+void ExprSlotBinder::visit(ReduceExpression *expr) {
+    bindNode(expr);
+    bind(expr->initial());
+    bind(expr->collection());
+    // The loop variable shadows the accumulator of the same name, as it's set
+    // after the accumulator
+    expr->setAccumulatorLocal(pushLocal(expr->accumulator()));
+    expr->setInnerVarLocal(pushLocal(expr->innerVar()));
+    bind(expr->mapping());
+    popLocals(2);
+}
+
+void ExprSlotBinder::visit(SubscriptRangeExpression *expr) {
+    bindNode(expr);
+    bind(expr->list());
+    bind(expr->lo());
+    bind(expr->hi());
+}
+
+}  // namespace nebula
@@ -0,0 +1,135 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_EXPRESSION_EXPRSLOTBINDER_H_
+#define COMMON_EXPRESSION_EXPRSLOTBINDER_H_
+
+#include "common/expression/ExprVisitor.h"
+
+namespace nebula {
+
+/**
+ * Assigns each node of the expression trees its own slot of an
+ * ExpressionFrame, so the results are written to the frame of the context
+ * rather than to the nodes. After being bound, the trees are not changed by
+ * eval(), and could be shared by threads, each evaluates them with its own
+ * context and a frame of numSlots() slots.
+ *
+ * The loop variables of list comprehension, reduce and predicate expressions
+ * are resolved to the locals of the frame as well, by their scopes, so the
+ * iterations refer to the elements rather than set them to the context:
+ *
+ *   ExprSlotBinder binder;
+ *   binder.bind(filter);
+ *   binder.bind(column);
+ *   ...
+ *   // In each thread
+ *   ExpressionFrame frame(binder.numSlots(), binder.numLocals());
+ *   ctx.setFrame(&frame);
+ *   auto& matched = filter->eval(ctx);
+ *
+ * The trees should be bound before shared, and all of them evaluated with the
+ * same frame should be bound by the same binder. The memos of the memoized
+ * function calls are kept in the frame as well, so each thread fills its own.
+ * The ones carrying external states, i.e. aggregate expressions, are still not
+ * shareable.
+ */
+class ExprSlotBinder final : public ExprVisitor {
+public:
+    // Binds the nodes of `expr' to the slots after the ones of trees bound
+    // before by this binder
+    void bind(Expression* expr) {
+        if (expr != nullptr) {
+            expr->accept(this);
+        }
+    }
+
+    size_t numSlots() const {
+        return numSlots_;
+    }
+
+    size_t numLocals() const {
+        return numLocals_;
+    }
+
+    void visit(ConstantExpression *expr) override;
+    void visit(UnaryExpression *expr) override;
+    void visit(TypeCastingExpression *expr) override;
+    void visit(LabelExpression *expr) override;
+    void visit(LabelAttributeExpression *expr) override;
+    void visit(ArithmeticExpression *expr) override;
+    void visit(RelationalExpression *expr) override;
+    void visit(SubscriptExpression *expr) override;
+    void visit(AttributeExpression *expr) override;
+    void visit(LogicalExpression *expr) override;
+    void visit(FunctionCallExpression *expr) override;
+    void visit(AggregateExpression *expr) override;
+    void visit(UUIDExpression *expr) override;
+    void visit(VariableExpression *expr) override;
+    void visit(VersionedVariableExpression *expr) override;
+    void visit(ListExpression *expr) override;
+    void visit(SetExpression *expr) override;
+    void visit(MapExpression *expr) override;
+    void visit(TagPropertyExpression *expr) override;
+    void visit(EdgePropertyExpression *expr) override;
+    void visit(InputPropertyExpression *expr) override;
+    void visit(VariablePropertyExpression *expr) override;
+    void visit(DestPropertyExpression *expr) override;
+    void visit(SourcePropertyExpression *expr) override;
+    void visit(EdgeSrcIdExpression *expr) override;
+    void visit(EdgeTypeExpression *expr) override;
+    void visit(EdgeRankExpression *expr) override;
+    void visit(EdgeDstIdExpression *expr) override;
+    void visit(VertexExpression *expr) override;
+    void visit(EdgeExpression *expr) override;
+    void visit(CaseExpression *expr) override;
+    void visit(PathBuildExpression *expr) override;
+    void visit(ColumnExpression *expr) override;
+    void visit(PredicateExpression *expr) override;
+    void visit(ListComprehensionExpression *expr) override;
+    void visit(ReduceExpression *expr) override;
+    void visit(SubscriptRangeExpression *expr) override;
+
+private:
+    void bindNode(Expression* expr) {
+        expr->setSlot(static_cast<int32_t>(numSlots_++));
+    }
+
+    void bindBinary(BinaryExpression* expr) {
+        bindNode(expr);
+        bind(expr->left());
+        bind(expr->right());
+    }
+
+    // Declares `var' in the innermost scope, shadowing the outer ones
+    int32_t pushLocal(const std::string& var) {
+        auto local = static_cast<int32_t>(numLocals_++);
+        scopes_.emplace_back(var, local);
+        return local;
+    }
+
+    void popLocals(size_t num) {
+        DCHECK_LE(num, scopes_.size());
+        scopes_.resize(scopes_.size() - num);
+    }
+
+    int32_t findLocal(const std::string& var) const {
+        for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
+            if (it->first == var) {
+                return it->second;
+            }
+        }
+        return Expression::kNoSlot;
+    }
+
+    size_t numSlots_{0};
+    size_t numLocals_{0};
+    // The loop variables in scope, the innermost last
+    std::vector<std::pair<std::string, int32_t>> scopes_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_EXPRESSION_EXPRSLOTBINDER_H_
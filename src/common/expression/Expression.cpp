@@ -187,6 +187,18 @@ std::string Expression::encode() const {
     return encoder.moveStr();
 }
 
+ValueColumn Expression::evalBatch(ExpressionContext& ctx,
+                                  size_t numRows,
+                                  folly::FunctionRef<void(size_t)> setRow) {
+    std::vector<Value> values;
+    values.reserve(numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+        setRow(i);
+        values.emplace_back(eval(ctx));
+    }
+    return ValueColumn(std::move(values));
+}
+
 // static
 Expression* Expression::decode(ObjectPool* pool, folly::StringPiece encoded) {
     Decoder decoder(encoded);
@@ -11,6 +11,8 @@
 #include "common/base/ObjectPool.h"
 #include "common/datatypes/Value.h"
 #include "common/context/ExpressionContext.h"
+#include "common/function/ValueColumn.h"
+#include <folly/Function.h>
 
 namespace nebula {
 
@@ -130,6 +132,14 @@ public:
 
     virtual const Value& eval(ExpressionContext& ctx) = 0;
 
+    // Evaluates the expression over the `numRows' rows of a batch, where
+    // `setRow(i)' points `ctx' to the i'th row. By default the rows are
+    // evaluated one by one, function calls evaluate their arguments this way,
+    // column by column, and pass them to the batch form of the function.
+    virtual ValueColumn evalBatch(ExpressionContext& ctx,
+                                  size_t numRows,
+                                  folly::FunctionRef<void(size_t)> setRow);
+
     virtual bool operator==(const Expression& rhs) const = 0;
     bool operator!=(const Expression& rhs) const {
         return !operator==(rhs);
@@ -172,6 +182,19 @@ public:
         return false;
     }
 
+    // The slot in the ExpressionFrame of a context which eval() writes the
+    // result to, it's assigned by ExprSlotBinder. Unbound expressions keep
+    // their results in themselves.
+    static constexpr int32_t kNoSlot = -1;
+
+    int32_t slot() const {
+        return slot_;
+    }
+
+    void setSlot(int32_t slot) {
+        slot_ = slot;
+    }
+
 protected:
     class Encoder final {
     public:
@@ -219,9 +242,36 @@ protected:
     // Reset the content of the expression from the given decoder
     virtual void resetFrom(Decoder& decoder) = 0;
 
+    // Where eval() writes the result to: the bound slot if `ctx' has a frame,
+    // otherwise `local', i.e. the result_ of the expression itself
+    Value& resultOf(ExpressionContext& ctx, Value& local) const {
+        auto* frame = ctx.frame();
+        if (slot_ == kNoSlot || frame == nullptr) {
+            return local;
+        }
+        return frame->slot(slot_);
+    }
+
+    // Sets the loop variable `var' to `val': the bound `local' of the frame if
+    // `ctx' has one, which refers to `val' rather than copying it, otherwise
+    // the variable of `ctx'
+    static void setLoopVar(ExpressionContext& ctx,
+                           int32_t local,
+                           const std::string& var,
+                           const Value& val) {
+        auto* frame = ctx.frame();
+        if (local == kNoSlot || frame == nullptr) {
+            ctx.setVar(var, val);
+            return;
+        }
+        frame->setLocal(local, &val);
+    }
+
     ObjectPool* pool_;
 
     Kind kind_;
+
+    int32_t slot_{kNoSlot};
 };
 
 std::ostream& operator<<(std::ostream& os, Expression::Kind kind);
@@ -71,15 +71,110 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
     if (funcResult.ok()) {
         func_ = std::move(funcResult).value();
     }
+    auto batchResult = FunctionManager::getBatch(name_, args_->numArgs());
+    if (batchResult.ok()) {
+        batchFunc_ = std::move(batchResult).value();
+    }
+    specialized_ = nullptr;
+    argsType_.clear();
+    memo_.reset();
+}
+
+bool FunctionCallExpression::specialize(const std::vector<Value::Type>& argsType) {
+    if (argsType.size() != DCHECK_NOTNULL(args_)->numArgs()) {
+        // eval() checks the argument types by index
+        specialized_ = nullptr;
+        argsType_.clear();
+        return false;
+    }
+    auto result = FunctionManager::getSpecialized(name_, argsType);
+    if (!result.ok() || result.value() == nullptr) {
+        specialized_ = nullptr;
+        argsType_.clear();
+        return false;
+    }
+    specialized_ = result.value();
+    argsType_.assign(argsType.begin(), argsType.end());
+    return true;
+}
+
+bool FunctionCallExpression::enableMemo(const FunctionMemo::Options& options) {
+    auto isPure = FunctionManager::getIsPure(name_, DCHECK_NOTNULL(args_)->numArgs());
+    if (!isPure.ok() || !isPure.value()) {
+        memo_.reset();
+        return false;
+    }
+    memoOptions_ = options;
+    memo_ = std::make_unique<FunctionMemo>(options);
+    return true;
+}
+
+const FunctionMemo* FunctionCallExpression::memo(const ExpressionContext& ctx) const {
+    auto* frame = ctx.frame();
+    if (memo_ == nullptr || slot() == kNoSlot || frame == nullptr) {
+        return memo_.get();
+    }
+    return frame->findMemo(slot());
+}
+
+FunctionMemo* FunctionCallExpression::memoOf(ExpressionContext& ctx) {
+    auto* frame = ctx.frame();
+    if (memo_ == nullptr || slot() == kNoSlot || frame == nullptr) {
+        return memo_.get();
+    }
+    auto& frameMemo = frame->memo(slot());
+    if (frameMemo == nullptr) {
+        frameMemo = std::make_unique<FunctionMemo>(memoOptions_);
+    }
+    return frameMemo.get();
 }
 
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
-    std::vector<std::reference_wrapper<const Value>> parameter;
-    for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
-        parameter.emplace_back(arg->eval(ctx));
+    auto& result = resultOf(ctx, result_);
+    FunctionManager::ArgList parameter;
+    parameter.reserve(DCHECK_NOTNULL(args_)->numArgs());
+    auto specialized = specialized_ != nullptr;
+    for (size_t i = 0; i < args_->numArgs(); ++i) {
+        auto& val = args_->args()[i]->eval(ctx);
+        specialized = specialized && val.type() == argsType_[i];
+        parameter.emplace_back(val);
+    }
+    auto call = [this, specialized] (const FunctionManager::ArgList& args) -> Value {
+        if (specialized) {
+            return specialized_(args);
+        }
+        if (!func_) {
+            // Unknown function or arity
+            return Value::kNullBadType;
+        }
+        return func_(args);
+    };
+    auto* argsMemo = memoOf(ctx);
+    if (argsMemo != nullptr) {
+        result = argsMemo->call(parameter, call);
+    } else {
+        result = call(parameter);
+    }
+    return result;
+}
+
+ValueColumn FunctionCallExpression::evalBatch(ExpressionContext& ctx,
+                                             size_t numRows,
+                                             folly::FunctionRef<void(size_t)> setRow) {
+    if (!batchFunc_) {
+        // Unknown function or arity, like eval()
+        return ValueColumn::constant(Value::kNullBadType, numRows);
+    }
+    std::vector<ValueColumn> columns;
+    columns.reserve(DCHECK_NOTNULL(args_)->numArgs());
+    for (auto* arg : args_->args()) {
+        columns.emplace_back(arg->evalBatch(ctx, numRows, setRow));
+    }
+    FunctionManager::ColumnArgs argColumns;
+    for (const auto& column : columns) {
+        argColumns.emplace_back(&column);
     }
-    result_ = DCHECK_NOTNULL(func_)(parameter);
-    return result_;
+    return batchFunc_(argColumns, numRows);
 }
 
 std::string FunctionCallExpression::toString() const {
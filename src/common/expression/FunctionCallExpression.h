@@ -10,6 +10,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include "common/function/FunctionManager.h"
+#include "common/function/FunctionMemo.h"
 #include "common/expression/Expression.h"
 
 namespace nebula {
@@ -75,8 +76,13 @@ public:
                    : pool->add(new FunctionCallExpression(pool, name, args));
     }
 
+    // NULL of BAD_TYPE if there's no function of the name and the arity
     const Value& eval(ExpressionContext& ctx) override;
 
+    ValueColumn evalBatch(ExpressionContext& ctx,
+                          size_t numRows,
+                          folly::FunctionRef<void(size_t)> setRow) override;
+
     bool operator==(const Expression& rhs) const override;
 
     std::string toString() const override;
@@ -107,6 +113,33 @@ public:
         return args_;
     }
 
+    // Specializes the call for arguments of `argsType', which are known at bind
+    // time, e.g. deduced by the validator. Returns false if there's no specialized
+    // body for the types, or `argsType' is not of the number of arguments. The
+    // arguments found of other types, such as NULL of nullable properties, are
+    // still passed to the generic body.
+    bool specialize(const std::vector<Value::Type>& argsType);
+
+    bool isSpecialized() const {
+        return specialized_ != nullptr;
+    }
+
+    // Memoizes the results by the arguments for the rest of the query, which is
+    // opted in per query, e.g. for the calls over a low-cardinality column.
+    // Returns false if the function is not pure. Once bound by ExprSlotBinder,
+    // the call keeps a memo in each frame it's evaluated with, so it's still
+    // shareable by the threads.
+    bool enableMemo(const FunctionMemo::Options& options = FunctionMemo::Options());
+
+    // The memo of the evaluations without a frame, nullptr if not enabled
+    const FunctionMemo* memo() const {
+        return memo_.get();
+    }
+
+    // The memo which eval() with `ctx' uses, nullptr if not enabled or not
+    // evaluated with the frame of `ctx' yet
+    const FunctionMemo* memo(const ExpressionContext& ctx) const;
+
 private:
     explicit FunctionCallExpression(ObjectPool* pool, const std::string& name, ArgumentList* args)
         : Expression(pool, Kind::kFunctionCall), name_(name), args_(args) {
@@ -115,12 +148,19 @@ private:
             if (funcResult.ok()) {
                 func_ = funcResult.value();
             }
+            auto batchResult = FunctionManager::getBatch(name_, args_->numArgs());
+            if (batchResult.ok()) {
+                batchFunc_ = std::move(batchResult).value();
+            }
         }
     }
 
     void writeTo(Encoder& encoder) const override;
     void resetFrom(Decoder& decoder) override;
 
+    // The memo of the frame of `ctx' if bound, otherwise memo_
+    FunctionMemo* memoOf(ExpressionContext& ctx);
+
 private:
     std::string name_;
     ArgumentList* args_;
@@ -128,6 +168,11 @@ private:
     // runtime cache
     Value result_;
     FunctionManager::Function func_;
+    FunctionManager::BatchFunction batchFunc_;
+    FunctionManager::SpecializedBody specialized_{nullptr};
+    folly::small_vector<Value::Type, FunctionManager::kInlineArgs> argsType_;
+    FunctionMemo::Options memoOptions_;
+    std::unique_ptr<FunctionMemo> memo_;
 };
 
 }  // namespace nebula
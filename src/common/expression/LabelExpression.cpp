@@ -9,9 +9,13 @@
 
 namespace nebula {
 
-const Value& LabelExpression::eval(ExpressionContext&) {
-    result_.setStr(name_);
-    return result_;
+const Value& LabelExpression::eval(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
+    // The name is the same each time, so it's only set once
+    if (!result.isStr() || result.getStr() != name_) {
+        result.setStr(name_);
+    }
+    return result;
 }
 
 std::string LabelExpression::toString() const {
@@ -10,28 +10,25 @@
 namespace nebula {
 
 const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
-    List ret;
-
     auto& listVal = collection_->eval(ctx);
     if (listVal.isNull() || listVal.empty()) {
-        result_ = listVal;
-        return result_;
+        return listVal;
     }
     if (!listVal.isList()) {
-        result_ = Value::kNullBadType;
-        return result_;
+        return Value::kNullBadType;
     }
-
-    auto& list = listVal.getList();
-
+    // The collection itself, borrowed rather than copied
     if  (filter_ == nullptr && mapping_ == nullptr) {
-        result_ = std::move(list);
-        return result_;
+        return listVal;
     }
 
+    auto& list = listVal.getList();
+    List ret;
+    ret.reserve(list.size());
+
     for (size_t i = 0; i < list.size(); ++i) {
         auto& v = list[i];
-        ctx.setVar(innerVar_, v);
+        setLoopVar(ctx, innerVarLocal_, innerVar_, v);
         if (filter_ != nullptr) {
             auto& filterVal = filter_->eval(ctx);
             if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
@@ -49,8 +46,9 @@ const Value& ListComprehensionExpression::eval(ExpressionContext& ctx) {
         }
     }
 
-    result_ = std::move(ret);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result.setList(std::move(ret));
+    return result;
 }
 
 Expression* ListComprehensionExpression::clone() const {
@@ -45,6 +45,14 @@ public:
         return innerVar_;
     }
 
+    int32_t innerVarLocal() const {
+        return innerVarLocal_;
+    }
+
+    void setInnerVarLocal(int32_t local) {
+        innerVarLocal_ = local;
+    }
+
     const Expression* collection() const {
         return collection_;
     }
@@ -119,6 +127,7 @@ private:
 
 private:
     std::string innerVar_;
+    int32_t innerVarLocal_{kNoSlot};
     Expression* collection_{nullptr};
     Expression* filter_{nullptr};    // filter_ is optional
     Expression* mapping_{nullptr};   // mapping_ is optional
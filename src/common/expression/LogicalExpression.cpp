@@ -25,83 +25,86 @@ const Value& LogicalExpression::eval(ExpressionContext& ctx) {
 
 // evalAnd short circuit logic: BADNULL == false > NULL >= EMPTY > true
 const Value& LogicalExpression::evalAnd(ExpressionContext &ctx) {
-    result_ = true;
+    auto& result = resultOf(ctx, result_);
+    result = true;
     for (auto i = 0u; i < operands_.size(); i++) {
         auto& value = operands_[i]->eval(ctx);
         if (value.isBadNull()
             || (value.isBool() && !value.getBool())) {
-            result_ = value;
-            return result_;
+            result = value;
+            return result;
         }
         if (!value.isBool()) {
             if (value.isNull()) {
-                result_ = value;
-            } else if (value.empty() && !result_.isNull()) {
-                result_ = value;
+                result = value;
+            } else if (value.empty() && !result.isNull()) {
+                result = value;
             } else {
-                result_ = Value::kNullBadType;
-                return result_;
+                result = Value::kNullBadType;
+                return result;
             }
         }
     }
 
-    return result_;
+    return result;
 }
 
 // evalOr short circuit logic: BADNULL == true > NULL >= EMPTY > false
 const Value& LogicalExpression::evalOr(ExpressionContext &ctx) {
-    result_ = false;
+    auto& result = resultOf(ctx, result_);
+    result = false;
     for (auto i = 0u; i < operands_.size(); i++) {
         auto& value = operands_[i]->eval(ctx);
         if (value.isBadNull()
             || (value.isBool() && value.getBool())) {
-            result_ = value;
-            return result_;
+            result = value;
+            return result;
         }
         if (!value.isBool()) {
             if (value.isNull()) {
-                result_ = value;
-            } else if (value.empty() && !result_.isNull()) {
-                result_ = value;
+                result = value;
+            } else if (value.empty() && !result.isNull()) {
+                result = value;
             } else {
-                result_ = Value::kNullBadType;
-                return result_;
+                result = Value::kNullBadType;
+                return result;
             }
         }
     }
 
-    return result_;
+    return result;
 }
 
 // evalXor short circuit logic: BADNULL == NULL > EMPTY > Bool
 const Value& LogicalExpression::evalXor(ExpressionContext &ctx) {
+    auto& result = resultOf(ctx, result_);
     auto hasEmpty = 0u;
     auto firstBool = 1u;
     for (auto i = 0u; i < operands_.size(); i++) {
         auto &value = operands_[i]->eval(ctx);
         if (value.isNull()) {
-            result_ = value;
-            return result_;
+            result = value;
+            return result;
         }
         if (!value.isBool()) {
             if (value.empty()) {
-                result_ = value;
+                result = value;
                 hasEmpty = 1;
                 continue;
             }
-            result_ = Value::kNullBadType;
-            return result_;
+            result = Value::kNullBadType;
+            return result;
         }
         if (hasEmpty) continue;
         if (firstBool) {
-            result_ = static_cast<bool>(value.getBool());
+            result = static_cast<bool>(value.getBool());
             firstBool = 0u;
         } else {
-            result_ = static_cast<bool>(result_.getBool() ^ value.getBool());
+            result = static_cast<bool>(result.getBool() ^ value.getBool());
         }
     }
 
-    return result_;
+    return result;
 }
 
 std::string LogicalExpression::toString() const {
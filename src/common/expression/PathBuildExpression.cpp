@@ -65,8 +65,9 @@ const Value& PathBuildExpression::eval(ExpressionContext& ctx) {
         }
     }
 
-    result_ = path;
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result.setPath(std::move(path));
+    return result;
 }
 
 bool PathBuildExpression::getVertex(const Value& value, Vertex& vertex) const {
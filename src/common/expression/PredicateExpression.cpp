@@ -17,6 +17,7 @@ std::unordered_map<std::string, PredicateExpression::Type> PredicateExpression::
 };
 
 const Value& PredicateExpression::evalExists(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
     DCHECK(collection_->kind() == Expression::Kind::kAttribute ||
            collection_->kind() == Expression::Kind::kSubscript);
 
@@ -25,132 +26,131 @@ const Value& PredicateExpression::evalExists(ExpressionContext& ctx) {
     auto& key = attributeExpr->right()->eval(ctx);
 
     if (!key.isStr()) {
-        result_ = Value::kNullBadType;
-        return result_;
+        result = Value::kNullBadType;
+        return result;
     }
 
     switch (container.type()) {
         case Value::Type::VERTEX: {
-            result_ = !container.getVertex().value(key.getStr()).isNull();
+            result = !container.getVertex().value(key.getStr()).isNull();
             break;
         }
         case Value::Type::EDGE: {
-            result_ = !container.getEdge().value(key.getStr()).isNull();
+            result = !container.getEdge().value(key.getStr()).isNull();
             break;
         }
         case Value::Type::MAP: {
-            result_ = !container.getMap().at(key.getStr()).isNull();
+            result = !container.getMap().at(key.getStr()).isNull();
             break;
         }
         case Value::Type::NULLVALUE: {
-            result_ = Value::kNullValue;
+            result = Value::kNullValue;
             break;
         }
         default: {
-            result_ = Value::kNullBadType;
+            result = Value::kNullBadType;
         }
     }
-    return result_;
+    return result;
 }
 
 const Value& PredicateExpression::eval(ExpressionContext& ctx) {
     if (name_ == "exists") {
         return evalExists(ctx);
     }
+
     Type type;
     auto iter = typeMap_.find(name_);
     if (iter != typeMap_.end()) {
         type = iter->second;
     } else {
-        result_ = Value::kNullBadType;
-        return result_;
+        return Value::kNullBadType;
     }
 
     auto& listVal = collection_->eval(ctx);
     if (listVal.isNull() || listVal.empty()) {
-        result_ = listVal;
-        return result_;
+        return listVal;
     }
     if (!listVal.isList()) {
-        result_ = Value::kNullBadType;
-        return result_;
+        return Value::kNullBadType;
     }
     auto& list = listVal.getList();
 
+    auto& result = resultOf(ctx, result_);
     switch (type) {
         case Type::ALL: {
-            result_ = true;
+            result = true;
             for (size_t i = 0; i < list.size(); ++i) {
                 auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                setLoopVar(ctx, innerVarLocal_, innerVar_, v);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
                 }
                 if (filterVal.empty() || filterVal.isNull() || !filterVal.getBool()) {
-                    result_ = false;
-                    return result_;
+                    result = false;
+                    return result;
                 }
             }
-            return result_;
+            return result;
         }
         case Type::ANY: {
-            result_ = false;
+            result = false;
             for (size_t i = 0; i < list.size(); ++i) {
                 auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                setLoopVar(ctx, innerVarLocal_, innerVar_, v);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
                 }
                 if (filterVal.isBool() && filterVal.getBool()) {
-                    result_ = true;
-                    return result_;
+                    result = true;
+                    return result;
                 }
             }
-            return result_;
+            return result;
         }
         case Type::SINGLE: {
-            result_ = false;
+            result = false;
             for (size_t i = 0; i < list.size(); ++i) {
                 auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                setLoopVar(ctx, innerVarLocal_, innerVar_, v);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
                 }
                 if (filterVal.isBool() && filterVal.getBool()) {
-                    if (result_ == false) {
-                        result_ = true;
+                    if (result == false) {
+                        result = true;
                     } else {
-                        result_ = false;
-                        return result_;
+                        result = false;
+                        return result;
                     }
                 }
             }
-            return result_;
+            return result;
         }
         case Type::NONE: {
-            result_ = true;
+            result = true;
             for (size_t i = 0; i < list.size(); ++i) {
                 auto& v = list[i];
-                ctx.setVar(innerVar_, v);
+                setLoopVar(ctx, innerVarLocal_, innerVar_, v);
                 auto& filterVal = filter_->eval(ctx);
                 if (!filterVal.empty() && !filterVal.isNull() && !filterVal.isBool()) {
                     return Value::kNullBadType;
                 }
                 if (filterVal.isBool() && filterVal.getBool()) {
-                    result_ = false;
-                    return result_;
+                    result = false;
+                    return result;
                 }
             }
-            return result_;
+            return result;
         }
         // no default so the compiler will warning when lack
     }
 
-    result_ = Value::kNullBadType;
-    return result_;
+    result = Value::kNullBadType;
+    return result;
 }
 
 bool PredicateExpression::operator==(const Expression& rhs) const {
@@ -57,6 +57,14 @@ public:
         return innerVar_;
     }
 
+    int32_t innerVarLocal() const {
+        return innerVarLocal_;
+    }
+
+    void setInnerVarLocal(int32_t local) {
+        innerVarLocal_ = local;
+    }
+
     const Expression* collection() const {
         return collection_;
     }
@@ -122,6 +130,7 @@ private:
 
     std::string name_;
     std::string innerVar_;
+    int32_t innerVarLocal_{kNoSlot};
     Expression* collection_;
     Expression* filter_;
     std::string originString_;
@@ -53,8 +53,9 @@ const Value& PropertyExpression::eval(ExpressionContext& ctx) {
 }
 
 const Value& EdgePropertyExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getEdgeProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdgeProp(sym_, prop_);
+    return result;
 }
 
 void EdgePropertyExpression::accept(ExprVisitor *visitor) {
@@ -62,8 +63,9 @@ void EdgePropertyExpression::accept(ExprVisitor *visitor) {
 }
 
 const Value& TagPropertyExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getTagProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getTagProp(sym_, prop_);
+    return result;
 }
 
 void TagPropertyExpression::accept(ExprVisitor* visitor) {
@@ -87,8 +89,9 @@ void VariablePropertyExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& SourcePropertyExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getSrcProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getSrcProp(sym_, prop_);
+    return result;
 }
 
 void SourcePropertyExpression::accept(ExprVisitor* visitor) {
@@ -104,8 +107,9 @@ void DestPropertyExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeSrcIdExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getEdgeProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdgeProp(sym_, prop_);
+    return result;
 }
 
 void EdgeSrcIdExpression::accept(ExprVisitor* visitor) {
@@ -113,8 +117,9 @@ void EdgeSrcIdExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeTypeExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getEdgeProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdgeProp(sym_, prop_);
+    return result;
 }
 
 void EdgeTypeExpression::accept(ExprVisitor* visitor) {
@@ -122,8 +127,9 @@ void EdgeTypeExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeRankExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getEdgeProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdgeProp(sym_, prop_);
+    return result;
 }
 
 void EdgeRankExpression::accept(ExprVisitor* visitor) {
@@ -131,8 +137,9 @@ void EdgeRankExpression::accept(ExprVisitor* visitor) {
 }
 
 const Value& EdgeDstIdExpression::eval(ExpressionContext& ctx) {
-    result_ = ctx.getEdgeProp(sym_, prop_);
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getEdgeProp(sym_, prop_);
+    return result;
 }
 
 void EdgeDstIdExpression::accept(ExprVisitor * visitor) {
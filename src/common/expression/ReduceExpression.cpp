@@ -14,25 +14,44 @@ const Value& ReduceExpression::eval(ExpressionContext& ctx) {
 
     auto& listVal = collection_->eval(ctx);
     if (listVal.isNull() || listVal.empty()) {
-        result_ = listVal;
-        return result_;
+        return listVal;
     }
     if (!listVal.isList()) {
-        result_ = Value::kNullBadType;
-        return result_;
+        return Value::kNullBadType;
     }
     auto& list = listVal.getList();
 
-    ctx.setVar(accumulator_, initVal);
+    auto* frame = ctx.frame();
+    if (accumulatorLocal_ == kNoSlot || frame == nullptr) {
+        ctx.setVar(accumulator_, initVal);
+        for (size_t i = 0; i < list.size(); ++i) {
+            auto& v = list[i];
+            setLoopVar(ctx, innerVarLocal_, innerVar_, v);
+            auto& mappingVal = mapping_->eval(ctx);
+            ctx.setVar(accumulator_, mappingVal);
+        }
+
+        // Copied, the variable could be set again before the result is used
+        auto& result = resultOf(ctx, result_);
+        result = ctx.getVar(accumulator_);
+        return result;
+    }
+
+    // The result is the accumulator itself, which the bound local refers to
+    auto& result = resultOf(ctx, result_);
+    result = initVal;
+    frame->setLocal(accumulatorLocal_, &result);
     for (size_t i = 0; i < list.size(); ++i) {
         auto& v = list[i];
-        ctx.setVar(innerVar_, v);
+        setLoopVar(ctx, innerVarLocal_, innerVar_, v);
         auto& mappingVal = mapping_->eval(ctx);
-        ctx.setVar(accumulator_, mappingVal);
+        if (&mappingVal != &result) {
+            // The mapping could borrow a part of the accumulator
+            Value next = mappingVal;
+            result = std::move(next);
+        }
     }
-
-    result_ = ctx.getVar(accumulator_);
-    return result_;
+    return result;
 }
 
 Expression* ReduceExpression::clone() const {
@@ -44,6 +44,14 @@ public:
         return accumulator_;
     }
 
+    int32_t accumulatorLocal() const {
+        return accumulatorLocal_;
+    }
+
+    void setAccumulatorLocal(int32_t local) {
+        accumulatorLocal_ = local;
+    }
+
     const Expression* initial() const {
         return initial_;
     }
@@ -56,6 +64,14 @@ public:
         return innerVar_;
     }
 
+    int32_t innerVarLocal() const {
+        return innerVarLocal_;
+    }
+
+    void setInnerVarLocal(int32_t local) {
+        innerVarLocal_ = local;
+    }
+
     const Expression* collection() const {
         return collection_;
     }
@@ -119,8 +135,10 @@ private:
 
 private:
     std::string accumulator_;
+    int32_t accumulatorLocal_{kNoSlot};
     Expression* initial_;
     std::string innerVar_;
+    int32_t innerVarLocal_{kNoSlot};
     Expression* collection_;
     Expression* mapping_;
     std::string originString_;
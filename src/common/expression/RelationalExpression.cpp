@@ -12,204 +12,205 @@
 
 namespace nebula {
 const Value& RelationalExpression::eval(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
     auto& lhs = lhs_->eval(ctx);
     auto& rhs = rhs_->eval(ctx);
 
     switch (kind_) {
         case Kind::kRelEQ:
-            result_ = lhs.equal(rhs);
+            result = lhs.equal(rhs);
             break;
         case Kind::kRelNE:
-            result_ = !lhs.equal(rhs);
+            result = !lhs.equal(rhs);
             break;
         case Kind::kRelLT:
-            result_ = lhs.lessThan(rhs);
+            result = lhs.lessThan(rhs);
             break;
         case Kind::kRelLE:
-            result_ = lhs.lessThan(rhs) || lhs.equal(rhs);
+            result = lhs.lessThan(rhs) || lhs.equal(rhs);
             break;
         case Kind::kRelGT:
-            result_ = !lhs.lessThan(rhs) && !lhs.equal(rhs);
+            result = !lhs.lessThan(rhs) && !lhs.equal(rhs);
             break;
         case Kind::kRelGE:
-            result_ = !lhs.lessThan(rhs) || lhs.equal(rhs);
+            result = !lhs.lessThan(rhs) || lhs.equal(rhs);
             break;
         case Kind::kRelREG: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
                 try {
                     const auto& r = ctx.getRegex(rhs.getStr());
-                    result_ = std::regex_match(lhs.getStr(), r);
+                    result = std::regex_match(lhs.getStr(), r);
                 } catch (const std::exception& ex) {
                     LOG(ERROR) << "Regex match error: " << ex.what();
-                    result_ = Value::kNullBadType;
+                    result = Value::kNullBadType;
                 }
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kRelIn: {
             if (rhs.isNull() && !rhs.isBadNull()) {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             } else if (rhs.isList()) {
                 auto& list = rhs.getList();
-                result_ = list.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             !result_.getBool() &&
+                result = list.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             !result.getBool() &&
                              list.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else if (rhs.isSet()) {
                 auto& set = rhs.getSet();
-                result_ = set.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             !result_.getBool() &&
+                result = set.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             !result.getBool() &&
                              set.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else if (rhs.isMap()) {
                 auto& map = rhs.getMap();
-                result_ = map.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             !result_.getBool() &&
+                result = map.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             !result.getBool() &&
                              map.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else {
-                result_ = Value(NullType::BAD_TYPE);
+                result = Value(NullType::BAD_TYPE);
             }
 
-            if (UNLIKELY(!result_.isBadNull() && lhs.isNull())) {
-                result_ = Value::kNullValue;
+            if (UNLIKELY(!result.isBadNull() && lhs.isNull())) {
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kRelNotIn: {
             if (rhs.isNull() && !rhs.isBadNull()) {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             } else if (rhs.isList()) {
                 auto& list = rhs.getList();
-                result_ = !list.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             result_.getBool() &&
+                result = !list.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             result.getBool() &&
                              list.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else if (rhs.isSet()) {
                 auto& set = rhs.getSet();
-                result_ = !set.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             result_.getBool() &&
+                result = !set.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             result.getBool() &&
                              set.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else if (rhs.isMap()) {
                 auto& map = rhs.getMap();
-                result_ = !map.contains(lhs);
-                if (UNLIKELY(result_.isBool() &&
-                             result_.getBool() &&
+                result = !map.contains(lhs);
+                if (UNLIKELY(result.isBool() &&
+                             result.getBool() &&
                              map.contains(Value::kNullValue))) {
-                    result_ = Value::kNullValue;
+                    result = Value::kNullValue;
                 }
             } else {
-                result_ = Value(NullType::BAD_TYPE);
+                result = Value(NullType::BAD_TYPE);
             }
 
-            if (UNLIKELY(!result_.isBadNull() && lhs.isNull())) {
-                result_ = Value::kNullValue;
+            if (UNLIKELY(!result.isBadNull() && lhs.isNull())) {
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kContains: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
+                result = lhs.getStr().size() >= rhs.getStr().size() &&
                           lhs.getStr().find(rhs.getStr()) != std::string::npos;
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kNotContains: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
+                result = !(lhs.getStr().size() >= rhs.getStr().size() &&
                             lhs.getStr().find(rhs.getStr()) != std::string::npos);
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kStartsWith: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
+                result = lhs.getStr().size() >= rhs.getStr().size() &&
                           lhs.getStr().find(rhs.getStr()) == 0;
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kNotStartsWith: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
+                result = !(lhs.getStr().size() >= rhs.getStr().size() &&
                             lhs.getStr().find(rhs.getStr()) == 0);
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kEndsWith: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = lhs.getStr().size() >= rhs.getStr().size() &&
+                result = lhs.getStr().size() >= rhs.getStr().size() &&
                           lhs.getStr().compare(lhs.getStr().size() - rhs.getStr().size(),
                                                rhs.getStr().size(),
                                                rhs.getStr()) == 0;
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         case Kind::kNotEndsWith: {
             if (lhs.isBadNull() || rhs.isBadNull()) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if ((!lhs.isNull() && !lhs.isStr()) || (!rhs.isNull() && !rhs.isStr())) {
-                result_ = Value::kNullBadType;
+                result = Value::kNullBadType;
             } else if (lhs.isStr() && rhs.isStr()) {
-                result_ = !(lhs.getStr().size() >= rhs.getStr().size() &&
+                result = !(lhs.getStr().size() >= rhs.getStr().size() &&
                             lhs.getStr().compare(lhs.getStr().size() - rhs.getStr().size(),
                                                  rhs.getStr().size(),
                                                  rhs.getStr()) == 0);
             } else {
-                result_ = Value::kNullValue;
+                result = Value::kNullValue;
             }
             break;
         }
         default:
             LOG(FATAL) << "Unknown type: " << kind_;
     }
-    return result_;
+    return result;
 }
 
 std::string RelationalExpression::toString() const {
@@ -16,90 +16,86 @@ const Value& SubscriptExpression::eval(ExpressionContext &ctx) {
     auto &lvalue = left()->eval(ctx);
     auto &rvalue = right()->eval(ctx);
 
-    result_ = Value::kNullValue;
-    do {
-        if (lvalue.isList()) {
-            if (!rvalue.isInt()) {
-                result_ = Value::kNullBadType;
-                break;
-            }
-            auto size = static_cast<int64_t>(lvalue.getList().size());
-            auto index = rvalue.getInt();
-            if (index >= size || index < -size) {
-                result_ = Value::kNullOutOfRange;
-                break;
-            }
-            // list[0] === list[-size], list[-1] === list[size-1]
-            if (index < 0) {
-                index += size;
-            }
-            result_ = lvalue.getList()[index];
-            break;
+    // The elements and properties are borrowed from `lvalue', which lives until
+    // the left operand is evaluated again
+    if (lvalue.isList()) {
+        if (!rvalue.isInt()) {
+            return Value::kNullBadType;
         }
-        if (lvalue.isMap()) {
-            if (!rvalue.isStr()) {
-                break;
-            }
-            result_ = lvalue.getMap().at(rvalue.getStr());
-            break;
+        auto size = static_cast<int64_t>(lvalue.getList().size());
+        auto index = rvalue.getInt();
+        if (index >= size || index < -size) {
+            return Value::kNullOutOfRange;
         }
-        if (lvalue.isDataSet()) {
-            if (!rvalue.isInt()) {
-                result_ = Value::kNullBadType;
-                break;
-            }
-            auto size = static_cast<int64_t>(lvalue.getDataSet().rowSize());
-            auto rowIndex = rvalue.getInt();
-            if (rowIndex >= size || rowIndex < 0) {
-                result_ = Value::kNullOutOfRange;
-                break;
-            }
-            result_ = lvalue.getDataSet().rows[rowIndex];
-            break;
+        // list[0] === list[-size], list[-1] === list[size-1]
+        if (index < 0) {
+            index += size;
         }
-        if (lvalue.isVertex()) {
-            if (!rvalue.isStr()) {
-                break;
-            }
-            if (rvalue.getStr() == kVid) {
-                result_ = lvalue.getVertex().vid;
-                return result_;
-            }
-            for (auto &tag : lvalue.getVertex().tags) {
-                auto iter = tag.props.find(rvalue.getStr());
-                if (iter != tag.props.end()) {
-                    return iter->second;
-                }
+        return lvalue.getList()[index];
+    }
+    if (lvalue.isMap()) {
+        if (!rvalue.isStr()) {
+            return Value::kNullValue;
+        }
+        return lvalue.getMap().at(rvalue.getStr());
+    }
+    if (lvalue.isDataSet()) {
+        if (!rvalue.isInt()) {
+            return Value::kNullBadType;
+        }
+        auto size = static_cast<int64_t>(lvalue.getDataSet().rowSize());
+        auto rowIndex = rvalue.getInt();
+        if (rowIndex >= size || rowIndex < 0) {
+            return Value::kNullOutOfRange;
+        }
+        auto& result = resultOf(ctx, result_);
+        result = lvalue.getDataSet().rows[rowIndex];
+        return result;
+    }
+    if (lvalue.isVertex()) {
+        if (!rvalue.isStr()) {
+            return Value::kNullValue;
+        }
+        if (rvalue.getStr() == kVid) {
+            return lvalue.getVertex().vid;
+        }
+        for (auto &tag : lvalue.getVertex().tags) {
+            auto iter = tag.props.find(rvalue.getStr());
+            if (iter != tag.props.end()) {
+                return iter->second;
             }
+        }
+        return Value::kNullValue;
+    }
+    if (lvalue.isEdge()) {
+        if (!rvalue.isStr()) {
             return Value::kNullValue;
         }
-        if (lvalue.isEdge()) {
-            if (!rvalue.isStr()) {
-                break;
+        DCHECK(!rvalue.getStr().empty());
+        if (rvalue.getStr()[0] == '_') {
+            if (rvalue.getStr() == kSrc) {
+                return lvalue.getEdge().src;
             }
-            DCHECK(!rvalue.getStr().empty());
-            if (rvalue.getStr()[0] == '_') {
-                if (rvalue.getStr() == kSrc) {
-                    result_ = lvalue.getEdge().src;
-                } else if (rvalue.getStr() == kDst) {
-                    result_ = lvalue.getEdge().dst;
-                } else if (rvalue.getStr() == kRank) {
-                    result_ = lvalue.getEdge().ranking;
-                } else if (rvalue.getStr() == kType) {
-                    result_ = lvalue.getEdge().name;
-                }
-                return result_;
+            if (rvalue.getStr() == kDst) {
+                return lvalue.getEdge().dst;
             }
-            auto iter = lvalue.getEdge().props.find(rvalue.getStr());
-            if (iter == lvalue.getEdge().props.end()) {
-                return Value::kNullValue;
+            auto& result = resultOf(ctx, result_);
+            if (rvalue.getStr() == kRank) {
+                result = lvalue.getEdge().ranking;
+            } else if (rvalue.getStr() == kType) {
+                result = lvalue.getEdge().name.str();
+            } else {
+                result = Value::kNullValue;
             }
-            return iter->second;
+            return result;
         }
-        result_ = Value::kNullBadType;
-    } while (false);
-
-    return result_;
+        auto iter = lvalue.getEdge().props.find(rvalue.getStr());
+        if (iter == lvalue.getEdge().props.end()) {
+            return Value::kNullValue;
+        }
+        return iter->second;
+    }
+    return Value::kNullBadType;
 }
 
 
@@ -120,10 +116,11 @@ void SubscriptExpression::accept(ExprVisitor *visitor) {
 // For the positive range bound it start from begin,
 // for the negative range bound it start from end
 const Value& SubscriptRangeExpression::eval(ExpressionContext &ctx) {
+    auto& result = resultOf(ctx, result_);
     const auto& listValue = DCHECK_NOTNULL(list_)->eval(ctx);
     if (!listValue.isList()) {
-        result_ = Value::kNullBadType;
-        return result_;
+        result = Value::kNullBadType;
+        return result;
     }
     const auto& list = listValue.getList();
     size_t size = list.size();
@@ -131,14 +128,14 @@ const Value& SubscriptRangeExpression::eval(ExpressionContext &ctx) {
     if (lo_ == nullptr) {
         lo = 0;
     } else {
-        auto loValue = DCHECK_NOTNULL(lo_)->eval(ctx);
+        auto& loValue = DCHECK_NOTNULL(lo_)->eval(ctx);
         if (loValue.isNull()) {
-            result_ = Value::kNullValue;
-            return result_;
+            result = Value::kNullValue;
+            return result;
         }
         if (!loValue.isInt()) {
-            result_ = Value::kNullBadType;
-            return result_;
+            result = Value::kNullBadType;
+            return result;
         }
         lo = loValue.getInt();
         if (lo < 0) {
@@ -149,14 +146,14 @@ const Value& SubscriptRangeExpression::eval(ExpressionContext &ctx) {
     if (hi_ == nullptr) {
         hi = size;
     } else {
-        auto hiValue = DCHECK_NOTNULL(hi_)->eval(ctx);
+        auto& hiValue = DCHECK_NOTNULL(hi_)->eval(ctx);
         if (hiValue.isNull()) {
-            result_ = Value::kNullValue;
-            return result_;
+            result = Value::kNullValue;
+            return result;
         }
         if (!hiValue.isInt()) {
-            result_ = Value::kNullBadType;
-            return result_;
+            result = Value::kNullBadType;
+            return result;
         }
         hi = hiValue.getInt();
         if (hi < 0) {
@@ -169,12 +166,12 @@ const Value& SubscriptRangeExpression::eval(ExpressionContext &ctx) {
         lo = 0;
     }
     if (lo >= hi) {
-        result_ = List();
-        return result_;
+        result = List();
+        return result;
     }
     if (static_cast<size_t>(lo) >= size) {
-        result_ = List();
-        return result_;
+        result = List();
+        return result;
     }
     if (static_cast<size_t>(hi) >= size) {
         hi = size;
@@ -182,8 +179,8 @@ const Value& SubscriptRangeExpression::eval(ExpressionContext &ctx) {
 
     List r;
     r.values = {list.values.begin()+lo, list.values.begin()+hi};
-    result_ = std::move(r);
-    return result_;
+    result = std::move(r);
+    return result;
 }
 
 std::string SubscriptRangeExpression::toString() const {
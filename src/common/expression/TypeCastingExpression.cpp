@@ -62,27 +62,32 @@ bool TypeCastingExpression::validateTypeCast(Value::Type operandType, Value::Typ
 }
 
 const Value& TypeCastingExpression::eval(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
     DCHECK(!!operand_);
-    auto val = operand_->eval(ctx);
+    auto& val = operand_->eval(ctx);
 
     switch (vType_) {
         case Value::Type::BOOL: {
-            result_ = val.toBool();
+            result = val.toBool();
             break;
         }
         case Value::Type::INT: {
-            result_ = val.toInt();
+            result = val.toInt();
             break;
         }
         case Value::Type::FLOAT: {
-            result_ = val.toFloat();
+            result = val.toFloat();
             break;
         }
         case Value::Type::STRING: {
+            // Reuse the string of the last result, which is mostly big enough
+            if (!result.isStr()) {
+                result.setStr("");
+            }
             if (val.isStr()) {
-                result_.setStr(val.moveStr());
+                result.mutableStr() = val.getStr();
             } else {
-                result_.setStr(val.toString());
+                result.mutableStr() = val.toString();
             }
             break;
         }
@@ -91,7 +96,7 @@ const Value& TypeCastingExpression::eval(ExpressionContext& ctx) {
             return Value::kNullValue;
         }
     }
-    return result_;
+    return result;
 }
 
 
@@ -37,9 +37,10 @@ void UUIDExpression::resetFrom(Decoder& decoder) {
 
 
 const Value& UUIDExpression::eval(ExpressionContext& ctx) {
+    auto& result = resultOf(ctx, result_);
     // TODO
     UNUSED(ctx);
-    return result_;
+    return result;
 }
 
 std::string UUIDExpression::toString() const {
@@ -40,62 +40,70 @@ void UnaryExpression::resetFrom(Decoder& decoder) {
 
 const Value& UnaryExpression::eval(ExpressionContext& ctx) {
     DCHECK(!!operand_);
+    if (kind_ == Kind::kUnaryPlus) {
+        return operand_->eval(ctx);
+    }
+
+    auto& result = resultOf(ctx, result_);
     switch (kind_) {
         case Kind::kUnaryPlus: {
-            Value val(operand_->eval(ctx));
-            result_ = std::move(val);
+            // Returned above, without copying
             break;
         }
         case Kind::kUnaryNegate: {
-            result_ = -(operand_->eval(ctx));
+            result = -(operand_->eval(ctx));
             break;
         }
         case Kind::kUnaryNot: {
-            result_ = !(operand_->eval(ctx));
+            result = !(operand_->eval(ctx));
             break;
         }
         case Kind::kUnaryIncr: {
             if (UNLIKELY(operand_->kind() != Kind::kVar
                         && operand_->kind() != Kind::kVersionedVar)) {
-                result_ = Value(NullType::BAD_TYPE);
+                result = Value(NullType::BAD_TYPE);
                 break;
             }
-            result_ = operand_->eval(ctx) + 1;
+            result = operand_->eval(ctx) + 1;
             auto* varExpr = static_cast<VariableExpression*>(operand_);
-            ctx.setVar(varExpr->var(), result_);
+            // A bound loop variable is updated by referring to the result
+            auto local = operand_->kind() == Kind::kVar ? varExpr->local() : kNoSlot;
+            setLoopVar(ctx, local, varExpr->var(), result);
             break;
         }
         case Kind::kUnaryDecr: {
             if (UNLIKELY(operand_->kind() != Kind::kVar
                         && operand_->kind() != Kind::kVersionedVar)) {
-                result_ = Value(NullType::BAD_TYPE);
+                result = Value(NullType::BAD_TYPE);
                 break;
             }
-            result_ = operand_->eval(ctx) - 1;
+            result = operand_->eval(ctx) - 1;
             auto* varExpr = static_cast<VariableExpression*>(operand_);
-            ctx.setVar(varExpr->var(), result_);
+            // A bound loop variable is updated by referring to the result
+            auto local = operand_->kind() == Kind::kVar ? varExpr->local() : kNoSlot;
+            setLoopVar(ctx, local, varExpr->var(), result);
             break;
         }
         case Kind::kIsNull: {
-            result_ = (operand_->eval(ctx)).isNull() ? true : false;
+            result = (operand_->eval(ctx)).isNull() ? true : false;
             break;
         }
         case Kind::kIsNotNull: {
-            result_ = (operand_->eval(ctx)).isNull() ? false : true;
+            result = (operand_->eval(ctx)).isNull() ? false : true;
             break;
         }
         case Kind::kIsEmpty: {
-            result_ = (operand_->eval(ctx)).empty() ? true : false;
+            result = (operand_->eval(ctx)).empty() ? true : false;
             break;
         }
         case Kind::kIsNotEmpty: {
-            result_ = (operand_->eval(ctx)).empty() ? false : true;
+            result = (operand_->eval(ctx)).empty() ? false : true;
             break;
         }
        default:
            LOG(FATAL) << "Unknown type: " << kind_;
    }
-   return result_;
+   return result;
 }
 
 std::string UnaryExpression::toString() const {
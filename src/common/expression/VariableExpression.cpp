@@ -10,6 +10,10 @@
 
 namespace nebula {
 const Value& VariableExpression::eval(ExpressionContext& ctx) {
+    auto* frame = ctx.frame();
+    if (local_ != kNoSlot && frame != nullptr) {
+        return frame->local(local_);
+    }
     return ctx.getVar(var_);
 }
 
@@ -30,7 +34,7 @@ void VariableExpression::resetFrom(Decoder& decoder) {
 
 const Value& VersionedVariableExpression::eval(ExpressionContext& ctx) {
     if (version_ != nullptr) {
-        auto version = version_->eval(ctx);
+        auto& version = version_->eval(ctx);
         if (UNLIKELY(!version.isInt())) {
             return Value::kNullBadType;
         }
@@ -27,6 +27,16 @@ public:
         return isInner_;
     }
 
+    // The local of the ExpressionFrame which the variable is read from, it's
+    // assigned by ExprSlotBinder to the loop variables in scope
+    int32_t local() const {
+        return local_;
+    }
+
+    void setLocal(int32_t local) {
+        local_ = local;
+    }
+
     const Value& eval(ExpressionContext& ctx) override;
 
     bool operator==(const Expression& rhs) const override {
@@ -56,6 +66,7 @@ private:
 private:
     bool isInner_{false};
     std::string var_;
+    int32_t local_{kNoSlot};
 };
 
 /*
@@ -75,6 +86,14 @@ public:
         return var_;
     }
 
+    const Expression* version() const {
+        return version_;
+    }
+
+    Expression* version() {
+        return version_;
+    }
+
     const Value& eval(ExpressionContext& ctx) override;
 
     bool operator==(const Expression& rhs) const override {
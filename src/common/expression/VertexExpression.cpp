@@ -11,8 +11,9 @@
 namespace nebula {
 
 const Value& VertexExpression::eval(ExpressionContext &ctx) {
-    result_ = ctx.getVertex();
-    return result_;
+    auto& result = resultOf(ctx, result_);
+    result = ctx.getVertex();
+    return result;
 }
 
 void VertexExpression::accept(ExprVisitor *visitor) {
@@ -5,7 +5,9 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <memory>
+#include <thread>
 #include "common/base/ObjectPool.h"
 #include "common/expression/AggregateExpression.h"
 #include "common/expression/ConstantExpression.h"
@@ -26,6 +28,139 @@ size_t aggFuncCall(size_t iters) {
 
 BENCHMARK_NAMED_PARAM_MULTI(aggFuncCall, AggregateExpressionBM)
 
+static constexpr size_t kRows = 10000000;
+static std::vector<Value> rows;
+
+// Aggregate all the rows in a single thread
+size_t serialAgg(size_t iters, const char* name) {
+    auto aggFunc = AggFunctionManager::get(name).value();
+    for (size_t i = 0; i < iters; ++i) {
+        AggData aggData;
+        for (const auto& row : rows) {
+            aggFunc(&aggData, row);
+        }
+        aggData.finalize();
+        folly::doNotOptimizeAway(aggData.result());
+    }
+    return iters * rows.size();
+}
+
+// Aggregate a slice of the rows in each thread, then merge the partial results
+size_t parallelAgg(size_t iters, const char* name, size_t numThreads) {
+    auto aggFunc = AggFunctionManager::get(name).value();
+    auto mergeFunc = AggFunctionManager::getMerge(name).value();
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<AggData> partials(numThreads);
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        auto sliceSize = (rows.size() + numThreads - 1) / numThreads;
+        for (size_t t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&, t] {
+                auto begin = std::min(t * sliceSize, rows.size());
+                auto end = std::min(begin + sliceSize, rows.size());
+                for (auto j = begin; j < end; ++j) {
+                    aggFunc(&partials[t], rows[j]);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        AggData aggData;
+        for (const auto& partial : partials) {
+            mergeFunc(&aggData, partial);
+        }
+        aggData.finalize();
+        folly::doNotOptimizeAway(aggData.result());
+    }
+    return iters * rows.size();
+}
+
+// Aggregate the rows into groups, each group keeps an AggData
+size_t groupAggData(size_t iters, const char* name, size_t numGroups) {
+    auto aggFunc = AggFunctionManager::get(name).value();
+    for (size_t i = 0; i < iters; ++i) {
+        std::vector<AggData> groups(numGroups);
+        for (size_t j = 0; j < rows.size(); ++j) {
+            aggFunc(&groups[j % numGroups], rows[j]);
+        }
+        groups.back().finalize();
+        folly::doNotOptimizeAway(groups.back().result());
+    }
+    return iters * rows.size();
+}
+
+// Aggregate the rows into groups, the compact states are kept in an arena
+size_t groupAggState(size_t iters, const char* name, size_t numGroups) {
+    auto state = AggFunctionManager::getState(name).value();
+    for (size_t i = 0; i < iters; ++i) {
+        AggStateArena arena({{state, false}});
+        for (size_t j = 0; j < numGroups; ++j) {
+            arena.addGroup();
+        }
+        for (size_t j = 0; j < rows.size(); ++j) {
+            arena.apply(j % numGroups, 0, rows[j]);
+        }
+        folly::doNotOptimizeAway(arena.result(numGroups - 1, 0));
+    }
+    return iters * rows.size();
+}
+
+// Print the memory taken by each group, the payload of the result values excluded
+void printMemoryPerGroup(const char* name, size_t numGroups) {
+    auto aggFunc = AggFunctionManager::get(name).value();
+    std::vector<AggData> groups(numGroups);
+    for (size_t j = 0; j < numGroups; ++j) {
+        aggFunc(&groups[j], rows[j]);
+    }
+    size_t aggDataBytes = numGroups * sizeof(AggData);
+    for (auto& group : groups) {
+        const auto& cgroup = group;
+        if (cgroup.uniques() != nullptr) {
+            aggDataBytes += sizeof(Set);
+        }
+    }
+
+    AggStateArena arena({{AggFunctionManager::getState(name).value(), false}});
+    for (size_t j = 0; j < numGroups; ++j) {
+        arena.apply(arena.addGroup(), 0, rows[j]);
+    }
+    LOG(INFO) << name << " of " << numGroups << " groups, bytes per group: AggData "
+              << aggDataBytes / numGroups << ", compact state "
+              << arena.memoryUsage() / numGroups;
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(groupAggData, count_1M_groups, "count", 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(groupAggState, count_1M_groups, "count", 1000000)
+BENCHMARK_NAMED_PARAM_MULTI(groupAggData, sum_1M_groups, "sum", 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(groupAggState, sum_1M_groups, "sum", 1000000)
+BENCHMARK_NAMED_PARAM_MULTI(groupAggData, avg_1M_groups, "avg", 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(groupAggState, avg_1M_groups, "avg", 1000000)
+BENCHMARK_NAMED_PARAM_MULTI(groupAggData, avg_1K_groups, "avg", 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(groupAggState, avg_1K_groups, "avg", 1000)
+BENCHMARK_NAMED_PARAM_MULTI(groupAggData, max_1M_groups, "max", 1000000)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(groupAggState, max_1M_groups, "max", 1000000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(serialAgg, count, "count")
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, count_4_threads, "count", 4)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, count_16_threads, "count", 16)
+BENCHMARK_NAMED_PARAM_MULTI(serialAgg, sum, "sum")
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, sum_4_threads, "sum", 4)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, sum_16_threads, "sum", 16)
+BENCHMARK_NAMED_PARAM_MULTI(serialAgg, avg, "avg")
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, avg_4_threads, "avg", 4)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, avg_16_threads, "avg", 16)
+BENCHMARK_NAMED_PARAM_MULTI(serialAgg, std, "std")
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, std_4_threads, "std", 4)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, std_16_threads, "std", 16)
+BENCHMARK_NAMED_PARAM_MULTI(serialAgg, max, "max")
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, max_4_threads, "max", 4)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(parallelAgg, max_16_threads, "max", 16)
+
 }   // namespace nebula
 
 using nebula::AggregateExpression;
@@ -37,7 +172,15 @@ int main(int argc, char** argv) {
     nebula::AggData aggData;
     nebula::expr->setAggData(&aggData);
 
+    nebula::rows.reserve(nebula::kRows);
+    for (size_t i = 0; i < nebula::kRows; ++i) {
+        nebula::rows.emplace_back(static_cast<int64_t>(folly::Random::rand32(1000000)));
+    }
+
     folly::init(&argc, &argv, true);
+    for (auto name : {"count", "sum", "avg", "std", "max", "collect"}) {
+        nebula::printMemoryPerGroup(name, 1000000);
+    }
     folly::runBenchmarks();
 
     return 0;
@@ -12,6 +12,8 @@
         EXPECT_TRUE(testAggExpr(#name, isDistinct, #expr, inputVar, expected));                    \
     } while (0)
 
+DECLARE_int32(approx_percentile_compression);
+
 namespace nebula {
 
 template<typename K, typename V>
@@ -61,7 +63,8 @@ public:
         }
         std::unordered_map<std::string, Value> res;
         for (auto& iter : agg_data_map) {
-            res[iter.first] = iter.second->result();
+            aggExpr->setAggData(iter.second.get());
+            res[iter.first] = aggExpr->finalize();
         }
         if (res != expected) {
             return ::testing::AssertionFailure() << "Expect: " << expected << ", Got: " << res;
@@ -347,6 +350,32 @@ TEST_F(AggregateExpressionTest, AggregateExpression) {
     }
 }
 
+TEST_F(AggregateExpressionTest, DeferredResult) {
+    constexpr int64_t kRows = 10000;
+    for (auto distinct : {false, true}) {
+        auto* arg = ConstantExpression::make(&pool);
+        auto* aggExpr = AggregateExpression::make(&pool, "APPROX_MEDIAN", arg, distinct);
+        AggData aggData;
+        aggExpr->setAggData(&aggData);
+        for (int64_t i = 0; i < kRows; ++i) {
+            arg->setValue(i % 2 == 0 ? i : kRows - i);
+            aggExpr->eval(gExpCtxt);
+            EXPECT_TRUE(aggData.pending());
+        }
+        ASSERT_NE(nullptr, aggData.digest());
+        auto buffered = static_cast<size_t>(FLAGS_approx_percentile_compression) * 5;
+        auto numValues = static_cast<size_t>(aggData.digest()->count());
+        // Only the full buffers are compressed, not a quantile per row
+        EXPECT_EQ(numValues / buffered, aggData.digest()->numCompressions());
+
+        auto& result = aggExpr->finalize();
+        EXPECT_FALSE(aggData.pending());
+        EXPECT_NEAR(kRows / 2, result.getFloat(), kRows * 0.02);
+        EXPECT_EQ(numValues / buffered + (numValues % buffered != 0 ? 1 : 0),
+                  aggData.digest()->numCompressions());
+    }
+}
+
 TEST_F(ExpressionTest, AggregateToString) {
     auto arg = ConstantExpression::make(&pool, "$-.age");
     auto* aggName = "COUNT";
@@ -0,0 +1,108 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <folly/Benchmark.h>
+#include "common/base/ObjectPool.h"
+#include "common/expression/ExprConstantChecker.h"
+#include "common/expression/test/ExpressionContextMock.h"
+
+nebula::ExpressionContextMock gExpCtxt;
+nebula::ObjectPool pool;
+
+namespace nebula {
+
+// A row inserted without any of the 20 defaulted columns, which is what the
+// insert path pays for the defaults per row
+static constexpr size_t kNumDefaults = 20;
+
+struct Defaults {
+    std::vector<std::string> encoded;
+    std::vector<Expression*> decoded;
+    // What NebulaSchemaProvider caches once the schema is loaded
+    std::vector<Value> cached;
+};
+
+static const Defaults& defaults() {
+    static const auto defaults = [] () {
+        Defaults d;
+        for (size_t i = 0; i < kNumDefaults; ++i) {
+            Expression* expr = nullptr;
+            switch (i % 4) {
+                case 0:
+                    expr = ConstantExpression::make(&pool, static_cast<int64_t>(i));
+                    break;
+                case 1:
+                    expr = ConstantExpression::make(&pool, "a default string value");
+                    break;
+                case 2:
+                    expr = ArithmeticExpression::makeMultiply(
+                        &pool,
+                        ConstantExpression::make(&pool, 1.5),
+                        ConstantExpression::make(&pool, static_cast<int64_t>(i)));
+                    break;
+                default: {
+                    auto* args = ArgumentList::make(&pool);
+                    args->addArgument(ConstantExpression::make(&pool, "default"));
+                    expr = FunctionCallExpression::make(&pool, "upper", args);
+                    break;
+                }
+            }
+            CHECK(ExprConstantChecker::isConstant(expr));
+            d.encoded.emplace_back(Expression::encode(*expr));
+            d.decoded.emplace_back(Expression::decode(&pool, d.encoded.back()));
+            d.cached.emplace_back(Expression::eval(expr, gExpCtxt));
+        }
+        return d;
+    }();
+    return defaults;
+}
+
+size_t decodeAndEval(size_t iters) {
+    auto& d = defaults();
+    for (size_t i = 0; i < iters; ++i) {
+        ObjectPool rowPool;
+        for (auto& encoded : d.encoded) {
+            auto* expr = Expression::decode(&rowPool, encoded);
+            Value val = Expression::eval(expr, gExpCtxt);
+            folly::doNotOptimizeAway(val);
+        }
+    }
+    return iters;
+}
+
+size_t eval(size_t iters) {
+    auto& d = defaults();
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto* expr : d.decoded) {
+            Value val = Expression::eval(expr, gExpCtxt);
+            folly::doNotOptimizeAway(val);
+        }
+    }
+    return iters;
+}
+
+size_t cached(size_t iters) {
+    auto& d = defaults();
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto& cachedVal : d.cached) {
+            Value val = cachedVal;
+            folly::doNotOptimizeAway(val);
+        }
+    }
+    return iters;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(decodeAndEval, decode_eval_20_defaults)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(eval, eval_20_defaults)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(cached, cached_20_defaults)
+
+}   // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/expression/ExprConstantChecker.h"
+
+namespace nebula {
+
+class ExprConstantCheckerTest : public ::testing::Test {
+protected:
+    Expression* call(const std::string& name, std::vector<Expression*> args = {}) {
+        auto* argList = ArgumentList::make(&pool_);
+        for (auto* arg : args) {
+            argList->addArgument(arg);
+        }
+        return FunctionCallExpression::make(&pool_, name, argList);
+    }
+
+    Expression* constant(Value val) {
+        return ConstantExpression::make(&pool_, std::move(val));
+    }
+
+    ObjectPool pool_;
+};
+
+
+TEST_F(ExprConstantCheckerTest, Constant) {
+    EXPECT_TRUE(ExprConstantChecker::isConstant(constant(1)));
+    EXPECT_TRUE(ExprConstantChecker::isConstant(constant("default")));
+    // 1 + 2 * 3
+    EXPECT_TRUE(ExprConstantChecker::isConstant(ArithmeticExpression::makeAdd(
+        &pool_, constant(1), ArithmeticExpression::makeMultiply(&pool_, constant(2), constant(3)))));
+    // upper("abc")
+    EXPECT_TRUE(ExprConstantChecker::isConstant(call("upper", {constant("abc")})));
+    // [1, abs(-2)]
+    auto* list = ExpressionList::make(&pool_);
+    list->add(constant(1));
+    list->add(call("abs", {constant(-2)}));
+    EXPECT_TRUE(ExprConstantChecker::isConstant(ListExpression::make(&pool_, list)));
+    // The variables of its own: [n IN range(1, 3) | n * 2]
+    EXPECT_TRUE(ExprConstantChecker::isConstant(ListComprehensionExpression::make(
+        &pool_,
+        "n",
+        call("range", {constant(1), constant(3)}),
+        nullptr,
+        ArithmeticExpression::makeMultiply(
+            &pool_, VariableExpression::make(&pool_, "n"), constant(2)))));
+    // reduce(acc = 0, n IN [1, 2] | acc + n)
+    auto* items = ExpressionList::make(&pool_);
+    items->add(constant(1));
+    items->add(constant(2));
+    EXPECT_TRUE(ExprConstantChecker::isConstant(ReduceExpression::make(
+        &pool_,
+        "acc",
+        constant(0),
+        "n",
+        ListExpression::make(&pool_, items),
+        ArithmeticExpression::makeAdd(&pool_,
+                                      VariableExpression::make(&pool_, "acc"),
+                                      VariableExpression::make(&pool_, "n")))));
+}
+
+
+TEST_F(ExprConstantCheckerTest, NotConstant) {
+    EXPECT_FALSE(ExprConstantChecker::isConstant(call("now")));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(call("rand")));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(call("timestamp")));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(UUIDExpression::make(&pool_, "a")));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(call("no_such_function")));
+    // now() + 1
+    EXPECT_FALSE(ExprConstantChecker::isConstant(
+        ArithmeticExpression::makeAdd(&pool_, call("now"), constant(1))));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(InputPropertyExpression::make(&pool_, "a")));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(VariableExpression::make(&pool_, "n")));
+    // The variable out of the scope: [n IN [1] | m]
+    auto* items = ExpressionList::make(&pool_);
+    items->add(constant(1));
+    EXPECT_FALSE(ExprConstantChecker::isConstant(ListComprehensionExpression::make(
+        &pool_,
+        "n",
+        ListExpression::make(&pool_, items),
+        nullptr,
+        VariableExpression::make(&pool_, "m"))));
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,338 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include "common/expression/ExprSlotBinder.h"
+
+namespace nebula {
+
+// The input row and variables are of the context, unlike ExpressionContextMock
+class RowContext final : public ExpressionContext {
+public:
+    const Value& getVar(const std::string& var) const override {
+        auto found = vars_.find(var);
+        return found == vars_.end() ? Value::kNullValue : found->second;
+    }
+
+    const Value& getVersionedVar(const std::string&, int64_t) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getVarProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getEdgeProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getTagProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getSrcProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getDstProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getInputProp(const std::string& prop) const override {
+        auto found = row_.find(prop);
+        return found == row_.end() ? Value::kNullValue : found->second;
+    }
+
+    Value getVertex() const override {
+        return Value();
+    }
+
+    Value getEdge() const override {
+        return Value();
+    }
+
+    Value getColumn(int32_t) const override {
+        return Value::kNullValue;
+    }
+
+    void setVar(const std::string& var, Value val) override {
+        vars_[var] = std::move(val);
+    }
+
+    void setRow(int64_t a, int64_t b) {
+        row_["a"] = a;
+        row_["b"] = b;
+    }
+
+private:
+    std::unordered_map<std::string, Value> row_;
+    std::unordered_map<std::string, Value> vars_;
+};
+
+
+class ExprSlotBinderTest : public ::testing::Test {
+protected:
+    // ($-.a + 1) * 2 > $-.b AND abs($-.a - 10) <= 5
+    Expression* makeFilter() {
+        auto* lhs = RelationalExpression::makeGT(
+            &pool_,
+            ArithmeticExpression::makeMultiply(
+                &pool_,
+                ArithmeticExpression::makeAdd(&pool_,
+                                              InputPropertyExpression::make(&pool_, "a"),
+                                              ConstantExpression::make(&pool_, 1)),
+                ConstantExpression::make(&pool_, 2)),
+            InputPropertyExpression::make(&pool_, "b"));
+        auto* args = ArgumentList::make(&pool_);
+        args->addArgument(
+            ArithmeticExpression::makeMinus(&pool_,
+                                            InputPropertyExpression::make(&pool_, "a"),
+                                            ConstantExpression::make(&pool_, 10)));
+        auto* rhs = RelationalExpression::makeLE(
+            &pool_,
+            FunctionCallExpression::make(&pool_, "abs", args),
+            ConstantExpression::make(&pool_, 5));
+        return LogicalExpression::makeAnd(&pool_, lhs, rhs);
+    }
+
+    // [n IN range(1, $-.a) WHERE n % 2 == 0 | n * $-.b]
+    Expression* makeProjection() {
+        auto* args = ArgumentList::make(&pool_);
+        args->addArgument(ConstantExpression::make(&pool_, 1));
+        args->addArgument(InputPropertyExpression::make(&pool_, "a"));
+        return ListComprehensionExpression::make(
+            &pool_,
+            "n",
+            FunctionCallExpression::make(&pool_, "range", args),
+            RelationalExpression::makeEQ(
+                &pool_,
+                ArithmeticExpression::makeMod(&pool_,
+                                              VariableExpression::make(&pool_, "n"),
+                                              ConstantExpression::make(&pool_, 2)),
+                ConstantExpression::make(&pool_, 0)),
+            ArithmeticExpression::makeMultiply(&pool_,
+                                               VariableExpression::make(&pool_, "n"),
+                                               InputPropertyExpression::make(&pool_, "b")));
+    }
+
+    Expression* makeRange() {
+        auto* args = ArgumentList::make(&pool_);
+        args->addArgument(ConstantExpression::make(&pool_, 1));
+        args->addArgument(InputPropertyExpression::make(&pool_, "a"));
+        return FunctionCallExpression::make(&pool_, "range", args);
+    }
+
+    static bool expectedFilter(int64_t a, int64_t b) {
+        return (a + 1) * 2 > b && std::abs(a - 10) <= 5;
+    }
+
+    static List expectedProjection(int64_t a, int64_t b) {
+        List list;
+        for (int64_t n = 1; n <= a; ++n) {
+            if (n % 2 == 0) {
+                list.emplace_back(n * b);
+            }
+        }
+        return list;
+    }
+
+    ObjectPool pool_;
+};
+
+
+TEST_F(ExprSlotBinderTest, Bind) {
+    auto* filter = makeFilter();
+    EXPECT_EQ(Expression::kNoSlot, filter->slot());
+
+    ExprSlotBinder binder;
+    binder.bind(filter);
+    // AND, GT, *, +, $-.a, 1, 2, $-.b, LE, abs, -, $-.a, 10, 5
+    EXPECT_EQ(14, binder.numSlots());
+    EXPECT_EQ(0, filter->slot());
+
+    // The next tree takes the slots after
+    auto* projection = makeProjection();
+    binder.bind(projection);
+    EXPECT_EQ(14, projection->slot());
+    EXPECT_LT(14, binder.numSlots());
+
+    // Clones are not bound
+    EXPECT_EQ(Expression::kNoSlot, filter->clone()->slot());
+}
+
+
+TEST_F(ExprSlotBinderTest, Frame) {
+    auto* filter = makeFilter();
+    ExprSlotBinder binder;
+    binder.bind(filter);
+
+    RowContext ctx;
+    ctx.setRow(8, 3);
+    // Without a frame, the result is kept in the expression
+    EXPECT_EQ(Value(true), filter->eval(ctx));
+
+    ExpressionFrame frame(binder.numSlots());
+    ctx.setFrame(&frame);
+    auto& result = filter->eval(ctx);
+    EXPECT_EQ(Value(true), result);
+    EXPECT_EQ(&frame.slot(filter->slot()), &result);
+
+    ctx.setRow(20, 3);
+    EXPECT_EQ(Value(false), filter->eval(ctx));
+
+    // Unbound expressions still work with a frame
+    auto* unbound = makeFilter();
+    ctx.setRow(8, 3);
+    EXPECT_EQ(Value(true), unbound->eval(ctx));
+
+    frame.reset();
+    EXPECT_TRUE(frame.slot(filter->slot()).empty());
+}
+
+
+TEST_F(ExprSlotBinderTest, Concurrent) {
+    auto* filter = makeFilter();
+    auto* projection = makeProjection();
+    // Memoized in each frame
+    auto* range = static_cast<FunctionCallExpression*>(makeRange());
+    ASSERT_TRUE(range->enableMemo());
+    ExprSlotBinder binder;
+    binder.bind(filter);
+    binder.bind(projection);
+    binder.bind(range);
+
+    constexpr int64_t kThreads = 8;
+    constexpr int64_t kRows = 2000;
+    std::vector<size_t> failures(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] () {
+            RowContext ctx;
+            ExpressionFrame frame(binder.numSlots(), binder.numLocals());
+            ctx.setFrame(&frame);
+            for (int64_t i = 0; i < kRows; ++i) {
+                auto a = (t * kRows + i) % 20;
+                auto b = t * 7 + i % 13;
+                ctx.setRow(a, b);
+                if (filter->eval(ctx) != Value(expectedFilter(a, b))) {
+                    ++failures[t];
+                }
+                if (projection->eval(ctx) != Value(expectedProjection(a, b))) {
+                    ++failures[t];
+                }
+                if (range->eval(ctx).getList().size() != static_cast<size_t>(a)) {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int64_t t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(0, failures[t]) << "thread " << t;
+    }
+}
+
+
+TEST_F(ExprSlotBinderTest, Locals) {
+    // [n IN range(1, $-.a) | [n IN range(1, n) | n * $-.b]]
+    auto* innerArgs = ArgumentList::make(&pool_);
+    innerArgs->addArgument(ConstantExpression::make(&pool_, 1));
+    innerArgs->addArgument(VariableExpression::make(&pool_, "n"));
+    auto* innerN = VariableExpression::make(&pool_, "n");
+    auto* inner = ListComprehensionExpression::make(
+        &pool_,
+        "n",
+        FunctionCallExpression::make(&pool_, "range", innerArgs),
+        nullptr,
+        ArithmeticExpression::makeMultiply(&pool_,
+                                           innerN,
+                                           InputPropertyExpression::make(&pool_, "b")));
+    auto* nested = ListComprehensionExpression::make(&pool_, "n", makeRange(), nullptr, inner);
+
+    // reduce(acc = 0, n IN range(1, $-.a) | acc + n * $-.b)
+    auto* reduce = ReduceExpression::make(
+        &pool_,
+        "acc",
+        ConstantExpression::make(&pool_, 0),
+        "n",
+        makeRange(),
+        ArithmeticExpression::makeAdd(
+            &pool_,
+            VariableExpression::make(&pool_, "acc"),
+            ArithmeticExpression::makeMultiply(&pool_,
+                                               VariableExpression::make(&pool_, "n"),
+                                               InputPropertyExpression::make(&pool_, "b"))));
+
+    // any(n IN range(1, $-.a) WHERE n > $-.b)
+    auto* any = PredicateExpression::make(
+        &pool_,
+        "any",
+        "n",
+        makeRange(),
+        RelationalExpression::makeGT(&pool_,
+                                     VariableExpression::make(&pool_, "n"),
+                                     InputPropertyExpression::make(&pool_, "b")));
+
+    // Out of any scope, read from the context
+    auto* outer = VariableExpression::make(&pool_, "n");
+
+    std::vector<Expression*> exprs = {nested, reduce, any, outer};
+    std::vector<Expression*> unbound;
+    ExprSlotBinder binder;
+    for (auto* expr : exprs) {
+        unbound.emplace_back(expr->clone());
+        binder.bind(expr);
+    }
+    // n, n; acc, n; n
+    EXPECT_EQ(5, binder.numLocals());
+    EXPECT_EQ(0, nested->innerVarLocal());
+    EXPECT_EQ(1, inner->innerVarLocal());
+    EXPECT_EQ(1, innerN->local());
+    // The range of the inner one is in the scope of the outer n
+    EXPECT_EQ(0, static_cast<VariableExpression*>(innerArgs->args()[1])->local());
+    EXPECT_EQ(2, reduce->accumulatorLocal());
+    EXPECT_EQ(3, reduce->innerVarLocal());
+    EXPECT_EQ(4, any->innerVarLocal());
+    EXPECT_EQ(Expression::kNoSlot, outer->local());
+
+    RowContext ctx;
+    ctx.setVar("n", 100);
+    ExpressionFrame frame(binder.numSlots(), binder.numLocals());
+    for (int64_t a = 0; a < 6; ++a) {
+        for (int64_t b = 0; b < 6; ++b) {
+            ctx.setRow(a, b);
+            for (size_t i = 0; i < exprs.size(); ++i) {
+                ctx.setFrame(nullptr);
+                Value expected = unbound[i]->eval(ctx);
+                ctx.setFrame(&frame);
+                EXPECT_EQ(expected, exprs[i]->eval(ctx)) << exprs[i]->toString();
+            }
+        }
+    }
+
+    // The loop variables leave the context as it was
+    RowContext other;
+    other.setVar("n", 100);
+    other.setRow(4, 2);
+    other.setFrame(&frame);
+    EXPECT_EQ(Value(20), reduce->eval(other));
+    EXPECT_EQ(Value(100), other.getVar("n"));
+    EXPECT_EQ(Value::kNullValue, other.getVar("acc"));
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/expression/test/TestBase.h"
+
+// The allocations of the thread while counting, through the replaced
+// operator new, so the counts are not disturbed by other threads
+static thread_local bool gCounting = false;
+static thread_local size_t gNumAllocs = 0;
+
+void* operator new(size_t size) {
+    if (gCounting) {
+        ++gNumAllocs;
+    }
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace nebula {
+
+class ExpressionAllocationTest : public ExpressionTest {
+protected:
+    // Allocations per eval once the result of `expr' is in place, as it is for
+    // all the rows but the first one
+    static double allocsPerEval(Expression* expr) {
+        constexpr size_t kEvals = 100;
+        expr->eval(gExpCtxt);
+        gNumAllocs = 0;
+        gCounting = true;
+        for (size_t i = 0; i < kEvals; ++i) {
+            expr->eval(gExpCtxt);
+        }
+        gCounting = false;
+        return static_cast<double>(gNumAllocs) / kEvals;
+    }
+
+    static Expression* var(const char* prop) {
+        return VariablePropertyExpression::make(&pool, "var", prop);
+    }
+};
+
+// The operands are strings of 32 or 64 bytes, which took two allocations per
+// copy, one of the Value and one of the std::string
+TEST_F(ExpressionAllocationTest, Borrowed) {
+    // CAST($var.string64 AS STRING) reuses the string of the last result
+    EXPECT_EQ(0, allocsPerEval(
+        TypeCastingExpression::make(&pool, Value::Type::STRING, var("string64"))));
+
+    // CASE $var.string32 WHEN $var.string32 THEN $var.string64 END
+    auto* cases = CaseList::make(&pool);
+    cases->add(var("string32"), var("string64"));
+    auto* generic = CaseExpression::make(&pool, cases);
+    generic->setCondition(var("string32"));
+    EXPECT_EQ(0, allocsPerEval(generic));
+
+    // +$var.string64
+    EXPECT_EQ(0, allocsPerEval(UnaryExpression::makePlus(&pool, var("string64"))));
+
+    // $var.list[3]
+    EXPECT_EQ(0, allocsPerEval(
+        SubscriptExpression::make(&pool, var("list"), ConstantExpression::make(&pool, 3))));
+
+    // $var.path_edge1._src
+    EXPECT_EQ(0, allocsPerEval(
+        AttributeExpression::make(&pool, var("path_edge1"), LabelExpression::make(&pool, "_src"))));
+
+    // [n IN $var.list]
+    EXPECT_EQ(0, allocsPerEval(ListComprehensionExpression::make(&pool, "n", var("list"))));
+}
+
+TEST_F(ExpressionAllocationTest, FunctionCall) {
+    // left($var.string64, 4): the arguments are kept inline, the only
+    // allocation is of the std::string in the Value returned, whose 4 bytes
+    // are inline too
+    auto* args = ArgumentList::make(&pool);
+    args->addArgument(var("string64"));
+    args->addArgument(ConstantExpression::make(&pool, 4));
+    EXPECT_EQ(1, allocsPerEval(FunctionCallExpression::make(&pool, "left", args)));
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -5,8 +5,30 @@
  */
 
 #include <folly/Benchmark.h>
+#include <iostream>
+#include "common/expression/ExprSlotBinder.h"
 #include "common/expression/test/TestBase.h"
 
+// All allocations of the process are counted, to report the allocations per
+// eval of each kind of expressions
+static size_t gNumAllocs = 0;
+
+void* operator new(size_t size) {
+    ++gNumAllocs;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
 namespace nebula {
 size_t add2Constant(size_t iters) {
     constexpr size_t ops = 1000000UL;
@@ -129,6 +151,130 @@ size_t getEdgeProp(size_t iters, const char* prop) {
     }
     return iters * ops;
 }
+
+// The kinds of expressions which borrow or move the values of their operands
+// rather than copying them per eval
+static const std::vector<std::pair<std::string, Expression*>>& kindExprs() {
+    static const auto exprs = [] () {
+        std::vector<std::pair<std::string, Expression*>> kinds;
+        auto str = [] (const char* prop) {
+            return VariablePropertyExpression::make(&pool, "var", prop);
+        };
+
+        kinds.emplace_back("type_casting_string",
+                           TypeCastingExpression::make(&pool, Value::Type::STRING, str("string64")));
+
+        auto* cases = CaseList::make(&pool);
+        cases->add(str("string32"), str("string64"));
+        auto* generic = CaseExpression::make(&pool, cases);
+        generic->setCondition(str("string32"));
+        kinds.emplace_back("case_generic_string", generic);
+
+        auto* args = ArgumentList::make(&pool);
+        args->addArgument(str("string64"));
+        args->addArgument(ConstantExpression::make(&pool, 4));
+        kinds.emplace_back("function_call_left", FunctionCallExpression::make(&pool, "left", args));
+
+        kinds.emplace_back("list_comprehension_list",
+                           ListComprehensionExpression::make(&pool, "n", str("list")));
+        kinds.emplace_back(
+            "list_comprehension_filter",
+            ListComprehensionExpression::make(
+                &pool,
+                "n",
+                str("list"),
+                RelationalExpression::makeEQ(&pool,
+                                             VariableExpression::make(&pool, "n"),
+                                             ConstantExpression::make(&pool, "aaaa"))));
+        kinds.emplace_back(
+            "subscript_list",
+            SubscriptExpression::make(&pool, str("list"), ConstantExpression::make(&pool, 3)));
+        kinds.emplace_back(
+            "attribute_edge_src",
+            AttributeExpression::make(&pool, str("path_edge1"), LabelExpression::make(&pool, "_src")));
+        kinds.emplace_back("unary_plus_string", UnaryExpression::makePlus(&pool, str("string64")));
+        return kinds;
+    }();
+    return exprs;
+}
+
+size_t evalKind(size_t iters, const char* kind) {
+    constexpr size_t ops = 1000000UL;
+    Expression* expr = nullptr;
+    for (auto& kv : kindExprs()) {
+        if (kv.first == kind) {
+            expr = kv.second;
+        }
+    }
+    CHECK_NOTNULL(expr);
+    for (size_t i = 0; i < iters * ops; ++i) {
+        auto& eval = expr->eval(gExpCtxt);
+        folly::doNotOptimizeAway(eval);
+    }
+    return iters * ops;
+}
+
+// [n IN range(1, 100000) WHERE n % 2 == 0 | n * n]
+static Expression* makeLoop() {
+    auto* args = ArgumentList::make(&pool);
+    args->addArgument(ConstantExpression::make(&pool, 1));
+    args->addArgument(ConstantExpression::make(&pool, 100000));
+    return ListComprehensionExpression::make(
+        &pool,
+        "n",
+        FunctionCallExpression::make(&pool, "range", args),
+        RelationalExpression::makeEQ(
+            &pool,
+            ArithmeticExpression::makeMod(&pool,
+                                          VariableExpression::make(&pool, "n"),
+                                          ConstantExpression::make(&pool, 2)),
+            ConstantExpression::make(&pool, 0)),
+        ArithmeticExpression::makeMultiply(&pool,
+                                           VariableExpression::make(&pool, "n"),
+                                           VariableExpression::make(&pool, "n")));
+}
+
+// The loop variable set to the context per element, or read from the local
+// of the frame once bound
+size_t loopVar(size_t iters, bool bound) {
+    static auto* unboundExpr = makeLoop();
+    static auto* boundExpr = makeLoop();
+    static ExprSlotBinder binder = [] () {
+        ExprSlotBinder b;
+        b.bind(boundExpr);
+        return b;
+    }();
+    auto* expr = bound ? boundExpr : unboundExpr;
+    ExpressionFrame frame(binder.numSlots(), binder.numLocals());
+    if (bound) {
+        gExpCtxt.setFrame(&frame);
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        auto& eval = expr->eval(gExpCtxt);
+        folly::doNotOptimizeAway(eval);
+    }
+    gExpCtxt.setFrame(nullptr);
+    return iters;
+}
+
+// Allocations per eval, the results are borrowed, not copied out
+void reportAllocations() {
+    constexpr size_t kEvals = 10000;
+    std::cout << "Allocations per eval" << std::endl;
+    for (auto& kv : kindExprs()) {
+        // Warm up, so the results of the last evals are in place
+        kv.second->eval(gExpCtxt);
+        auto before = gNumAllocs;
+        for (size_t i = 0; i < kEvals; ++i) {
+            folly::doNotOptimizeAway(kv.second->eval(gExpCtxt));
+        }
+        std::cout << folly::stringPrintf("  %-32s %8.2f",
+                                         kv.first.c_str(),
+                                         static_cast<double>(gNumAllocs - before) / kEvals)
+                  << std::endl;
+    }
+}
+
 // TODO(cpw): more test cases.
 
 BENCHMARK_NAMED_PARAM_MULTI(add2Constant, 1_add_2)
@@ -146,10 +292,23 @@ BENCHMARK_NAMED_PARAM_MULTI(getDstProp, ger_dst_prop_int, "int")
 BENCHMARK_NAMED_PARAM_MULTI(getDstProp, ger_dst_prop_string, "string16")
 BENCHMARK_NAMED_PARAM_MULTI(getEdgeProp, ger_edge_prop_int, "int")
 BENCHMARK_NAMED_PARAM_MULTI(getEdgeProp, ger_edge_prop_string, "string16")
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, type_casting_string, "type_casting_string")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, case_generic_string, "case_generic_string")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, function_call_left, "function_call_left")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, list_comprehension_list, "list_comprehension_list")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, list_comprehension_filter, "list_comprehension_filter")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, subscript_list, "subscript_list")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, attribute_edge_src, "attribute_edge_src")
+BENCHMARK_NAMED_PARAM_MULTI(evalKind, unary_plus_string, "unary_plus_string")
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(loopVar, list_comprehension_set_var, false)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(loopVar, list_comprehension_local, true)
 }   // namespace nebula
 
 int main(int argc, char** argv) {
     folly::init(&argc, &argv, true);
+    nebula::reportAllocations();
     folly::runBenchmarks();
     return 0;
 }
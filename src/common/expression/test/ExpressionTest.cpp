@@ -32,7 +32,7 @@ TEST_F(ExpressionTest, toStringTest) {
     }
     {
         auto ep = ConstantExpression::make(&pool, Map({{"hello", "world"}, {"name", "zhang"}}));
-        EXPECT_EQ(ep->toString(), "{name:\"zhang\",hello:\"world\"}");
+        EXPECT_EQ(ep->toString(), "{hello:\"world\",name:\"zhang\"}");
     }
     {
         auto ep = ConstantExpression::make(&pool, Set({1, 2.3, "hello", true}));
@@ -5,10 +5,12 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <memory>
 #include "common/base/ObjectPool.h"
 #include "common/expression/ConstantExpression.h"
 #include "common/expression/FunctionCallExpression.h"
+#include "common/expression/VariableExpression.h"
 #include "common/expression/test/ExpressionContextMock.h"
 
 nebula::ExpressionContextMock gExpCtxt;
@@ -16,6 +18,22 @@ nebula::ObjectPool pool;
 namespace nebula {
 
 static FunctionCallExpression* expr = nullptr;
+// abs($n)
+static FunctionCallExpression* varExpr = nullptr;
+// Of constant arguments, generic and specialized by the types
+static std::vector<FunctionCallExpression*> genericExprs;
+static std::vector<FunctionCallExpression*> specializedExprs;
+
+constexpr size_t kRows = 1000;
+static ValueColumn gInts;
+static ValueColumn gFloats;
+static ValueColumn gStrs;
+// split($d, ","), plain and memoized
+static FunctionCallExpression* plainExpr = nullptr;
+static FunctionCallExpression* memoExpr = nullptr;
+// Strings of 16 distinct and of all distinct values
+static std::vector<Value> gLowCardinality;
+static std::vector<Value> gHighCardinality;
 
 size_t funcCall(size_t iters) {
     for (size_t i = 0; i < iters; ++i) {
@@ -25,8 +43,133 @@ size_t funcCall(size_t iters) {
     return iters;
 }
 
+size_t genericCall(size_t iters, size_t index) {
+    auto* call = genericExprs[index];
+    for (size_t i = 0; i < iters; ++i) {
+        auto& eval = call->eval(gExpCtxt);
+        folly::doNotOptimizeAway(eval);
+    }
+    return iters;
+}
+
+size_t specializedCall(size_t iters, size_t index) {
+    auto* call = specializedExprs[index];
+    for (size_t i = 0; i < iters; ++i) {
+        auto& eval = call->eval(gExpCtxt);
+        folly::doNotOptimizeAway(eval);
+    }
+    return iters;
+}
+
+// The scalar form of `func' called on each row of `column'
+size_t scalarRows(size_t iters, const char* func, const ValueColumn* column) {
+    FunctionManager::Function body;
+    std::vector<Value> rows;
+    BENCHMARK_SUSPEND {
+        body = FunctionManager::get(func, 1).value();
+        for (size_t i = 0; i < column->size(); ++i) {
+            rows.emplace_back(column->value(i));
+        }
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        for (const auto& row : rows) {
+            FunctionManager::ArgList args;
+            args.emplace_back(row);
+            Value result = body(args);
+            folly::doNotOptimizeAway(result);
+        }
+    }
+    return iters * rows.size();
+}
+
+// The batch form of `func' called on `column'
+size_t batchRows(size_t iters, const char* func, const ValueColumn* column) {
+    FunctionManager::BatchFunction body;
+    BENCHMARK_SUSPEND {
+        body = FunctionManager::getBatch(func, 1).value();
+    }
+    for (size_t i = 0; i < iters; ++i) {
+        auto result = body({column}, column->size());
+        folly::doNotOptimizeAway(result);
+    }
+    return iters * column->size();
+}
+
+size_t exprRows(size_t iters) {
+    for (size_t i = 0; i < iters; ++i) {
+        for (size_t row = 0; row < kRows; ++row) {
+            gExpCtxt.setVar("n", gInts.value(row));
+            Value eval = Expression::eval(varExpr, gExpCtxt);
+            folly::doNotOptimizeAway(eval);
+        }
+    }
+    return iters * kRows;
+}
+
+size_t exprBatch(size_t iters) {
+    for (size_t i = 0; i < iters; ++i) {
+        auto column = varExpr->evalBatch(gExpCtxt, kRows, [](size_t row) {
+            gExpCtxt.setVar("n", gInts.value(row));
+        });
+        folly::doNotOptimizeAway(column);
+    }
+    return iters * kRows;
+}
+
+// Evaluates `call' over the rows of `rows', memoized or not
+size_t memoRows(size_t iters, FunctionCallExpression* call, const std::vector<Value>* rows) {
+    for (size_t i = 0; i < iters; ++i) {
+        if (call->memo() != nullptr) {
+            BENCHMARK_SUSPEND {
+                // Per query
+                CHECK(call->enableMemo());
+            }
+        }
+        for (const auto& row : *rows) {
+            gExpCtxt.setVar("d", row);
+            auto& eval = call->eval(gExpCtxt);
+            folly::doNotOptimizeAway(eval);
+        }
+    }
+    return iters * rows->size();
+}
+
 BENCHMARK_NAMED_PARAM_MULTI(funcCall, FunctionCallBM)
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(genericCall, abs_int, 0)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(specializedCall, abs_int, 0)
+BENCHMARK_NAMED_PARAM_MULTI(genericCall, sqrt_float, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(specializedCall, sqrt_float, 1)
+BENCHMARK_NAMED_PARAM_MULTI(genericCall, substr_string, 2)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(specializedCall, substr_string, 2)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(scalarRows, abs_int, "abs", &gInts)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(batchRows, abs_int, "abs", &gInts)
+BENCHMARK_NAMED_PARAM_MULTI(scalarRows, floor_float, "floor", &gFloats)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(batchRows, floor_float, "floor", &gFloats)
+BENCHMARK_NAMED_PARAM_MULTI(scalarRows, sqrt_float, "sqrt", &gFloats)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(batchRows, sqrt_float, "sqrt", &gFloats)
+BENCHMARK_NAMED_PARAM_MULTI(scalarRows, lower_string, "lower", &gStrs)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(batchRows, lower_string, "lower", &gStrs)
+BENCHMARK_NAMED_PARAM_MULTI(scalarRows, hash_string, "hash", &gStrs)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(batchRows, hash_string, "hash", &gStrs)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(exprRows, abs_var)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(exprBatch, abs_var)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM_MULTI(memoRows, split_low_card, plainExpr, &gLowCardinality)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(memoRows, split_low_card, memoExpr, &gLowCardinality)
+BENCHMARK_NAMED_PARAM_MULTI(memoRows, split_high_card, plainExpr, &gHighCardinality)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(memoRows, split_high_card, memoExpr, &gHighCardinality)
+
 }   // namespace nebula
 
 int main(int argc, char** argv) {
@@ -34,6 +177,54 @@ int main(int argc, char** argv) {
     args->addArgument(nebula::ConstantExpression::make(&pool, 1));
     nebula::expr = nebula::FunctionCallExpression::make(&pool, "abs", args);
 
+    nebula::ArgumentList* varArgs = nebula::ArgumentList::make(&pool);
+    varArgs->addArgument(nebula::VariableExpression::make(&pool, "n"));
+    nebula::varExpr = nebula::FunctionCallExpression::make(&pool, "abs", varArgs);
+
+    // abs(-42), sqrt(2.25), substr("nebula graph", 3, 5)
+    std::vector<std::pair<std::string, std::vector<nebula::Value>>> calls = {
+        {"abs", {-42}},
+        {"sqrt", {2.25}},
+        {"substr", {"nebula graph", 3, 5}},
+    };
+    for (const auto& call : calls) {
+        std::vector<nebula::Value::Type> argsType;
+        for (auto* exprs : {&nebula::genericExprs, &nebula::specializedExprs}) {
+            auto* callArgs = nebula::ArgumentList::make(&pool);
+            argsType.clear();
+            for (const auto& arg : call.second) {
+                callArgs->addArgument(nebula::ConstantExpression::make(&pool, arg));
+                argsType.emplace_back(arg.type());
+            }
+            exprs->emplace_back(nebula::FunctionCallExpression::make(&pool, call.first, callArgs));
+        }
+        CHECK(nebula::specializedExprs.back()->specialize(argsType));
+    }
+
+    for (auto** splitExpr : {&nebula::plainExpr, &nebula::memoExpr}) {
+        auto* splitArgs = nebula::ArgumentList::make(&pool);
+        splitArgs->addArgument(nebula::VariableExpression::make(&pool, "d"));
+        splitArgs->addArgument(nebula::ConstantExpression::make(&pool, ","));
+        *splitExpr = nebula::FunctionCallExpression::make(&pool, "split", splitArgs);
+    }
+    CHECK(nebula::memoExpr->enableMemo());
+
+    std::vector<int64_t> ints;
+    std::vector<double> floats;
+    std::vector<std::string> strs;
+    for (size_t i = 0; i < nebula::kRows; ++i) {
+        ints.emplace_back(static_cast<int64_t>(folly::Random::rand32(2000)) - 1000);
+        floats.emplace_back(folly::Random::randDouble(0, 1000));
+        strs.emplace_back(folly::to<std::string>("Name_", i, "_", folly::Random::rand32()));
+        nebula::gLowCardinality.emplace_back(
+            folly::to<std::string>("tag_", i % 16, ",nebula,graph,database"));
+        nebula::gHighCardinality.emplace_back(
+            folly::to<std::string>("tag_", i, ",nebula,graph,database"));
+    }
+    nebula::gInts = nebula::ValueColumn(std::move(ints));
+    nebula::gFloats = nebula::ValueColumn(std::move(floats));
+    nebula::gStrs = nebula::ValueColumn(std::move(strs));
+
     folly::init(&argc, &argv, true);
     folly::runBenchmarks();
 
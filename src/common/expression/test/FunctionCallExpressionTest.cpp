@@ -4,6 +4,7 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 #include "common/expression/test/TestBase.h"
+#include "common/expression/ExprSlotBinder.h"
 
 namespace nebula {
 
@@ -130,6 +131,177 @@ TEST_F(FunctionCallExpressionTest, FunctionCallToStringTest) {
         EXPECT_EQ(ep->toString(), "now()");
     }
 }
+
+TEST_F(FunctionCallExpressionTest, Specialize) {
+    // abs($n)
+    auto *args = ArgumentList::make(&pool);
+    args->addArgument(VariableExpression::make(&pool, "n"));
+    auto *expr = FunctionCallExpression::make(&pool, "abs", args);
+    EXPECT_FALSE(expr->isSpecialized());
+    EXPECT_FALSE(expr->specialize({Value::Type::STRING}));
+    EXPECT_FALSE(expr->isSpecialized());
+    // Not of the number of arguments
+    EXPECT_FALSE(expr->specialize({}));
+    EXPECT_FALSE(expr->specialize({Value::Type::INT, Value::Type::INT}));
+    EXPECT_FALSE(expr->isSpecialized());
+    EXPECT_TRUE(expr->specialize({Value::Type::INT}));
+    EXPECT_TRUE(expr->isSpecialized());
+
+    // Other types than the bound ones go to the generic body
+    std::vector<std::pair<Value, Value>> cases = {
+        {-3, 3},
+        {-2.5, 2.5},
+        {Value::kNullValue, Value::kNullValue},
+        {"abc", Value::kNullBadType},
+    };
+    for (const auto &c : cases) {
+        gExpCtxt.setVar("n", c.first);
+        auto &result = expr->eval(gExpCtxt);
+        EXPECT_EQ(c.second.type(), result.type()) << c.first;
+        EXPECT_EQ(c.second, result) << c.first;
+    }
+    gExpCtxt.setVar("n", Value::kNullValue);
+
+    // Clones are not specialized
+    EXPECT_FALSE(static_cast<FunctionCallExpression *>(expr->clone())->isSpecialized());
+}
+
+TEST_F(FunctionCallExpressionTest, Memo) {
+    // Impure
+    auto *rand = FunctionCallExpression::make(&pool, "rand");
+    EXPECT_FALSE(rand->enableMemo());
+    EXPECT_EQ(nullptr, rand->memo());
+
+    // lower($p)
+    auto *args = ArgumentList::make(&pool);
+    args->addArgument(VariableExpression::make(&pool, "p"));
+    auto *expr = FunctionCallExpression::make(&pool, "lower", args);
+    EXPECT_EQ(nullptr, expr->memo());
+    ASSERT_TRUE(expr->enableMemo());
+    ASSERT_NE(nullptr, expr->memo());
+
+    std::vector<std::pair<Value, Value>> cases = {
+        {"A", "a"},
+        {"B", "b"},
+        {"A", "a"},
+        {Value::kNullValue, Value::kNullValue},
+        {"A", "a"},
+        {"B", "b"},
+        {Value::kNullValue, Value::kNullValue},
+        {1, Value::kNullBadType},
+    };
+    for (const auto &c : cases) {
+        gExpCtxt.setVar("p", c.first);
+        auto &result = expr->eval(gExpCtxt);
+        EXPECT_EQ(c.second.type(), result.type()) << c.first;
+        EXPECT_EQ(c.second, result) << c.first;
+    }
+    gExpCtxt.setVar("p", Value::kNullValue);
+
+    auto stats = expr->memo()->stats();
+    EXPECT_EQ(8, stats.lookups_);
+    // Missed "A", "B", NULL and 1
+    EXPECT_EQ(4, stats.hits_);
+    EXPECT_EQ(0, stats.bypasses_);
+    EXPECT_FALSE(stats.disabled_);
+
+    // Bound, each frame has a memo of its own
+    ExprSlotBinder binder;
+    binder.bind(expr);
+    ExpressionFrame frame1(binder.numSlots()), frame2(binder.numSlots());
+    gExpCtxt.setFrame(&frame1);
+    EXPECT_EQ(nullptr, expr->memo(gExpCtxt));
+    gExpCtxt.setVar("p", "A");
+    EXPECT_EQ(Value("a"), expr->eval(gExpCtxt));
+    EXPECT_EQ(Value("a"), expr->eval(gExpCtxt));
+    ASSERT_NE(nullptr, expr->memo(gExpCtxt));
+    EXPECT_NE(expr->memo(), expr->memo(gExpCtxt));
+    EXPECT_EQ(2, expr->memo(gExpCtxt)->stats().lookups_);
+    EXPECT_EQ(1, expr->memo(gExpCtxt)->stats().hits_);
+    gExpCtxt.setFrame(&frame2);
+    EXPECT_EQ(nullptr, expr->memo(gExpCtxt));
+    EXPECT_EQ(Value("a"), expr->eval(gExpCtxt));
+    EXPECT_EQ(0, expr->memo(gExpCtxt)->stats().hits_);
+    gExpCtxt.setFrame(nullptr);
+    gExpCtxt.setVar("p", Value::kNullValue);
+    EXPECT_EQ(expr->memo(), expr->memo(gExpCtxt));
+    EXPECT_EQ(8, expr->memo()->stats().lookups_);
+
+    // Clones are not memoized
+    EXPECT_EQ(nullptr, static_cast<FunctionCallExpression *>(expr->clone())->memo());
+}
+
+TEST_F(FunctionCallExpressionTest, EvalBatch) {
+    std::vector<Value> ns = {-3, 4, 16, 0, 7};
+    std::vector<Value> ps = {"Hello", "NEBULA", "a", "", "Graph"};
+    auto setRow = [&ns, &ps](size_t i) {
+        gExpCtxt.setVar("n", ns[i]);
+        gExpCtxt.setVar("p", ps[i]);
+    };
+
+    std::vector<Expression *> exprs;
+    {
+        // abs($n)
+        auto *args = ArgumentList::make(&pool);
+        args->addArgument(VariableExpression::make(&pool, "n"));
+        exprs.emplace_back(FunctionCallExpression::make(&pool, "abs", args));
+    }
+    {
+        // substr(lower($p), 1, 3)
+        auto *lowerArgs = ArgumentList::make(&pool);
+        lowerArgs->addArgument(VariableExpression::make(&pool, "p"));
+        auto *args = ArgumentList::make(&pool);
+        args->addArgument(FunctionCallExpression::make(&pool, "lower", lowerArgs));
+        args->addArgument(ConstantExpression::make(&pool, 1));
+        args->addArgument(ConstantExpression::make(&pool, 3));
+        exprs.emplace_back(FunctionCallExpression::make(&pool, "substr", args));
+    }
+    {
+        // pow($n + 1, 2)
+        auto *args = ArgumentList::make(&pool);
+        args->addArgument(ArithmeticExpression::makeAdd(&pool,
+                                                        VariableExpression::make(&pool, "n"),
+                                                        ConstantExpression::make(&pool, 1)));
+        args->addArgument(ConstantExpression::make(&pool, 2));
+        exprs.emplace_back(FunctionCallExpression::make(&pool, "pow", args));
+    }
+    {
+        // sqrt(16), the same for all rows
+        auto *args = ArgumentList::make(&pool);
+        args->addArgument(ConstantExpression::make(&pool, 16));
+        exprs.emplace_back(FunctionCallExpression::make(&pool, "sqrt", args));
+    }
+
+    for (auto *expr : exprs) {
+        auto column = expr->evalBatch(gExpCtxt, ns.size(), setRow);
+        ASSERT_EQ(ns.size(), column.size()) << expr->toString();
+        for (size_t i = 0; i < ns.size(); ++i) {
+            setRow(i);
+            EXPECT_EQ(expr->eval(gExpCtxt), column.value(i)) << expr->toString() << " of row " << i;
+        }
+    }
+    gExpCtxt.setVar("n", Value::kNullValue);
+    gExpCtxt.setVar("p", Value::kNullValue);
+}
+
+TEST_F(FunctionCallExpressionTest, Unknown) {
+    std::vector<Expression *> exprs;
+    exprs.emplace_back(FunctionCallExpression::make(&pool, "no_such_function"));
+    // abs() of no argument
+    exprs.emplace_back(FunctionCallExpression::make(&pool, "abs"));
+    for (auto *expr : exprs) {
+        auto &result = expr->eval(gExpCtxt);
+        EXPECT_EQ(Value::Type::NULLVALUE, result.type()) << expr->toString();
+        EXPECT_EQ(Value::kNullBadType, result) << expr->toString();
+
+        auto column = expr->evalBatch(gExpCtxt, 3, [](size_t) {});
+        ASSERT_EQ(3, column.size()) << expr->toString();
+        for (size_t i = 0; i < column.size(); ++i) {
+            EXPECT_EQ(Value::kNullBadType, column.value(i)) << expr->toString();
+        }
+    }
+}
+
 }   // namespace nebula
 
 int main(int argc, char **argv) {
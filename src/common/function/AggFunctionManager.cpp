@@ -7,9 +7,82 @@
 #include "AggFunctionManager.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Set.h"
+#include <folly/hash/Hash.h>
+
+DEFINE_int32(approx_count_distinct_precision, 14,
+             "Precision of the HyperLogLog sketch of approx_count_distinct, in [4, 18], "
+             "which takes 2^precision bytes per group with a standard error of "
+             "1.04/sqrt(2^precision)");
+DEFINE_int32(approx_percentile_compression, 100,
+             "Compression of the t-digest of approximate percentiles, larger is more "
+             "accurate and takes more memory");
 
 namespace nebula {
 
+Value AggData::toState() const {
+    List state;
+    state.reserve(8);
+    state.emplace_back(cnt_);
+    state.emplace_back(sum_);
+    state.emplace_back(avg_);
+    state.emplace_back(deviation_);
+    state.emplace_back(result());
+    if (uniques_ != nullptr && !uniques_->values.empty()) {
+        state.emplace_back(*uniques_);
+    } else {
+        state.emplace_back(Value::kNullValue);
+    }
+    if (hll_ != nullptr) {
+        state.emplace_back(hll_->serialize());
+    } else {
+        state.emplace_back(Value::kNullValue);
+    }
+    if (digest_ != nullptr) {
+        state.emplace_back(digest_->serialize());
+    } else {
+        state.emplace_back(Value::kNullValue);
+    }
+    return state;
+}
+
+Status AggData::fromState(const Value& state) {
+    if (!state.isList() || state.getList().size() != 8) {
+        return Status::Error("Invalid aggregation state: %s", state.toString().c_str());
+    }
+    const auto& values = state.getList().values;
+    hll_.reset();
+    digest_.reset();
+    if (values[6].isStr()) {
+        auto hll = algorithm::HyperLogLog::deserialize(values[6].getStr());
+        NG_RETURN_IF_ERROR(hll);
+        hll_ = std::make_unique<algorithm::HyperLogLog>(std::move(hll).value());
+    }
+    if (values[7].isStr()) {
+        auto digest = algorithm::TDigest::deserialize(values[7].getStr());
+        NG_RETURN_IF_ERROR(digest);
+        digest_ = std::make_unique<algorithm::TDigest>(std::move(digest).value());
+    }
+    cnt_ = values[0];
+    sum_ = values[1];
+    avg_ = values[2];
+    deviation_ = values[3];
+    setResult(values[4]);
+    if (values[5].isSet()) {
+        uniques_ = std::make_unique<Set>(values[5].getSet());
+    } else if (uniques_ != nullptr) {
+        uniques_->values.clear();
+    }
+    return Status::OK();
+}
+
+void AggData::updateQuantile() {
+    DCHECK(digest_ != nullptr);
+    auto q = pendingQuantile_;
+    pendingQuantile_ = -1;
+    auto value = digest_->quantile(q);
+    result_ = std::isnan(value) ? Value::kNullValue : Value(value);
+}
+
 // static
 AggFunctionManager &AggFunctionManager::instance() {
     static AggFunctionManager instance;
@@ -276,6 +349,277 @@ AggFunctionManager::AggFunctionManager() {
             set.values.emplace(val);
         };
     }
+    addApproxFunctions();
+    addMergeFunctions();
+}
+
+void AggFunctionManager::addApproxFunctions() {
+    {
+        auto &func = functions_["APPROX_COUNT_DISTINCT"];
+        func = [](AggData* aggData, const Value& val) {
+            auto& res = aggData->result();
+            if (res.isBadNull()) {
+                return;
+            }
+            if (res.isNull()) {
+                res = 0;
+            }
+            if (val.isNull() || val.empty()) {
+                return;
+            }
+            if (UNLIKELY(val.isMap() || val.isSet() || val.isDataSet())) {
+                res = Value::kNullBadType;
+                return;
+            }
+            auto& hll = aggData->hll();
+            if (hll == nullptr) {
+                hll = std::make_unique<algorithm::HyperLogLog>(
+                    FLAGS_approx_count_distinct_precision);
+            }
+            // std::hash of integers is identity, mix it to spread over the registers
+            hll->add(folly::hash::twang_mix64(std::hash<Value>()(val)));
+            res = static_cast<int64_t>(hll->estimate());
+        };
+        auto &merge = mergeFunctions_["APPROX_COUNT_DISTINCT"];
+        merge = [](AggData* dst, const AggData& src) {
+            auto& res = dst->result();
+            if (res.isBadNull()) {
+                return;
+            }
+            if (src.result().isBadNull() || src.hll() == nullptr) {
+                if (res.isNull() || src.result().isBadNull()) {
+                    res = src.result();
+                }
+                return;
+            }
+            auto& hll = dst->hll();
+            if (hll == nullptr) {
+                hll = std::make_unique<algorithm::HyperLogLog>(*src.hll());
+            } else {
+                hll->merge(*src.hll());
+            }
+            res = static_cast<int64_t>(hll->estimate());
+        };
+    }
+    std::vector<std::pair<std::string, double>> quantiles = {
+        {"APPROX_MEDIAN", 0.5},
+        {"APPROX_P90", 0.9},
+        {"APPROX_P95", 0.95},
+        {"APPROX_P99", 0.99},
+    };
+    for (const auto& quantile : quantiles) {
+        auto q = quantile.second;
+        auto &func = functions_[quantile.first];
+        func = [q](AggData* aggData, const Value& val) {
+            auto& digest = aggData->digest();
+            // The result is not pending without a digest
+            if (digest == nullptr && aggData->result().isBadNull()) {
+                return;
+            }
+            if (val.isNull() || val.empty()) {
+                return;
+            }
+            if (UNLIKELY(!val.isNumeric())) {
+                digest.reset();
+                aggData->setResult(Value::kNullBadType);
+                return;
+            }
+            if (digest == nullptr) {
+                digest = std::make_unique<algorithm::TDigest>(FLAGS_approx_percentile_compression);
+            }
+            digest->add(val.isInt() ? val.getInt() : val.getFloat());
+            aggData->setPendingQuantile(q);
+        };
+        auto &merge = mergeFunctions_[quantile.first];
+        merge = [q](AggData* dst, const AggData& src) {
+            auto& digest = dst->digest();
+            if (digest == nullptr && dst->result().isBadNull()) {
+                return;
+            }
+            // A pending result is never a bad null
+            if (!src.pending() && src.result().isBadNull()) {
+                digest.reset();
+                dst->setResult(src.result());
+                return;
+            }
+            if (src.digest() == nullptr) {
+                return;
+            }
+            if (digest == nullptr) {
+                digest = std::make_unique<algorithm::TDigest>(*src.digest());
+            } else {
+                digest->merge(*src.digest());
+            }
+            dst->setPendingQuantile(q);
+        };
+    }
+}
+
+void AggFunctionManager::addMergeFunctions() {
+    // The partial result which could not be merged any more
+    auto mergeBadNull = [](AggData* dst, const AggData& src) {
+        auto& res = dst->result();
+        if (res.isBadNull()) {
+            return true;
+        }
+        if (src.result().isBadNull()) {
+            res = src.result();
+            return true;
+        }
+        return false;
+    };
+    {
+        auto &func = mergeFunctions_[""];
+        func = [](AggData* dst, const AggData& src) {
+            if (!src.result().isNull()) {
+                dst->setResult(src.result());
+            }
+        };
+    }
+    {
+        // COUNT, SUM and the bit ops merge the partial results the way they apply values
+        auto mergeResult = [mergeBadNull](auto&& op) {
+            return [mergeBadNull, op](AggData* dst, const AggData& src) {
+                if (mergeBadNull(dst, src)) {
+                    return;
+                }
+                auto& res = dst->result();
+                if (src.result().isNull()) {
+                    return;
+                }
+                if (res.isNull()) {
+                    res = src.result();
+                    return;
+                }
+                res = op(res, src.result());
+            };
+        };
+        auto add = [](const Value& lhs, const Value& rhs) { return lhs + rhs; };
+        mergeFunctions_["COUNT"] = mergeResult(add);
+        mergeFunctions_["SUM"] = mergeResult(add);
+        mergeFunctions_["BIT_AND"] = mergeResult(
+            [](const Value& lhs, const Value& rhs) { return lhs & rhs; });
+        mergeFunctions_["BIT_OR"] = mergeResult(
+            [](const Value& lhs, const Value& rhs) { return lhs | rhs; });
+        mergeFunctions_["BIT_XOR"] = mergeResult(
+            [](const Value& lhs, const Value& rhs) { return lhs ^ rhs; });
+    }
+    {
+        auto &func = mergeFunctions_["AVG"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            auto& sum = dst->sum();
+            auto& cnt = dst->cnt();
+            if (res.isNull()) {
+                res = src.result();
+                sum = src.sum();
+                cnt = src.cnt();
+                return;
+            }
+            sum = sum + src.sum();
+            cnt = cnt + src.cnt();
+            res = sum / cnt;
+        };
+    }
+    {
+        auto &func = mergeFunctions_["MAX"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            if (res.isNull() || src.result() > res) {
+                res = src.result();
+            }
+        };
+    }
+    {
+        auto &func = mergeFunctions_["MIN"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            if (res.isNull() || src.result() < res) {
+                res = src.result();
+            }
+        };
+    }
+    {
+        auto &func = mergeFunctions_["STD"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            auto& cnt = dst->cnt();
+            auto& avg = dst->avg();
+            auto& deviation = dst->deviation();
+            if (res.isNull()) {
+                res = src.result();
+                cnt = src.cnt();
+                avg = src.avg();
+                deviation = src.deviation();
+                return;
+            }
+            // Combine the population variances, see Chan et al., "Updating Formulae
+            // and a Pairwise Algorithm for Computing Sample Variances"
+            auto n1 = cnt.getFloat();
+            auto n2 = src.cnt().getFloat();
+            auto avg1 = avg.isInt() ? avg.getInt() : avg.getFloat();
+            auto avg2 = src.avg().isInt() ? src.avg().getInt() : src.avg().getFloat();
+            auto n = n1 + n2;
+            auto delta = avg2 - avg1;
+            auto m2 = deviation.getFloat() * n1 + src.deviation().getFloat() * n2
+                + delta * delta * n1 * n2 / n;
+            cnt = n;
+            avg = avg1 + delta * n2 / n;
+            deviation = m2 / n;
+            res = std::sqrt(m2 / n);
+        };
+    }
+    {
+        auto &func = mergeFunctions_["COLLECT"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            if (res.isNull()) {
+                res = src.result();
+                return;
+            }
+            if (!res.isList() || !src.result().isList()) {
+                res = Value::kNullBadData;
+                return;
+            }
+            auto& list = res.mutableList().values;
+            const auto& srcList = src.result().getList().values;
+            list.insert(list.end(), srcList.begin(), srcList.end());
+        };
+    }
+    {
+        auto &func = mergeFunctions_["COLLECT_SET"];
+        func = [mergeBadNull](AggData* dst, const AggData& src) {
+            if (mergeBadNull(dst, src) || src.result().isNull()) {
+                return;
+            }
+            auto& res = dst->result();
+            if (res.isNull()) {
+                res = src.result();
+                return;
+            }
+            if (!res.isSet() || !src.result().isSet()) {
+                res = Value::kNullBadData;
+                return;
+            }
+            const auto& srcSet = src.result().getSet().values;
+            res.mutableSet().values.insert(srcSet.begin(), srcSet.end());
+        };
+    }
 }
 
 StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::get(const std::string &func) {
@@ -284,6 +628,24 @@ StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::get(const std::str
     return result.value();
 }
 
+StatusOr<AggFunctionManager::AggMergeFunction>
+AggFunctionManager::getMerge(const std::string &func) {
+    auto result = instance().getMergeInternal(func);
+    NG_RETURN_IF_ERROR(result);
+    return result.value();
+}
+
+StatusOr<const AggStateFunction*> AggFunctionManager::getState(const std::string &func) {
+    auto name = func;
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    const auto& functions = builtinAggStateFunctions();
+    auto iter = functions.find(name);
+    if (iter == functions.end()) {
+        return Status::Error("Aggregate function `%s' has no compact state", name.c_str());
+    }
+    return &iter->second;
+}
+
 Status AggFunctionManager::find(const std::string &func) {
     auto result = instance().getInternal(func);
     NG_RETURN_IF_ERROR(result);
@@ -301,6 +663,17 @@ StatusOr<AggFunctionManager::AggFunction> AggFunctionManager::getInternal(std::s
     return iter->second;
 }
 
+StatusOr<AggFunctionManager::AggMergeFunction>
+AggFunctionManager::getMergeInternal(std::string func) const {
+    std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+    auto iter = mergeFunctions_.find(func);
+    if (iter == mergeFunctions_.end()) {
+        return Status::Error("Aggregate function `%s' could not be merged", func.c_str());
+    }
+
+    return iter->second;
+}
+
 Status AggFunctionManager::load(const std::string &soname, const std::vector<std::string> &funcs) {
     return instance().loadInternal(soname, funcs);
 }
@@ -11,6 +11,10 @@
 #include "common/base/StatusOr.h"
 #include "common/base/Status.h"
 #include "common/datatypes/Value.h"
+#include "common/datatypes/Set.h"
+#include "common/algorithm/HyperLogLog.h"
+#include "common/algorithm/TDigest.h"
+#include "common/function/AggState.h"
 /**
  * AggFunctionManager is for managing builtin and dynamic-loaded aggregate functions,
  * which users could use as AggregateExpression.
@@ -27,12 +31,8 @@ public:
           sum_(0.0),
           avg_(0.0),
           deviation_(0.0),
-          result_(Value::kNullValue) {
-        if (uniques == nullptr) {
-            uniques_ = std::make_unique<Set>();
-        } else {
-            uniques_.reset(uniques);
-        }
+          result_(Value::kNullValue),
+          uniques_(uniques) {
     }
 
     const Value& cnt() const {
@@ -83,27 +83,56 @@ public:
         deviation_ = std::move(deviation);
     }
 
+    // The result of the aggregation, call finalize() first once any value has
+    // been applied or merged since
     const Value& result() const {
+        DCHECK(!pending()) << "Call AggData::finalize() before reading the result";
         return result_;
     }
 
     Value& result() {
+        DCHECK(!pending()) << "Call AggData::finalize() before reading the result";
+        return result_;
+    }
+
+    // The result without finalizing, which lags behind the applied values while
+    // pending
+    const Value& partialResult() const {
         return result_;
     }
 
+    // Works out the result deferred by the aggregate functions, i.e. the
+    // quantile of approximate percentiles
+    void finalize() {
+        if (UNLIKELY(pending())) {
+            updateQuantile();
+        }
+    }
+
+    bool pending() const {
+        return pendingQuantile_ >= 0;
+    }
+
     void setResult(Value&& res) {
+        pendingQuantile_ = -1;
         result_ = std::move(res);
     }
 
     void setResult(const Value& res) {
+        pendingQuantile_ = -1;
         result_ = res;
     }
 
+    // nullptr if no value has been collected, i.e. the aggregation is not DISTINCT
     const Set* uniques() const {
         return uniques_.get();
     }
 
+    // Allocated on the first call, only DISTINCT aggregation needs it
     Set* uniques() {
+        if (uniques_ == nullptr) {
+            uniques_ = std::make_unique<Set>();
+        }
         return uniques_.get();
     }
 
@@ -111,6 +140,40 @@ public:
         uniques_.reset(uniques);
     }
 
+    // The sketches of approximate aggregate functions, allocated on demand
+    const algorithm::HyperLogLog* hll() const {
+        return hll_.get();
+    }
+
+    std::unique_ptr<algorithm::HyperLogLog>& hll() {
+        return hll_;
+    }
+
+    const algorithm::TDigest* digest() const {
+        return digest_.get();
+    }
+
+    std::unique_ptr<algorithm::TDigest>& digest() {
+        return digest_;
+    }
+
+    // The result is estimated from the digest by finalize(), since estimating
+    // for each value is much more expensive than adding it.
+    void setPendingQuantile(double q) {
+        pendingQuantile_ = q;
+    }
+
+    // The intermediate state of the aggregation, which could be shipped to
+    // another AggData, e.g. from storaged to graphd, and merged there.
+    // It's a list of [cnt, sum, avg, deviation, result, uniques, hll, digest].
+    // Must be finalized first.
+    Value toState() const;
+
+    Status fromState(const Value& state);
+
+private:
+    void updateQuantile();
+
 private:
     Value cnt_;
     Value sum_;
@@ -118,17 +181,35 @@ private:
     Value deviation_;
     Value result_;
     std::unique_ptr<Set>   uniques_;
+    std::unique_ptr<algorithm::HyperLogLog> hll_;
+    std::unique_ptr<algorithm::TDigest> digest_;
+    double pendingQuantile_{-1};
 };
 
 class AggFunctionManager final {
 public:
     using AggFunction = std::function<void(AggData*, const Value&)>;
+    // Merge the partial aggregation `src' into `dst', as if all values applied
+    // to `src' had been applied to `dst'. The uniques of DISTINCT aggregation
+    // are not handled here, see AggregateExpression::merge.
+    using AggMergeFunction = std::function<void(AggData* dst, const AggData& src)>;
 
     /**
      * To obtain a aggregate function named `func'
      */
     static StatusOr<AggFunction> get(const std::string &func);
 
+    /**
+     * To obtain the merge function of the aggregate function named `func'
+     */
+    static StatusOr<AggMergeFunction> getMerge(const std::string &func);
+
+    /**
+     * To obtain the compact state of the aggregate function named `func',
+     * to aggregate many groups in an AggStateArena
+     */
+    static StatusOr<const AggStateFunction*> getState(const std::string &func);
+
     /**
      * To Check the validity of the function named `func'
      * Only used for parser check.
@@ -155,11 +236,18 @@ private:
 
     StatusOr<AggFunction> getInternal(std::string func) const;
 
+    StatusOr<AggMergeFunction> getMergeInternal(std::string func) const;
+
+    void addApproxFunctions();
+
+    void addMergeFunctions();
+
     Status loadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
     Status unloadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
     std::unordered_map<std::string, AggFunction> functions_;
+    std::unordered_map<std::string, AggMergeFunction> mergeFunctions_;
 };
 
 }   // namespace nebula
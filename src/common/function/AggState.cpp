@@ -0,0 +1,526 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/function/AggState.h"
+#include "common/datatypes/List.h"
+#include "common/algorithm/HyperLogLog.h"
+#include "common/algorithm/TDigest.h"
+#include <folly/hash/Hash.h>
+
+DECLARE_int32(approx_count_distinct_precision);
+DECLARE_int32(approx_percentile_compression);
+
+namespace nebula {
+
+namespace {
+
+// The states below follow the semantics of the AggData based functions in
+// AggFunctionManager. Null and empty values are skipped, and the first error
+// is sticky, kept as `error'.
+
+struct CountState {
+    int64_t cnt{0};
+
+    void apply(const Value& val) {
+        if (!val.isNull() && !val.empty()) {
+            ++cnt;
+        }
+    }
+
+    void merge(const CountState& other) {
+        cnt += other.cnt;
+    }
+
+    Value result() const {
+        return cnt;
+    }
+};
+
+struct SumState {
+    int64_t intSum{0};
+    double floatSum{0};
+    bool hasFloat{false};
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (val.isInt()) {
+            addInt(val.getInt());
+        } else if (val.isFloat()) {
+            floatSum += val.getFloat();
+            hasFloat = true;
+        } else {
+            error = NullType::BAD_TYPE;
+        }
+    }
+
+    void merge(const SumState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            return;
+        }
+        addInt(other.intSum);
+        floatSum += other.floatSum;
+        hasFloat |= other.hasFloat;
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        if (hasFloat) {
+            return intSum + floatSum;
+        }
+        return intSum;
+    }
+
+    void addInt(int64_t val) {
+        if (__builtin_add_overflow(intSum, val, &intSum)) {
+            error = NullType::ERR_OVERFLOW;
+        }
+    }
+};
+
+struct AvgState {
+    double sum{0};
+    int64_t cnt{0};
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (!val.isNumeric()) {
+            error = NullType::BAD_TYPE;
+            return;
+        }
+        sum += val.isInt() ? val.getInt() : val.getFloat();
+        ++cnt;
+    }
+
+    void merge(const AvgState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            return;
+        }
+        sum += other.sum;
+        cnt += other.cnt;
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        if (cnt == 0) {
+            return Value::kNullValue;
+        }
+        return sum / cnt;
+    }
+};
+
+// Population standard deviation, by Welford's online algorithm
+struct StdState {
+    double cnt{0};
+    double avg{0};
+    // Sum of squares of differences from the mean
+    double m2{0};
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (!val.isNumeric()) {
+            error = NullType::BAD_TYPE;
+            return;
+        }
+        double x = val.isInt() ? val.getInt() : val.getFloat();
+        cnt += 1;
+        auto delta = x - avg;
+        avg += delta / cnt;
+        m2 += delta * (x - avg);
+    }
+
+    void merge(const StdState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            return;
+        }
+        if (other.cnt == 0) {
+            return;
+        }
+        auto n = cnt + other.cnt;
+        auto delta = other.avg - avg;
+        m2 += other.m2 + delta * delta * cnt * other.cnt / n;
+        avg += delta * other.cnt / n;
+        cnt = n;
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        if (cnt == 0) {
+            return Value::kNullValue;
+        }
+        return std::sqrt(m2 / cnt);
+    }
+};
+
+template <class Op>
+struct BitState {
+    int64_t bits{0};
+    bool seen{false};
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (!val.isInt()) {
+            error = NullType::BAD_TYPE;
+            return;
+        }
+        bits = seen ? Op()(bits, val.getInt()) : val.getInt();
+        seen = true;
+    }
+
+    void merge(const BitState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            return;
+        }
+        if (other.seen) {
+            bits = seen ? Op()(bits, other.bits) : other.bits;
+            seen = true;
+        }
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        return seen ? Value(bits) : Value::kNullValue;
+    }
+};
+
+// The last value, for the group keys
+struct LastState {
+    Value val{Value::kNullValue};
+
+    void apply(const Value& v) {
+        val = v;
+    }
+
+    void merge(const LastState& other) {
+        if (!other.val.isNull()) {
+            val = other.val;
+        }
+    }
+
+    Value result() const {
+        return val;
+    }
+};
+
+template <class Compare>
+struct ExtremeState {
+    Value val{Value::kNullValue};
+
+    void apply(const Value& v) {
+        if (v.isNull() || v.empty()) {
+            return;
+        }
+        if (val.isNull() || Compare()(v, val)) {
+            val = v;
+        }
+    }
+
+    void merge(const ExtremeState& other) {
+        apply(other.val);
+    }
+
+    Value result() const {
+        return val;
+    }
+};
+
+struct CollectState {
+    List list;
+
+    void apply(const Value& val) {
+        if (!val.isNull() && !val.empty()) {
+            list.values.emplace_back(val);
+        }
+    }
+
+    void merge(const CollectState& other) {
+        list.values.insert(list.values.end(), other.list.values.begin(), other.list.values.end());
+    }
+
+    Value result() const {
+        return list;
+    }
+};
+
+struct CollectSetState {
+    Set set;
+
+    void apply(const Value& val) {
+        if (!val.isNull() && !val.empty()) {
+            set.values.emplace(val);
+        }
+    }
+
+    void merge(const CollectSetState& other) {
+        set.values.insert(other.set.values.begin(), other.set.values.end());
+    }
+
+    Value result() const {
+        return set;
+    }
+};
+
+struct ApproxCountDistinctState {
+    std::unique_ptr<algorithm::HyperLogLog> hll;
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (val.isMap() || val.isSet() || val.isDataSet()) {
+            error = NullType::BAD_TYPE;
+            return;
+        }
+        if (hll == nullptr) {
+            hll = std::make_unique<algorithm::HyperLogLog>(FLAGS_approx_count_distinct_precision);
+        }
+        hll->add(folly::hash::twang_mix64(std::hash<Value>()(val)));
+    }
+
+    void merge(const ApproxCountDistinctState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            return;
+        }
+        if (other.hll == nullptr) {
+            return;
+        }
+        if (hll == nullptr) {
+            hll = std::make_unique<algorithm::HyperLogLog>(*other.hll);
+        } else {
+            hll->merge(*other.hll);
+        }
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        return hll == nullptr ? 0 : static_cast<int64_t>(hll->estimate());
+    }
+};
+
+template <int kPermille>
+struct QuantileState {
+    std::unique_ptr<algorithm::TDigest> digest;
+    NullType error{NullType::__NULL__};
+
+    void apply(const Value& val) {
+        if (error != NullType::__NULL__ || val.isNull() || val.empty()) {
+            return;
+        }
+        if (!val.isNumeric()) {
+            error = NullType::BAD_TYPE;
+            digest.reset();
+            return;
+        }
+        if (digest == nullptr) {
+            digest = std::make_unique<algorithm::TDigest>(FLAGS_approx_percentile_compression);
+        }
+        digest->add(val.isInt() ? val.getInt() : val.getFloat());
+    }
+
+    void merge(const QuantileState& other) {
+        if (error != NullType::__NULL__) {
+            return;
+        }
+        if (other.error != NullType::__NULL__) {
+            error = other.error;
+            digest.reset();
+            return;
+        }
+        if (other.digest == nullptr) {
+            return;
+        }
+        if (digest == nullptr) {
+            digest = std::make_unique<algorithm::TDigest>(*other.digest);
+        } else {
+            digest->merge(*other.digest);
+        }
+    }
+
+    Value result() const {
+        if (error != NullType::__NULL__) {
+            return error;
+        }
+        if (digest == nullptr) {
+            return Value::kNullValue;
+        }
+        return digest->quantile(kPermille / 1000.0);
+    }
+};
+
+size_t alignUp(size_t offset, size_t align) {
+    return (offset + align - 1) / align * align;
+}
+
+}   // namespace
+
+const std::unordered_map<std::string, AggStateFunction>& builtinAggStateFunctions() {
+    static const std::unordered_map<std::string, AggStateFunction> functions = {
+        {"", makeAggStateFunction<LastState>()},
+        {"COUNT", makeAggStateFunction<CountState>()},
+        {"SUM", makeAggStateFunction<SumState>()},
+        {"AVG", makeAggStateFunction<AvgState>()},
+        {"MAX", makeAggStateFunction<ExtremeState<std::greater<Value>>>()},
+        {"MIN", makeAggStateFunction<ExtremeState<std::less<Value>>>()},
+        {"STD", makeAggStateFunction<StdState>()},
+        {"BIT_AND", makeAggStateFunction<BitState<std::bit_and<int64_t>>>()},
+        {"BIT_OR", makeAggStateFunction<BitState<std::bit_or<int64_t>>>()},
+        {"BIT_XOR", makeAggStateFunction<BitState<std::bit_xor<int64_t>>>()},
+        {"COLLECT", makeAggStateFunction<CollectState>()},
+        {"COLLECT_SET", makeAggStateFunction<CollectSetState>()},
+        {"APPROX_COUNT_DISTINCT", makeAggStateFunction<ApproxCountDistinctState>()},
+        {"APPROX_MEDIAN", makeAggStateFunction<QuantileState<500>>()},
+        {"APPROX_P90", makeAggStateFunction<QuantileState<900>>()},
+        {"APPROX_P95", makeAggStateFunction<QuantileState<950>>()},
+        {"APPROX_P99", makeAggStateFunction<QuantileState<990>>()},
+    };
+    return functions;
+}
+
+
+AggStateArena::AggStateArena(std::vector<Column> columns, size_t groupsPerChunk)
+        : columns_(std::move(columns))
+        , groupsPerChunk_(groupsPerChunk) {
+    CHECK_GT(groupsPerChunk_, 0);
+    size_t maxAlign = alignof(Set*);
+    offsets_.reserve(columns_.size());
+    uniquesOffsets_.reserve(columns_.size());
+    for (const auto& column : columns_) {
+        CHECK_NOTNULL(column.func);
+        // The chunks are allocated by new[], aligned to the fundamental alignment
+        CHECK_LE(column.func->align, alignof(std::max_align_t));
+        if (column.distinct) {
+            rowSize_ = alignUp(rowSize_, alignof(Set*));
+            uniquesOffsets_.emplace_back(rowSize_);
+            rowSize_ += sizeof(Set*);
+        } else {
+            uniquesOffsets_.emplace_back(0);
+        }
+        rowSize_ = alignUp(rowSize_, column.func->align);
+        offsets_.emplace_back(rowSize_);
+        rowSize_ += column.func->size;
+        maxAlign = std::max(maxAlign, column.func->align);
+    }
+    rowSize_ = alignUp(std::max(rowSize_, static_cast<size_t>(1)), maxAlign);
+}
+
+
+AggStateArena::~AggStateArena() {
+    for (size_t group = 0; group < numGroups_; ++group) {
+        auto* row = rowOf(group);
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            if (columns_[i].distinct) {
+                delete uniquesOf(row, i);
+            }
+            if (columns_[i].func->destroy != nullptr) {
+                columns_[i].func->destroy(row + offsets_[i]);
+            }
+        }
+    }
+}
+
+
+size_t AggStateArena::addGroup() {
+    if (numGroups_ == chunks_.size() * groupsPerChunk_) {
+        chunks_.emplace_back(new char[rowSize_ * groupsPerChunk_]);
+    }
+    auto group = numGroups_++;
+    auto* row = rowOf(group);
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (columns_[i].distinct) {
+            uniquesOf(row, i) = nullptr;
+        }
+        columns_[i].func->init(row + offsets_[i]);
+    }
+    return group;
+}
+
+
+void AggStateArena::merge(size_t group, const AggStateArena& other, size_t otherGroup) {
+    DCHECK_EQ(columns_.size(), other.columns_.size());
+    auto* row = rowOf(group);
+    auto* otherRow = other.rowOf(otherGroup);
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        DCHECK_EQ(columns_[i].func, other.columns_[i].func);
+        if (!columns_[i].distinct) {
+            columns_[i].func->merge(row + offsets_[i], otherRow + other.offsets_[i]);
+            continue;
+        }
+        // The partial states could not be merged, since they may share values
+        auto* uniques = other.uniquesOf(otherRow, i);
+        if (uniques == nullptr) {
+            continue;
+        }
+        for (const auto& val : uniques->values) {
+            if (collect(row, i, val)) {
+                columns_[i].func->apply(row + offsets_[i], val);
+            }
+        }
+    }
+}
+
+
+size_t AggStateArena::memoryUsage() const {
+    // Roughly a hash node and a bucket for each unique value
+    return sizeof(*this) + chunks_.size() * groupsPerChunk_ * rowSize_
+         + numUniques_ * (sizeof(Value) + 3 * sizeof(void*));
+}
+
+
+bool AggStateArena::collect(char* row, size_t column, const Value& val) {
+    auto*& uniques = uniquesOf(row, column);
+    if (uniques == nullptr) {
+        uniques = new Set();
+    }
+    if (!uniques->values.emplace(val).second) {
+        return false;
+    }
+    ++numUniques_;
+    return true;
+}
+
+}   // namespace nebula
@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_AGGSTATE_H_
+#define COMMON_FUNCTION_AGGSTATE_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+#include "common/datatypes/Set.h"
+
+namespace nebula {
+
+/**
+ * The compact state of an aggregate function, e.g. a single int64 for count,
+ * {sum, cnt} for avg. Unlike AggData, which carries five Values for every
+ * function, each function only takes what it needs.
+ *
+ * The state lives in raw memory provided by AggStateArena, so it's described
+ * by its layout and a set of function pointers.
+ */
+struct AggStateFunction {
+    size_t size;
+    size_t align;
+    void (*init)(void* state);
+    // nullptr if the state is trivially destructible
+    void (*destroy)(void* state);
+    void (*apply)(void* state, const Value& val);
+    void (*merge)(void* dst, const void* src);
+    Value (*result)(const void* state);
+};
+
+/**
+ * Make the AggStateFunction of a default constructible State, which has
+ * the following members:
+ *      void apply(const Value& val);
+ *      void merge(const State& other);
+ *      Value result() const;
+ */
+template <class State>
+AggStateFunction makeAggStateFunction() {
+    AggStateFunction func;
+    func.size = sizeof(State);
+    func.align = alignof(State);
+    func.init = [] (void* state) {
+        new (state) State();
+    };
+    if (std::is_trivially_destructible<State>::value) {
+        func.destroy = nullptr;
+    } else {
+        func.destroy = [] (void* state) {
+            static_cast<State*>(state)->~State();
+        };
+    }
+    func.apply = [] (void* state, const Value& val) {
+        static_cast<State*>(state)->apply(val);
+    };
+    func.merge = [] (void* dst, const void* src) {
+        static_cast<State*>(dst)->merge(*static_cast<const State*>(src));
+    };
+    func.result = [] (const void* state) {
+        return static_cast<const State*>(state)->result();
+    };
+    return func;
+}
+
+// The states of the builtin aggregate functions, keyed by the upper case name
+const std::unordered_map<std::string, AggStateFunction>& builtinAggStateFunctions();
+
+/**
+ * The states of all aggregate columns of all groups, stored contiguously.
+ *
+ * Groups are numbered densely from 0, e.g. by a group-by hash table, and the
+ * states of a group are laid out in a fixed size row. Rows are allocated in
+ * chunks, so adding groups never moves existing states.
+ *
+ * The uniques Set is only allocated for DISTINCT columns, and only for the
+ * groups actually seeing values.
+ */
+class AggStateArena final {
+public:
+    struct Column {
+        const AggStateFunction* func;
+        bool distinct{false};
+    };
+
+    explicit AggStateArena(std::vector<Column> columns, size_t groupsPerChunk = 1024);
+
+    ~AggStateArena();
+
+    AggStateArena(const AggStateArena&) = delete;
+    AggStateArena& operator=(const AggStateArena&) = delete;
+
+    // Returns the id of the new group, with all states initialized
+    size_t addGroup();
+
+    size_t numGroups() const {
+        return numGroups_;
+    }
+
+    size_t numColumns() const {
+        return columns_.size();
+    }
+
+    void apply(size_t group, size_t column, const Value& val) {
+        auto* row = rowOf(group);
+        if (columns_[column].distinct && !collect(row, column, val)) {
+            return;
+        }
+        columns_[column].func->apply(row + offsets_[column], val);
+    }
+
+    // Merge all the states of `otherGroup' in `other', which must have the same
+    // columns, into `group'
+    void merge(size_t group, const AggStateArena& other, size_t otherGroup);
+
+    Value result(size_t group, size_t column) const {
+        return columns_[column].func->result(rowOf(group) + offsets_[column]);
+    }
+
+    // Bytes taken by the rows and the uniques sets, excluding the payload of
+    // the values, e.g. the strings held by MIN/MAX states or uniques.
+    size_t memoryUsage() const;
+
+private:
+    char* rowOf(size_t group) const {
+        DCHECK_LT(group, numGroups_);
+        return chunks_[group / groupsPerChunk_].get() + (group % groupsPerChunk_) * rowSize_;
+    }
+
+    // A DISTINCT column keeps a Set* before its state, returns false if the value
+    // has been seen
+    bool collect(char* row, size_t column, const Value& val);
+
+    Set*& uniquesOf(char* row, size_t column) const {
+        return *reinterpret_cast<Set**>(row + uniquesOffsets_[column]);
+    }
+
+private:
+    std::vector<Column> columns_;
+    // Offset of each state in a row
+    std::vector<size_t> offsets_;
+    // Offset of the Set* of each DISTINCT column in a row
+    std::vector<size_t> uniquesOffsets_;
+    size_t rowSize_{0};
+    const size_t groupsPerChunk_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    size_t numGroups_{0};
+    size_t numUniques_{0};
+};
+
+}   // namespace nebula
+#endif   // COMMON_FUNCTION_AGGSTATE_H_
@@ -17,6 +17,7 @@
 #include "common/datatypes/Set.h"
 #include "common/datatypes/Vertex.h"
 #include "common/expression/Expression.h"
+#include "common/function/UdfLibrary.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/time/TimeUtils.h"
 #include "common/time/WallClock.h"
@@ -244,6 +245,7 @@ FunctionManager::getReturnType(const std::string& funcName,
                                const std::vector<Value::Type> &argsType) {
     auto func = funcName;
     std::transform(func.begin(), func.end(), func.begin(), ::tolower);
+    folly::SharedMutex::ReadHolder holder(instance().lock_);
     auto iter = typeSignature_.find(func);
     if (iter == typeSignature_.end()) {
         return Status::Error("Function `%s' not defined", funcName.c_str());
@@ -267,6 +269,124 @@ FunctionManager::getReturnType(const std::string& funcName,
     return Status::Error("Parameter's type error");
 }
 
+namespace {
+
+// Maps each of `in' by `op', in a plain loop which the compiler could vectorize
+template <typename T, typename Op>
+auto mapColumn(const std::vector<T> &in, Op op) {
+    std::vector<std::decay_t<decltype(op(in.front()))>> out(in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        out[i] = op(in[i]);
+    }
+    return out;
+}
+
+// The batch body of a numeric function of one argument, which maps an INT by
+// `intOp' and a FLOAT by `floatOp'. If `negativeIsNull', a negative argument
+// makes the result NULL, then the rows are left to the scalar body.
+template <typename IntOp, typename FloatOp>
+auto numericBatch(IntOp intOp, FloatOp floatOp, bool negativeIsNull = false) {
+    return [=](const auto &args, ValueColumn &result) -> bool {
+        const auto &col = *args[0];
+        auto isNegative = [](auto val) { return val < 0; };
+        switch (col.type()) {
+            case Value::Type::INT: {
+                const auto &ints = col.ints();
+                if (negativeIsNull && std::any_of(ints.begin(), ints.end(), isNegative)) {
+                    return false;
+                }
+                result = ValueColumn(mapColumn(ints, intOp));
+                return true;
+            }
+            case Value::Type::FLOAT: {
+                const auto &floats = col.floats();
+                if (negativeIsNull && std::any_of(floats.begin(), floats.end(), isNegative)) {
+                    return false;
+                }
+                result = ValueColumn(mapColumn(floats, floatOp));
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    };
+}
+
+// The batch body of a string function of one argument, which maps a STRING by `op'
+template <typename Op>
+auto stringBatch(Op op) {
+    return [=](const auto &args, ValueColumn &result) -> bool {
+        const auto &col = *args[0];
+        if (col.type() != Value::Type::STRING) {
+            return false;
+        }
+        result = ValueColumn(mapColumn(col.strs(), op));
+        return true;
+    };
+}
+
+// substr(STRING, INT[, INT])
+Value substrOf(const FunctionManager::ArgList &args) {
+    const auto &value = args[0].get().getStr();
+    auto start = args[1].get().getInt();
+    auto length = 0;
+    if (args.size() == 3) {
+        length = args[2].get().getInt();
+    } else {
+        length = static_cast<size_t>(start) >= value.size()
+                     ? 0
+                     : value.size() - static_cast<size_t>(start);
+    }
+    if (start < 0 || length < 0) {
+        return Value::kNullBadData;
+    }
+    if (static_cast<size_t>(start) >= value.size() || length == 0) {
+        return std::string("");
+    }
+    return value.substr(start, length);
+}
+
+// Calls `body' on each of the `numRows' rows of the argument columns
+ValueColumn callRows(const FunctionManager::Function &body,
+                     const FunctionManager::ColumnArgs &args,
+                     size_t numRows) {
+    // The values of typed columns are copied once to be referred to by the arguments
+    std::vector<std::vector<Value>> copies(args.size());
+    std::vector<const Value *> bases(args.size());
+    std::vector<size_t> strides(args.size(), 1);
+    for (size_t i = 0; i < args.size(); ++i) {
+        const auto *col = args[i];
+        DCHECK_EQ(numRows, col->size());
+        if (col->isTyped()) {
+            copies[i].reserve(numRows);
+            for (size_t row = 0; row < numRows; ++row) {
+                copies[i].emplace_back(col->value(row));
+            }
+            bases[i] = copies[i].data();
+        } else {
+            bases[i] = col->values().data();
+            if (col->isConstant()) {
+                strides[i] = 0;
+            }
+        }
+    }
+
+    std::vector<Value> results;
+    results.reserve(numRows);
+    FunctionManager::ArgList argList;
+    for (size_t row = 0; row < numRows; ++row) {
+        argList.clear();
+        for (size_t i = 0; i < args.size(); ++i) {
+            argList.emplace_back(bases[i][row * strides[i]]);
+        }
+        results.emplace_back(body(argList));
+    }
+    return ValueColumn(std::move(results));
+}
+
+}   // namespace
+
 FunctionManager::FunctionManager() {
     {
         // absolute value
@@ -290,6 +410,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> int64_t { return std::abs(val); },
+                                       [](double val) -> double { return std::abs(val); });
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value { return std::abs(args[0].get().getInt()); }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value { return std::abs(args[0].get().getFloat()); }},
+        };
     }
     {
         auto &attr = functions_["bit_and"];
@@ -340,6 +468,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> double { return std::floor(val); },
+                                       [](double val) -> double { return std::floor(val); });
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value { return std::floor(args[0].get().getInt()); }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value { return std::floor(args[0].get().getFloat()); }},
+        };
     }
     {
         // returns the smallest floating point number that is not less than x
@@ -363,6 +499,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> double { return std::ceil(val); },
+                                       [](double val) -> double { return std::ceil(val); });
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value { return std::ceil(args[0].get().getInt()); }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value { return std::ceil(args[0].get().getFloat()); }},
+        };
     }
     {
         // to nearest integral (as a floating-point value)
@@ -386,6 +530,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> double { return std::round(val); },
+                                       [](double val) -> double { return std::round(val); });
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value { return std::round(args[0].get().getInt()); }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value { return std::round(args[0].get().getFloat()); }},
+        };
     }
     {
         // square root
@@ -417,6 +569,21 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> double { return std::sqrt(val); },
+                                       [](double val) -> double { return std::sqrt(val); },
+                                       true);
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value {
+                 auto val = args[0].get().getInt();
+                 return val < 0 ? Value::kNullValue : Value(std::sqrt(val));
+             }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value {
+                 auto val = args[0].get().getFloat();
+                 return val < 0 ? Value::kNullValue : Value(std::sqrt(val));
+             }},
+        };
     }
     {
         // cubic root
@@ -440,6 +607,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = numericBatch([](int64_t val) -> double { return std::cbrt(val); },
+                                       [](double val) -> double { return std::cbrt(val); });
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value { return std::cbrt(args[0].get().getInt()); }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value { return std::cbrt(args[0].get().getFloat()); }},
+        };
     }
     {
         // sqrt(x^2 + y^2)
@@ -822,7 +997,7 @@ FunctionManager::FunctionManager() {
         auto &attr = functions_["rand"];
         attr.minArity_ = 0;
         attr.maxArity_ = 0;
-        attr.isPure_ = true;
+        attr.isPure_ = false;
         attr.body_ = [](const auto &args) -> Value {
             UNUSED(args);
             return folly::Random::randDouble01();
@@ -940,6 +1115,19 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = stringBatch([](const std::string &str) {
+            std::string value(str);
+            folly::toLowerAscii(value);
+            return value;
+        });
+        attr.specializations_ = {
+            {{Value::Type::STRING},
+             [](const ArgList &args) -> Value {
+                 std::string value(args[0].get().getStr());
+                 folly::toLowerAscii(value);
+                 return value;
+             }},
+        };
         functions_["tolower"] = attr;
     }
     {
@@ -964,6 +1152,23 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = stringBatch([](const std::string &str) {
+            std::string value(str);
+            std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+                return std::toupper(c);
+            });
+            return value;
+        });
+        attr.specializations_ = {
+            {{Value::Type::STRING},
+             [](const ArgList &args) -> Value {
+                 std::string value(args[0].get().getStr());
+                 std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+                     return std::toupper(c);
+                 });
+                 return value;
+             }},
+        };
         functions_["toupper"] = attr;
     }
     {
@@ -989,6 +1194,14 @@ FunctionManager::FunctionManager() {
                 }
             }
         };
+        attr.batchBody_ = stringBatch(
+            [](const std::string &str) -> int64_t { return str.length(); });
+        attr.specializations_ = {
+            {{Value::Type::STRING},
+             [](const ArgList &args) -> Value {
+                 return static_cast<int64_t>(args[0].get().getStr().length());
+             }},
+        };
     }
     {
         auto &attr = functions_["trim"];
@@ -1330,23 +1543,40 @@ FunctionManager::FunctionManager() {
                 (argSize == 3 && !args[2].get().isInt())) {
                 return Value::kNullBadType;
             }
-            auto value = args[0].get().getStr();
-            auto start = args[1].get().getInt();
-            auto length = 0;
-            if (argSize == 3) {
-                length = args[2].get().getInt();
-            } else {
-                length = static_cast<size_t>(start) >= value.size()
-                             ? 0
-                             : value.size() - static_cast<size_t>(start);
+            return substrOf(args);
+        };
+        // For the start and length of constants
+        attr.batchBody_ = [](const auto &args, ValueColumn &result) -> bool {
+            if (args[0]->type() != Value::Type::STRING) {
+                return false;
+            }
+            for (size_t i = 1; i < args.size(); ++i) {
+                if (!args[i]->isConstant() || !args[i]->values().front().isInt()) {
+                    return false;
+                }
+            }
+            auto start = args[1]->values().front().getInt();
+            auto hasLength = args.size() == 3;
+            int length = 0;
+            if (hasLength) {
+                length = args[2]->values().front().getInt();
             }
             if (start < 0 || length < 0) {
-                return Value::kNullBadData;
+                return false;
             }
-            if (static_cast<size_t>(start) >= value.size() || length == 0) {
-                return std::string("");
+            const auto &strs = args[0]->strs();
+            std::vector<std::string> values(strs.size());
+            for (size_t i = 0; i < strs.size(); ++i) {
+                if (static_cast<size_t>(start) < strs[i].size()) {
+                    values[i] = hasLength ? strs[i].substr(start, length) : strs[i].substr(start);
+                }
             }
-            return value.substr(start, length);
+            result = ValueColumn(std::move(values));
+            return true;
+        };
+        attr.specializations_ = {
+            {{Value::Type::STRING, Value::Type::INT}, substrOf},
+            {{Value::Type::STRING, Value::Type::INT, Value::Type::INT}, substrOf},
         };
         functions_["substring"] = attr;
     }
@@ -1377,6 +1607,47 @@ FunctionManager::FunctionManager() {
                     return Value::kNullBadType;
             }
         };
+        attr.batchBody_ = [](const auto &args, ValueColumn &result) -> bool {
+            // The same as std::hash<Value> of each type
+            const auto &col = *args[0];
+            switch (col.type()) {
+                case Value::Type::INT: {
+                    result = ValueColumn(mapColumn(col.ints(), [](int64_t val) {
+                        return static_cast<int64_t>(std::hash<int64_t>()(val));
+                    }));
+                    return true;
+                }
+                case Value::Type::FLOAT: {
+                    result = ValueColumn(mapColumn(col.floats(), [](double val) {
+                        return static_cast<int64_t>(std::hash<double>()(val));
+                    }));
+                    return true;
+                }
+                case Value::Type::STRING: {
+                    result = ValueColumn(mapColumn(col.strs(), [](const std::string &val) {
+                        return static_cast<int64_t>(std::hash<std::string>()(val));
+                    }));
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        };
+        attr.specializations_ = {
+            {{Value::Type::INT},
+             [](const ArgList &args) -> Value {
+                 return static_cast<int64_t>(std::hash<int64_t>()(args[0].get().getInt()));
+             }},
+            {{Value::Type::FLOAT},
+             [](const ArgList &args) -> Value {
+                 return static_cast<int64_t>(std::hash<double>()(args[0].get().getFloat()));
+             }},
+            {{Value::Type::STRING},
+             [](const ArgList &args) -> Value {
+                 return static_cast<int64_t>(std::hash<std::string>()(args[0].get().getStr()));
+             }},
+        };
     }
     {
         auto &attr = functions_["udf_is_in"];
@@ -1660,7 +1931,7 @@ FunctionManager::FunctionManager() {
                 case Value::Type::VERTEX: {
                     List tags;
                     for (auto& tag : args[0].get().getVertex().tags) {
-                        tags.emplace_back(tag.name);
+                        tags.emplace_back(tag.name.str());
                     }
                     return tags;
                 }
@@ -1689,9 +1960,8 @@ FunctionManager::FunctionManager() {
                     return Value(std::move(props));
                 }
                 case Value::Type::EDGE: {
-                    Map props;
-                    props.kvs = args[0].get().getEdge().props;
-                    return Value(std::move(props));
+                    const auto &edgeProps = args[0].get().getEdge().props;
+                    return Value(Map(MapKvs(edgeProps.begin(), edgeProps.end())));
                 }
                 case Value::Type::MAP: {
                     return args[0].get();
@@ -1713,7 +1983,7 @@ FunctionManager::FunctionManager() {
                     return Value::kNullValue;
                 }
                 case Value::Type::EDGE: {
-                    return args[0].get().getEdge().name;
+                    return args[0].get().getEdge().name.str();
                 }
                 default: {
                     return Value::kNullBadType;
@@ -2109,25 +2379,74 @@ FunctionManager::FunctionManager() {
 
 // static
 StatusOr<FunctionManager::Function> FunctionManager::get(const std::string &func, size_t arity) {
-    auto result = instance().getInternal(func, arity);
+    auto &manager = instance();
+    folly::SharedMutex::ReadHolder holder(manager.lock_);
+    auto result = manager.getInternal(func, arity);
+    NG_RETURN_IF_ERROR(result);
+    return result.value()->body_;
+}
+
+// static
+StatusOr<FunctionManager::BatchFunction> FunctionManager::getBatch(const std::string &func,
+                                                                   size_t arity) {
+    auto &manager = instance();
+    folly::SharedMutex::ReadHolder holder(manager.lock_);
+    auto result = manager.getInternal(func, arity);
     NG_RETURN_IF_ERROR(result);
-    return result.value().body_;
+    const auto &attr = *result.value();
+    return BatchFunction([body = attr.body_, batchBody = attr.batchBody_, isPure = attr.isPure_](
+                             const ColumnArgs &args, size_t numRows) -> ValueColumn {
+        auto isConstant = [](const ValueColumn *col) { return col->isConstant(); };
+        if (isPure && std::all_of(args.begin(), args.end(), isConstant)) {
+            // The same result for all rows
+            ArgList argList;
+            for (const auto *col : args) {
+                argList.emplace_back(col->values().front());
+            }
+            return ValueColumn::constant(body(argList), numRows);
+        }
+        ValueColumn column;
+        if (batchBody && batchBody(args, column)) {
+            return column;
+        }
+        return callRows(body, args, numRows);
+    });
+}
+
+// static
+StatusOr<FunctionManager::SpecializedBody>
+FunctionManager::getSpecialized(const std::string &func,
+                                const std::vector<Value::Type> &argsType) {
+    auto &manager = instance();
+    folly::SharedMutex::ReadHolder holder(manager.lock_);
+    auto result = manager.getInternal(func, argsType.size());
+    NG_RETURN_IF_ERROR(result);
+    for (const auto &specialization : result.value()->specializations_) {
+        if (specialization.argsType_ == argsType) {
+            return specialization.body_;
+        }
+    }
+    return static_cast<SpecializedBody>(nullptr);
 }
 
 // static
 Status FunctionManager::find(const std::string &func, const size_t arity) {
-    auto result = instance().getInternal(func, arity);
+    auto &manager = instance();
+    folly::SharedMutex::ReadHolder holder(manager.lock_);
+    auto result = manager.getInternal(func, arity);
     NG_RETURN_IF_ERROR(result);
     return Status::OK();
 }
 
 /*static*/ StatusOr<bool> FunctionManager::getIsPure(const std::string &func, size_t arity) {
-    auto result = instance().getInternal(func, arity);
+    auto &manager = instance();
+    folly::SharedMutex::ReadHolder holder(manager.lock_);
+    auto result = manager.getInternal(func, arity);
     NG_RETURN_IF_ERROR(result);
-    return result.value().isPure_;
+    return result.value()->isPure_;
 }
 
-/*static*/ StatusOr<const FunctionManager::FunctionAttributes>
+/*static*/ StatusOr<const FunctionManager::FunctionAttributes*>
 FunctionManager::getInternal(std::string func,
                              size_t arity) const {
     // check existence
@@ -2155,7 +2474,7 @@ FunctionManager::getInternal(std::string func,
                                  maxArity);
         }
     }
-    return iter->second;
+    return &iter->second;
 }
 
 // static
@@ -2163,17 +2482,105 @@ Status FunctionManager::load(const std::string &name, const std::vector<std::str
     return instance().loadInternal(name, funcs);
 }
 
-Status FunctionManager::loadInternal(const std::string &, const std::vector<std::string> &) {
-    return Status::Error("Dynamic function loading not supported yet");
+Status FunctionManager::loadInternal(const std::string &soname,
+                                     const std::vector<std::string> &funcs) {
+    folly::SharedMutex::WriteHolder holder(lock_);
+    std::shared_ptr<UdfLibrary> library;
+    auto found = libraries_.find(soname);
+    if (found != libraries_.end()) {
+        library = found->second.library_;
+    } else {
+        auto result = UdfLibrary::open(soname);
+        NG_RETURN_IF_ERROR(result);
+        library = std::move(result).value();
+    }
+
+    // Check all of them before loading any
+    std::vector<std::pair<std::string, const nebula_udf_function *>> toLoad;
+    if (funcs.empty()) {
+        for (const auto *udf : library->functions()) {
+            toLoad.emplace_back(udf->name, udf);
+        }
+    } else {
+        for (const auto &func : funcs) {
+            toLoad.emplace_back(func, library->find(func));
+            if (toLoad.back().second == nullptr) {
+                return Status::Error("Function `%s' not exported by `%s'",
+                                     func.c_str(),
+                                     soname.c_str());
+            }
+        }
+    }
+    for (auto &udf : toLoad) {
+        std::transform(udf.first.begin(), udf.first.end(), udf.first.begin(), ::tolower);
+        if (functions_.count(udf.first) != 0) {
+            return Status::Error("Function `%s' already defined", udf.first.c_str());
+        }
+    }
+
+    auto &loaded = libraries_[soname];
+    loaded.library_ = library;
+    for (const auto &udf : toLoad) {
+        const auto *desc = udf.second;
+        auto &attr = functions_[udf.first];
+        attr.minArity_ = UdfLibrary::minArity(*desc);
+        attr.maxArity_ = UdfLibrary::maxArity(*desc);
+        attr.isPure_ = desc->is_pure != 0;
+        // The library is held by the bodies, until the last of them is released
+        attr.body_ = [library, desc](const ArgList &args) -> Value {
+            return UdfLibrary::call(*desc, args);
+        };
+        if (desc->batch != nullptr) {
+            attr.batchBody_ = [library, desc](const ColumnArgs &args, ValueColumn &result) {
+                return UdfLibrary::callBatch(*desc, args, result);
+            };
+        }
+        typeSignature_[udf.first] = UdfLibrary::typeSignatures(*desc);
+        loaded.funcs_.emplace(udf.first);
+    }
+    LOG(INFO) << "Loaded " << toLoad.size() << " functions from " << soname;
+    return Status::OK();
 }
 
 // static
 Status FunctionManager::unload(const std::string &name, const std::vector<std::string> &funcs) {
-    return instance().loadInternal(name, funcs);
+    return instance().unloadInternal(name, funcs);
 }
 
-Status FunctionManager::unloadInternal(const std::string &, const std::vector<std::string> &) {
-    return Status::Error("Dynamic function unloading not supported yet");
+Status FunctionManager::unloadInternal(const std::string &soname,
+                                       const std::vector<std::string> &funcs) {
+    folly::SharedMutex::WriteHolder holder(lock_);
+    auto found = libraries_.find(soname);
+    if (found == libraries_.end()) {
+        return Status::Error("`%s' not loaded", soname.c_str());
+    }
+    auto &loaded = found->second;
+
+    std::vector<std::string> toUnload;
+    if (funcs.empty()) {
+        toUnload.assign(loaded.funcs_.begin(), loaded.funcs_.end());
+    } else {
+        for (auto func : funcs) {
+            std::transform(func.begin(), func.end(), func.begin(), ::tolower);
+            if (loaded.funcs_.count(func) == 0) {
+                return Status::Error("Function `%s' not loaded from `%s'",
+                                     func.c_str(),
+                                     soname.c_str());
+            }
+            toUnload.emplace_back(std::move(func));
+        }
+    }
+
+    for (const auto &func : toUnload) {
+        functions_.erase(func);
+        typeSignature_.erase(func);
+        loaded.funcs_.erase(func);
+    }
+    if (loaded.funcs_.empty()) {
+        libraries_.erase(found);
+    }
+    LOG(INFO) << "Unloaded " << toUnload.size() << " functions of " << soname;
+    return Status::OK();
 }
 
 }   // namespace nebula
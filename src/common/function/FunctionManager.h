@@ -10,17 +10,23 @@
 #include "common/base/StatusOr.h"
 #include "common/base/Status.h"
 #include "common/datatypes/Value.h"
+#include "common/function/ValueColumn.h"
+#include <folly/SharedMutex.h>
 #include <folly/futures/Future.h>
+#include <folly/small_vector.h>
 
 /**
  * FunctionManager is for managing builtin and dynamic-loaded functions,
  * which users could use as function call expressions.
  *
- * TODO(dutor) To implement dynamic loading.
+ * The functions are dynamic-loaded from shared objects of the C ABI in
+ * NebulaUdf.h, see load().
  */
 
 namespace nebula {
 
+class UdfLibrary;
+
 struct TypeSignature {
     TypeSignature() = default;
     TypeSignature(std::vector<Value::Type> argsType, Value::Type returnType)
@@ -32,13 +38,80 @@ struct TypeSignature {
 class FunctionManager final {
 public:
     using ArgType = std::reference_wrapper<const Value>;
-    using Function = std::function<Value(const std::vector<ArgType>&)>;
+    // The arguments of most calls are kept inline, without allocating per call
+    static constexpr size_t kInlineArgs = 4;
+    using ArgList = folly::small_vector<ArgType, kInlineArgs>;
+
+    /**
+     * The generic body of a function, which is a std::function of an ArgList.
+     *
+     * It used to be a std::function of a std::vector<ArgType>, which is still
+     * accepted by forwarding to an ArgList, so the callers holding their
+     * arguments in a vector keep working, at the cost of copying the
+     * references. The bodies are best called with an ArgList.
+     */
+    class Function final {
+    public:
+        Function() = default;
+
+        Function(std::nullptr_t) {}      // NOLINT
+
+        template <class F,
+                  typename = std::enable_if_t<
+                      !std::is_same<std::decay_t<F>, Function>::value &&
+                      std::is_invocable_r<Value, F&, const ArgList&>::value>>
+        Function(F&& body) : body_(std::forward<F>(body)) {}     // NOLINT
+
+        Value operator()(const ArgList& args) const {
+            return body_(args);
+        }
+
+        Value operator()(const std::vector<ArgType>& args) const {
+            return body_(ArgList(args.begin(), args.end()));
+        }
+
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(body_);
+        }
+
+        friend bool operator==(const Function& f, std::nullptr_t) noexcept {
+            return !f;
+        }
+
+        friend bool operator!=(const Function& f, std::nullptr_t) noexcept {
+            return static_cast<bool>(f);
+        }
+
+    private:
+        std::function<Value(const ArgList&)> body_;
+    };
+
+    // A body for arguments of known types, which doesn't check them
+    using SpecializedBody = Value (*)(const ArgList&);
+    using ColumnArgs = folly::small_vector<const ValueColumn*, kInlineArgs>;
+    // Returns the results of the function over the `numRows' rows of the argument columns
+    using BatchFunction = std::function<ValueColumn(const ColumnArgs&, size_t numRows)>;
 
     /**
      * To obtain a function named `func', with the actual arity.
      */
     static StatusOr<Function> get(const std::string &func, size_t arity);
 
+    /**
+     * To obtain the body of the function named `func' specialized for arguments of
+     * `argsType', which are known at bind time. It's nullptr if there's none for the
+     * types, then the generic body should be called.
+     */
+    static StatusOr<SpecializedBody> getSpecialized(const std::string &func,
+                                                    const std::vector<Value::Type> &argsType);
+
+    /**
+     * To obtain the batch form of a function named `func', with the actual arity.
+     * The builtins with a batch body loop over typed argument columns, the other
+     * functions and columns are called row by row.
+     */
+    static StatusOr<BatchFunction> getBatch(const std::string &func, size_t arity);
+
     /**
      * To Check the validity of the function named `func', with the actual arity.
      * Only used for parser check.
@@ -48,12 +121,16 @@ public:
     static StatusOr<bool> getIsPure(const std::string &func, size_t arity);
 
     /**
-     * To load a set of functions from a shared object dynamically.
+     * To load a set of functions from a shared object dynamically, or all of the
+     * functions it exports if `funcs' is empty. None is loaded if any of them fails,
+     * e.g. of the same name as a function loaded.
      */
     static Status load(const std::string &soname, const std::vector<std::string> &funcs);
 
     /**
-     * To unload a shared object.
+     * To unload a set of functions loaded from a shared object, or all of them if
+     * `funcs' is empty. The shared object is closed when the last of its functions
+     * obtained is released, so the ones obtained before could still be called.
      */
     static Status unload(const std::string &soname, const std::vector<std::string> &funcs);
 
@@ -64,12 +141,25 @@ public:
                                                const std::vector<Value::Type> &argsType);
 
 private:
+    // Sets `result' and returns true if the columns are of the types handled,
+    // otherwise the function is called row by row
+    using BatchBody = std::function<bool(const ColumnArgs&, ValueColumn &result)>;
+
+    struct Specialization final {
+        std::vector<Value::Type> argsType_;
+        SpecializedBody body_;
+    };
+
     struct FunctionAttributes final {
         size_t minArity_{0};
         size_t maxArity_{0};
         // pure means same input same result
         bool     isPure_{true};
         Function body_;
+        // optional
+        BatchBody batchBody_;
+        // optional, of the types in typeSignature_
+        std::vector<Specialization> specializations_;
     };
 
     /**
@@ -79,16 +169,27 @@ private:
 
     static FunctionManager &instance();
 
-    StatusOr<const FunctionAttributes>
+    StatusOr<const FunctionAttributes*>
     getInternal(std::string func, size_t arity) const;
 
     Status loadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
     Status unloadInternal(const std::string &soname, const std::vector<std::string> &funcs);
 
+    struct LoadedLibrary final {
+        std::shared_ptr<UdfLibrary> library_;
+        std::unordered_set<std::string> funcs_;
+    };
+
     static std::unordered_map<std::string, std::vector<TypeSignature>> typeSignature_;
 
+    // Guards the functions, the signatures and the libraries while loading
+    folly::SharedMutex lock_;
+
     std::unordered_map<std::string, FunctionAttributes> functions_;
+
+    // Of the sonames
+    std::unordered_map<std::string, LoadedLibrary> libraries_;
 };
 
 }   // namespace nebula
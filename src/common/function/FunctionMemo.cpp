@@ -0,0 +1,148 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/function/FunctionMemo.h"
+
+#include <cstring>
+
+namespace nebula {
+
+// static
+bool MemoKey::memoizable(const FunctionManager::ArgList& args) {
+    for (const auto& arg : args) {
+        switch (arg.get().type()) {
+            case Value::Type::NULLVALUE:
+            case Value::Type::BOOL:
+            case Value::Type::INT:
+            case Value::Type::FLOAT:
+            case Value::Type::STRING:
+            case Value::Type::DATE:
+            case Value::Type::TIME:
+            case Value::Type::DATETIME:
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool MemoKey::operator==(const MemoKey& rhs) const {
+    if (args_.size() != rhs.args_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < args_.size(); ++i) {
+        const auto& lhsArg = args_[i];
+        const auto& rhsArg = rhs.args_[i];
+        if (lhsArg.type() != rhsArg.type()) {
+            return false;
+        }
+        switch (lhsArg.type()) {
+            case Value::Type::NULLVALUE: {
+                if (lhsArg.getNull() != rhsArg.getNull()) {
+                    return false;
+                }
+                break;
+            }
+            case Value::Type::FLOAT: {
+                // Bitwise, to tell -0.0 from 0.0, and NaN is of itself
+                auto lhsFloat = lhsArg.getFloat();
+                auto rhsFloat = rhsArg.getFloat();
+                if (std::memcmp(&lhsFloat, &rhsFloat, sizeof(double)) != 0) {
+                    return false;
+                }
+                break;
+            }
+            default: {
+                if (lhsArg != rhsArg) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+FunctionMemo::FunctionMemo(const Options& options)
+    : options_(options), lru_(std::make_unique<LRU<MemoKey, Value>>(options.capacity_)) {
+    DCHECK_GT(options_.capacity_, 0);
+    DCHECK_GT(options_.window_, 0);
+}
+
+Value FunctionMemo::call(const FunctionManager::ArgList& args, Body body) {
+    if (lru_ == nullptr || !MemoKey::memoizable(args)) {
+        ++stats_.bypasses_;
+        return body(args);
+    }
+
+    MemoKey key;
+    key.args_.assign(args.begin(), args.end());
+    ++stats_.lookups_;
+    ++windowLookups_;
+    auto memoized = lru_->get(key);
+    if (memoized != boost::none) {
+        ++stats_.hits_;
+        ++windowHits_;
+        checkHitRate();
+        return std::move(memoized).value();
+    }
+
+    auto result = body(args);
+    lru_->insert(std::move(key), Value(result));
+    checkHitRate();
+    return result;
+}
+
+void FunctionMemo::checkHitRate() {
+    if (windowLookups_ < options_.window_) {
+        return;
+    }
+    auto hitRate = static_cast<double>(windowHits_) / windowLookups_;
+    windowLookups_ = 0;
+    windowHits_ = 0;
+    if (hitRate >= options_.minHitRate_) {
+        return;
+    }
+    VLOG(1) << "Function memo disabled of the hit rate " << hitRate
+            << " below " << options_.minHitRate_;
+    stats_.evicts_ += lru_->evicts();
+    stats_.disabled_ = true;
+    lru_.reset();
+}
+
+FunctionMemo::Stats FunctionMemo::stats() const {
+    auto stats = stats_;
+    if (lru_ != nullptr) {
+        stats.evicts_ += lru_->evicts();
+    }
+    return stats;
+}
+
+std::string FunctionMemo::Stats::toString() const {
+    return folly::stringPrintf("lookups: %lu, hits: %lu, hit rate: %.3f, evicts: %lu, "
+                               "bypasses: %lu, disabled: %s",
+                               lookups_,
+                               hits_,
+                               hitRate(),
+                               evicts_,
+                               bypasses_,
+                               disabled_ ? "true" : "false");
+}
+
+}   // namespace nebula
+
+namespace std {
+
+std::size_t hash<nebula::MemoKey>::operator()(const nebula::MemoKey& key) const noexcept {
+    std::size_t seed = key.args_.size();
+    for (const auto& arg : key.args_) {
+        seed ^= hash<nebula::Value>()(arg) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+}   // namespace std
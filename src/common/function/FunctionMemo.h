@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_FUNCTIONMEMO_H_
+#define COMMON_FUNCTION_FUNCTIONMEMO_H_
+
+#include <folly/Function.h>
+
+#include "common/base/Base.h"
+#include "common/base/ConcurrentLRUCache.h"
+#include "common/datatypes/Value.h"
+#include "common/function/FunctionManager.h"
+
+namespace nebula {
+
+/**
+ * The arguments of a call as the key of FunctionMemo. They are equal only if
+ * of the same types and the exact values, e.g. 1 is not 1.0, and NULL of
+ * different kinds are different.
+ */
+struct MemoKey {
+    folly::small_vector<Value, FunctionManager::kInlineArgs> args_;
+
+    // If the arguments are of the types cheap to hash and compare exactly,
+    // i.e. NULL, BOOL, INT, FLOAT, STRING, DATE, TIME and DATETIME
+    static bool memoizable(const FunctionManager::ArgList& args);
+
+    bool operator==(const MemoKey& rhs) const;
+};
+
+}   // namespace nebula
+
+namespace std {
+
+template <>
+struct hash<nebula::MemoKey> {
+    std::size_t operator()(const nebula::MemoKey& key) const noexcept;
+};
+
+}   // namespace std
+
+namespace nebula {
+
+/**
+ * Memoizes the results of a pure function by the arguments, for a function
+ * call expression evaluated over the rows of a query, see
+ * FunctionCallExpression::enableMemo(). Not thread safe, like the expression.
+ *
+ * It keeps at most `capacity_' results and evicts the least recently used.
+ * The hit rate is checked every `window_' lookups, and when it's below
+ * `minHitRate_', e.g. the arguments are of high cardinality, the memo is
+ * disabled and freed for the rest of the query, so the function is called
+ * directly without the cost of hashing and copying the arguments.
+ */
+class FunctionMemo final {
+public:
+    using Body = folly::FunctionRef<Value(const FunctionManager::ArgList&)>;
+
+    struct Options {
+        size_t capacity_{1024};
+        size_t window_{1024};
+        double minHitRate_{0.2};
+    };
+
+    struct Stats {
+        // Calls looked up in the memo
+        uint64_t lookups_{0};
+        uint64_t hits_{0};
+        uint64_t evicts_{0};
+        // Calls passed to the function directly, since the memo is disabled
+        // or the arguments are not memoizable
+        uint64_t bypasses_{0};
+        bool disabled_{false};
+
+        double hitRate() const {
+            return lookups_ == 0 ? 0.0 : static_cast<double>(hits_) / lookups_;
+        }
+
+        std::string toString() const;
+    };
+
+    FunctionMemo() : FunctionMemo(Options()) {}
+
+    explicit FunctionMemo(const Options& options);
+
+    // Returns the memoized result of `args', or calls `body' and memoizes it
+    Value call(const FunctionManager::ArgList& args, Body body);
+
+    bool disabled() const {
+        return lru_ == nullptr;
+    }
+
+    Stats stats() const;
+
+private:
+    void checkHitRate();
+
+    Options options_;
+    std::unique_ptr<LRU<MemoKey, Value>> lru_;
+    Stats stats_;
+    // Of the current window
+    uint64_t windowLookups_{0};
+    uint64_t windowHits_{0};
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_FUNCTION_FUNCTIONMEMO_H_
@@ -0,0 +1,132 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_NEBULAUDF_H_
+#define COMMON_FUNCTION_NEBULAUDF_H_
+
+/**
+ * The C ABI of user defined functions, which FunctionManager::load() loads
+ * from a shared object. The shared object exports:
+ *
+ *   uint32_t nebula_udf_abi_version(void);
+ *     Returns NEBULA_UDF_ABI_VERSION it's built with, the shared objects of
+ *     other versions are refused.
+ *
+ *   const nebula_udf_function* nebula_udf_functions(size_t* num);
+ *     Returns the functions and sets `*num' to the number of them. They should
+ *     stay valid until the shared object is closed.
+ *
+ * Only plain C types cross the boundary, so the shared object could be built
+ * by another compiler or standard library than the host. The entries could be
+ * called from multiple threads at the same time.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NEBULA_UDF_ABI_VERSION 1u
+
+/* To export the entries of a shared object built with hidden visibility */
+#define NEBULA_UDF_EXPORT __attribute__((visibility("default")))
+
+/* Types of arguments and results */
+#define NEBULA_UDF_NULL   0
+#define NEBULA_UDF_BOOL   1
+#define NEBULA_UDF_INT    2
+#define NEBULA_UDF_FLOAT  3
+#define NEBULA_UDF_STRING 4
+
+typedef struct nebula_udf_string {
+    const char* data;
+    size_t len;
+} nebula_udf_string;
+
+typedef struct nebula_udf_value {
+    int32_t type;
+    union {
+        int32_t b;
+        int64_t i;
+        double f;
+        nebula_udf_string s;
+    } u;
+} nebula_udf_value;
+
+/* A column of arguments of a batch call */
+typedef struct nebula_udf_column {
+    /* NEBULA_UDF_INT, NEBULA_UDF_FLOAT or NEBULA_UDF_STRING */
+    int32_t type;
+    /* Not zero if `data' has a single value for all rows */
+    int32_t is_constant;
+    /* The number of rows */
+    size_t size;
+    /* 1 for a row of NULL, or NULL if there is none */
+    const uint8_t* nulls;
+    /* int64_t, double or nebula_udf_string of the rows */
+    const void* data;
+} nebula_udf_column;
+
+/* The results of a batch call, allocated by the host */
+typedef struct nebula_udf_result_column {
+    /* The return type of the signature: NEBULA_UDF_BOOL, NEBULA_UDF_INT or NEBULA_UDF_FLOAT */
+    int32_t type;
+    /* The number of rows */
+    size_t size;
+    /* Zeroed by the host, set 1 for a row of NULL */
+    uint8_t* nulls;
+    /* uint8_t, int64_t or double of the rows */
+    void* data;
+} nebula_udf_result_column;
+
+/*
+ * Sets `*result' of the `num_args' arguments, which are of the types of a
+ * signature and never NULL. Returns 0 if succeeded, otherwise the result is
+ * NULL of BAD_DATA. A string result should stay valid until the next call
+ * from the same thread.
+ */
+typedef int32_t (*nebula_udf_scalar_fn)(const nebula_udf_value* args,
+                                        size_t num_args,
+                                        nebula_udf_value* result);
+
+/*
+ * Sets `*result' of the `num_args' argument columns, which are of the types
+ * of a signature whose return type is BOOL, INT or FLOAT. Returns 0 if
+ * succeeded, otherwise the rows are passed to the scalar entry one by one.
+ */
+typedef int32_t (*nebula_udf_batch_fn)(const nebula_udf_column* args,
+                                       size_t num_args,
+                                       nebula_udf_result_column* result);
+
+typedef struct nebula_udf_signature {
+    const int32_t* arg_types;
+    size_t num_args;
+    int32_t return_type;
+} nebula_udf_signature;
+
+typedef struct nebula_udf_function {
+    /* Case insensitive, not of any function loaded */
+    const char* name;
+    /* Not zero if the same arguments always give the same result */
+    int32_t is_pure;
+    const nebula_udf_signature* signatures;
+    size_t num_signatures;
+    /* Required */
+    nebula_udf_scalar_fn scalar;
+    /* Optional, NULL if none */
+    nebula_udf_batch_fn batch;
+} nebula_udf_function;
+
+typedef uint32_t (*nebula_udf_abi_version_fn)(void);
+typedef const nebula_udf_function* (*nebula_udf_functions_fn)(size_t* num);
+
+#ifdef __cplusplus
+}   // extern "C"
+#endif
+
+#endif  // COMMON_FUNCTION_NEBULAUDF_H_
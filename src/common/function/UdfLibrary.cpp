@@ -0,0 +1,377 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/function/UdfLibrary.h"
+
+#include <dlfcn.h>
+
+namespace nebula {
+
+namespace {
+
+bool isUdfType(int32_t type) {
+    switch (type) {
+        case NEBULA_UDF_BOOL:
+        case NEBULA_UDF_INT:
+        case NEBULA_UDF_FLOAT:
+        case NEBULA_UDF_STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Value::Type toValueType(int32_t type) {
+    switch (type) {
+        case NEBULA_UDF_BOOL:
+            return Value::Type::BOOL;
+        case NEBULA_UDF_INT:
+            return Value::Type::INT;
+        case NEBULA_UDF_FLOAT:
+            return Value::Type::FLOAT;
+        case NEBULA_UDF_STRING:
+            return Value::Type::STRING;
+        default:
+            return Value::Type::NULLVALUE;
+    }
+}
+
+// The string of `udfVal' refers to the one of `val'
+bool toUdfValue(const Value& val, nebula_udf_value& udfVal) {
+    switch (val.type()) {
+        case Value::Type::BOOL: {
+            udfVal.type = NEBULA_UDF_BOOL;
+            udfVal.u.b = val.getBool() ? 1 : 0;
+            return true;
+        }
+        case Value::Type::INT: {
+            udfVal.type = NEBULA_UDF_INT;
+            udfVal.u.i = val.getInt();
+            return true;
+        }
+        case Value::Type::FLOAT: {
+            udfVal.type = NEBULA_UDF_FLOAT;
+            udfVal.u.f = val.getFloat();
+            return true;
+        }
+        case Value::Type::STRING: {
+            const auto& str = val.getStr();
+            udfVal.type = NEBULA_UDF_STRING;
+            udfVal.u.s.data = str.data();
+            udfVal.u.s.len = str.size();
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+Value fromUdfValue(const nebula_udf_value& udfVal) {
+    switch (udfVal.type) {
+        case NEBULA_UDF_NULL:
+            return Value::kNullValue;
+        case NEBULA_UDF_BOOL:
+            return udfVal.u.b != 0;
+        case NEBULA_UDF_INT:
+            return udfVal.u.i;
+        case NEBULA_UDF_FLOAT:
+            return udfVal.u.f;
+        case NEBULA_UDF_STRING:
+            if (udfVal.u.s.data == nullptr) {
+                return std::string();
+            }
+            return std::string(udfVal.u.s.data, udfVal.u.s.len);
+        default:
+            return Value::kNullBadData;
+    }
+}
+
+template <typename Types>
+const nebula_udf_signature* findSignature(const nebula_udf_function& func, const Types& types) {
+    for (size_t i = 0; i < func.num_signatures; ++i) {
+        const auto& signature = func.signatures[i];
+        if (signature.num_args == types.size() &&
+            std::equal(types.begin(), types.end(), signature.arg_types)) {
+            return &signature;
+        }
+    }
+    return nullptr;
+}
+
+}   // namespace
+
+// static
+StatusOr<std::shared_ptr<UdfLibrary>> UdfLibrary::open(const std::string& path) {
+    auto* handle = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        const char* error = ::dlerror();
+        return Status::Error("Failed to open `%s': %s",
+                             path.c_str(),
+                             error == nullptr ? "unknown error" : error);
+    }
+    std::shared_ptr<UdfLibrary> library(new UdfLibrary(path, handle));
+    NG_RETURN_IF_ERROR(library->init());
+    return library;
+}
+
+UdfLibrary::~UdfLibrary() {
+    if (handle_ != nullptr) {
+        ::dlclose(handle_);
+    }
+}
+
+Status UdfLibrary::init() {
+    auto abiVersion = reinterpret_cast<nebula_udf_abi_version_fn>(
+        ::dlsym(handle_, "nebula_udf_abi_version"));
+    auto functions = reinterpret_cast<nebula_udf_functions_fn>(
+        ::dlsym(handle_, "nebula_udf_functions"));
+    if (abiVersion == nullptr || functions == nullptr) {
+        return Status::Error("`%s' exports no functions", path_.c_str());
+    }
+    auto version = abiVersion();
+    if (version != NEBULA_UDF_ABI_VERSION) {
+        return Status::Error("ABI version not match for `%s': provided %u but %u expected",
+                             path_.c_str(),
+                             version,
+                             NEBULA_UDF_ABI_VERSION);
+    }
+
+    size_t num = 0;
+    const auto* funcs = functions(&num);
+    if (funcs == nullptr && num > 0) {
+        return Status::Error("`%s' exports no functions", path_.c_str());
+    }
+    for (size_t i = 0; i < num; ++i) {
+        const auto& func = funcs[i];
+        if (func.name == nullptr || *func.name == '\0' || func.scalar == nullptr ||
+            func.signatures == nullptr || func.num_signatures == 0) {
+            return Status::Error("Invalid function %lu of `%s'", i, path_.c_str());
+        }
+        for (size_t j = 0; j < func.num_signatures; ++j) {
+            const auto& signature = func.signatures[j];
+            auto validArgs = signature.num_args == 0 || signature.arg_types != nullptr;
+            for (size_t k = 0; validArgs && k < signature.num_args; ++k) {
+                validArgs = isUdfType(signature.arg_types[k]);
+            }
+            if (!validArgs || !isUdfType(signature.return_type)) {
+                return Status::Error("Invalid signature %lu of function `%s' of `%s'",
+                                     j,
+                                     func.name,
+                                     path_.c_str());
+            }
+        }
+        if (find(func.name) != nullptr) {
+            return Status::Error("Function `%s' exported twice by `%s'", func.name, path_.c_str());
+        }
+        functions_.emplace_back(&func);
+    }
+    return Status::OK();
+}
+
+const nebula_udf_function* UdfLibrary::find(const std::string& name) const {
+    for (const auto* func : functions_) {
+        if (::strcasecmp(func->name, name.c_str()) == 0) {
+            return func;
+        }
+    }
+    return nullptr;
+}
+
+// static
+size_t UdfLibrary::minArity(const nebula_udf_function& func) {
+    auto arity = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < func.num_signatures; ++i) {
+        arity = std::min(arity, func.signatures[i].num_args);
+    }
+    return arity;
+}
+
+// static
+size_t UdfLibrary::maxArity(const nebula_udf_function& func) {
+    size_t arity = 0;
+    for (size_t i = 0; i < func.num_signatures; ++i) {
+        arity = std::max(arity, func.signatures[i].num_args);
+    }
+    return arity;
+}
+
+// static
+std::vector<TypeSignature> UdfLibrary::typeSignatures(const nebula_udf_function& func) {
+    std::vector<TypeSignature> signatures;
+    for (size_t i = 0; i < func.num_signatures; ++i) {
+        const auto& signature = func.signatures[i];
+        std::vector<Value::Type> argsType;
+        for (size_t j = 0; j < signature.num_args; ++j) {
+            argsType.emplace_back(toValueType(signature.arg_types[j]));
+        }
+        signatures.emplace_back(std::move(argsType), toValueType(signature.return_type));
+    }
+    return signatures;
+}
+
+// static
+Value UdfLibrary::call(const nebula_udf_function& func, const FunctionManager::ArgList& args) {
+    folly::small_vector<nebula_udf_value, FunctionManager::kInlineArgs> udfArgs(args.size());
+    folly::small_vector<int32_t, FunctionManager::kInlineArgs> types;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const auto& val = args[i].get();
+        if (val.isNull()) {
+            return Value::kNullValue;
+        }
+        if (!toUdfValue(val, udfArgs[i])) {
+            return Value::kNullBadType;
+        }
+        types.emplace_back(udfArgs[i].type);
+    }
+    const auto* signature = findSignature(func, types);
+    if (signature == nullptr) {
+        return Value::kNullBadType;
+    }
+
+    nebula_udf_value result;
+    result.type = NEBULA_UDF_NULL;
+    if (func.scalar(udfArgs.data(), udfArgs.size(), &result) != 0) {
+        return Value::kNullBadData;
+    }
+    if (result.type != NEBULA_UDF_NULL && result.type != signature->return_type) {
+        return Value::kNullBadData;
+    }
+    return fromUdfValue(result);
+}
+
+// static
+bool UdfLibrary::callBatch(const nebula_udf_function& func,
+                           const FunctionManager::ColumnArgs& args,
+                           ValueColumn& result) {
+    if (func.batch == nullptr || args.empty()) {
+        return false;
+    }
+    auto numRows = args.front()->size();
+    folly::small_vector<nebula_udf_column, FunctionManager::kInlineArgs> columns(args.size());
+    // Referred to by the columns of constants and strings
+    folly::small_vector<nebula_udf_value, FunctionManager::kInlineArgs> constants(args.size());
+    std::vector<std::vector<nebula_udf_string>> strs(args.size());
+    folly::small_vector<int32_t, FunctionManager::kInlineArgs> types;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const auto* arg = args[i];
+        auto& column = columns[i];
+        column.size = numRows;
+        column.nulls = nullptr;
+        if (arg->isConstant()) {
+            auto& constant = constants[i];
+            if (!toUdfValue(arg->values().front(), constant)) {
+                return false;
+            }
+            column.type = constant.type;
+            column.is_constant = 1;
+            switch (constant.type) {
+                case NEBULA_UDF_INT:
+                    column.data = &constant.u.i;
+                    break;
+                case NEBULA_UDF_FLOAT:
+                    column.data = &constant.u.f;
+                    break;
+                case NEBULA_UDF_STRING:
+                    column.data = &constant.u.s;
+                    break;
+                default:
+                    return false;
+            }
+        } else {
+            column.is_constant = 0;
+            switch (arg->type()) {
+                case Value::Type::INT: {
+                    column.type = NEBULA_UDF_INT;
+                    column.data = arg->ints().data();
+                    break;
+                }
+                case Value::Type::FLOAT: {
+                    column.type = NEBULA_UDF_FLOAT;
+                    column.data = arg->floats().data();
+                    break;
+                }
+                case Value::Type::STRING: {
+                    auto& pieces = strs[i];
+                    pieces.reserve(numRows);
+                    for (const auto& str : arg->strs()) {
+                        pieces.push_back({str.data(), str.size()});
+                    }
+                    column.type = NEBULA_UDF_STRING;
+                    column.data = pieces.data();
+                    break;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        types.emplace_back(column.type);
+    }
+    const auto* signature = findSignature(func, types);
+    if (signature == nullptr) {
+        return false;
+    }
+
+    std::vector<uint8_t> nulls(numRows, 0);
+    std::vector<int64_t> ints;
+    std::vector<double> floats;
+    std::vector<uint8_t> bools;
+    nebula_udf_result_column out;
+    out.type = signature->return_type;
+    out.size = numRows;
+    out.nulls = nulls.data();
+    switch (signature->return_type) {
+        case NEBULA_UDF_INT: {
+            ints.resize(numRows);
+            out.data = ints.data();
+            break;
+        }
+        case NEBULA_UDF_FLOAT: {
+            floats.resize(numRows);
+            out.data = floats.data();
+            break;
+        }
+        case NEBULA_UDF_BOOL: {
+            bools.resize(numRows);
+            out.data = bools.data();
+            break;
+        }
+        default: {
+            return false;
+        }
+    }
+    if (func.batch(columns.data(), columns.size(), &out) != 0) {
+        return false;
+    }
+
+    auto hasNull = std::any_of(nulls.begin(), nulls.end(), [](auto null) { return null != 0; });
+    if (!hasNull && out.type == NEBULA_UDF_INT) {
+        result = ValueColumn(std::move(ints));
+        return true;
+    }
+    if (!hasNull && out.type == NEBULA_UDF_FLOAT) {
+        result = ValueColumn(std::move(floats));
+        return true;
+    }
+    std::vector<Value> values;
+    values.reserve(numRows);
+    for (size_t row = 0; row < numRows; ++row) {
+        if (nulls[row] != 0) {
+            values.emplace_back(Value::kNullValue);
+        } else if (out.type == NEBULA_UDF_INT) {
+            values.emplace_back(ints[row]);
+        } else if (out.type == NEBULA_UDF_FLOAT) {
+            values.emplace_back(floats[row]);
+        } else {
+            values.emplace_back(bools[row] != 0);
+        }
+    }
+    result = ValueColumn(std::move(values));
+    return true;
+}
+
+}   // namespace nebula
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_UDFLIBRARY_H_
+#define COMMON_FUNCTION_UDFLIBRARY_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/function/FunctionManager.h"
+#include "common/function/NebulaUdf.h"
+
+namespace nebula {
+
+/**
+ * A shared object of user defined functions, see NebulaUdf.h.
+ *
+ * It's closed when destroyed, and the functions loaded from it hold it by
+ * shared_ptr, so the bodies obtained before it's unloaded could still be called.
+ */
+class UdfLibrary final {
+public:
+    static StatusOr<std::shared_ptr<UdfLibrary>> open(const std::string& path);
+
+    ~UdfLibrary();
+
+    const std::string& path() const {
+        return path_;
+    }
+
+    const std::vector<const nebula_udf_function*>& functions() const {
+        return functions_;
+    }
+
+    // The function named `name', case insensitive, nullptr if none
+    const nebula_udf_function* find(const std::string& name) const;
+
+    static size_t minArity(const nebula_udf_function& func);
+
+    static size_t maxArity(const nebula_udf_function& func);
+
+    static std::vector<TypeSignature> typeSignatures(const nebula_udf_function& func);
+
+    // Calls the scalar entry, NULL if any of `args' is NULL
+    static Value call(const nebula_udf_function& func, const FunctionManager::ArgList& args);
+
+    // Calls the batch entry if `args' are typed or constant columns, returns
+    // false if it's not called or fails, then the rows should be called one by one
+    static bool callBatch(const nebula_udf_function& func,
+                          const FunctionManager::ColumnArgs& args,
+                          ValueColumn& result);
+
+private:
+    UdfLibrary(std::string path, void* handle) : path_(std::move(path)), handle_(handle) {}
+
+    Status init();
+
+    std::string path_;
+    void* handle_{nullptr};
+    std::vector<const nebula_udf_function*> functions_;
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_FUNCTION_UDFLIBRARY_H_
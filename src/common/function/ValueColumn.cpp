@@ -0,0 +1,113 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/function/ValueColumn.h"
+
+namespace nebula {
+
+ValueColumn::ValueColumn(std::vector<Value> values) : size_(values.size()) {
+    if (values.empty()) {
+        return;
+    }
+    auto type = values.front().type();
+    if (type != Value::Type::INT && type != Value::Type::FLOAT && type != Value::Type::STRING) {
+        values_ = std::move(values);
+        return;
+    }
+    for (const auto& val : values) {
+        if (val.type() != type) {
+            values_ = std::move(values);
+            return;
+        }
+    }
+
+    type_ = type;
+    switch (type) {
+        case Value::Type::INT: {
+            ints_.reserve(size_);
+            for (const auto& val : values) {
+                ints_.emplace_back(val.getInt());
+            }
+            break;
+        }
+        case Value::Type::FLOAT: {
+            floats_.reserve(size_);
+            for (const auto& val : values) {
+                floats_.emplace_back(val.getFloat());
+            }
+            break;
+        }
+        default: {
+            strs_.reserve(size_);
+            for (auto& val : values) {
+                strs_.emplace_back(val.moveStr());
+            }
+            break;
+        }
+    }
+}
+
+// static
+ValueColumn ValueColumn::constant(Value val, size_t numRows) {
+    ValueColumn column;
+    column.size_ = numRows;
+    column.isConstant_ = true;
+    column.values_.emplace_back(std::move(val));
+    return column;
+}
+
+Value ValueColumn::value(size_t i) const {
+    DCHECK_LT(i, size_);
+    switch (type_) {
+        case Value::Type::INT:
+            return ints_[i];
+        case Value::Type::FLOAT:
+            return floats_[i];
+        case Value::Type::STRING:
+            return strs_[i];
+        default:
+            return isConstant_ ? values_.front() : values_[i];
+    }
+}
+
+std::vector<Value> ValueColumn::moveValues() {
+    std::vector<Value> values;
+    switch (type_) {
+        case Value::Type::INT: {
+            values.reserve(size_);
+            for (auto val : ints_) {
+                values.emplace_back(val);
+            }
+            break;
+        }
+        case Value::Type::FLOAT: {
+            values.reserve(size_);
+            for (auto val : floats_) {
+                values.emplace_back(val);
+            }
+            break;
+        }
+        case Value::Type::STRING: {
+            values.reserve(size_);
+            for (auto& val : strs_) {
+                values.emplace_back(std::move(val));
+            }
+            break;
+        }
+        default: {
+            if (isConstant_) {
+                values.assign(size_, values_.front());
+            } else {
+                values = std::move(values_);
+            }
+            break;
+        }
+    }
+    *this = ValueColumn();
+    return values;
+}
+
+}   // namespace nebula
@@ -0,0 +1,99 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_FUNCTION_VALUECOLUMN_H_
+#define COMMON_FUNCTION_VALUECOLUMN_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * The values of an argument or a result over the rows of a batch, which the
+ * batch form of a function takes, see FunctionManager::getBatch().
+ *
+ * When the values are all INT, all FLOAT or all STRING, they are kept in the
+ * vector of the type, which batch bodies loop over. Otherwise, including
+ * any NULL, they are kept in values(), which is evaluated row by row.
+ * A constant keeps its value once for all rows.
+ */
+class ValueColumn final {
+public:
+    ValueColumn() = default;
+
+    explicit ValueColumn(std::vector<int64_t> ints)
+        : type_(Value::Type::INT), size_(ints.size()), ints_(std::move(ints)) {}
+
+    explicit ValueColumn(std::vector<double> floats)
+        : type_(Value::Type::FLOAT), size_(floats.size()), floats_(std::move(floats)) {}
+
+    explicit ValueColumn(std::vector<std::string> strs)
+        : type_(Value::Type::STRING), size_(strs.size()), strs_(std::move(strs)) {}
+
+    // Moved to the typed vector if all of the same type
+    explicit ValueColumn(std::vector<Value> values);
+
+    static ValueColumn constant(Value val, size_t numRows);
+
+    size_t size() const {
+        return size_;
+    }
+
+    // INT, FLOAT or STRING if typed, otherwise __EMPTY__
+    Value::Type type() const {
+        return type_;
+    }
+
+    bool isTyped() const {
+        return type_ != Value::Type::__EMPTY__;
+    }
+
+    bool isConstant() const {
+        return isConstant_;
+    }
+
+    const std::vector<int64_t>& ints() const {
+        DCHECK_EQ(type_, Value::Type::INT);
+        return ints_;
+    }
+
+    const std::vector<double>& floats() const {
+        DCHECK_EQ(type_, Value::Type::FLOAT);
+        return floats_;
+    }
+
+    const std::vector<std::string>& strs() const {
+        DCHECK_EQ(type_, Value::Type::STRING);
+        return strs_;
+    }
+
+    // The values of an untyped column, a single one if constant
+    const std::vector<Value>& values() const {
+        DCHECK(!isTyped());
+        return values_;
+    }
+
+    // The value of the `i'th row, copied out of a typed column
+    Value value(size_t i) const;
+
+    // The values of all rows, moved out of the column
+    std::vector<Value> moveValues();
+
+private:
+    Value::Type type_{Value::Type::__EMPTY__};
+    size_t size_{0};
+    bool isConstant_{false};
+
+    std::vector<int64_t> ints_;
+    std::vector<double> floats_;
+    std::vector<std::string> strs_;
+    std::vector<Value> values_;
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_FUNCTION_VALUECOLUMN_H_
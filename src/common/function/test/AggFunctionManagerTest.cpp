@@ -27,11 +27,49 @@ protected:
         for (auto i : groupData) {
             aggFunc(&aggData, i);
         }
+        aggData.finalize();
         auto res = aggData.result();
         EXPECT_EQ(res.type(), expect.type()) << "agg function return type check failed: " << expr;
         EXPECT_EQ(res, expect) << "agg function return value check failed: " << expr;
     }
 
+    // Split the group at every position, aggregate both parts separately, ship the
+    // partial states and merge them, which should be the same as the serial result.
+    void testMerge(const char *expr, const std::vector<Value> &groupData) {
+        auto aggFunc = AggFunctionManager::get(expr);
+        ASSERT_TRUE(aggFunc.ok());
+        auto mergeFunc = AggFunctionManager::getMerge(expr);
+        ASSERT_TRUE(mergeFunc.ok()) << mergeFunc.status();
+        AggData serial;
+        for (auto &v : groupData) {
+            aggFunc.value()(&serial, v);
+        }
+        serial.finalize();
+        for (size_t split = 0; split <= groupData.size(); ++split) {
+            AggData lhs, rhs;
+            for (size_t i = 0; i < groupData.size(); ++i) {
+                aggFunc.value()(i < split ? &lhs : &rhs, groupData[i]);
+            }
+            AggData shipped;
+            rhs.finalize();
+            ASSERT_TRUE(shipped.fromState(rhs.toState()).ok());
+            mergeFunc.value()(&lhs, shipped);
+            lhs.finalize();
+
+            auto &res = lhs.result();
+            auto &expect = serial.result();
+            EXPECT_EQ(res.type(), expect.type())
+                << "agg merge return type check failed: " << expr << ", split at " << split;
+            if (res.isFloat() && expect.isFloat()) {
+                EXPECT_NEAR(res.getFloat(), expect.getFloat(), 1e-9)
+                    << "agg merge return value check failed: " << expr << ", split at " << split;
+            } else {
+                EXPECT_EQ(res, expect)
+                    << "agg merge return value check failed: " << expr << ", split at " << split;
+            }
+        }
+    }
+
     static std::unordered_map<std::string, std::vector<Value>> testData_;
 };
 
@@ -126,6 +164,183 @@ TEST_F(AggFunctionManagerTest, aggFunc) {
         TEST_FUNCTION(collect_set, testData_["float"], Set({1.1, 2.2, 3.3}));
         TEST_FUNCTION(collect_set, testData_["mixed"], Set({1, 2.0}));
     }
+    {
+        TEST_FUNCTION(approx_count_distinct, testData_["empty"], 0);
+        TEST_FUNCTION(approx_count_distinct, testData_["null"], 0);
+        TEST_FUNCTION(approx_count_distinct, testData_["int"], 3);
+        TEST_FUNCTION(approx_count_distinct, testData_["float"], 3);
+        TEST_FUNCTION(approx_count_distinct, testData_["mixed"], 2);
+    }
+    {
+        TEST_FUNCTION(approx_median, testData_["empty"], Value::kNullValue);
+        TEST_FUNCTION(approx_median, testData_["null"], Value::kNullValue);
+        TEST_FUNCTION(approx_median, testData_["int"], 2.0);
+        TEST_FUNCTION(approx_median, testData_["float"], 2.2);
+        TEST_FUNCTION(approx_median, testData_["mixed"], 1.5);
+    }
+}
+
+TEST_F(AggFunctionManagerTest, approxFunc) {
+    AggData countDistinct, median, p99;
+    auto countDistinctFunc = AggFunctionManager::get("approx_count_distinct").value();
+    auto medianFunc = AggFunctionManager::get("approx_median").value();
+    auto p99Func = AggFunctionManager::get("approx_p99").value();
+    for (int64_t i = 0; i < 200000; ++i) {
+        Value val(i % 100000);
+        countDistinctFunc(&countDistinct, val);
+        medianFunc(&median, val);
+        p99Func(&p99, val);
+    }
+    median.finalize();
+    p99.finalize();
+    EXPECT_NEAR(100000, countDistinct.result().getInt(), 5000);
+    EXPECT_NEAR(50000, median.result().getFloat(), 1000);
+    EXPECT_NEAR(99000, p99.result().getFloat(), 1000);
+    // The memory is bounded, no matter how many distinct values
+    EXPECT_EQ(nullptr, static_cast<const AggData&>(countDistinct).uniques());
+    EXPECT_LE(countDistinct.hll()->memoryUsage(), 17 * 1024);
+    EXPECT_LE(median.digest()->memoryUsage(), 16 * 1024);
+
+    {
+        AggData aggData;
+        medianFunc(&aggData, 1);
+        medianFunc(&aggData, "a");
+        medianFunc(&aggData, 2);
+        aggData.finalize();
+        EXPECT_TRUE(aggData.result().isBadNull());
+    }
+}
+
+TEST_F(AggFunctionManagerTest, merge) {
+    for (auto func : {"", "count", "sum", "avg", "min", "max", "std",
+                      "bit_and", "bit_or", "bit_xor", "collect", "collect_set",
+                      "approx_count_distinct", "approx_median", "approx_p99"}) {
+        for (auto &data : testData_) {
+            testMerge(func, data.second);
+        }
+        testMerge(func, {5, 3, NullType::__NULL__, 8, 1, 2, 7});
+    }
+    {
+        // Merging into a bad null keeps it bad
+        testMerge("sum", {1, "a", 2});
+        testMerge("avg", {1, 2, true});
+    }
+    {
+        auto result = AggFunctionManager::getMerge("not_exist");
+        EXPECT_FALSE(result.ok());
+    }
+}
+
+TEST_F(AggFunctionManagerTest, stateArena) {
+    auto expectSame = [] (const Value& res, const Value& expect, const std::string& func) {
+        EXPECT_EQ(res.type(), expect.type()) << "compact state type check failed: " << func;
+        if (res.isFloat() && expect.isFloat()) {
+            EXPECT_NEAR(res.getFloat(), expect.getFloat(), 1e-9)
+                << "compact state value check failed: " << func;
+        } else {
+            EXPECT_EQ(res, expect) << "compact state value check failed: " << func;
+        }
+    };
+    std::vector<std::string> funcs = {"", "count", "sum", "avg", "min", "max", "std",
+                                      "bit_and", "bit_or", "bit_xor", "collect", "collect_set",
+                                      "approx_count_distinct", "approx_median"};
+    std::vector<AggStateArena::Column> columns;
+    for (auto& func : funcs) {
+        auto state = AggFunctionManager::getState(func);
+        ASSERT_TRUE(state.ok()) << state.status();
+        columns.emplace_back(AggStateArena::Column{state.value(), false});
+    }
+    // Few groups per chunk to cover multiple chunks
+    AggStateArena arena(columns, 2);
+    std::vector<std::string> groups;
+    for (auto& data : testData_) {
+        auto group = arena.addGroup();
+        ASSERT_EQ(groups.size(), group);
+        groups.emplace_back(data.first);
+        for (auto& v : data.second) {
+            for (size_t i = 0; i < funcs.size(); ++i) {
+                arena.apply(group, i, v);
+            }
+        }
+    }
+    for (size_t group = 0; group < groups.size(); ++group) {
+        for (size_t i = 0; i < funcs.size(); ++i) {
+            AggData aggData;
+            auto aggFunc = AggFunctionManager::get(funcs[i]).value();
+            for (auto& v : testData_[groups[group]]) {
+                aggFunc(&aggData, v);
+            }
+            aggData.finalize();
+            auto& expect = aggData.result();
+            auto res = arena.result(group, i);
+            // The states never applied a value, e.g. sum of nothing, are not
+            // distinguishable from the ones having only nulls applied
+            if (expect.isNull() && !expect.isBadNull()) {
+                continue;
+            }
+            expectSame(res, expect, funcs[i] + " of " + groups[group]);
+        }
+    }
+    {
+        // Merge groups of different arenas
+        AggStateArena other(columns);
+        auto group = other.addGroup();
+        for (auto& v : testData_["int"]) {
+            for (size_t i = 0; i < funcs.size(); ++i) {
+                other.apply(group, i, v);
+            }
+        }
+        AggStateArena merged(columns);
+        auto dst = merged.addGroup();
+        merged.merge(dst, other, group);
+        merged.merge(dst, other, group);
+        EXPECT_EQ(Value(6), merged.result(dst, 1));
+        EXPECT_EQ(Value(12), merged.result(dst, 2));
+        EXPECT_EQ(Value(2.0), merged.result(dst, 3));
+        EXPECT_EQ(Value(3), merged.result(dst, 12));
+    }
+    {
+        auto count = AggFunctionManager::getState("count").value();
+        auto sum = AggFunctionManager::getState("sum").value();
+        // count(distinct), sum
+        AggStateArena lhs({{count, true}, {sum, false}});
+        AggStateArena rhs({{count, true}, {sum, false}});
+        auto l = lhs.addGroup();
+        auto r = rhs.addGroup();
+        for (auto v : {1, 2, 2, 3}) {
+            lhs.apply(l, 0, v);
+            lhs.apply(l, 1, v);
+        }
+        for (auto v : {3, 4, 4}) {
+            rhs.apply(r, 0, v);
+            rhs.apply(r, 1, v);
+        }
+        EXPECT_EQ(Value(3), lhs.result(l, 0));
+        lhs.merge(l, rhs, r);
+        EXPECT_EQ(Value(4), lhs.result(l, 0));
+        EXPECT_EQ(Value(19), lhs.result(l, 1));
+    }
+    EXPECT_FALSE(AggFunctionManager::getState("not_exist").ok());
+}
+
+TEST_F(AggFunctionManagerTest, state) {
+    AggData aggData;
+    auto aggFunc = AggFunctionManager::get("std").value();
+    for (auto &v : testData_["int"]) {
+        aggFunc(&aggData, v);
+    }
+    aggData.uniques()->values.emplace(1);
+
+    AggData restored;
+    ASSERT_TRUE(restored.fromState(aggData.toState()).ok());
+    EXPECT_EQ(aggData.cnt(), restored.cnt());
+    EXPECT_EQ(aggData.avg(), restored.avg());
+    EXPECT_EQ(aggData.deviation(), restored.deviation());
+    EXPECT_EQ(aggData.result(), restored.result());
+    EXPECT_EQ(*aggData.uniques(), *restored.uniques());
+
+    EXPECT_FALSE(restored.fromState(Value(1)).ok());
+    EXPECT_FALSE(restored.fromState(List({1, 2})).ok());
 }
 
 }   // namespace nebula
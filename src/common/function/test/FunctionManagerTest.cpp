@@ -62,7 +62,7 @@ protected:
     }
 
     ::testing::AssertionResult testFunction(const char *expr, const std::vector<Value> &args) {
-        std::vector<FunctionManager::ArgType> argsRef;
+        FunctionManager::ArgList argsRef;
         argsRef.insert(argsRef.end(), args.begin(), args.end());
         auto result = FunctionManager::get(expr, args.size());
         if (!result.ok()) {
@@ -72,8 +72,49 @@ protected:
         return ::testing::AssertionSuccess();
     }
 
-    std::vector<FunctionManager::ArgType> genArgsRef(const std::vector<Value> &args) {
-        std::vector<FunctionManager::ArgType> argsRef;
+    // Checks the batch form of `func' against the scalar form on each row,
+    // an argument of a single value is passed as a constant
+    ::testing::AssertionResult testBatch(const char *func,
+                                         const std::vector<std::vector<Value>> &args,
+                                         size_t numRows) {
+        auto scalar = FunctionManager::get(func, args.size());
+        auto batch = FunctionManager::getBatch(func, args.size());
+        if (!scalar.ok() || !batch.ok()) {
+            return ::testing::AssertionFailure()
+                   << "Can't get fuction " << func << " with " << args.size() << " parameters.";
+        }
+        std::vector<ValueColumn> columns;
+        for (const auto &arg : args) {
+            columns.emplace_back(arg.size() == 1 ? ValueColumn::constant(arg.front(), numRows)
+                                                 : ValueColumn(arg));
+        }
+        FunctionManager::ColumnArgs argColumns;
+        for (const auto &column : columns) {
+            argColumns.emplace_back(&column);
+        }
+        auto result = batch.value()(argColumns, numRows);
+        if (result.size() != numRows) {
+            return ::testing::AssertionFailure() << "batch size check failed: " << func;
+        }
+        for (size_t row = 0; row < numRows; ++row) {
+            FunctionManager::ArgList argsRef;
+            for (const auto &arg : args) {
+                argsRef.emplace_back(arg.size() == 1 ? arg.front() : arg[row]);
+            }
+            auto expect = scalar.value()(argsRef);
+            auto val = result.value(row);
+            if (val.type() != expect.type() || val != expect ||
+                (val.isNull() && val.getNull() != expect.getNull())) {
+                return ::testing::AssertionFailure()
+                       << "batch value check failed: " << func << " of row " << row << ", "
+                       << val << " vs. " << expect;
+            }
+        }
+        return ::testing::AssertionSuccess();
+    }
+
+    FunctionManager::ArgList genArgsRef(const std::vector<Value> &args) {
+        FunctionManager::ArgList argsRef;
         argsRef.insert(argsRef.end(), args.begin(), args.end());
         return argsRef;
     }
@@ -1823,6 +1864,156 @@ TEST_F(FunctionManagerTest, DataSetRowCol) {
     }
 }
 
+TEST_F(FunctionManagerTest, SpecializedFunction) {
+    using Args = std::vector<Value>;
+    std::vector<std::pair<const char *, std::vector<Args>>> calls = {
+        {"abs", {{-3}, {7}, {-2.5}, {0.0}}},
+        {"floor", {{-3}, {-2.5}, {1.1}}},
+        {"ceil", {{-3}, {-2.5}, {1.1}}},
+        {"round", {{4}, {-2.5}, {1.5}}},
+        {"sqrt", {{4}, {-4}, {2.25}, {-0.5}}},
+        {"cbrt", {{27}, {-8.0}}},
+        {"lower", {{"Hello"}, {""}}},
+        {"toupper", {{"Hello"}, {""}}},
+        {"length", {{"Hello"}, {""}}},
+        {"hash", {{42}, {1.5}, {"nebula"}}},
+        {"substr", {{"abcdef", 2}, {"abcdef", 10}, {"abcdef", -1}, {"abcdef", 1, 3},
+                    {"abcdef", 1, -1}, {"abcdef", 4, 10}}},
+    };
+    for (const auto &call : calls) {
+        for (const auto &args : call.second) {
+            std::vector<Value::Type> argsType;
+            for (const auto &arg : args) {
+                argsType.emplace_back(arg.type());
+            }
+            // The types are of the signatures of the function
+            EXPECT_TRUE(FunctionManager::getReturnType(call.first, argsType).ok()) << call.first;
+
+            auto specialized = FunctionManager::getSpecialized(call.first, argsType);
+            ASSERT_TRUE(specialized.ok()) << call.first;
+            ASSERT_TRUE(specialized.value() != nullptr) << call.first;
+            auto generic = FunctionManager::get(call.first, args.size());
+            ASSERT_TRUE(generic.ok());
+
+            auto argsRef = genArgsRef(args);
+            auto expect = generic.value()(argsRef);
+            auto result = specialized.value()(argsRef);
+            EXPECT_EQ(expect.type(), result.type()) << call.first;
+            EXPECT_EQ(expect, result) << call.first;
+            if (expect.isNull()) {
+                EXPECT_EQ(expect.getNull(), result.getNull()) << call.first;
+            }
+        }
+    }
+    {
+        // No specialization for the types
+        auto result = FunctionManager::getSpecialized("abs", {Value::Type::STRING});
+        ASSERT_TRUE(result.ok());
+        EXPECT_TRUE(result.value() == nullptr);
+        result = FunctionManager::getSpecialized("pow", {Value::Type::INT, Value::Type::INT});
+        ASSERT_TRUE(result.ok());
+        EXPECT_TRUE(result.value() == nullptr);
+    }
+    {
+        EXPECT_FALSE(FunctionManager::getSpecialized("not_exist", {Value::Type::INT}).ok());
+        EXPECT_FALSE(FunctionManager::getSpecialized("abs", {}).ok());
+    }
+}
+
+TEST_F(FunctionManagerTest, BatchFunction) {
+    constexpr size_t kRows = 5;
+    std::vector<Value> ints = {-3, 0, 7, 1024, -99};
+    std::vector<Value> positive = {0, 1, 4, 9, 100};
+    std::vector<Value> floats = {-2.5, 0.0, 1.1, 16.0, 3.5};
+    std::vector<Value> strs = {"Hello", "", "nebula", "GRAPH", "a"};
+    std::vector<Value> mixed = {-3, 2.5, Value::kNullValue, "abc", 4};
+    for (auto *func : {"abs", "floor", "ceil", "round", "sqrt", "cbrt", "hash"}) {
+        EXPECT_TRUE(testBatch(func, {ints}, kRows));
+        EXPECT_TRUE(testBatch(func, {positive}, kRows));
+        EXPECT_TRUE(testBatch(func, {floats}, kRows));
+        EXPECT_TRUE(testBatch(func, {mixed}, kRows));
+        EXPECT_TRUE(testBatch(func, {{-3}}, kRows));
+    }
+    for (auto *func : {"lower", "toupper", "length", "hash"}) {
+        EXPECT_TRUE(testBatch(func, {strs}, kRows));
+        EXPECT_TRUE(testBatch(func, {mixed}, kRows));
+    }
+    {
+        EXPECT_TRUE(testBatch("substr", {strs, {1}}, kRows));
+        EXPECT_TRUE(testBatch("substr", {strs, {0}, {3}}, kRows));
+        EXPECT_TRUE(testBatch("substring", {strs, {2}, {0}}, kRows));
+        EXPECT_TRUE(testBatch("substr", {strs, {10}}, kRows));
+        EXPECT_TRUE(testBatch("substr", {strs, {-1}}, kRows));
+        EXPECT_TRUE(testBatch("substr", {strs, {1}, {-1}}, kRows));
+        EXPECT_TRUE(testBatch("substr", {strs, positive}, kRows));
+        EXPECT_TRUE(testBatch("substr", {mixed, {1}}, kRows));
+    }
+    {
+        // Without a batch body
+        EXPECT_TRUE(testBatch("pow", {ints, {2}}, kRows));
+        EXPECT_TRUE(testBatch("pow", {floats, positive}, kRows));
+        EXPECT_TRUE(testBatch("trim", {strs}, kRows));
+    }
+    {
+        // The results of batch bodies are typed
+        auto absFunc = FunctionManager::getBatch("abs", 1);
+        ASSERT_TRUE(absFunc.ok());
+        ValueColumn intColumn(ints);
+        ASSERT_EQ(Value::Type::INT, intColumn.type());
+        auto result = absFunc.value()({&intColumn}, kRows);
+        EXPECT_EQ(Value::Type::INT, result.type());
+        EXPECT_EQ(std::vector<int64_t>({3, 0, 7, 1024, 99}), result.ints());
+
+        auto floorFunc = FunctionManager::getBatch("floor", 1);
+        ASSERT_TRUE(floorFunc.ok());
+        ValueColumn floatColumn(floats);
+        result = floorFunc.value()({&floatColumn}, kRows);
+        EXPECT_EQ(Value::Type::FLOAT, result.type());
+
+        auto lowerFunc = FunctionManager::getBatch("lower", 1);
+        ASSERT_TRUE(lowerFunc.ok());
+        ValueColumn strColumn(strs);
+        result = lowerFunc.value()({&strColumn}, kRows);
+        EXPECT_EQ(Value::Type::STRING, result.type());
+        EXPECT_EQ("graph", result.strs()[3]);
+
+        // Pure functions of constants are called once
+        auto constant = ValueColumn::constant(-3, kRows);
+        result = absFunc.value()({&constant}, kRows);
+        EXPECT_TRUE(result.isConstant());
+        EXPECT_EQ(Value(3), result.value(kRows - 1));
+
+        // Mixed types are kept as values
+        ValueColumn mixedColumn(mixed);
+        EXPECT_FALSE(mixedColumn.isTyped());
+        result = absFunc.value()({&mixedColumn}, kRows);
+        EXPECT_FALSE(result.isTyped());
+        EXPECT_EQ(Value::kNullBadType, result.value(3));
+    }
+    {
+        // Impure ones are called on each row
+        auto randFunc = FunctionManager::getBatch("rand32", 0);
+        ASSERT_TRUE(randFunc.ok());
+        auto result = randFunc.value()({}, kRows);
+        EXPECT_FALSE(result.isConstant());
+        EXPECT_EQ(kRows, result.moveValues().size());
+    }
+}
+
+TEST_F(FunctionManagerTest, VectorArgs) {
+    // Called like before the arguments were an ArgList
+    auto substr = FunctionManager::get("substr", 3);
+    ASSERT_TRUE(substr.ok());
+    std::vector<Value> values = {"abcdefghijkl", 2, 4};
+    std::vector<FunctionManager::ArgType> args(values.begin(), values.end());
+    EXPECT_EQ(Value("cdef"), substr.value()(args));
+    EXPECT_EQ(Value("cdef"), substr.value()(genArgsRef(values)));
+
+    // And held as the std::function of a vector
+    std::function<Value(const std::vector<FunctionManager::ArgType>&)> func = substr.value();
+    EXPECT_EQ(Value("cdef"), func(args));
+}
+
 }   // namespace nebula
 
 int main(int argc, char **argv) {
@@ -0,0 +1,169 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/function/FunctionMemo.h"
+
+namespace nebula {
+
+class FunctionMemoTest : public ::testing::Test {
+protected:
+    // Calls `memo' of `args', counting the calls of the function
+    Value call(FunctionMemo& memo, std::vector<Value> args) {
+        FunctionManager::ArgList argsRef;
+        argsRef.insert(argsRef.end(), args.begin(), args.end());
+        return memo.call(argsRef, [this](const FunctionManager::ArgList& callArgs) -> Value {
+            ++calls_;
+            std::stringstream result;
+            for (const auto& arg : callArgs) {
+                result << arg.get() << ":" << arg.get().type() << ",";
+            }
+            return result.str();
+        });
+    }
+
+    size_t calls_{0};
+};
+
+
+TEST_F(FunctionMemoTest, Hit) {
+    FunctionMemo memo;
+    auto result = call(memo, {"a", 1});
+    EXPECT_EQ(1, calls_);
+    EXPECT_EQ(result, call(memo, {"a", 1}));
+    EXPECT_EQ(1, calls_);
+    call(memo, {"a", 2});
+    call(memo, {"a"});
+    EXPECT_EQ(3, calls_);
+
+    auto stats = memo.stats();
+    EXPECT_EQ(4, stats.lookups_);
+    EXPECT_EQ(1, stats.hits_);
+    EXPECT_EQ(0, stats.evicts_);
+    EXPECT_EQ(0, stats.bypasses_);
+    EXPECT_FALSE(stats.disabled_);
+    EXPECT_DOUBLE_EQ(0.25, stats.hitRate());
+}
+
+
+TEST_F(FunctionMemoTest, ExactArgs) {
+    FunctionMemo memo;
+    std::vector<Value> args = {
+        1,
+        1.0,
+        0.0,
+        -0.0,
+        true,
+        "1",
+        Value::kNullValue,
+        Value::kNullBadType,
+        Date(2021, 1, 1),
+        DateTime(2021, 1, 1, 0, 0, 0, 0),
+    };
+    // All different from each other
+    for (const auto& arg : args) {
+        call(memo, {arg});
+    }
+    EXPECT_EQ(args.size(), calls_);
+    // And hit by the same
+    for (const auto& arg : args) {
+        call(memo, {arg});
+    }
+    EXPECT_EQ(args.size(), calls_);
+
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    call(memo, {nan});
+    call(memo, {nan});
+    EXPECT_EQ(args.size() + 1, calls_);
+}
+
+
+TEST_F(FunctionMemoTest, NotMemoizable) {
+    FunctionMemo memo;
+    List list;
+    list.values = {1, 2};
+    call(memo, {"a", list});
+    call(memo, {"a", list});
+    EXPECT_EQ(2, calls_);
+
+    auto stats = memo.stats();
+    EXPECT_EQ(0, stats.lookups_);
+    EXPECT_EQ(2, stats.bypasses_);
+    EXPECT_FALSE(stats.disabled_);
+}
+
+
+TEST_F(FunctionMemoTest, Capacity) {
+    FunctionMemo::Options options;
+    options.capacity_ = 2;
+    options.minHitRate_ = 0.0;
+    FunctionMemo memo(options);
+    call(memo, {1});
+    call(memo, {2});
+    call(memo, {1});
+    // Evicts 2, the least recently used
+    call(memo, {3});
+    EXPECT_EQ(3, calls_);
+    call(memo, {1});
+    EXPECT_EQ(3, calls_);
+    call(memo, {2});
+    EXPECT_EQ(4, calls_);
+
+    auto stats = memo.stats();
+    EXPECT_EQ(6, stats.lookups_);
+    EXPECT_EQ(2, stats.hits_);
+    EXPECT_EQ(2, stats.evicts_);
+}
+
+
+TEST_F(FunctionMemoTest, Disable) {
+    FunctionMemo::Options options;
+    options.capacity_ = 16;
+    options.window_ = 10;
+    options.minHitRate_ = 0.5;
+    {
+        // Low cardinality
+        FunctionMemo memo(options);
+        for (int64_t i = 0; i < 100; ++i) {
+            call(memo, {i % 4});
+        }
+        EXPECT_EQ(4, calls_);
+        auto stats = memo.stats();
+        EXPECT_FALSE(memo.disabled());
+        EXPECT_FALSE(stats.disabled_);
+        EXPECT_EQ(96, stats.hits_);
+    }
+    calls_ = 0;
+    {
+        // High cardinality, disabled after the first window
+        FunctionMemo memo(options);
+        for (int64_t i = 0; i < 100; ++i) {
+            call(memo, {i});
+        }
+        EXPECT_EQ(100, calls_);
+        auto stats = memo.stats();
+        EXPECT_TRUE(memo.disabled());
+        EXPECT_TRUE(stats.disabled_);
+        EXPECT_EQ(10, stats.lookups_);
+        EXPECT_EQ(0, stats.hits_);
+        EXPECT_EQ(90, stats.bypasses_);
+
+        // Correct still
+        EXPECT_EQ(Value("1:INT,"), call(memo, {1}));
+    }
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
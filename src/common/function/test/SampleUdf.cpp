@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+/**
+ * A sample shared object of user defined functions, which depends on nothing
+ * but NebulaUdf.h:
+ *
+ *   sample_score(weight, clicks) = weight * ln(1 + clicks), NULL if clicks < 0
+ *   sample_div(a, b) = a / b, BAD_DATA if b is 0
+ *   sample_greet(name) = "Hello, " + name
+ *   sample_next_id() = 1, 2, 3...
+ */
+
+#include <atomic>
+#include <cmath>
+#include <string>
+
+#include "common/function/NebulaUdf.h"
+
+namespace {
+
+bool isNull(const nebula_udf_column& col, size_t row) {
+    return col.nulls != nullptr && col.nulls[col.is_constant ? 0 : row] != 0;
+}
+
+int64_t intAt(const nebula_udf_column& col, size_t row) {
+    return static_cast<const int64_t*>(col.data)[col.is_constant ? 0 : row];
+}
+
+double numberAt(const nebula_udf_column& col, size_t row) {
+    if (col.type == NEBULA_UDF_INT) {
+        return static_cast<double>(intAt(col, row));
+    }
+    return static_cast<const double*>(col.data)[col.is_constant ? 0 : row];
+}
+
+int32_t scoreScalar(const nebula_udf_value* args, size_t, nebula_udf_value* result) {
+    auto weight = args[0].type == NEBULA_UDF_INT ? static_cast<double>(args[0].u.i) : args[0].u.f;
+    auto clicks = args[1].u.i;
+    if (clicks < 0) {
+        result->type = NEBULA_UDF_NULL;
+        return 0;
+    }
+    result->type = NEBULA_UDF_FLOAT;
+    result->u.f = weight * std::log1p(static_cast<double>(clicks));
+    return 0;
+}
+
+int32_t scoreBatch(const nebula_udf_column* args, size_t, nebula_udf_result_column* result) {
+    auto* scores = static_cast<double*>(result->data);
+    for (size_t row = 0; row < result->size; ++row) {
+        if (isNull(args[0], row) || isNull(args[1], row) || intAt(args[1], row) < 0) {
+            result->nulls[row] = 1;
+            continue;
+        }
+        scores[row] = numberAt(args[0], row) *
+                      std::log1p(static_cast<double>(intAt(args[1], row)));
+    }
+    return 0;
+}
+
+int32_t divScalar(const nebula_udf_value* args, size_t, nebula_udf_value* result) {
+    if (args[1].u.i == 0) {
+        return 1;
+    }
+    result->type = NEBULA_UDF_INT;
+    result->u.i = args[0].u.i / args[1].u.i;
+    return 0;
+}
+
+int32_t divBatch(const nebula_udf_column* args, size_t, nebula_udf_result_column* result) {
+    auto* quotients = static_cast<int64_t*>(result->data);
+    for (size_t row = 0; row < result->size; ++row) {
+        if (isNull(args[0], row) || isNull(args[1], row)) {
+            result->nulls[row] = 1;
+            continue;
+        }
+        auto divisor = intAt(args[1], row);
+        if (divisor == 0) {
+            return 1;
+        }
+        quotients[row] = intAt(args[0], row) / divisor;
+    }
+    return 0;
+}
+
+int32_t greetScalar(const nebula_udf_value* args, size_t, nebula_udf_value* result) {
+    // Valid until the next call of the thread
+    thread_local std::string greeting;
+    greeting.assign("Hello, ");
+    greeting.append(args[0].u.s.data, args[0].u.s.len);
+    result->type = NEBULA_UDF_STRING;
+    result->u.s.data = greeting.data();
+    result->u.s.len = greeting.size();
+    return 0;
+}
+
+std::atomic<int64_t> nextId{0};
+
+int32_t nextIdScalar(const nebula_udf_value*, size_t, nebula_udf_value* result) {
+    result->type = NEBULA_UDF_INT;
+    result->u.i = ++nextId;
+    return 0;
+}
+
+const int32_t kFloatInt[] = {NEBULA_UDF_FLOAT, NEBULA_UDF_INT};
+const int32_t kIntInt[] = {NEBULA_UDF_INT, NEBULA_UDF_INT};
+const int32_t kString[] = {NEBULA_UDF_STRING};
+
+const nebula_udf_signature kScoreSignatures[] = {
+    {kFloatInt, 2, NEBULA_UDF_FLOAT},
+    {kIntInt, 2, NEBULA_UDF_FLOAT},
+};
+const nebula_udf_signature kDivSignatures[] = {
+    {kIntInt, 2, NEBULA_UDF_INT},
+};
+const nebula_udf_signature kGreetSignatures[] = {
+    {kString, 1, NEBULA_UDF_STRING},
+};
+const nebula_udf_signature kNextIdSignatures[] = {
+    {nullptr, 0, NEBULA_UDF_INT},
+};
+
+const nebula_udf_function kFunctions[] = {
+    {"sample_score", 1, kScoreSignatures, 2, scoreScalar, scoreBatch},
+    {"sample_div", 1, kDivSignatures, 1, divScalar, divBatch},
+    {"sample_greet", 1, kGreetSignatures, 1, greetScalar, nullptr},
+    {"sample_next_id", 0, kNextIdSignatures, 1, nextIdScalar, nullptr},
+};
+
+}   // namespace
+
+extern "C" {
+
+NEBULA_UDF_EXPORT uint32_t nebula_udf_abi_version(void) {
+#ifdef SAMPLE_UDF_BAD_VERSION
+    return NEBULA_UDF_ABI_VERSION + 1;
+#else
+    return NEBULA_UDF_ABI_VERSION;
+#endif
+}
+
+NEBULA_UDF_EXPORT const nebula_udf_function* nebula_udf_functions(size_t* num) {
+    *num = sizeof(kFunctions) / sizeof(kFunctions[0]);
+    return kFunctions;
+}
+
+}   // extern "C"
@@ -0,0 +1,243 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "common/base/Base.h"
+#include "common/function/FunctionManager.h"
+
+namespace nebula {
+
+// The shared objects built of SampleUdf.cpp, see CMakeLists.txt
+static const char* kSampleUdf = SAMPLE_UDF_PATH;
+static const char* kBadVersionUdf = BAD_VERSION_UDF_PATH;
+
+class UdfTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        // Whatever left by the test
+        FunctionManager::unload(kSampleUdf, {});
+    }
+
+    static Value call(const std::string& func, const std::vector<Value>& args) {
+        auto result = FunctionManager::get(func, args.size());
+        CHECK(result.ok()) << result.status();
+        FunctionManager::ArgList argsRef;
+        argsRef.insert(argsRef.end(), args.begin(), args.end());
+        return result.value()(argsRef);
+    }
+
+    // Checks the batch form of `func' against the scalar form on each row
+    static ::testing::AssertionResult testBatch(const std::string& func,
+                                                const std::vector<const ValueColumn*>& columns,
+                                                size_t numRows) {
+        auto batch = FunctionManager::getBatch(func, columns.size());
+        if (!batch.ok()) {
+            return ::testing::AssertionFailure() << batch.status();
+        }
+        FunctionManager::ColumnArgs args(columns.begin(), columns.end());
+        auto result = batch.value()(args, numRows);
+        if (result.size() != numRows) {
+            return ::testing::AssertionFailure() << "batch size check failed: " << func;
+        }
+        for (size_t row = 0; row < numRows; ++row) {
+            std::vector<Value> rowArgs;
+            for (const auto* column : columns) {
+                rowArgs.emplace_back(column->value(row));
+            }
+            auto expect = call(func, rowArgs);
+            auto val = result.value(row);
+            if (val.type() != expect.type() || val != expect ||
+                (val.isNull() && val.getNull() != expect.getNull())) {
+                return ::testing::AssertionFailure()
+                       << "batch value check failed: " << func << " of row " << row << ", "
+                       << val << " vs. " << expect;
+            }
+        }
+        return ::testing::AssertionSuccess();
+    }
+};
+
+
+TEST_F(UdfTest, Load) {
+    ASSERT_TRUE(FunctionManager::load(kSampleUdf, {}).ok());
+
+    // Case insensitive, of the arity of the signatures
+    EXPECT_TRUE(FunctionManager::find("SAMPLE_SCORE", 2).ok());
+    EXPECT_FALSE(FunctionManager::find("sample_score", 1).ok());
+    EXPECT_TRUE(FunctionManager::find("sample_next_id", 0).ok());
+
+    EXPECT_EQ(Value(2.0 * std::log1p(3.0)), call("sample_score", {2.0, 3}));
+    EXPECT_EQ(Value(2.0 * std::log1p(3.0)), call("sample_score", {2, 3}));
+    EXPECT_EQ(Value::kNullValue, call("sample_score", {2.0, -1}));
+    EXPECT_EQ(Value::kNullValue, call("sample_score", {Value::kNullValue, 3}));
+    auto badType = call("sample_score", {"2.0", 3});
+    ASSERT_TRUE(badType.isNull());
+    EXPECT_EQ(NullType::BAD_TYPE, badType.getNull());
+
+    EXPECT_EQ(Value(3), call("sample_div", {7, 2}));
+    auto badData = call("sample_div", {7, 0});
+    ASSERT_TRUE(badData.isNull());
+    EXPECT_EQ(NullType::BAD_DATA, badData.getNull());
+
+    EXPECT_EQ(Value("Hello, nebula"), call("sample_greet", {"nebula"}));
+
+    auto id = call("sample_next_id", {});
+    ASSERT_TRUE(id.isInt());
+    EXPECT_EQ(Value(id.getInt() + 1), call("sample_next_id", {}));
+
+    auto isPure = FunctionManager::getIsPure("sample_score", 2);
+    ASSERT_TRUE(isPure.ok());
+    EXPECT_TRUE(isPure.value());
+    isPure = FunctionManager::getIsPure("sample_next_id", 0);
+    ASSERT_TRUE(isPure.ok());
+    EXPECT_FALSE(isPure.value());
+
+    auto returnType = FunctionManager::getReturnType("sample_score",
+                                                     {Value::Type::INT, Value::Type::INT});
+    ASSERT_TRUE(returnType.ok());
+    EXPECT_EQ(Value::Type::FLOAT, returnType.value());
+    returnType = FunctionManager::getReturnType("sample_greet", {Value::Type::STRING});
+    ASSERT_TRUE(returnType.ok());
+    EXPECT_EQ(Value::Type::STRING, returnType.value());
+    EXPECT_FALSE(FunctionManager::getReturnType("sample_greet", {Value::Type::INT}).ok());
+}
+
+
+TEST_F(UdfTest, LoadErrors) {
+    EXPECT_FALSE(FunctionManager::load("/path/not/exist.so", {}).ok());
+    EXPECT_FALSE(FunctionManager::load(kBadVersionUdf, {}).ok());
+    EXPECT_FALSE(FunctionManager::find("sample_score", 2).ok());
+
+    // None is loaded if any fails
+    EXPECT_FALSE(FunctionManager::load(kSampleUdf, {"sample_score", "not_exported"}).ok());
+    EXPECT_FALSE(FunctionManager::find("sample_score", 2).ok());
+
+    ASSERT_TRUE(FunctionManager::load(kSampleUdf, {"sample_score"}).ok());
+    EXPECT_FALSE(FunctionManager::load(kSampleUdf, {"Sample_Score"}).ok());
+    EXPECT_FALSE(FunctionManager::load(kSampleUdf, {}).ok());
+    EXPECT_TRUE(FunctionManager::load(kSampleUdf, {"sample_div"}).ok());
+
+    EXPECT_FALSE(FunctionManager::unload(kSampleUdf, {"abs"}).ok());
+    EXPECT_FALSE(FunctionManager::unload(kSampleUdf, {"sample_greet"}).ok());
+    EXPECT_FALSE(FunctionManager::unload(kBadVersionUdf, {}).ok());
+    EXPECT_TRUE(FunctionManager::find("abs", 1).ok());
+}
+
+
+TEST_F(UdfTest, Unload) {
+    ASSERT_TRUE(FunctionManager::load(kSampleUdf, {}).ok());
+    auto greet = FunctionManager::get("sample_greet", 1);
+    ASSERT_TRUE(greet.ok());
+    auto score = FunctionManager::getBatch("sample_score", 2);
+    ASSERT_TRUE(score.ok());
+
+    ASSERT_TRUE(FunctionManager::unload(kSampleUdf, {"SAMPLE_GREET"}).ok());
+    EXPECT_FALSE(FunctionManager::find("sample_greet", 1).ok());
+    EXPECT_FALSE(FunctionManager::getReturnType("sample_greet", {Value::Type::STRING}).ok());
+    EXPECT_TRUE(FunctionManager::find("sample_score", 2).ok());
+
+    ASSERT_TRUE(FunctionManager::unload(kSampleUdf, {}).ok());
+    EXPECT_FALSE(FunctionManager::find("sample_score", 2).ok());
+    EXPECT_FALSE(FunctionManager::unload(kSampleUdf, {}).ok());
+
+    // The functions obtained before are still of the shared object
+    Value name("again");
+    FunctionManager::ArgList args;
+    args.emplace_back(name);
+    EXPECT_EQ(Value("Hello, again"), greet.value()(args));
+    ValueColumn weights(std::vector<double>{1.0, 2.0});
+    ValueColumn clicks(std::vector<int64_t>{1, 2});
+    auto scores = score.value()({&weights, &clicks}, 2);
+    EXPECT_EQ(Value(2.0 * std::log1p(2.0)), scores.value(1));
+
+    // And loaded again
+    ASSERT_TRUE(FunctionManager::load(kSampleUdf, {}).ok());
+    EXPECT_EQ(Value("Hello, again"), call("sample_greet", {"again"}));
+}
+
+
+TEST_F(UdfTest, Batch) {
+    ASSERT_TRUE(FunctionManager::load(kSampleUdf, {}).ok());
+    constexpr size_t kRows = 4;
+    ValueColumn weights(std::vector<double>{1.0, 2.5, 0.5, 3.0});
+    ValueColumn intWeights(std::vector<int64_t>{1, 2, 0, 3});
+    ValueColumn clicks(std::vector<int64_t>{0, 10, 7, 100});
+    ValueColumn negativeClicks(std::vector<int64_t>{0, 10, -1, 100});
+    ValueColumn nullClicks(std::vector<Value>{0, Value::kNullValue, 7, 100});
+    auto constantWeight = ValueColumn::constant(2.0, kRows);
+    auto constantClicks = ValueColumn::constant(5, kRows);
+
+    EXPECT_TRUE(testBatch("sample_score", {&weights, &clicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&intWeights, &clicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&weights, &negativeClicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&weights, &nullClicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&constantWeight, &clicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&weights, &constantClicks}, kRows));
+    EXPECT_TRUE(testBatch("sample_score", {&constantWeight, &constantClicks}, kRows));
+
+    // The results of the batch entry are typed
+    auto score = FunctionManager::getBatch("sample_score", 2);
+    ASSERT_TRUE(score.ok());
+    auto result = score.value()({&weights, &clicks}, kRows);
+    EXPECT_EQ(Value::Type::FLOAT, result.type());
+    result = score.value()({&weights, &negativeClicks}, kRows);
+    EXPECT_EQ(Value::kNullValue, result.value(2));
+
+    // A failed batch is called row by row
+    ValueColumn divisors(std::vector<int64_t>{1, 0, 3, 4});
+    EXPECT_TRUE(testBatch("sample_div", {&clicks, &divisors}, kRows));
+    // Without a batch entry
+    ValueColumn names(std::vector<std::string>{"a", "b", "c", "d"});
+    EXPECT_TRUE(testBatch("sample_greet", {&names}, kRows));
+}
+
+
+TEST_F(UdfTest, Concurrent) {
+    constexpr size_t kThreads = 4;
+    constexpr size_t kCalls = 2000;
+    std::atomic<size_t> finished{0};
+    std::vector<size_t> failures(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] () {
+            Value weight(2.0);
+            Value clicks(3);
+            FunctionManager::ArgList args;
+            args.emplace_back(weight);
+            args.emplace_back(clicks);
+            for (size_t i = 0; i < kCalls; ++i) {
+                // Found or not while loading and unloading, but never broken
+                auto score = FunctionManager::get("sample_score", 2);
+                if (score.ok() && score.value()(args) != Value(2.0 * std::log1p(3.0))) {
+                    ++failures[t];
+                }
+            }
+            ++finished;
+        });
+    }
+    while (finished < kThreads) {
+        EXPECT_TRUE(FunctionManager::load(kSampleUdf, {}).ok());
+        EXPECT_TRUE(FunctionManager::unload(kSampleUdf, {}).ok());
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(0, failures[t]) << "thread " << t;
+    }
+}
+
+}   // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_META_DEFAULTVALUECONTEXT_H_
+#define COMMON_META_DEFAULTVALUECONTEXT_H_
+
+#include "common/base/Base.h"
+#include "common/context/ExpressionContext.h"
+
+namespace nebula {
+namespace meta {
+
+// Evaluates the default values of the schema fields, which read nothing from
+// the row but the loop variables of their own
+class DefaultValueContext final : public ExpressionContext {
+public:
+    const Value& getVar(const std::string& var) const override {
+        auto it = vars_.find(var);
+        return it == vars_.end() ? Value::kNullValue : it->second;
+    }
+
+    const Value& getVersionedVar(const std::string&, int64_t) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getVarProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getEdgeProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getTagProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getSrcProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getDstProp(const std::string&, const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    const Value& getInputProp(const std::string&) const override {
+        return Value::kNullValue;
+    }
+
+    Value getVertex() const override {
+        return Value::kNullValue;
+    }
+
+    Value getEdge() const override {
+        return Value::kNullValue;
+    }
+
+    Value getColumn(int32_t) const override {
+        return Value::kNullValue;
+    }
+
+    void setVar(const std::string& var, Value val) override {
+        vars_[var] = std::move(val);
+    }
+
+private:
+    std::unordered_map<std::string, Value> vars_;
+};
+
+}  // namespace meta
+}  // namespace nebula
+#endif  // COMMON_META_DEFAULTVALUECONTEXT_H_
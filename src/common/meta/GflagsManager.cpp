@@ -35,11 +35,11 @@ Value GflagsManager::gflagsValueToValue(const std::string &type, const std::stri
                         << " failed: " << status;
             return Value::kNullValue;
         }
-        Map map;
-        conf.forEachItem([&map] (const std::string& key, const folly::dynamic& val) {
-            map.kvs.emplace(key, val.asString());
+        MapKvs::Builder builder;
+        conf.forEachItem([&builder] (const std::string& key, const folly::dynamic& val) {
+            builder.emplace(key, val.asString());
         });
-        value.setMap(std::move(map));
+        value.setMap(Map(std::move(builder).build()));
         return value;
     }
     LOG(WARNING) << "Unknown type: " << type;
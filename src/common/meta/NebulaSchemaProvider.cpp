@@ -6,10 +6,26 @@
 
 #include "common/base/Base.h"
 #include "common/meta/NebulaSchemaProvider.h"
+#include <folly/lang/Bits.h>
+#include "common/meta/DefaultValueContext.h"
+#include "common/expression/ExprConstantChecker.h"
+#include "common/expression/ExprSlotBinder.h"
 
 namespace nebula {
 namespace meta {
 
+Value NebulaSchemaProvider::SchemaField::evalDefault() const {
+    DCHECK(hasDefault_);
+    if (hasConstDefault_) {
+        return constDefault_;
+    }
+    DefaultValueContext ctx;
+    ExpressionFrame frame(numDefaultSlots_, numDefaultLocals_);
+    ctx.setFrame(&frame);
+    return Expression::eval(defaultValue_, ctx);
+}
+
+
 SchemaVer NebulaSchemaProvider::getVersion() const noexcept {
     return ver_;
 }
@@ -35,13 +51,22 @@ size_t NebulaSchemaProvider::size() const noexcept {
 }
 
 
-int64_t NebulaSchemaProvider::getFieldIndex(const std::string& name) const {
-    auto it = fieldNameIndex_.find(name);
-    if (it == fieldNameIndex_.end()) {
-        // Not found
+int64_t NebulaSchemaProvider::getFieldIndex(folly::StringPiece name) const {
+    if (fieldNameIndex_.empty()) {
         return -1;
-    } else {
-        return it->second;
+    }
+    auto hash = MurmurHash2()(name.data(), name.size());
+    auto mask = fieldNameIndex_.size() - 1;
+    for (auto pos = hash & mask; ; pos = (pos + 1) & mask) {
+        auto index = fieldNameIndex_[pos];
+        if (index < 0) {
+            // Not found
+            return -1;
+        }
+        auto& field = fields_[index];
+        if (field.nameHash_ == hash && folly::StringPiece(field.name_) == name) {
+            return index;
+        }
     }
 }
 
@@ -66,15 +91,15 @@ cpp2::PropertyType NebulaSchemaProvider::getFieldType(int64_t index) const {
 }
 
 
-cpp2::PropertyType NebulaSchemaProvider::getFieldType(const std::string& name)
+cpp2::PropertyType NebulaSchemaProvider::getFieldType(folly::StringPiece name)
         const {
-    auto it = fieldNameIndex_.find(name);
-    if (UNLIKELY(fieldNameIndex_.end() == it)) {
+    auto index = getFieldIndex(name);
+    if (UNLIKELY(index < 0)) {
         LOG(ERROR) << "Unknown field \"" << name << "\"";
         return cpp2::PropertyType::UNKNOWN;
     }
 
-    return fields_[it->second].type();
+    return fields_[index].type();
 }
 
 
@@ -93,14 +118,14 @@ const SchemaProviderIf::Field* NebulaSchemaProvider::field(int64_t index) const
 
 
 const SchemaProviderIf::Field* NebulaSchemaProvider::field(
-        const std::string& name) const {
-    auto it = fieldNameIndex_.find(name);
-    if (it == fieldNameIndex_.end()) {
+        folly::StringPiece name) const {
+    auto index = getFieldIndex(name);
+    if (index < 0) {
         VLOG(2) << "Unknown field \"" << name << "\"";
         return nullptr;
     }
 
-    return &fields_[it->second];
+    return &fields_[index];
 }
 
 
@@ -130,8 +155,48 @@ void NebulaSchemaProvider::addField(folly::StringPiece name,
                          size,
                          offset,
                          nullFlagPos);
-    fieldNameIndex_.emplace(name.toString(),
-                            static_cast<int64_t>(fields_.size() - 1));
+    // The constant defaults are evaluated only once, rather than per row,
+    // and the others are bound to be evaluated by threads
+    if (defaultValue != nullptr) {
+        auto& field = fields_.back();
+        if (ExprConstantChecker::isConstant(defaultValue)) {
+            DefaultValueContext ctx;
+            field.constDefault_ = Expression::eval(defaultValue, ctx);
+            field.hasConstDefault_ = true;
+        } else {
+            ExprSlotBinder binder;
+            binder.bind(defaultValue);
+            field.numDefaultSlots_ = binder.numSlots();
+            field.numDefaultLocals_ = binder.numLocals();
+        }
+    }
+    if (fields_.size() * 2 > fieldNameIndex_.size()) {
+        // Grows and reindexes in the order of fields_
+        fieldNameIndex_.assign(folly::nextPowTwo(fields_.size() * 4), -1);
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            indexField(i);
+        }
+    } else {
+        indexField(fields_.size() - 1);
+    }
+}
+
+
+void NebulaSchemaProvider::indexField(size_t index) {
+    auto& field = fields_[index];
+    auto mask = fieldNameIndex_.size() - 1;
+    for (auto pos = field.nameHash_ & mask; ; pos = (pos + 1) & mask) {
+        auto existing = fieldNameIndex_[pos];
+        if (existing < 0) {
+            fieldNameIndex_[pos] = static_cast<int32_t>(index);
+            return;
+        }
+        if (fields_[existing].nameHash_ == field.nameHash_ &&
+            fields_[existing].name_ == field.name_) {
+            // The first field of the same name wins
+            return;
+        }
+    }
 }
 
 /*static*/
@@ -9,6 +9,7 @@
 
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
+#include "common/base/MurmurHash2.h"
 #include <folly/RWSpinLock.h>
 #include "common/meta/SchemaProviderIf.h"
 
@@ -19,6 +20,7 @@ class NebulaSchemaProvider : public SchemaProviderIf {
     friend class FileBasedSchemaManager;
 public:
     class SchemaField final : public SchemaProviderIf::Field {
+        friend class NebulaSchemaProvider;
     public:
         SchemaField(std::string name,
                     cpp2::PropertyType type,
@@ -29,6 +31,7 @@ public:
                     size_t offset,
                     size_t nullFlagPos)
             : name_(std::move(name))
+            , nameHash_(MurmurHash2()(name_.data(), name_.size()))
             , type_(std::move(type))
             , nullable_(nullable)
             , hasDefault_(hasDefault)
@@ -57,6 +60,15 @@ public:
             return defaultValue_;
         }
 
+        const Value* constDefaultValue() const override {
+            return hasConstDefault_ ? &constDefault_ : nullptr;
+        }
+
+        // The default value of the field for a new row, which is either the
+        // cached constant one or evaluated with a frame of its own, so it
+        // could be called by threads
+        Value evalDefault() const;
+
         size_t size() const override {
             return size_;
         }
@@ -72,6 +84,7 @@ public:
 
     private:
         std::string name_;
+        size_t nameHash_;
         cpp2::PropertyType type_;
         bool nullable_;
         bool hasDefault_;
@@ -79,6 +92,12 @@ public:
         size_t size_;
         size_t offset_;
         size_t nullFlagPos_;
+        // Whether defaultValue_ is constant, and evaluated to constDefault_
+        bool hasConstDefault_{false};
+        Value constDefault_;
+        // The frame size of the bound defaultValue_ which is not constant
+        size_t numDefaultSlots_{0};
+        size_t numDefaultLocals_{0};
     };
 
 public:
@@ -94,14 +113,24 @@ public:
     // Returns the total space in bytes occupied by the fields_
     size_t size() const noexcept override;
 
-    int64_t getFieldIndex(const std::string& name) const override;
+    // The std::string and C string lookups of SchemaProviderIf forward to the
+    // folly::StringPiece ones
+    using SchemaProviderIf::getFieldIndex;
+    using SchemaProviderIf::getFieldType;
+    using SchemaProviderIf::field;
+
+    int64_t getFieldIndex(folly::StringPiece name) const override;
     const char* getFieldName(int64_t index) const override;
 
     cpp2::PropertyType getFieldType(int64_t index) const override;
-    cpp2::PropertyType getFieldType(const std::string& name) const override;
+    cpp2::PropertyType getFieldType(folly::StringPiece name) const override;
 
     const SchemaProviderIf::Field* field(int64_t index) const override;
-    const SchemaProviderIf::Field* field(const std::string& name) const override;
+    // The fields without the virtual calls, for decoding rows
+    const std::vector<SchemaField>& fields() const {
+        return fields_;
+    }
+    const SchemaProviderIf::Field* field(folly::StringPiece name) const override;
 
     void addField(folly::StringPiece name,
                   cpp2::PropertyType type,
@@ -120,11 +149,16 @@ public:
 protected:
     NebulaSchemaProvider() = default;
 
+    // Adds fields_[index] to fieldNameIndex_
+    void indexField(size_t index);
+
 protected:
     SchemaVer ver_{-1};
 
-    // fieldname -> index
-    std::unordered_map<std::string, int64_t>    fieldNameIndex_;
+    // fieldname -> index, an open addressing table probed linearly, each slot
+    // is an index of fields_ or -1. The size is a power of 2 and at least
+    // twice the number of fields, so the probes are short.
+    std::vector<int32_t>                        fieldNameIndex_;
     std::vector<SchemaField>                    fields_;
     size_t                                      numNullableFields_;
     cpp2::SchemaProp                            schemaProp_;
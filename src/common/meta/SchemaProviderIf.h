@@ -27,6 +27,13 @@ public:
         virtual bool nullable() const = 0;
         virtual bool hasDefault() const = 0;
         virtual Expression* defaultValue() const = 0;
+        // The default value evaluated once when the schema is loaded. It
+        // returns nullptr if there is no default, or the default is not
+        // constant, e.g. now() or uuid(), so defaultValue() should be
+        // evaluated for each row
+        virtual const Value* constDefaultValue() const {
+            return nullptr;
+        }
         // This method returns the number of bytes the field will occupy
         // when the field is persisted on the storage medium
         // For the variant length string, the size will return 8
@@ -108,14 +115,54 @@ public:
     // persisted on the disk
     virtual size_t size() const noexcept = 0;
 
-    virtual int64_t getFieldIndex(const std::string& name) const = 0;
+    // Looks up the fields by the names without copying them, returns -1 for
+    // the unknown names.
+    //
+    // The lookups by name used to take `const std::string&', which are kept as
+    // virtual functions forwarding to the folly::StringPiece ones, and the other
+    // way around, so the implementations overriding either one still work. An
+    // implementation must override at least one of each pair, the StringPiece
+    // one preferably, which saves building a std::string.
+    virtual int64_t getFieldIndex(folly::StringPiece name) const {
+        return getFieldIndex(name.str());
+    }
+    virtual int64_t getFieldIndex(const std::string& name) const {
+        return getFieldIndex(folly::StringPiece(name));
+    }
     virtual const char* getFieldName(int64_t index) const = 0;
 
     virtual cpp2::PropertyType getFieldType(int64_t index) const = 0;
-    virtual cpp2::PropertyType getFieldType(const std::string& name) const = 0;
+    virtual cpp2::PropertyType getFieldType(folly::StringPiece name) const {
+        return getFieldType(name.str());
+    }
+    virtual cpp2::PropertyType getFieldType(const std::string& name) const {
+        return getFieldType(folly::StringPiece(name));
+    }
 
     virtual const Field* field(int64_t index) const = 0;
-    virtual const Field* field(const std::string& name) const = 0;
+    virtual const Field* field(folly::StringPiece name) const {
+        return field(name.str());
+    }
+    virtual const Field* field(const std::string& name) const {
+        return field(folly::StringPiece(name));
+    }
+
+    // C strings would be ambiguous between the two above. Being a template, it
+    // is not a candidate for an integer, e.g. field(0).
+    template <class C, typename = std::enable_if_t<std::is_same<C, char>::value>>
+    int64_t getFieldIndex(const C* name) const {
+        return getFieldIndex(folly::StringPiece(name));
+    }
+
+    template <class C, typename = std::enable_if_t<std::is_same<C, char>::value>>
+    cpp2::PropertyType getFieldType(const C* name) const {
+        return getFieldType(folly::StringPiece(name));
+    }
+
+    template <class C, typename = std::enable_if_t<std::is_same<C, char>::value>>
+    const Field* field(const C* name) const {
+        return field(folly::StringPiece(name));
+    }
 
     /******************************************
      *
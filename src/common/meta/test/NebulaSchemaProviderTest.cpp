@@ -0,0 +1,184 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+namespace meta {
+
+TEST(NebulaSchemaProviderTest, FieldByName) {
+    NebulaSchemaProvider schema(0);
+    EXPECT_EQ(-1, schema.getFieldIndex("prop_0"));
+    EXPECT_EQ(nullptr, schema.field("prop_0"));
+
+    // Grows the index several times
+    constexpr int64_t kNumFields = 500;
+    for (int64_t i = 0; i < kNumFields; ++i) {
+        schema.addField(folly::stringPrintf("prop_%ld", i),
+                        i % 2 == 0 ? cpp2::PropertyType::INT64 : cpp2::PropertyType::STRING);
+    }
+    for (int64_t i = 0; i < kNumFields; ++i) {
+        auto name = folly::stringPrintf("prop_%ld", i);
+        EXPECT_EQ(i, schema.getFieldIndex(name));
+        // Looked up by a piece of a larger string
+        std::string padded = name + "_suffix";
+        EXPECT_EQ(i, schema.getFieldIndex(folly::StringPiece(padded.data(), name.size())));
+        ASSERT_NE(nullptr, schema.field(name));
+        EXPECT_EQ(name, schema.field(name)->name());
+        EXPECT_EQ(i % 2 == 0 ? cpp2::PropertyType::INT64 : cpp2::PropertyType::STRING,
+                  schema.getFieldType(name));
+    }
+    EXPECT_EQ(-1, schema.getFieldIndex("prop_500"));
+    EXPECT_EQ(-1, schema.getFieldIndex("prop"));
+    EXPECT_EQ(-1, schema.getFieldIndex(""));
+    EXPECT_EQ(cpp2::PropertyType::UNKNOWN, schema.getFieldType("unknown"));
+}
+
+
+TEST(NebulaSchemaProviderTest, DuplicateName) {
+    NebulaSchemaProvider schema(0);
+    schema.addField("a", cpp2::PropertyType::INT64);
+    schema.addField("b", cpp2::PropertyType::INT64);
+    schema.addField("a", cpp2::PropertyType::STRING);
+    // The first one wins
+    EXPECT_EQ(0, schema.getFieldIndex("a"));
+    EXPECT_EQ(cpp2::PropertyType::INT64, schema.getFieldType("a"));
+    // Still after the index grows
+    for (int i = 0; i < 10; ++i) {
+        schema.addField(folly::stringPrintf("c%d", i), cpp2::PropertyType::INT64);
+    }
+    EXPECT_EQ(0, schema.getFieldIndex("a"));
+    EXPECT_EQ(1, schema.getFieldIndex("b"));
+    EXPECT_EQ(3, schema.getFieldIndex("c0"));
+}
+
+
+// Written against the std::string lookups, before they took folly::StringPiece
+class LegacySchemaProvider final : public SchemaProviderIf {
+public:
+    explicit LegacySchemaProvider(const NebulaSchemaProvider* schema) : schema_(schema) {}
+
+    using SchemaProviderIf::getFieldIndex;
+    using SchemaProviderIf::getFieldType;
+    using SchemaProviderIf::field;
+
+    SchemaVer getVersion() const noexcept override {
+        return schema_->getVersion();
+    }
+    size_t getNumFields() const noexcept override {
+        return schema_->getNumFields();
+    }
+    size_t getNumNullableFields() const noexcept override {
+        return schema_->getNumNullableFields();
+    }
+    size_t size() const noexcept override {
+        return schema_->size();
+    }
+
+    int64_t getFieldIndex(const std::string& name) const override {
+        ++lookups_;
+        return schema_->getFieldIndex(folly::StringPiece(name));
+    }
+    const char* getFieldName(int64_t index) const override {
+        return schema_->getFieldName(index);
+    }
+
+    cpp2::PropertyType getFieldType(int64_t index) const override {
+        return schema_->getFieldType(index);
+    }
+    cpp2::PropertyType getFieldType(const std::string& name) const override {
+        ++lookups_;
+        return schema_->getFieldType(folly::StringPiece(name));
+    }
+
+    const Field* field(int64_t index) const override {
+        return schema_->field(index);
+    }
+    const Field* field(const std::string& name) const override {
+        ++lookups_;
+        return schema_->field(folly::StringPiece(name));
+    }
+
+    mutable size_t lookups_{0};
+
+private:
+    const NebulaSchemaProvider* schema_;
+};
+
+
+TEST(NebulaSchemaProviderTest, LookupOverloads) {
+    NebulaSchemaProvider schema(0);
+    schema.addField("a", cpp2::PropertyType::INT64);
+    schema.addField("b", cpp2::PropertyType::STRING);
+    LegacySchemaProvider legacy(&schema);
+
+    std::string name = "b";
+    const char* cstr = "b";
+    for (const SchemaProviderIf* provider : {static_cast<const SchemaProviderIf*>(&schema),
+                                             static_cast<const SchemaProviderIf*>(&legacy)}) {
+        EXPECT_EQ(1, provider->getFieldIndex(folly::StringPiece(name)));
+        EXPECT_EQ(1, provider->getFieldIndex(name));
+        EXPECT_EQ(1, provider->getFieldIndex(cstr));
+        EXPECT_EQ(1, provider->getFieldIndex("b"));
+        EXPECT_EQ(-1, provider->getFieldIndex("c"));
+        EXPECT_EQ(cpp2::PropertyType::STRING, provider->getFieldType(folly::StringPiece(name)));
+        EXPECT_EQ(cpp2::PropertyType::STRING, provider->getFieldType(name));
+        EXPECT_EQ(cpp2::PropertyType::STRING, provider->getFieldType("b"));
+        EXPECT_EQ(cpp2::PropertyType::INT64, provider->getFieldType(0));
+        EXPECT_STREQ("b", provider->field(folly::StringPiece(name))->name());
+        EXPECT_STREQ("b", provider->field(name)->name());
+        EXPECT_STREQ("b", provider->field("b")->name());
+        EXPECT_STREQ("a", provider->field(0)->name());
+    }
+    // All the lookups by name reach the legacy overrides
+    EXPECT_EQ(11, legacy.lookups_);
+}
+
+
+TEST(NebulaSchemaProviderTest, ConstDefaultValue) {
+    ObjectPool pool;
+    NebulaSchemaProvider schema(0);
+    schema.addField("none", cpp2::PropertyType::INT64);
+    schema.addField("int",
+                    cpp2::PropertyType::INT64,
+                    0,
+                    false,
+                    ArithmeticExpression::makeAdd(&pool,
+                                                  ConstantExpression::make(&pool, 1),
+                                                  ConstantExpression::make(&pool, 2)));
+    schema.addField("now",
+                    cpp2::PropertyType::TIMESTAMP,
+                    0,
+                    false,
+                    FunctionCallExpression::make(&pool, "now", ArgumentList::make(&pool)));
+
+    EXPECT_FALSE(schema.field("none")->hasDefault());
+    EXPECT_EQ(nullptr, schema.field("none")->constDefaultValue());
+
+    auto* cached = schema.field("int")->constDefaultValue();
+    ASSERT_NE(nullptr, cached);
+    EXPECT_EQ(Value(3), *cached);
+
+    // Evaluated for each row
+    EXPECT_TRUE(schema.field("now")->hasDefault());
+    EXPECT_EQ(nullptr, schema.field("now")->constDefaultValue());
+}
+
+}  // namespace meta
+}  // namespace nebula
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <folly/Benchmark.h>
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+namespace meta {
+
+struct Schema {
+    std::shared_ptr<NebulaSchemaProvider> provider;
+    // The index by std::string keys, as the provider kept before
+    std::unordered_map<std::string, int64_t> nameIndex;
+    std::vector<std::string> names;
+};
+
+static const Schema& schemaOf(size_t numFields) {
+    static std::unordered_map<size_t, Schema> schemas;
+    auto& schema = schemas[numFields];
+    if (schema.provider == nullptr) {
+        schema.provider = std::make_shared<NebulaSchemaProvider>(0);
+        for (size_t i = 0; i < numFields; ++i) {
+            auto name = folly::stringPrintf("property_name_%lu", i);
+            schema.provider->addField(name, cpp2::PropertyType::INT64);
+            schema.nameIndex.emplace(name, i);
+            schema.names.emplace_back(std::move(name));
+        }
+    }
+    return schema;
+}
+
+// Each iteration looks up all the fields once
+size_t stringMap(size_t iters, size_t numFields) {
+    auto& schema = schemaOf(numFields);
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto& name : schema.names) {
+            auto it = schema.nameIndex.find(name);
+            folly::doNotOptimizeAway(it);
+        }
+    }
+    return iters * numFields;
+}
+
+size_t fieldIndex(size_t iters, size_t numFields) {
+    auto& schema = schemaOf(numFields);
+    for (size_t i = 0; i < iters; ++i) {
+        for (auto& name : schema.names) {
+            auto index = schema.provider->getFieldIndex(name);
+            folly::doNotOptimizeAway(index);
+        }
+    }
+    return iters * numFields;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(stringMap, 5_fields, 5)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(fieldIndex, 5_fields, 5)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(stringMap, 50_fields, 50)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(fieldIndex, 50_fields, 50)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(stringMap, 500_fields, 500)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(fieldIndex, 500_fields, 500)
+
+}  // namespace meta
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    folly::runBenchmarks();
+    return 0;
+}
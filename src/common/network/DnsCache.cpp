@@ -0,0 +1,194 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include "common/network/DnsCache.h"
+#include <folly/IPAddress.h>
+#include <folly/ScopeGuard.h>
+#include <folly/SocketAddress.h>
+#include "common/time/WallClock.h"
+
+DEFINE_int32(dns_cache_ttl_secs, 60,
+             "Seconds a resolved hostname is considered fresh, "
+             "stale entries are still served while being refreshed in background");
+DEFINE_int32(dns_cache_negative_ttl_secs, 5,
+             "Seconds a failed hostname resolution is cached");
+
+namespace nebula {
+namespace network {
+
+// static
+DnsCache& DnsCache::instance() {
+    static DnsCache cache;
+    return cache;
+}
+
+
+DnsCache::DnsCache() {
+    hits_ = stats::StatsManager::registerStats("dns_cache_hits", "rate, sum");
+    misses_ = stats::StatsManager::registerStats("dns_cache_misses", "rate, sum");
+    latency_ = stats::StatsManager::registerHisto(
+        "dns_resolve_latency_us", 1000, 0, 2000000, "avg, p75, p95, p99");
+    refresher_ = std::make_unique<thread::GenericWorker>();
+    CHECK(refresher_->start("dns-refresher"));
+}
+
+
+DnsCache::~DnsCache() {
+    refresher_->stop();
+    refresher_->wait();
+}
+
+
+StatusOr<HostAddr> DnsCache::resolve(const HostAddr& addr) {
+    if (folly::IPAddress::validate(addr.host)) {
+        return addr;
+    }
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& entry = entries_[addr.host];
+    if (!entry.resolved) {
+        // Never resolved on the caller's thread, which may be an IO thread
+        stats::StatsManager::addValue(misses_);
+        scheduleRefresh(addr.host, entry);
+        return Status::Error("Host is being resolved: %s", addr.host.c_str());
+    }
+    return serve(addr, entry);
+}
+
+
+folly::SemiFuture<StatusOr<HostAddr>> DnsCache::resolveAsync(const HostAddr& addr) {
+    if (folly::IPAddress::validate(addr.host)) {
+        return folly::makeSemiFuture<StatusOr<HostAddr>>(addr);
+    }
+
+    std::lock_guard<std::mutex> guard(lock_);
+    auto& entry = entries_[addr.host];
+    if (entry.resolved) {
+        return folly::makeSemiFuture(serve(addr, entry));
+    }
+    stats::StatsManager::addValue(misses_);
+    entry.waiters.emplace_back();
+    auto future = entry.waiters.back().getSemiFuture();
+    scheduleRefresh(addr.host, entry);
+    return std::move(future).deferValue([port = addr.port] (StatusOr<std::string> ip)
+                                        -> StatusOr<HostAddr> {
+        if (!ip.ok()) {
+            return ip.status();
+        }
+        return HostAddr(std::move(ip).value(), port);
+    });
+}
+
+
+StatusOr<HostAddr> DnsCache::serve(const HostAddr& addr, Entry& entry) {
+    stats::StatsManager::addValue(hits_);
+    if (entry.expireAtSec <= time::WallClock::fastNowInSec()) {
+        // Serve the stale entry and refresh it asynchronously
+        scheduleRefresh(addr.host, entry);
+    }
+    if (entry.ip.empty()) {
+        return Status::Error("Failed to resolve host: %s", addr.host.c_str());
+    }
+    return HostAddr(entry.ip, addr.port);
+}
+
+
+void DnsCache::scheduleRefresh(const std::string& host, Entry& entry) {
+    if (!entry.refreshing) {
+        entry.refreshing = true;
+        refresher_->addTask(&DnsCache::refresh, this, host);
+    }
+}
+
+
+void DnsCache::invalidate(const std::string& host) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(host);
+    if (it == entries_.end()) {
+        return;
+    }
+    if (it->second.refreshing) {
+        // Kept for the resolution in flight and whoever waits for it
+        it->second.resolved = false;
+        it->second.ip.clear();
+    } else {
+        entries_.erase(it);
+    }
+}
+
+
+void DnsCache::clear() {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.refreshing) {
+            it->second.resolved = false;
+            it->second.ip.clear();
+            ++it;
+        } else {
+            it = entries_.erase(it);
+        }
+    }
+}
+
+
+size_t DnsCache::size() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.size();
+}
+
+
+StatusOr<std::string> DnsCache::doResolve(const std::string& host) {
+    auto startUs = time::WallClock::fastNowInMicroSec();
+    SCOPE_EXIT {
+        stats::StatsManager::addValue(latency_, time::WallClock::fastNowInMicroSec() - startUs);
+    };
+    try {
+        // folly said 'resolve' may take seconds to finish, that is why we cache it
+        folly::SocketAddress socketAddr(host, 0, true);
+        auto ip = socketAddr.getAddressStr();
+        LOG(INFO) << "Resolve " << host << " as " << ip;
+        return ip;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "Failed to resolve " << host << ": " << e.what();
+        return Status::Error("Failed to resolve host: %s", host.c_str());
+    }
+}
+
+
+void DnsCache::refresh(const std::string& host) {
+    auto result = doResolve(host);
+    update(host, result);
+}
+
+
+void DnsCache::update(const std::string& host, const StatusOr<std::string>& result) {
+    auto now = time::WallClock::fastNowInSec();
+    std::vector<folly::Promise<StatusOr<std::string>>> waiters;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto& entry = entries_[host];
+        entry.refreshing = false;
+        entry.resolved = true;
+        if (result.ok()) {
+            entry.ip = result.value();
+            entry.expireAtSec = now + FLAGS_dns_cache_ttl_secs;
+        } else if (entry.ip.empty()) {
+            entry.expireAtSec = now + FLAGS_dns_cache_negative_ttl_secs;
+        } else {
+            // Keep serving the last known good address, but retry sooner
+            VLOG(1) << "Keep the stale address " << entry.ip << " for " << host;
+            entry.expireAtSec = now + FLAGS_dns_cache_negative_ttl_secs;
+        }
+        waiters.swap(entry.waiters);
+    }
+    for (auto& waiter : waiters) {
+        waiter.setValue(result);
+    }
+}
+
+}  // namespace network
+}  // namespace nebula
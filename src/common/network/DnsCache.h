@@ -0,0 +1,100 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_NETWORK_DNSCACHE_H_
+#define COMMON_NETWORK_DNSCACHE_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include <folly/futures/Future.h>
+#include "common/datatypes/HostAddr.h"
+#include "common/stats/StatsManager.h"
+#include "common/thread/GenericWorker.h"
+
+DECLARE_int32(dns_cache_ttl_secs);
+DECLARE_int32(dns_cache_negative_ttl_secs);
+
+namespace nebula {
+namespace network {
+
+/**
+ * A process-wide cache of hostname resolutions, shared by all ThriftClientManagers.
+ *
+ * Hostnames are only ever resolved by a background worker, so lookups never block
+ * IO threads on DNS. The first lookup of a hostname fails fast with resolve(), or
+ * waits for the worker with resolveAsync(). Once an entry expires, the stale
+ * address keeps being served while the worker refreshes it. Failed resolutions
+ * are cached for a shorter period to avoid hammering the resolver.
+ *
+ * IP literals are returned as-is without touching the cache.
+ */
+class DnsCache final {
+public:
+    static DnsCache& instance();
+
+    // Returns the given address with its host part resolved to an IP, from the
+    // cache only. A host not resolved yet is an error, and it's resolved in
+    // background for the next lookup.
+    StatusOr<HostAddr> resolve(const HostAddr& addr);
+
+    // Like resolve(), but waits for the background resolution of a host not
+    // resolved yet instead of failing
+    folly::SemiFuture<StatusOr<HostAddr>> resolveAsync(const HostAddr& addr);
+
+    // Drops the cached entry so that the next lookup resolves again,
+    // e.g. when the connection to the resolved address is refused,
+    // see ThriftClientManager::onFailure().
+    void invalidate(const std::string& host);
+
+    void clear();
+
+    // The number of hosts cached or being resolved
+    size_t size();
+
+    ~DnsCache();
+
+private:
+    struct Entry {
+        // Empty if the resolution failed
+        std::string ip;
+        int64_t expireAtSec{0};
+        // Whether it has been resolved at least once, i.e. ip is valid
+        bool resolved{false};
+        bool refreshing{false};
+        // Waiting for the first resolution, see resolveAsync()
+        std::vector<folly::Promise<StatusOr<std::string>>> waiters;
+    };
+
+    DnsCache();
+
+    // The cached address of a resolved entry, which is refreshed if stale.
+    // lock_ must be held.
+    StatusOr<HostAddr> serve(const HostAddr& addr, Entry& entry);
+
+    // Resolves the host of the entry in background, unless it's being
+    // resolved already. lock_ must be held.
+    void scheduleRefresh(const std::string& host, Entry& entry);
+
+    StatusOr<std::string> doResolve(const std::string& host);
+
+    void refresh(const std::string& host);
+
+    void update(const std::string& host, const StatusOr<std::string>& result);
+
+private:
+    std::mutex lock_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::unique_ptr<thread::GenericWorker> refresher_;
+
+    stats::CounterId hits_;
+    stats::CounterId misses_;
+    stats::CounterId latency_;
+};
+
+}  // namespace network
+}  // namespace nebula
+
+#endif  // COMMON_NETWORK_DNSCACHE_H_
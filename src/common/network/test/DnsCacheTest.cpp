@@ -0,0 +1,110 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <folly/ScopeGuard.h>
+#include "common/network/DnsCache.h"
+
+namespace nebula {
+namespace network {
+
+TEST(DnsCache, IPLiteral) {
+    auto& cache = DnsCache::instance();
+    cache.clear();
+    auto result = cache.resolve(HostAddr("127.0.0.1", 8080));
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ("127.0.0.1", result.value().host);
+    EXPECT_EQ(8080, result.value().port);
+    // IP literals are never cached
+    EXPECT_EQ(0, cache.size());
+}
+
+
+TEST(DnsCache, Resolve) {
+    auto& cache = DnsCache::instance();
+    cache.clear();
+    {
+        auto result = cache.resolveAsync(HostAddr("localhost", 8080)).get();
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(8080, result.value().port);
+        EXPECT_EQ(1, cache.size());
+    }
+    {
+        // Served from the cache, with the port of the request
+        auto result = cache.resolve(HostAddr("localhost", 9090));
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(9090, result.value().port);
+        EXPECT_EQ(1, cache.size());
+    }
+    cache.invalidate("localhost");
+    EXPECT_EQ(0, cache.size());
+}
+
+
+TEST(DnsCache, ColdMiss) {
+    auto& cache = DnsCache::instance();
+    cache.clear();
+    // Fails fast rather than resolving on the caller's thread
+    auto result = cache.resolve(HostAddr("localhost", 8080));
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(1, cache.size());
+
+    // Whoever waits gets the same resolution
+    auto first = cache.resolveAsync(HostAddr("localhost", 8080));
+    auto second = cache.resolveAsync(HostAddr("localhost", 9090));
+    auto firstResult = std::move(first).get();
+    auto secondResult = std::move(second).get();
+    ASSERT_TRUE(firstResult.ok()) << firstResult.status();
+    ASSERT_TRUE(secondResult.ok()) << secondResult.status();
+    EXPECT_EQ(firstResult.value().host, secondResult.value().host);
+    EXPECT_EQ(9090, secondResult.value().port);
+
+    result = cache.resolve(HostAddr("localhost", 8080));
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(firstResult.value(), result.value());
+}
+
+
+TEST(DnsCache, NegativeCache) {
+    auto& cache = DnsCache::instance();
+    cache.clear();
+    // Names under ".invalid" never resolve, see RFC 2606
+    auto result = cache.resolveAsync(HostAddr("nebula.invalid", 8080)).get();
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(1, cache.size());
+    result = cache.resolve(HostAddr("nebula.invalid", 8080));
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(1, cache.size());
+}
+
+
+TEST(DnsCache, StaleEntry) {
+    FLAGS_dns_cache_ttl_secs = 0;
+    SCOPE_EXIT {
+        FLAGS_dns_cache_ttl_secs = 60;
+    };
+    auto& cache = DnsCache::instance();
+    cache.clear();
+    auto first = cache.resolveAsync(HostAddr("localhost", 8080)).get();
+    ASSERT_TRUE(first.ok()) << first.status();
+    // The entry has expired already, but the stale address is still served
+    auto second = cache.resolve(HostAddr("localhost", 8080));
+    ASSERT_TRUE(second.ok()) << second.status();
+    EXPECT_EQ(first.value().host, second.value().host);
+}
+
+}  // namespace network
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
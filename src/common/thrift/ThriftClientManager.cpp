@@ -6,6 +6,46 @@
 
 #include "common/base/Base.h"
 #include "common/thrift/ThriftClientManager.h"
+#include <thrift/lib/cpp/transport/TTransportException.h>
 
 DEFINE_int32(conn_timeout_ms, 1000,
              "Connection timeout in milliseconds");
+
+namespace nebula {
+namespace thrift {
+
+StatusOr<CompressionType> toCompressionType(folly::StringPiece name) {
+    auto lower = name.str();
+    folly::toLowerAscii(lower);
+    if (lower == "none" || lower.empty()) {
+        return CompressionType::NONE;
+    } else if (lower == "zlib") {
+        return CompressionType::ZLIB;
+    } else if (lower == "zstd") {
+        return CompressionType::ZSTD;
+    }
+    return Status::Error("Unknown compression type: %s", lower.c_str());
+}
+
+void ResponseSizeHandler::postRead(void*,
+                                   const char*,
+                                   apache::thrift::transport::THeader*,
+                                   uint32_t bytes) {
+    stats::StatsManager::addValue(bytes_, bytes);
+    // The socket is shared by all requests of the client, so count what it
+    // received since the last response. The sum is exact even though a single
+    // delta may include other responses partially received.
+    auto received = socket_->getRawBytesReceived();
+    stats::StatsManager::addValue(wireBytes_, received - lastReceived_);
+    lastReceived_ = received;
+}
+
+bool isConnectFailure(const folly::exception_wrapper& ex) {
+    using apache::thrift::transport::TTransportException;
+    // A channel fails the requests with NOT_OPEN if its socket failed to connect
+    auto* transportEx = ex.get_exception<TTransportException>();
+    return transportEx != nullptr && transportEx->getType() == TTransportException::NOT_OPEN;
+}
+
+}  // namespace thrift
+}  // namespace nebula
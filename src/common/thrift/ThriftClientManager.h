@@ -8,12 +8,55 @@
 #define COMMON_THRIFT_THRIFTCLIENTMANAGER_H_
 
 #include "common/base/Base.h"
+#include <folly/ExceptionWrapper.h>
+#include <folly/io/async/AsyncSocket.h>
 #include <folly/io/async/EventBaseManager.h>
+#include <thrift/lib/cpp/TProcessorEventHandler.h>
+#include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
+#include "common/stats/StatsManager.h"
 
 namespace nebula {
 namespace thrift {
 
+// Transport-level compression, applied through the thrift header transforms.
+// The server replies with the same transforms as the request, so turning it on
+// at client side compresses both directions.
+enum class CompressionType : uint8_t {
+    NONE = 0,
+    ZLIB = 1,
+    ZSTD = 2,
+};
+
+// Parse "none", "zlib" or "zstd", case insensitive
+StatusOr<CompressionType> toCompressionType(folly::StringPiece name);
+
+// If the rpc failed since the connection could not be established, e.g. refused
+// or unreachable, rather than failed or timed out on an established one
+bool isConnectFailure(const folly::exception_wrapper& ex);
+
+// Counts the size of the responses a client receives, decoded and on the wire,
+// from the counts thrift and the socket already keep. It's owned by the client,
+// which owns the socket, and called in the IO thread of the client.
+class ResponseSizeHandler final : public apache::thrift::TProcessorEventHandler {
+public:
+    ResponseSizeHandler(const folly::AsyncSocket* socket,
+                        stats::CounterId bytes,
+                        stats::CounterId wireBytes)
+        : socket_(socket), bytes_(bytes), wireBytes_(wireBytes) {}
+
+    void postRead(void* ctx,
+                  const char* fnName,
+                  apache::thrift::transport::THeader* header,
+                  uint32_t bytes) override;
+
+private:
+    const folly::AsyncSocket* socket_;
+    stats::CounterId bytes_;
+    stats::CounterId wireBytes_;
+    size_t lastReceived_{0};
+};
+
 template<class ClientType>
 class ThriftClientManager final {
 public:
@@ -22,6 +65,30 @@ public:
                                        bool compatibility = false,
                                        uint32_t timeout = 0);
 
+    // Only affects the clients created afterwards. Messages smaller than
+    // `minCompressBytes' are sent uncompressed.
+    void setCompression(CompressionType type, uint32_t minCompressBytes) {
+        compression_ = type;
+        minCompressBytes_ = minCompressBytes;
+    }
+
+    CompressionType compression() const {
+        return compression_;
+    }
+
+    // The clients created afterwards count the size of their responses into
+    // `bytes' and `wireBytes', see ResponseSizeHandler
+    void setResponseSizeStats(stats::CounterId bytes, stats::CounterId wireBytes) {
+        respBytes_ = bytes;
+        respWireBytes_ = wireBytes;
+    }
+
+    // To be called when the rpc to `host' failed with `ex'. If it failed to connect,
+    // the host may have moved to another address, e.g. a rescheduled pod, so its
+    // cached resolution is dropped and the next client resolves it again.
+    // Returns if it failed to connect.
+    bool onFailure(const HostAddr& host, const folly::exception_wrapper& ex);
+
     ~ThriftClientManager() {
         VLOG(3) << "~ThriftClientManager";
     }
@@ -37,6 +104,11 @@ private:
     >;
 
     folly::ThreadLocal<ClientMap> clientMap_;
+    std::atomic<CompressionType> compression_{CompressionType::NONE};
+    std::atomic<uint32_t> minCompressBytes_{0};
+    // Not counted if invalid
+    stats::CounterId respBytes_;
+    stats::CounterId respWireBytes_;
 };
 
 }  // namespace thrift
@@ -7,7 +7,7 @@
 #include <thrift/lib/cpp2/async/HeaderClientChannel.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/system/ThreadName.h>
-#include "common/network/NetworkUtils.h"
+#include "common/network/DnsCache.h"
 
 DECLARE_int32(conn_timeout_ms);
 
@@ -46,23 +46,15 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(
     // Need to create a new client and insert it to client map.
     VLOG(2) << "There is no existing client to " << host << ", trying to create one";
     static thread_local int connectionCount = 0;
-    /*
-     * TODO(liuyu): folly said 'resolve' may take second to finish
-     *              if this really happen, we will add a cache here.
-     * */
     HostAddr resolved = host;
-    if (!folly::IPAddress::validate(resolved.host)) {
-        try {
-            folly::SocketAddress socketAddr(resolved.host, resolved.port, true);
-            std::ostringstream oss;
-            oss << "resolve " << resolved << " as ";
-            resolved.host = socketAddr.getAddressStr();
-            oss << resolved;
-            LOG(INFO) << oss.str();
-        } catch(const std::exception& e) {
-            // if we resolve failed, just return a connection, we will retry later
-            LOG(ERROR) << e.what();
-        }
+    // Only served from the cache, this may be on the IO thread of evb
+    auto result = network::DnsCache::instance().resolve(host);
+    if (result.ok()) {
+        resolved = std::move(result).value();
+    } else {
+        // if we resolve failed or the host is still being resolved, just return
+        // a connection, which fails and is created again on the next request
+        LOG(ERROR) << result.status();
     }
 
     VLOG(2) << "Connecting to " << host << " for " << ++connectionCount << " times";
@@ -79,13 +71,34 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(
     if (compatibility) {
         headerClientChannel->setProtocolId(apache::thrift::protocol::T_BINARY_PROTOCOL);
         headerClientChannel->setClientType(THRIFT_UNFRAMED_DEPRECATED);
+    } else if (compression_ != CompressionType::NONE) {
+        // Header transforms are not available in the unframed compatible mode
+        headerClientChannel->setTransform(compression_ == CompressionType::ZSTD
+            ? apache::thrift::transport::THeader::ZSTD_TRANSFORM
+            : apache::thrift::transport::THeader::ZLIB_TRANSFORM);
+        headerClientChannel->setMinCompressBytes(minCompressBytes_);
     }
     std::shared_ptr<ClientType> client(
         new ClientType(std::move(headerClientChannel)),
         [evb](auto* p) { evb->runImmediatelyOrRunInEventBaseThreadAndWait([p] { delete p; }); });
-    clientMap_->emplace(std::make_pair(resolved, evb), client);
+    if (respBytes_.valid() && respWireBytes_.valid()) {
+        client->addEventHandler(
+            std::make_shared<ResponseSizeHandler>(socket.get(), respBytes_, respWireBytes_));
+    }
+    clientMap_->emplace(std::make_pair(host, evb), client);
     return client;
 }
 
+template<class ClientType>
+bool ThriftClientManager<ClientType>::onFailure(const HostAddr& host,
+                                               const folly::exception_wrapper& ex) {
+    if (!isConnectFailure(ex)) {
+        return false;
+    }
+    VLOG(1) << "Failed to connect to " << host << ", resolve it again next time";
+    network::DnsCache::instance().invalidate(host.host);
+    return true;
+}
+
 }  // namespace thrift
 }  // namespace nebula
@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "common/base/Base.h"
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp/transport/TTransportException.h>
+#include "common/network/DnsCache.h"
+#include "common/thrift/ThriftClientManager.h"
+
+namespace nebula {
+namespace thrift {
+
+using apache::thrift::transport::TTransportException;
+
+// Only the failure handling is tested, which doesn't create any client
+struct FakeClient {};
+
+TEST(ThriftClientManager, IsConnectFailure) {
+    EXPECT_TRUE(isConnectFailure(folly::make_exception_wrapper<TTransportException>(
+        TTransportException::NOT_OPEN, "Connection refused")));
+    EXPECT_FALSE(isConnectFailure(folly::make_exception_wrapper<TTransportException>(
+        TTransportException::TIMED_OUT, "Timed out")));
+    EXPECT_FALSE(isConnectFailure(folly::make_exception_wrapper<std::runtime_error>("oops")));
+}
+
+
+TEST(ThriftClientManager, InvalidateOnConnectFailure) {
+    auto& dnsCache = network::DnsCache::instance();
+    dnsCache.clear();
+    ThriftClientManager<FakeClient> clientsMan;
+    HostAddr host("localhost", 8080);
+    ASSERT_TRUE(dnsCache.resolveAsync(host).get().ok());
+    ASSERT_EQ(1, dnsCache.size());
+
+    // Failed on an established connection, the address is kept
+    EXPECT_FALSE(clientsMan.onFailure(host, folly::make_exception_wrapper<TTransportException>(
+        TTransportException::TIMED_OUT, "Timed out")));
+    EXPECT_EQ(1, dnsCache.size());
+
+    // Failed to connect, resolved again next time
+    EXPECT_TRUE(clientsMan.onFailure(host, folly::make_exception_wrapper<TTransportException>(
+        TTransportException::NOT_OPEN, "Connection refused")));
+    EXPECT_EQ(0, dnsCache.size());
+    ASSERT_TRUE(dnsCache.resolveAsync(host).get().ok());
+    EXPECT_EQ(1, dnsCache.size());
+}
+
+}  // namespace thrift
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}